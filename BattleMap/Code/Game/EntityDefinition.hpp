@@ -7,6 +7,7 @@
 #include "Game/GameCommon.hpp"
 
 #include <string>
+#include <vector>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -15,6 +16,27 @@ class SpriteAnimationSetDefinition;
 class ZephyrScriptDefinition;
 
 
+//-----------------------------------------------------------------------------------------------
+struct DamageMultiplier
+{
+public:
+	float defaultMultiplier = 1.f;
+	float curMultiplier = 1.f;
+	bool isDefined = false;
+
+public:
+	DamageMultiplier() = default;
+
+	DamageMultiplier( float defaultMultiplier )
+		: defaultMultiplier( defaultMultiplier )
+		, curMultiplier( defaultMultiplier )
+		, isDefined( true )
+	{ }
+
+	void Reset()					{ curMultiplier = defaultMultiplier; }
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class EntityDefinition : public ZephyrEntityDefinition
 {
@@ -29,6 +51,7 @@ public:
 	float			GetMaxHealth() const														{ return m_maxHealth; }
 
 	FloatRange		GetDamageRange() const														{ return m_damageRange; }
+	const std::vector<DamageMultiplier>& GetDamageMultipliers() const							{ return m_damageMultipliers; }
 
 	SpriteAnimationSetDefinition* GetDefaultSpriteAnimSetDef() const							{ return m_defaultSpriteAnimSetDef; }
 	std::map< std::string, SpriteAnimationSetDefinition* > GetSpriteAnimSetDefs() const			{ return m_spriteAnimSetDefs; }
@@ -45,6 +68,7 @@ protected:
 	float			m_maxHealth = 1.f;
 
 	FloatRange		m_damageRange = FloatRange( 0.f );
+	std::vector<DamageMultiplier> m_damageMultipliers;											// indexed by DamageTypeId
 
 	AABB2			m_localDrawBounds;
 	AABB2			m_uvCoords = AABB2::ONE_BY_ONE;
@@ -1,4 +1,6 @@
 #pragma once
+#include "Engine/Core/NameIdRegistry.hpp"
+
 #include <string>
 
 class Window;
@@ -25,6 +27,18 @@ extern Game* g_game;
 extern PerformanceTracker* g_performanceTracker;
 
 
+//-----------------------------------------------------------------------------------------------
+// Interned names, registered while loading data
+//-----------------------------------------------------------------------------------------------
+struct DamageTypeTag {};
+struct ScriptEventTag {};
+
+typedef NameId<DamageTypeTag> DamageTypeId;
+typedef NameId<ScriptEventTag> ScriptEventId;
+typedef NameIdRegistry<DamageTypeTag> DamageTypeRegistry;
+typedef NameIdRegistry<ScriptEventTag> ScriptEventRegistry;
+
+
 //-----------------------------------------------------------------------------------------------
 // Global Functions
 //
@@ -32,15 +32,13 @@ Map::Map( const MapData& mapData, World* world )
 //-----------------------------------------------------------------------------------------------
 Map::~Map()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		if ( m_entities[entityIdx] != nullptr )
-		{
-			PTR_SAFE_DELETE( m_entities[entityIdx] );
-		}
+		Entity* entity = m_entities[entityIdx];
+		PTR_SAFE_DELETE( entity );
 	}
 
-	m_entities.clear();
+	m_entities.Clear();
 }
 
 
@@ -53,12 +51,9 @@ void Map::Load( Entity* player )
 		return;
 	}
 
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		if ( m_entities[entityIdx] != nullptr )
-		{
-			m_entities[entityIdx]->Load();
-		}
+		m_entities[entityIdx]->Load();
 	}
 	
 	m_player = player;
@@ -74,18 +69,11 @@ void Map::Load( Entity* player )
 void Map::Unload()
 {
 	// Remove reference to player from this map
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		if ( m_entities[entityIdx] == m_player )
-		{
-			m_entities[entityIdx] = nullptr;
-			continue;
-		}
+	m_entities.Remove( m_player );
 
-		if ( m_entities[entityIdx] != nullptr )
-		{
-			m_entities[entityIdx]->Unload();
-		}
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
+	{
+		m_entities[entityIdx]->Unload();
 	}
 
 	m_player = nullptr;
@@ -101,15 +89,17 @@ void Map::Update( float deltaSeconds )
 	LARGE_INTEGER ticksBefore;
 	QueryPerformanceCounter( &ticksBefore );
 	
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); )
 	{
-		Entity* const& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
+		Entity* entity = m_entities[entityIdx];
+		entity->Update( deltaSeconds );
+
+		// An entity that left the map during its update had the last entity swapped into its place
+		if ( entityIdx < m_entities.GetCount()
+			 && m_entities[entityIdx] == entity )
 		{
-			continue;
+			++entityIdx;
 		}
-
-		entity->Update( deltaSeconds );
 	}
 
 	LARGE_INTEGER ticksAfter;
@@ -117,7 +107,7 @@ void Map::Update( float deltaSeconds )
 
 	double msElapsed = (double)( ticksAfter.QuadPart - ticksBefore.QuadPart ) * 1000.0 / (double)frequency.QuadPart ;
 
-	DebugAddScreenTextf( Vec4( 0.f, .05f, 10.f, 10.f ), Vec2::ZERO, 32.f, Rgba8::WHITE, Rgba8::WHITE, 0.f, "Entity Count: %d", (int)m_entities.size() );
+	DebugAddScreenTextf( Vec4( 0.f, .05f, 10.f, 10.f ), Vec2::ZERO, 32.f, Rgba8::WHITE, Rgba8::WHITE, 0.f, "Entity Count: %d", m_entities.GetCount() );
 	DebugAddScreenTextf( Vec4( 0.f, 0.f, 10.f, 10.f ), Vec2::ZERO, 32.f, Rgba8::WHITE, Rgba8::WHITE, 0.f, "Update Time: %.2f ms", msElapsed );
 
 	UpdateMesh();
@@ -129,14 +119,9 @@ void Map::Update( float deltaSeconds )
 //-----------------------------------------------------------------------------------------------
 void Map::Render() const
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity* const& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->Render();
 	}
 }
@@ -145,14 +130,9 @@ void Map::Render() const
 //-----------------------------------------------------------------------------------------------
 void Map::DebugRender() const
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity* const& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->DebugRender();
 	}
 }
@@ -197,14 +177,9 @@ Entity* Map::SpawnNewEntityOfTypeAtPosition( const std::string& entityDefName, c
 //-----------------------------------------------------------------------------------------------
 void Map::UnloadAllEntityScripts()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->UnloadZephyrScript();
 	}
 }
@@ -213,14 +188,9 @@ void Map::UnloadAllEntityScripts()
 //-----------------------------------------------------------------------------------------------
 void Map::ReloadAllEntityScripts()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->ReloadZephyrScript();
 	}
 }
@@ -229,14 +199,9 @@ void Map::ReloadAllEntityScripts()
 //-----------------------------------------------------------------------------------------------
 void Map::InitializeAllZephyrEntityVariables()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->InitializeZephyrEntityVariables();
 	}
 }
@@ -245,11 +210,10 @@ void Map::InitializeAllZephyrEntityVariables()
 //-----------------------------------------------------------------------------------------------
 void Map::CallAllMapEntityZephyrSpawnEvents( Entity* player )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr 
-			 || entity == player )
+		Entity* entity = m_entities[entityIdx];
+		if ( entity == player )
 		{
 			continue;
 		}
@@ -262,37 +226,15 @@ void Map::CallAllMapEntityZephyrSpawnEvents( Entity* player )
 //-----------------------------------------------------------------------------------------------
 void Map::RemoveOwnershipOfEntity( Entity* entityToRemove )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
-		if ( entity == entityToRemove )
-		{
-			m_entities[entityIdx] = nullptr;
-		}
-	}
+	m_entities.Remove( entityToRemove );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Map::TakeOwnershipOfEntity( Entity* entityToAdd )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			entity = entityToAdd;
-			return;
-		}
-	}
-
 	entityToAdd->m_map = this;
-	m_entities.push_back( entityToAdd );
+	m_entities.Add( entityToAdd );
 }
 
 
@@ -333,36 +275,26 @@ void Map::LoadEntities( const std::vector<MapEntityDefinition>& mapEntityDefs )
 //-----------------------------------------------------------------------------------------------
 void Map::AddToEntityList( Entity* entity )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		if ( m_entities[entityIdx] == nullptr )
-		{
-			m_entities[entityIdx] = entity;
-			return;
-		}
-	}
-
-	m_entities.push_back( entity );
+	m_entities.Add( entity );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Map::DeleteDeadEntities()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	// Walk backwards so the entity swapped into a removed slot has already been checked
+	for ( int entityIdx = m_entities.GetCount() - 1; entityIdx >= 0; --entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || !entity->IsDead() )
+		Entity* entity = m_entities[entityIdx];
+		if ( !entity->IsDead() )
 		{
 			continue;
 		}
 		
 		m_world->RemoveEntityFromWorldById( entity->GetId() );
 
+		m_entities.RemoveAtIndex( entityIdx );
 		PTR_SAFE_DELETE( entity );
-
-		m_entities[entityIdx] = nullptr;
 	}
 }
 
@@ -370,11 +302,10 @@ void Map::DeleteDeadEntities()
 //-----------------------------------------------------------------------------------------------
 Entity* Map::GetEntityByName( const std::string& name )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || entity->IsDead() )
+		Entity* entity = m_entities[entityIdx];
+		if ( entity->IsDead() )
 		{
 			continue;
 		}
@@ -392,33 +323,24 @@ Entity* Map::GetEntityByName( const std::string& name )
 //-----------------------------------------------------------------------------------------------
 Entity* Map::GetEntityById( EntityId id )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	Entity* entity = m_entities.GetById( id );
+	if ( entity == nullptr
+		 || entity->IsDead() )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || entity->IsDead() )
-		{
-			continue;
-		}
-
-		if ( entity->GetId() == id )
-		{
-			return entity;
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	return entity;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 Entity* Map::GetEntityAtPosition( const Vec2& position )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || entity->IsDead() )
+		Entity* entity = m_entities[entityIdx];
+		if ( entity->IsDead() )
 		{
 			continue;
 		}
@@ -1,4 +1,6 @@
 #pragma once
+#include "Engine/Framework/EntityStore.hpp"
+
 #include "Game/Tile.hpp"
 #include "Game/Entity.hpp"
 #include "Game/GameCommon.hpp"
@@ -89,5 +91,5 @@ protected:
 	float						m_playerStartYaw = 0.f;
 
 	Entity*						m_player = nullptr;
-	std::vector<Entity*>		m_entities;
+	EntityStore<Entity>			m_entities;
 };
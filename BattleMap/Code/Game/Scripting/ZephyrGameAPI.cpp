@@ -621,8 +621,8 @@ void ZephyrGameAPI::GetNewWanderTargetPosition( EventArgs* args )
 	}
 
 	Vec2 mapDimensions = map->GetDimensions();
-	float newX = g_game->m_rng->RollRandomFloatInRange( 2.f, mapDimensions.x - 2.f );
-	float newY = g_game->m_rng->RollRandomFloatInRange( 2.f, mapDimensions.y - 2.f );
+	float newX = entity->GetRNG().RollRandomFloatInRange( 2.f, mapDimensions.x - 2.f );
+	float newY = entity->GetRNG().RollRandomFloatInRange( 2.f, mapDimensions.y - 2.f );
 	
 	args->SetValue( "newPos", Vec3( newX, newY, 0.f ) );
 
@@ -813,9 +813,17 @@ void ZephyrGameAPI::SpawnEntitiesInRange( EventArgs* args )
 		return;
 	}
 
+	// Roll on the spawner's own stream when there is one so spawns replay the same way
+	RandomNumberGenerator* rng = g_game->m_rng;
+	Entity* spawner = (Entity*)args->GetValue( "entity", ( void* )nullptr );
+	if ( spawner != nullptr )
+	{
+		rng = &spawner->GetRNG();
+	}
+
 	for ( int i = 0; i < entityCount; ++i )
 	{
-		Vec2 randomPosition = Vec2( g_game->m_rng->RollRandomFloatInRange( minPos.x, maxPos.x ), g_game->m_rng->RollRandomFloatInRange( minPos.y, maxPos.y ) );
+		Vec2 randomPosition = Vec2( rng->RollRandomFloatInRange( minPos.x, maxPos.x ), rng->RollRandomFloatInRange( minPos.y, maxPos.y ) );
 		args->SetValue( "position", randomPosition );
 		g_eventSystem->FireEvent( "SpawnEntity", args );
 	}
@@ -4,6 +4,7 @@
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/ReplaySystem.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
 #include "Engine/Input/InputSystem.hpp"
@@ -61,6 +62,7 @@ void App::Startup()
 	g_zephyrSubsystem = new ZephyrSubsystem();
 	g_zephyrAPI = new ZephyrGameEvents();
 	g_performanceTracker = new PerformanceTracker();
+	g_replaySystem = new ReplaySystem();
 	g_game = new Game();
 
 	g_eventSystem->Startup();
@@ -68,6 +70,11 @@ void App::Startup()
 
 	g_jobSystem->Startup();
 
+	// Leave a core for the main thread, worker threads pick up async work like texture decoding
+	int numHardwareThreads = (int)std::thread::hardware_concurrency();
+	int numWorkerThreads = g_gameConfigBlackboard.GetValue( "numWorkerThreads", numHardwareThreads - 1 );
+	g_jobSystem->CreateWorkerThreads( numWorkerThreads > 0 ? numWorkerThreads : 1 );
+
 	g_inputSystem->Startup( g_window );
 	g_window->SetInputSystem( g_inputSystem );
 
@@ -80,6 +87,17 @@ void App::Startup()
 	g_devConsole->SetRenderer( g_renderer );
 	g_devConsole->SetBitmapFont( g_renderer->GetSystemFont() );
 
+	// Before the game starts up so the game is seeded from the replay
+	ReplaySystemParams replayParams;
+	replayParams.inputSystem = g_inputSystem;
+	replayParams.seed = (unsigned int)g_gameConfigBlackboard.GetValue( "seed", 0 );
+	replayParams.recordFilePath = g_gameConfigBlackboard.GetValue( "recordReplay", "" );
+	replayParams.replayFilePath = g_gameConfigBlackboard.GetValue( "playReplay", "" );
+	replayParams.isHeadless = g_gameConfigBlackboard.GetValue( "replayHeadless", false );
+	replayParams.timingsFilePath = g_gameConfigBlackboard.GetValue( "replayTimings", "" );
+	replayParams.baselineTimingsFilePath = g_gameConfigBlackboard.GetValue( "replayBaselineTimings", "" );
+	g_replaySystem->Startup( replayParams );
+
 	g_game->Startup();
 
 	ZephyrSystemParams zephyrParams;
@@ -97,6 +115,7 @@ void App::Startup()
 //-----------------------------------------------------------------------------------------------
 void App::Shutdown()
 {
+	g_replaySystem->Shutdown();
 	g_zephyrSubsystem->Shutdown();
 	g_game->Shutdown();
 	g_devConsole->Shutdown();
@@ -112,6 +131,7 @@ void App::Shutdown()
 	PTR_SAFE_DELETE( g_colliderFactory );
 	PTR_SAFE_DELETE( g_physicsConfig );
 	PTR_SAFE_DELETE( g_performanceTracker );
+	PTR_SAFE_DELETE( g_replaySystem );
 	PTR_SAFE_DELETE( g_zephyrAPI );
 	PTR_SAFE_DELETE( g_zephyrSubsystem );
 	PTR_SAFE_DELETE( g_devConsole );
@@ -129,7 +149,12 @@ void App::RunFrame()
 {
 	BeginFrame();											// for all engine systems (NOT the game)
 	Update();												// for the game only
-	Render();												// for the game only
+
+	if ( !g_replaySystem->IsHeadless() )
+	{
+		Render();											// for the game only
+	}
+
 	EndFrame();												// for all engine systems (NOT the game)
 }
 
@@ -178,13 +203,14 @@ eWindowMode App::GetWindowModeFromGameConfig()
 //-----------------------------------------------------------------------------------------------
 void App::BeginFrame()
 {
-	Clock::MasterBeginFrame();
+	g_replaySystem->BeginFrame();							// advances the master clock, by the recorded time when replaying
 
 	g_window->BeginFrame();
 	g_eventSystem->BeginFrame();
 	g_jobSystem->BeginFrame();
 	g_devConsole->BeginFrame();
 	g_inputSystem->BeginFrame();
+	g_replaySystem->UpdateInput();
 	g_audioSystem->BeginFrame();
 	g_renderer->BeginFrame();
 	DebugRenderBeginFrame();
@@ -251,6 +277,7 @@ void App::EndFrame()
 	g_jobSystem->EndFrame();
 	g_eventSystem->EndFrame();
 	g_window->EndFrame();
+	g_replaySystem->EndFrame();
 }
 
 
@@ -74,6 +74,7 @@ EntityDefinition::EntityDefinition( const XmlElement& entityDefElem )
 		m_physicsRadius = ParseXmlAttribute( *physicsElem, "radius", m_physicsRadius );
 		m_height = ParseXmlAttribute( *physicsElem, "height", m_height );
 		m_eyeHeight = ParseXmlAttribute( *physicsElem, "eyeHeight", m_eyeHeight );
+		m_isContinuousCollisionEnabled = ParseXmlAttribute( *physicsElem, "continuousCollision", m_isContinuousCollisionEnabled );
 		
 		m_initialCollisionLayer = ParseXmlAttribute( *physicsElem, "collisionLayer", m_initialCollisionLayer );
 		if ( !IsPhysicsLayerDefined( m_initialCollisionLayer ) )
@@ -59,6 +59,7 @@ public:
 	float						GetMass() const																{ return m_mass; }
 	std::string					GetInitialCollisionLayer() const											{ return m_initialCollisionLayer; }
 	bool						HasPhysics() const															{ return m_hasPhysics; }
+	bool						IsContinuousCollisionEnabled() const										{ return m_isContinuousCollisionEnabled; }
 	bool						HasZephyrScript() const														{ return m_zephyrDef != nullptr; }
 	ZephyrComponentDefinition*	GetZephyrCompDef() const													{ return m_zephyrDef; }
 
@@ -86,6 +87,7 @@ protected:
 	float			m_height = 0.f;
 	float			m_eyeHeight = 0.f;
 	float			m_mass = 1.f;
+	bool			m_isContinuousCollisionEnabled = false;		// sweep fast movers like projectiles so they don't tunnel
 
 	std::string		m_initialCollisionLayer;
 	std::vector<ColliderData> m_colliderDataVec;
@@ -18,5 +18,5 @@ FPSCamera::FPSCamera( const GameCameraSettings& gameCameraSettings )
 //-----------------------------------------------------------------------------------------------
 void FPSCamera::UpdateTranslation( GameEntity* target )
 {
-	SetPosition( target->GetPosition() + Vec3( 0.f, 0.f, target->GetEyeHeight() ) );
+	SetPosition( target->GetRenderPosition() + Vec3( 0.f, 0.f, target->GetEyeHeight() ) );
 }
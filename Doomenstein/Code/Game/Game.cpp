@@ -2,9 +2,11 @@
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/MatrixUtils.hpp"
+#include "Engine/Math/NoiseGrid.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/OBB3BVH.hpp"
 #include "Engine/Math/Vec4.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
@@ -13,11 +15,13 @@
 #include "Engine/Core/Image.hpp"
 #include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/ReplaySystem.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/TextBox.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Framework/EntityComponent.hpp"
+#include "Engine/Framework/EntityUpdateStage.hpp"
 #include "Engine/OS/Window.hpp"
 #include "Engine/Physics/PhysicsCommon.hpp"
 #include "Engine/Physics/PhysicsSystem.hpp"
@@ -29,6 +33,7 @@
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/MeshUtils.hpp"
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Renderer/D3D11Common.hpp"
 #include "Engine/Core/EventSystem.hpp"
@@ -46,10 +51,12 @@
 #include "Engine/Zephyr/Core/ZephyrUtils.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrComponentDefinition.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrSubsystem.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrSystem.hpp"
 
 #include "Game/GameEntity.hpp"
 #include "Game/EntityController.hpp"
 #include "Game/GameJobs.hpp"
+#include "Game/Map.hpp"
 #include "Game/MapData.hpp"
 #include "Game/MapRegionTypeDefinition.hpp"
 #include "Game/MapMaterialTypeDefinition.hpp"
@@ -85,12 +92,18 @@ void Game::Startup()
 
 	g_eventSystem->RegisterEvent( "set_mouse_sensitivity", "Usage: set_mouse_sensitivity multiplier=NUMBER. Set the multiplier for mouse sensitivity.", eUsageLocation::DEV_CONSOLE, SetMouseSensitivity );
 	g_eventSystem->RegisterEvent( "light_set_ambient_color", "Usage: light_set_ambient_color color=r,g,b", eUsageLocation::DEV_CONSOLE, SetAmbientLightColor );
+	g_eventSystem->RegisterEvent( "set_visibility_culling", "Usage: set_visibility_culling frustum=true occlusion=true. Toggle culling of map chunks and entities.", eUsageLocation::DEV_CONSOLE, Map::SetVisibilityCulling );
+	g_eventSystem->RegisterEvent( "benchmark_obb3_bvh", "Usage: benchmark_obb3_bvh walls=10000 rays=10000 maxDist=50. Compare bvh raycasts against every wall with brute force.", eUsageLocation::DEV_CONSOLE, BenchmarkOBB3BVHEvent );
+	g_eventSystem->RegisterEvent( "benchmark_noise_grid", "Usage: benchmark_noise_grid width=1024 height=1024 octaves=4 seed=7. Time grid noise against per sample calls and check they match.", eUsageLocation::DEV_CONSOLE, BenchmarkNoiseGridEvent );
+	g_eventSystem->RegisterEvent( "benchmark_random_fill", "Usage: benchmark_random_fill count=1048576 seed=7. Time bulk random fills against single rolls and check they match.", eUsageLocation::DEV_CONSOLE, BenchmarkRandomFillEvent );
+	g_eventSystem->RegisterEvent( "verify_entity_update", "Usage: verify_entity_update entities=10000 frames=60. Check the parallel entity update against a serial one.", eUsageLocation::DEV_CONSOLE, VerifyEntityUpdateEvent );
+	g_eventSystem->RegisterEvent( "benchmark_zephyr_update", "Usage: benchmark_zephyr_update entities=10000 frames=60. Time serial and parallel Zephyr script updates and check they match.", eUsageLocation::DEV_CONSOLE, BenchmarkZephyrUpdateEvent );
 	g_eventSystem->RegisterMethodEvent( "warp", "Usage: warp <map=string> <pos=float,float> <yaw=float>", eUsageLocation::DEV_CONSOLE, this, &Game::WarpMapCommand );
 	g_eventSystem->RegisterMethodEvent( "get_component_from_entity_id", "", eUsageLocation::GAME, this, &Game::GetComponentFromEntityId );
 
 	g_inputSystem->PushMouseOptions( CURSOR_RELATIVE, false, true );
 		
-	m_rng = new RandomNumberGenerator();
+	m_rng = new RandomNumberGenerator( g_replaySystem->GetSessionSeed() );
 
 	m_gameClock = new Clock();
 	g_renderer->Setup( m_gameClock );
@@ -106,6 +119,8 @@ void Game::Startup()
 	m_uiSystem = new UISystem();
 	m_uiSystem->Startup( g_window, g_renderer );
 
+	m_spriteBatch = new SpriteBatch( g_renderer );
+
 	m_physicsSystem = new PhysicsSystem3D();
 	m_physicsSystem->Startup( m_gameClock );
 	g_colliderFactory->RegisterCreator( "obb3", &OBB3Collider::Create );
@@ -142,14 +157,13 @@ void Game::AddGunToUI()
 {
 	// Add gun sprite
 	SpriteSheet* gunSprite = SpriteSheet::GetSpriteSheetByName( "ViewModels" );
-	Vec2 uvsAtMins, uvsAtMaxs;
-	gunSprite->GetSpriteUVs( uvsAtMins, uvsAtMaxs, IntVec2::ZERO );
 
 	UIAlignedPositionData posData;
 	posData.alignmentWithinParentElement = ALIGN_BOTTOM_CENTER;
 	posData.fractionOfParentDimensions = Vec2( .5f, 1.f );
 
-	SpriteDefinition spriteDef( *gunSprite, 0, uvsAtMins, uvsAtMaxs );
+	// Copy the sheet's definition rather than rebuilding it from remapped uvs, GetUVs applies the atlas region itself
+	SpriteDefinition spriteDef = gunSprite->GetSpriteDefinition( 0 );
 	m_uiSystem->GetUIElementByName( "Viewport" )->AddImage( posData, &spriteDef );
 }
 
@@ -170,6 +184,7 @@ void Game::Shutdown()
 	PTR_SAFE_DELETE( m_gameClock );
 	PTR_SAFE_DELETE( m_rng );
 	PTR_SAFE_DELETE( m_uiCamera );
+	PTR_SAFE_DELETE( m_spriteBatch );
 	PTR_SAFE_DELETE( m_uiSystem );
 	PTR_SAFE_DELETE( m_physicsSystem );
 }
@@ -199,6 +214,13 @@ void Game::Update()
 	m_world->Update();
 
 	m_playerController->UpdateTranslation();
+
+	// Lets a replay report the first frame it drifts from its recording
+	Vec3 cameraPosition = GetWorldCamera()->GetTransform().GetPosition();
+	int rngPosition = m_rng->GetPosition();
+	g_replaySystem->AddToFrameChecksum( &cameraPosition, sizeof( cameraPosition ) );
+	g_replaySystem->AddToFrameChecksum( &rngPosition, sizeof( rngPosition ) );
+	m_world->AddToFrameChecksum();
 }
 
 
@@ -411,6 +433,9 @@ void Game::LoadAssets()
 {
 	g_devConsole->PrintString( "Loading Assets...", Rgba8::WHITE );
 
+	// Atlases must exist before any sprite sheet requests one of their source textures
+	LoadXmlTextureAtlases();
+
 	SpriteSheet::CreateAndRegister( "ViewModels", *( g_renderer->CreateOrGetTextureFromFile( "Data/Images/ViewModelsSpriteSheet_8x8.png" ) ), IntVec2( 8, 8 ) );
 	
 	LoadSounds();
@@ -631,6 +656,66 @@ void Game::LoadXmlMapMaterials()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void Game::LoadXmlTextureAtlases()
+{
+	g_devConsole->PrintString( "Loading Texture Atlases..." );
+
+	const char* filePath = "Data/Definitions/TextureAtlases.xml";
+
+	XmlDocument doc;
+	XmlError loadError = doc.LoadFile( filePath );
+	if ( loadError != tinyxml2::XML_SUCCESS )
+	{
+		g_devConsole->PrintError( "TextureAtlases.xml could not be opened" );
+		return;
+	}
+
+	XmlElement* root = doc.RootElement();
+	if ( strcmp( root->Name(), "TextureAtlases" ) )
+	{
+		g_devConsole->PrintError( "TextureAtlases.xml: Incorrect root node name, must be TextureAtlases" );
+		return;
+	}
+
+	XmlElement* atlasElement = root->FirstChildElement( "TextureAtlas" );
+	while ( atlasElement )
+	{
+		std::string cachePath = ParseXmlAttribute( *atlasElement, "cachePath", "" );
+		if ( cachePath.empty() )
+		{
+			g_devConsole->PrintError( "TextureAtlases.xml: TextureAtlas node is missing a cachePath" );
+			atlasElement = atlasElement->NextSiblingElement( "TextureAtlas" );
+			continue;
+		}
+
+		Strings imagePaths;
+		XmlElement* imageElement = atlasElement->FirstChildElement( "Image" );
+		while ( imageElement )
+		{
+			std::string imagePath = ParseXmlAttribute( *imageElement, "path", "" );
+			if ( imagePath.empty() )
+			{
+				g_devConsole->PrintError( Stringf( "TextureAtlases.xml: Image node in '%s' is missing a path", cachePath.c_str() ) );
+			}
+			else
+			{
+				imagePaths.push_back( imagePath );
+			}
+
+			imageElement = imageElement->NextSiblingElement( "Image" );
+		}
+
+		if ( g_renderer->CreateOrLoadTextureAtlas( cachePath, imagePaths ) == nullptr )
+		{
+			g_devConsole->PrintError( Stringf( "TextureAtlases.xml: Couldn't create texture atlas '%s'", cachePath.c_str() ) );
+		}
+
+		atlasElement = atlasElement->NextSiblingElement( "TextureAtlas" );
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Game::LoadXmlMapRegions()
 {
@@ -24,6 +24,7 @@ class RandomNumberGenerator;
 class Camera;
 class GPUMesh;
 class Material;
+class SpriteBatch;
 class TextBox;
 class Texture;
 class UIPanel;
@@ -62,6 +63,7 @@ public:
 	const Vec2		GetMouseWorldPosition()														{ return m_mouseWorldPosition; }
 	const Camera*	GetWorldCamera()															{ return m_playerController->GetCurrentWorldCamera()->GetEngineCamera(); }
 	Clock*			GetGameClock()																{ return m_gameClock; }
+	SpriteBatch*	GetSpriteBatch() const														{ return m_spriteBatch; }
 
 	void			AddScreenShakeIntensity( float additionalIntensityFraction );
 	
@@ -104,6 +106,7 @@ public:
 private:
 	void LoadAssets();
 	void LoadSounds();
+	void LoadXmlTextureAtlases();
 	void LoadXmlUIElements();
 	void LoadXmlEntityTypes();
 	void LoadXmlMapMaterials();
@@ -153,6 +156,7 @@ private:
 	float m_screenShakeIntensity = 0.f;
 
 	Camera* m_uiCamera = nullptr;
+	SpriteBatch* m_spriteBatch = nullptr;
 
 	World* m_world = nullptr;
 	std::string m_startingMapName;
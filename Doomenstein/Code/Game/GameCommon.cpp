@@ -17,6 +17,7 @@ InputSystem* g_inputSystem = nullptr;				// Owned by the App
 AudioSystem* g_audioSystem = nullptr;				// Owned by the App
 Game* g_game = nullptr;								// Owned by the App
 PerformanceTracker* g_performanceTracker = nullptr;	// Owned by the App
+ReplaySystem* g_replaySystem = nullptr;				// Owned by the App
 
 
 //-----------------------------------------------------------------------------------------------
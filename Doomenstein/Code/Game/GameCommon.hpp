@@ -8,6 +8,7 @@ class AudioSystem;
 class RenderContext;
 class NetworkingSystem;
 class PerformanceTracker;
+class ReplaySystem;
 class PhysicsConfig;
 class Game;
 class SpriteSheet;
@@ -31,6 +32,7 @@ extern RenderContext* g_renderer;
 extern NetworkingSystem* g_networkingSystem;
 extern Game* g_game;
 extern PerformanceTracker* g_performanceTracker;
+extern ReplaySystem* g_replaySystem;
 
 
 //-----------------------------------------------------------------------------------------------
@@ -9,12 +9,15 @@
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Framework/EntityCommandBuffer.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
+#include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/MeshUtils.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Renderer/SpriteDefinition.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Time/Clock.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrSystem.hpp"
@@ -48,7 +51,7 @@ GameEntity::GameEntity( const EntityDefinition& entityDef, Map* map )
 
 
 //-----------------------------------------------------------------------------------------------
-void GameEntity::Update( float deltaSeconds )
+void GameEntity::UpdateInParallel( float deltaSeconds, EntityCommandBuffer& commands )
 {
 	m_cumulativeTime += deltaSeconds;
 
@@ -57,7 +60,7 @@ void GameEntity::Update( float deltaSeconds )
 	{
 		if ( m_isPossessed )
 		{
-			UpdateFromKeyboard( deltaSeconds );
+			UpdateFromKeyboard( deltaSeconds, commands );
 		}
 	}
 
@@ -68,7 +71,7 @@ void GameEntity::Update( float deltaSeconds )
 		SpriteAnimDefinition* animDef = m_curSpriteAnimSetDef->GetSpriteAnimationDefForDirection( position.XY(), m_transform.GetYawDegrees(), *g_game->GetWorldCamera() );
 		int frameIndex = animDef->GetFrameIndexAtTime( m_cumulativeTime );
 
-		m_curSpriteAnimSetDef->FireFrameEvent( frameIndex, this );
+		m_curSpriteAnimSetDef->QueueFrameEvent( frameIndex, this, commands );
 	}
 
 	// REFACTOR: Do this better somehow
@@ -82,7 +85,14 @@ void GameEntity::Update( float deltaSeconds )
 		}
 		break;
 	}
+}
+
 
+//-----------------------------------------------------------------------------------------------
+// The light pool is shared, so lights are handed out on the main thread in entity order
+//-----------------------------------------------------------------------------------------------
+void GameEntity::SubmitLight()
+{
 	if ( m_gameLight.isEnabled )
 	{
 		g_game->AcquireAndSetLightFromPool( m_gameLight.light );
@@ -91,7 +101,9 @@ void GameEntity::Update( float deltaSeconds )
 
 
 //-----------------------------------------------------------------------------------------------
-void GameEntity::Render() const
+// The batch owns the vertices and the draw, sprites from every entity go out in a few calls
+//-----------------------------------------------------------------------------------------------
+void GameEntity::AddToSpriteBatch( SpriteBatch& spriteBatch, const Camera& camera ) const
 {
 	if ( m_isPossessed 
 		|| m_curSpriteAnimSetDef == nullptr )
@@ -101,41 +113,27 @@ void GameEntity::Render() const
 
 	// Billboarding
 	Vec3 corners[4];
-	Vec3 position = GetPosition();
+	Vec3 position = GetRenderPosition();
 	switch ( m_entityDef.m_billboardStyle )
 	{
-		case eBillboardStyle::CAMERA_FACING_XY:		BillboardSpriteCameraFacingXY( position, m_entityDef.GetVisualSize(), *g_game->GetWorldCamera(), corners );	 break;
-		case eBillboardStyle::CAMERA_OPPOSING_XY:	BillboardSpriteCameraOpposingXY( position, m_entityDef.GetVisualSize(), *g_game->GetWorldCamera(), corners );	 break;
-		case eBillboardStyle::CAMERA_FACING_XYZ:	BillboardSpriteCameraFacingXYZ( position, m_entityDef.GetVisualSize(), *g_game->GetWorldCamera(), corners );	 break;
-		case eBillboardStyle::CAMERA_OPPOSING_XYZ:	BillboardSpriteCameraOpposingXYZ( position, m_entityDef.GetVisualSize(), *g_game->GetWorldCamera(), corners ); break;
+		case eBillboardStyle::CAMERA_FACING_XY:		BillboardSpriteCameraFacingXY( position, m_entityDef.GetVisualSize(), camera, corners );	 break;
+		case eBillboardStyle::CAMERA_OPPOSING_XY:	BillboardSpriteCameraOpposingXY( position, m_entityDef.GetVisualSize(), camera, corners );	 break;
+		case eBillboardStyle::CAMERA_FACING_XYZ:	BillboardSpriteCameraFacingXYZ( position, m_entityDef.GetVisualSize(), camera, corners );	 break;
+		case eBillboardStyle::CAMERA_OPPOSING_XYZ:	BillboardSpriteCameraOpposingXYZ( position, m_entityDef.GetVisualSize(), camera, corners ); break;
 		
-		default: BillboardSpriteCameraFacingXY( position, m_entityDef.GetVisualSize(), *g_game->GetWorldCamera(), corners ); break;
+		default: BillboardSpriteCameraFacingXY( position, m_entityDef.GetVisualSize(), camera, corners ); break;
 	}
 	
 	// Get UVs for sprite
-	SpriteAnimDefinition* animDef = m_curSpriteAnimSetDef->GetSpriteAnimationDefForDirection( position.XY(), m_transform.GetYawDegrees(), *g_game->GetWorldCamera() );
+	SpriteAnimDefinition* animDef = m_curSpriteAnimSetDef->GetSpriteAnimationDefForDirection( position.XY(), GetRenderOrientationDegrees(), camera );
 	const SpriteDefinition& spriteDef = animDef->GetSpriteDefAtTime( m_cumulativeTime );
 	
 	Vec2 mins, maxs;
 	spriteDef.GetUVs( mins, maxs );
 
-	std::vector<Vertex_PCUTBN> vertices;
-	AppendVertsForQuad( vertices, corners, Rgba8::WHITE, mins, maxs );
-
-	// Setup shaders and textures
-	if ( m_curSpriteAnimSetDef->GetMaterial() != nullptr )
-	{
-		g_renderer->BindMaterial( m_curSpriteAnimSetDef->GetMaterial() );
-	}
-	else
-	{
-		// No material for this sprite, just use the diffuse texture
-		g_renderer->BindShader( nullptr );
-		g_renderer->BindDiffuseTexture( &(m_curSpriteAnimSetDef->GetTexture()) );
-		g_renderer->BindNormalTexture( nullptr );
-	}
-	
-	g_renderer->DrawVertexArray( vertices );
+	// Without a material the batch binds the default shader and just the diffuse texture
+	float depth = GetDistanceSquared3D( position, camera.GetTransform().GetPosition() );
+	spriteBatch.AddSprite( corners, mins, maxs, &( m_curSpriteAnimSetDef->GetTexture() ), m_curSpriteAnimSetDef->GetMaterial(), depth );
 }
 
 
@@ -230,6 +228,38 @@ void GameEntity::SetOrientationDegrees( float orientationDegrees )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+const Vec3 GameEntity::GetRenderPosition() const
+{
+	if ( m_rigidbody == nullptr )
+	{
+		return GetPosition();
+	}
+
+	return m_renderPosition;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+const float GameEntity::GetRenderOrientationDegrees() const
+{
+	if ( m_rigidbody == nullptr )
+	{
+		return GetOrientationDegrees();
+	}
+
+	return m_renderOrientationDegrees;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GameEntity::SetRenderTransform( const Vec3& position, float orientationDegrees )
+{
+	m_renderPosition = position;
+	m_renderOrientationDegrees = orientationDegrees;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void GameEntity::CopyTransformToPhysicsComponent()
 {
@@ -465,7 +495,7 @@ void GameEntity::ChangeZephyrScriptState( const std::string& targetState )
 
 
 //-----------------------------------------------------------------------------------------------
-void GameEntity::UpdateFromKeyboard( float deltaSeconds )
+void GameEntity::UpdateFromKeyboard( float deltaSeconds, EntityCommandBuffer& commands )
 {
 	UNUSED( deltaSeconds );
 
@@ -483,8 +513,7 @@ void GameEntity::UpdateFromKeyboard( float deltaSeconds )
 		{
 			for ( auto& eventName : registeredKey.second )
 			{
-				EventArgs args;
-				ZephyrSystem::FireScriptEvent( m_id, eventName, &args );
+				commands.FireEvent( m_id, eventName );
 			}
 		}
 	}
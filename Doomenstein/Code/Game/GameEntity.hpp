@@ -15,9 +15,12 @@
 
 
 //-----------------------------------------------------------------------------------------------
+class Camera;
+class EntityCommandBuffer;
 class Map;
 class Rigidbody;
 class SpriteAnimationSetDefinition;
+class SpriteBatch;
 class Texture;
 class ZephyrComponent;
 
@@ -51,8 +54,10 @@ public:
 	GameEntity( const EntityDefinition& entityDef, Map* map );
 	virtual ~GameEntity() {}
 
-	virtual void		Update( float deltaSeconds );
-	virtual void		Render() const;
+	// Runs beside other entities, anything outside this entity goes through the commands
+	virtual void		UpdateInParallel( float deltaSeconds, EntityCommandBuffer& commands );
+	void				SubmitLight();
+	virtual void		AddToSpriteBatch( SpriteBatch& spriteBatch, const Camera& camera ) const;
 	virtual void		Die();
 	virtual void		DebugRender() const;
 
@@ -69,6 +74,9 @@ public:
 	const float			GetMass() const;
 	const float			GetOrientationDegrees() const							{ return m_transform.GetYawDegrees(); }
 	void				SetOrientationDegrees( float orientationDegrees );
+	const Vec3			GetRenderPosition() const;
+	const float			GetRenderOrientationDegrees() const;
+	void				SetRenderTransform( const Vec3& position, float orientationDegrees );
 	std::string			GetType() const											{ return m_entityDef.m_type; }
 	eEntityClass		GetClass() const										{ return m_entityDef.m_class; }
 	Map*				GetMap() const											{ return m_map; }
@@ -116,7 +124,7 @@ public:
 	//virtual void		AddGameEventParams( EventArgs* args ) const override;
 
 protected:
-	void				UpdateFromKeyboard( float deltaSeconds );
+	void				UpdateFromKeyboard( float deltaSeconds, EntityCommandBuffer& commands );
 	
 	char				GetKeyCodeFromString( const std::string& keyCodeStr );
 
@@ -133,6 +141,8 @@ protected:
 
 	// Physics
 	Rigidbody*						m_rigidbody = nullptr;
+	Vec3							m_renderPosition = Vec3::ZERO;					// blended between physics steps, only used with a rigidbody
+	float							m_renderOrientationDegrees = 0.f;
 
 	// Visual
 	float							m_cumulativeTime = 0.f;
@@ -1,4 +1,5 @@
 #include "Game/LineMap.hpp"
+#include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Math/OBB3.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -16,6 +17,22 @@
 #include "Game/World.hpp"
 
 
+//-----------------------------------------------------------------------------------------------
+static void ApplyWallHitToRaycastResult( const OBB3RaycastHit& hit, RaycastResult& out_result )
+{
+	if ( !hit.didImpact )
+	{
+		return;
+	}
+
+	out_result.didImpact = true;
+	out_result.impactPos = hit.impactPos;
+	out_result.impactDist = hit.impactDist;
+	out_result.impactFraction = out_result.maxDist > 0.f ? hit.impactDist / out_result.maxDist : 0.f;
+	out_result.impactSurfaceNormal = hit.impactSurfaceNormal;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 LineMap::LineMap( const MapData& mapData, World* world )
 	: Map( mapData, world )
@@ -24,13 +41,8 @@ LineMap::LineMap( const MapData& mapData, World* world )
 	m_regionTypeDefs = mapData.regionTypeDefs;
 
 	// Add gravity and drag to scene
-	m_physicsScene->AddAffector( "gravity", []( Rigidbody* rigidbody ) {
-		rigidbody->AddForce( Vec3( 0.f, 0.f, -9.8f ) );	 
-	} );
-
-	m_physicsScene->AddAffector( "drag", []( Rigidbody* rigidbody ) {
-		rigidbody->ApplyDragForce();	 
-	} );
+	m_physicsScene->AddUniformForceAffector( "gravity", Vec3( 0.f, 0.f, -9.8f ) );
+	m_physicsScene->AddDragAffector( "drag" );
 
 	for ( const auto& wall : m_walls )
 	{
@@ -58,13 +70,19 @@ LineMap::~LineMap()
 void LineMap::Load()
 {
 	g_game->SetCameraPositionAndYaw( m_playerStartPos, m_playerStartYaw );
+
+	m_wallBVH.Build( m_walls );
+
+	RegisterVisibilityCommands();
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void LineMap::Unload()
 {
+	g_eventSystem->DeRegisterObject( this );
 
+	m_wallBVH.Clear();
 }
 
 
@@ -163,11 +181,101 @@ void LineMap::DebugRender() const
 
 //-----------------------------------------------------------------------------------------------
 RaycastResult LineMap::Raycast( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const
+{
+	return RaycastAgainstWalls( startPos, forwardNormal, maxDist );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void LineMap::RaycastBatch( const std::vector<MapRay>& rays, std::vector<RaycastResult>& out_results ) const
+{
+	// Per call so batches can run from any number of threads at once
+	std::vector<OBB3Ray> bvhRays( rays.size() );
+	for ( int rayIdx = 0; rayIdx < (int)rays.size(); ++rayIdx )
+	{
+		bvhRays[rayIdx].startPos = rays[rayIdx].startPos;
+		bvhRays[rayIdx].forwardNormal = rays[rayIdx].forwardNormal;
+		bvhRays[rayIdx].maxDist = rays[rayIdx].maxDist;
+	}
+
+	std::vector<OBB3RaycastHit> hits;
+	m_wallBVH.RaycastBatch( bvhRays, hits );
+
+	out_results.resize( rays.size() );
+	for ( int rayIdx = 0; rayIdx < (int)rays.size(); ++rayIdx )
+	{
+		const MapRay& ray = rays[rayIdx];
+		const OBB3RaycastHit& hit = hits[rayIdx];
+
+		RaycastResult& result = out_results[rayIdx];
+		result = RaycastResult();
+		result.startPos = ray.startPos;
+		result.forwardNormal = ray.forwardNormal;
+		result.maxDist = ray.maxDist;
+
+		ApplyWallHitToRaycastResult( hit, result );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+RaycastResult LineMap::RaycastAgainstWalls( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const
 {
 	RaycastResult result;
 	result.startPos = startPos;
 	result.forwardNormal = forwardNormal;
 	result.maxDist = maxDist;
 
+	OBB3Ray ray;
+	ray.startPos = startPos;
+	ray.forwardNormal = forwardNormal;
+	ray.maxDist = maxDist;
+
+	ApplyWallHitToRaycastResult( m_wallBVH.Raycast( ray ), result );
 	return result;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+bool LineMap::HasLineOfSight( const Vec3& startPos, const Vec3& endPos ) const
+{
+	Vec3 displacement = endPos - startPos;
+	float distance = displacement.GetLength();
+	if ( distance <= 0.f )
+	{
+		return true;
+	}
+
+	OBB3Ray ray;
+	ray.startPos = startPos;
+	ray.forwardNormal = displacement / distance;
+	ray.maxDist = distance;
+
+	return !m_wallBVH.RaycastAny( ray );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void LineMap::CheckLinesOfSight( const std::vector<Vec3>& startPositions, const std::vector<Vec3>& endPositions, std::vector<byte>& out_hasLineOfSight ) const
+{
+	GUARANTEE_OR_DIE( startPositions.size() == endPositions.size(), "CheckLinesOfSight needs an end for every start" );
+
+	std::vector<OBB3Ray> bvhRays( startPositions.size() );
+	for ( int rayIdx = 0; rayIdx < (int)startPositions.size(); ++rayIdx )
+	{
+		Vec3 displacement = endPositions[rayIdx] - startPositions[rayIdx];
+		float distance = displacement.GetLength();
+
+		OBB3Ray& ray = bvhRays[rayIdx];
+		ray.startPos = startPositions[rayIdx];
+		ray.forwardNormal = distance > 0.f ? displacement / distance : Vec3( 1.f, 0.f, 0.f );
+		ray.maxDist = distance;
+	}
+
+	m_wallBVH.RaycastAnyBatch( bvhRays, out_hasLineOfSight );
+
+	for ( int rayIdx = 0; rayIdx < (int)out_hasLineOfSight.size(); ++rayIdx )
+	{
+		out_hasLineOfSight[rayIdx] = out_hasLineOfSight[rayIdx] != 0 ? 0 : 1;
+	}
+}
@@ -1,11 +1,11 @@
 #include "Game/Map.hpp"
+#include "Engine/Math/OBB3BVH.hpp"
 #include "Engine/Math/Transform.hpp"
 
 #include <vector>
 
 
 //-----------------------------------------------------------------------------------------------
-struct OBB3;
 struct Vertex_PCUTBN;
 class GameEntity;
 class MapRegionTypeDefinition;
@@ -26,6 +26,13 @@ public:
 	virtual void		Render() const override;
 	virtual void		DebugRender() const override;
 
+	virtual void		RaycastBatch( const std::vector<MapRay>& rays, std::vector<RaycastResult>& out_results ) const override;
+	RaycastResult		RaycastAgainstWalls( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const;
+	bool				HasLineOfSight( const Vec3& startPos, const Vec3& endPos ) const;
+	
+	// One entry per start/end pair, 1 where no wall is in the way. Rays are spread across the job system
+	void				CheckLinesOfSight( const std::vector<Vec3>& startPositions, const std::vector<Vec3>& endPositions, std::vector<byte>& out_hasLineOfSight ) const;
+
 protected:
 	virtual RaycastResult Raycast( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const override;
 
@@ -35,5 +42,6 @@ private:
 	bool									m_isMeshDirty = true;
 	std::vector<Vertex_PCUTBN>				m_mesh;
 	std::vector<OBB3>						m_walls;
+	OBB3BVH									m_wallBVH;				// Built on load, walls don't move
 	std::vector<MapRegionTypeDefinition*>	m_regionTypeDefs;	
 };
@@ -1,16 +1,23 @@
 #include "Game/Map.hpp"
+#include "Engine/Core/BufferWriter.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/ReplaySystem.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Framework/EntityComponent.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Transform.hpp"
 #include "Engine/Physics/PhysicsCommon.hpp"
 #include "Engine/Physics/PhysicsScene.hpp"
 #include "Engine/Physics/PhysicsSystem.hpp"
+#include "Engine/Physics/Rigidbody.hpp"
+#include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Renderer/MeshUtils.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrComponent.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrScene.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrSystem.hpp"
@@ -23,6 +30,11 @@
 #include "Game/World.hpp"
 
 
+//-----------------------------------------------------------------------------------------------
+static bool s_isFrustumCullingEnabled = true;
+static bool s_isOcclusionCullingEnabled = true;
+
+
 //-----------------------------------------------------------------------------------------------
 Map::Map( const MapData& mapData, World* world )
 	: m_name( mapData.mapName )
@@ -32,6 +44,7 @@ Map::Map( const MapData& mapData, World* world )
 {
 	m_physicsScene = new PhysicsScene();
 	m_zephyrScene = new ZephyrScene();
+	m_zephyrScene->isParallelUpdateEnabled = true;
 
 	LoadEntities( mapData.mapEntityDefs );
 }
@@ -49,6 +62,9 @@ Map::~Map()
 //-----------------------------------------------------------------------------------------------
 void Map::Update( float deltaSeconds )
 {
+	m_entityUpdateStage.Run( m_entities, (int)m_entities.size(), deltaSeconds );
+	ApplyEntityCommands();
+
 	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
 	{
 		GameEntity* const& entity = m_entities[entityIdx];
@@ -57,7 +73,7 @@ void Map::Update( float deltaSeconds )
 			continue;
 		}
 
-		entity->Update( deltaSeconds );
+		entity->SubmitLight();
 	}
 
 	ZephyrSystem::UpdateScene( *m_zephyrScene );
@@ -73,19 +89,148 @@ void Map::Update( float deltaSeconds )
 //-----------------------------------------------------------------------------------------------
 void Map::Render() const
 {
+	const Camera& worldCamera = *g_game->GetWorldCamera();
+	GatherVisibleEntities( worldCamera.GetWorldFrustum(), worldCamera.GetTransform().GetPosition(), m_visibleEntities );
+
+	SpriteBatch& spriteBatch = *g_game->GetSpriteBatch();
+	spriteBatch.Begin();
+
+	for ( int entityIdx = 0; entityIdx < (int)m_visibleEntities.size(); ++entityIdx )
+	{
+		m_visibleEntities[entityIdx]->AddToSpriteBatch( spriteBatch, worldCamera );
+	}
+
+	// Billboards without a material draw with the default shader
+	g_renderer->BindShader( nullptr );
+	spriteBatch.End();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Everything an entity carries from frame to frame, written field by field so struct padding never
+// reaches the hash
+//-----------------------------------------------------------------------------------------------
+void Map::AddToFrameChecksum()
+{
+	m_checksumBuffer.clear();
+	BufferWriter writer( m_checksumBuffer );
+
 	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
 	{
-		GameEntity* const& entity = m_entities[entityIdx];
+		const GameEntity* entity = m_entities[entityIdx];
+		if ( entity == nullptr )
+		{
+			continue;
+		}
+
+		writer.AppendInt32( entity->GetId() );
+		writer.AppendVec3( entity->m_transform.GetPosition() );
+		writer.AppendFloat( entity->m_transform.GetYawDegrees() );
+		writer.AppendFloat( entity->m_transform.GetPitchDegrees() );
+		writer.AppendFloat( entity->m_transform.GetRollDegrees() );
+		writer.AppendInt32( entity->m_curHealth );
+		writer.AppendBool( entity->m_isDead );
+
+		const Rigidbody* rigidbody = entity->m_rigidbody;
+		writer.AppendBool( rigidbody != nullptr );
+		if ( rigidbody != nullptr )
+		{
+			writer.AppendVec3( rigidbody->GetWorldPosition() );
+			writer.AppendVec3( rigidbody->GetVelocity() );
+			writer.AppendFloat( rigidbody->GetOrientationDegrees() );
+			writer.AppendFloat( rigidbody->GetAngularVelocity() );
+		}
+	}
+
+	g_replaySystem->AddToFrameChecksum( m_checksumBuffer.data(), m_checksumBuffer.size() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Bounds are loose enough to cover the billboard however it's anchored and turned to the camera
+//-----------------------------------------------------------------------------------------------
+void Map::GatherVisibleEntities( const Frustum& frustum, const Vec3& viewerPos, std::vector<const GameEntity*>& out_visibleEntities ) const
+{
+	out_visibleEntities.clear();
+	m_visibilityStats.numSubmittedEntities = 0;
+	m_visibilityStats.numFrustumCulledEntities = 0;
+	m_visibilityStats.numOccludedEntities = 0;
+
+	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	{
+		const GameEntity* entity = m_entities[entityIdx];
 		if ( entity == nullptr )
 		{
 			continue;
 		}
 
-		entity->Render();
+		float boundingRadius = Max( entity->m_entityDef.GetVisualSize().GetLength(), entity->GetHeight() ) + entity->GetPhysicsRadius();
+		if ( s_isFrustumCullingEnabled
+			 && !frustum.DoesSphereOverlap( entity->GetRenderPosition(), boundingRadius ) )
+		{
+			++m_visibilityStats.numFrustumCulledEntities;
+			continue;
+		}
+
+		if ( s_isOcclusionCullingEnabled
+			 && IsEntityOccluded( viewerPos, *entity ) )
+		{
+			++m_visibilityStats.numOccludedEntities;
+			continue;
+		}
+
+		out_visibleEntities.push_back( entity );
+		++m_visibilityStats.numSubmittedEntities;
 	}
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void Map::PrintVisibilityStats( EventArgs* args )
+{
+	UNUSED( args );
+
+	g_devConsole->PrintString( Stringf( "Map '%s' last frame:", m_name.c_str() ) );
+	g_devConsole->PrintString( Stringf( "Chunks: %i submitted, %i frustum culled", m_visibilityStats.numSubmittedChunks, m_visibilityStats.numFrustumCulledChunks ) );
+	g_devConsole->PrintString( Stringf( "Entities: %i submitted, %i frustum culled, %i occluded", 
+										m_visibilityStats.numSubmittedEntities, m_visibilityStats.numFrustumCulledEntities, m_visibilityStats.numOccludedEntities ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Map::RegisterVisibilityCommands()
+{
+	g_eventSystem->RegisterMethodEvent( "map_visibility_stats", "Print how many map chunks and entities were drawn and culled last frame", eUsageLocation::DEV_CONSOLE, this, &Map::PrintVisibilityStats );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool Map::SetVisibilityCulling( EventArgs* args )
+{
+	s_isFrustumCullingEnabled = args->GetValue( "frustum", s_isFrustumCullingEnabled );
+	s_isOcclusionCullingEnabled = args->GetValue( "occlusion", s_isOcclusionCullingEnabled );
+
+	g_devConsole->PrintString( Stringf( "Frustum culling %s, occlusion culling %s", 
+										s_isFrustumCullingEnabled ? "enabled" : "disabled",
+										s_isOcclusionCullingEnabled ? "enabled" : "disabled" ) );
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool Map::IsFrustumCullingEnabled()
+{
+	return s_isFrustumCullingEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool Map::IsOcclusionCullingEnabled()
+{
+	return s_isOcclusionCullingEnabled;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Map::DebugRender() const
 {
@@ -278,6 +423,18 @@ GameEntity* Map::GetClosestEntityInSector( const Vec3& observerPos, float forwar
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void Map::RaycastBatch( const std::vector<MapRay>& rays, std::vector<RaycastResult>& out_results ) const
+{
+	out_results.resize( rays.size() );
+	for ( int rayIdx = 0; rayIdx < (int)rays.size(); ++rayIdx )
+	{
+		const MapRay& ray = rays[rayIdx];
+		out_results[rayIdx] = Raycast( ray.startPos, ray.forwardNormal, ray.maxDist );
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 GameEntity* Map::GetEntityFromRaycast( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const
 {
@@ -346,6 +503,7 @@ void Map::LoadEntities( const std::vector<MapEntityDefinition>& mapEntityDefs )
 			newEntity->SetRigidbody( rigidbody );
 			rigidbody->SetPosition( mapEntityDef.position );
 			rigidbody->SetMass( mapEntityDef.entityDef->GetMass() );
+			rigidbody->SetContinuousCollisionEnabled( mapEntityDef.entityDef->IsContinuousCollisionEnabled() );
 			newEntity->m_rigidbody->SetSimulationMode( SIMULATION_MODE_DYNAMIC );
 
 			for ( const ColliderData& colData : newEntity->GetColliderDataVec() )
@@ -371,6 +529,87 @@ void Map::LoadEntities( const std::vector<MapEntityDefinition>& mapEntityDefs )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Sync point for the parallel entity update. Buffers are in entity order, so commands land in the
+// same order a serial update would have made the changes
+//-----------------------------------------------------------------------------------------------
+void Map::ApplyEntityCommands()
+{
+	for ( int bufferIdx = 0; bufferIdx < m_entityUpdateStage.GetNumCommandBuffers(); ++bufferIdx )
+	{
+		const std::vector<EntityCommand>& commands = m_entityUpdateStage.GetCommandBuffer( bufferIdx ).GetCommands();
+		for ( int commandIdx = 0; commandIdx < (int)commands.size(); ++commandIdx )
+		{
+			const EntityCommand& command = commands[commandIdx];
+			switch ( command.type )
+			{
+				case eEntityCommandType::SPAWN:
+				{
+					GameEntity* newEntity = SpawnNewEntityOfType( command.name );
+					if ( newEntity != nullptr )
+					{
+						newEntity->SetPosition( command.position );
+						newEntity->SetOrientationDegrees( command.value );
+					}
+				}
+				break;
+
+				case eEntityCommandType::DIE:
+				{
+					GameEntity* entity = (GameEntity*)g_game->GetEntityById( command.entityId );
+					if ( entity != nullptr )
+					{
+						entity->Die();
+					}
+				}
+				break;
+
+				case eEntityCommandType::WARP:
+				{
+					GameEntity* entity = (GameEntity*)g_game->GetEntityById( command.entityId );
+					if ( entity != nullptr )
+					{
+						g_game->WarpEntityToMap( entity, command.name, command.position, command.value );
+					}
+				}
+				break;
+
+				case eEntityCommandType::DAMAGE:
+				{
+					GameEntity* entity = (GameEntity*)g_game->GetEntityById( command.entityId );
+					if ( entity != nullptr )
+					{
+						entity->TakeDamage( (int)command.value );
+					}
+				}
+				break;
+
+				case eEntityCommandType::FIRE_EVENT:
+				{
+					if ( command.entityId == INVALID_ENTITY_ID )
+					{
+						g_eventSystem->FireEvent( command.name, command.eventArgs );
+					}
+					else
+					{
+						ZephyrSystem::FireScriptEvent( command.entityId, command.name, command.eventArgs );
+					}
+				}
+				break;
+
+				case eEntityCommandType::MOVE_TO_INVENTORY:
+				{
+					g_devConsole->PrintWarning( "Doomenstein entities don't have inventories" );
+				}
+				break;
+			}
+		}
+	}
+
+	m_entityUpdateStage.ClearCommands();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Map::UpdateRigidbodyTransformsFromEntities()
 {
@@ -390,9 +629,11 @@ void Map::UpdateRigidbodyTransformsFromEntities()
 //-----------------------------------------------------------------------------------------------
 void Map::UpdateEntityTransformsFromRigidbodies()
 {
-	for ( int rigidbodyIdx = 0; rigidbodyIdx < (int)m_physicsScene->rigidbodies.size(); ++rigidbodyIdx )
+	const RigidbodyStore& rigidbodyStore = m_physicsScene->rigidbodyStore;
+	float interpolationFraction = g_game->GetCurrentPhysicsSystem()->GetInterpolationFraction();
+	for ( int bodyIdx = 0; bodyIdx < rigidbodyStore.GetNumBodies(); ++bodyIdx )
 	{
-		Rigidbody*& rigidbody = m_physicsScene->rigidbodies[rigidbodyIdx];
+		Rigidbody* rigidbody = rigidbodyStore.GetOwner( bodyIdx );
 		if ( rigidbody == nullptr 
 			 || rigidbody->GetParentEntityId() == INVALID_ENTITY_ID )
 		{
@@ -406,8 +647,12 @@ void Map::UpdateEntityTransformsFromRigidbodies()
 			continue;
 		}
 
-		entity->SetPosition( rigidbody->GetWorldPosition() );
-		entity->SetOrientationDegrees( rigidbody->GetOrientationDegrees() );
+		entity->SetPosition( rigidbodyStore.GetPosition( bodyIdx ) );
+		entity->SetOrientationDegrees( ConvertRadiansToDegrees( rigidbodyStore.GetOrientationRadians( bodyIdx ) ) );
+
+		// Gameplay keeps the latest simulated transform, rendering blends between the last two steps
+		entity->SetRenderTransform( rigidbodyStore.GetInterpolatedPosition( bodyIdx, interpolationFraction ),
+									ConvertRadiansToDegrees( rigidbodyStore.GetInterpolatedOrientationRadians( bodyIdx, interpolationFraction ) ) );
 	}
 }
 
@@ -1,4 +1,6 @@
 #pragma once
+#include "Engine/Framework/EntityUpdateStage.hpp"
+
 #include "Game/Tile.hpp"
 #include "Game/GameEntity.hpp"
 
@@ -7,6 +9,7 @@
 
 
 //-----------------------------------------------------------------------------------------------
+struct Frustum;
 struct MapData;
 struct MapEntityDefinition;
 struct PhysicsScene;
@@ -30,6 +33,29 @@ struct RaycastResult
 };
 
 
+//-----------------------------------------------------------------------------------------------
+struct MapRay
+{
+	Vec3 startPos;
+	Vec3 forwardNormal;
+	float maxDist = 0.f;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Filled in while gathering what to draw, so it's available without a renderer
+//-----------------------------------------------------------------------------------------------
+struct MapVisibilityStats
+{
+public:
+	int numSubmittedChunks = 0;
+	int numFrustumCulledChunks = 0;
+	int numSubmittedEntities = 0;
+	int numFrustumCulledEntities = 0;
+	int numOccludedEntities = 0;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class Map
 {
@@ -65,15 +91,35 @@ public:
 	GameEntity*				GetClosestEntityInSector( const Vec3& observerPos, float forwardDegrees, float apertureDegrees, float maxDist );
 	GameEntity*				GetEntityFromRaycast( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const;
 
+	// Same results as one Raycast per ray, maps override it to share setup across the whole batch
+	virtual void			RaycastBatch( const std::vector<MapRay>& rays, std::vector<RaycastResult>& out_results ) const;
+
 	EntityComponent*		GetZephyrComponentFromEntityId( const EntityId& id );
 
+	// Visibility
+	void					GatherVisibleEntities( const Frustum& frustum, const Vec3& viewerPos, std::vector<const GameEntity*>& out_visibleEntities ) const;
+	const MapVisibilityStats& GetLastVisibilityStats() const						{ return m_visibilityStats; }
+	void					PrintVisibilityStats( EventArgs* args );
+
+	static bool				SetVisibilityCulling( EventArgs* args );
+
+	// Replays
+	void					AddToFrameChecksum();
+
 protected:
 	void LoadEntities( const std::vector<MapEntityDefinition>& mapEntityDefs );
 
+	void ApplyEntityCommands();
 	void UpdateRigidbodyTransformsFromEntities();
 	void UpdateEntityTransformsFromRigidbodies();
 
 	virtual RaycastResult Raycast( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const = 0;
+	virtual bool IsEntityOccluded( const Vec3& viewerPos, const GameEntity& entity ) const		{ UNUSED( viewerPos ); UNUSED( entity ); return false; }
+
+	void RegisterVisibilityCommands();		// Deregistered with the rest of the map's commands in Unload
+
+	static bool IsFrustumCullingEnabled();
+	static bool IsOcclusionCullingEnabled();
 
 protected:
 	std::string				m_name;
@@ -88,5 +134,10 @@ protected:
 	float					m_playerStartYaw = 0.f;
 
 	std::vector<GameEntity*>			m_entities;
+	EntityUpdateStage					m_entityUpdateStage;
+
+	mutable MapVisibilityStats m_visibilityStats;		// Render const, counted while gathering
+	mutable std::vector<const GameEntity*> m_visibleEntities;	// Render scratch, kept to reuse its memory
+	std::vector<byte>		m_checksumBuffer;							// Kept to reuse its memory
 	// TODO: Change to actual object once my memory manager is in
 };
@@ -23,6 +23,20 @@
 										g_eventSystem->RegisterMethodEvent( #eventName, "", EVERYWHERE, this, &ZephyrGameEvents::eventName );\
 									}
 
+#define REGISTER_EVENT_WITH_OUT_PARAMS( eventName, ... ) {\
+															REGISTER_EVENT( eventName );\
+															RegisterMethodOutParams( #eventName, { __VA_ARGS__ } );\
+														}
+
+#define REGISTER_NATIVE_FUNCTION( functionName, ... ) RegisterNativeFunction( #functionName, { __VA_ARGS__ }, &ZephyrGameEvents::functionName );
+
+// Every native entity function takes the target params first, their own params start after
+#define TARGET_ENTITY_PARAMS ZephyrNativeParam( TARGET_ENTITY_STR, ZephyrValue( (EntityId)INVALID_ENTITY_ID ) ), ZephyrNativeParam( TARGET_ENTITY_NAME_STR, ZephyrValue( std::string( "" ) ) )
+constexpr int TARGET_ENTITY_PARAM_IDX = 0;
+constexpr int TARGET_ENTITY_NAME_PARAM_IDX = 1;
+constexpr int FIRST_ENTITY_FUNCTION_PARAM_IDX = 2;
+
+
 //-----------------------------------------------------------------------------------------------
 ZephyrGameEvents::ZephyrGameEvents()
 {
@@ -34,11 +48,7 @@ ZephyrGameEvents::ZephyrGameEvents()
 	REGISTER_EVENT( DestroySelf );
 	REGISTER_EVENT( Die );
 	REGISTER_EVENT( WarpToMap );
-	REGISTER_EVENT( RotateEntity );
 	REGISTER_EVENT( MoveInCircle );
-	REGISTER_EVENT( MoveInDirection );
-	REGISTER_EVENT( MoveInRelativeDirection );
-	REGISTER_EVENT( AddImpulse );
 
 	REGISTER_EVENT( StartNewTimer );
 	REGISTER_EVENT( WinGame );
@@ -56,11 +66,24 @@ ZephyrGameEvents::ZephyrGameEvents()
 	REGISTER_EVENT( ChangeMusic );
 	REGISTER_EVENT( AddScreenShake );
 	REGISTER_EVENT( ChangeLight );
-	REGISTER_EVENT( GetEntityFromRaytrace );
-	REGISTER_EVENT( GetEntityFromCameraRaytrace );
+	REGISTER_EVENT_WITH_OUT_PARAMS( GetEntityFromRaytrace, "foundEntity" );
+	REGISTER_EVENT_WITH_OUT_PARAMS( GetEntityFromCameraRaytrace, "foundEntity" );
 
 	REGISTER_EVENT( PushCamera );
 	REGISTER_EVENT( PopCamera );
+
+	REGISTER_NATIVE_FUNCTION( RotateEntity, TARGET_ENTITY_PARAMS,
+							  ZephyrNativeParam( "pitchDegrees", ZephyrValue( 0.f ) ),
+							  ZephyrNativeParam( "yawDegrees", ZephyrValue( 0.f ) ),
+							  ZephyrNativeParam( "rollDegrees", ZephyrValue( 0.f ) ) );
+	REGISTER_NATIVE_FUNCTION( MoveInDirection, TARGET_ENTITY_PARAMS,
+							  ZephyrNativeParam( "speed", ZephyrValue( 1.f ) ),
+							  ZephyrNativeParam( "direction", ZephyrValue( Vec3::ZERO ) ) );
+	REGISTER_NATIVE_FUNCTION( MoveInRelativeDirection, TARGET_ENTITY_PARAMS,
+							  ZephyrNativeParam( "speed", ZephyrValue( 1.f ) ),
+							  ZephyrNativeParam( "direction", ZephyrValue( Vec3::ZERO ) ) );
+	REGISTER_NATIVE_FUNCTION( AddImpulse, TARGET_ENTITY_PARAMS,
+							  ZephyrNativeParam( "impulse", ZephyrValue( Vec3::ZERO ) ) );
 }
 
 
@@ -143,67 +166,64 @@ void ZephyrGameEvents::WarpToMap( EventArgs* args )
 
 
 //-----------------------------------------------------------------------------------------------
-void ZephyrGameEvents::RotateEntity( EventArgs* args )
+void ZephyrGameEvents::RotateEntity( ZephyrNativeCallArgs& args )
 {
-	GameEntity* targetEntity = GetTargetEntityFromArgs( args );
+	GameEntity* targetEntity = GetTargetEntityFromNativeArgs( args );
 	if ( targetEntity == nullptr )
 	{
 		return;
 	}
 
-	float pitchDegrees = args->GetValue( "pitchDegrees", 0.f );
-	float yawDegrees = args->GetValue( "yawDegrees", 0.f );
-	float rollDegrees = args->GetValue( "rollDegrees", 0.f );
+	float pitchDegrees = args.GetNumber( FIRST_ENTITY_FUNCTION_PARAM_IDX );
+	float yawDegrees = args.GetNumber( FIRST_ENTITY_FUNCTION_PARAM_IDX + 1 );
+	float rollDegrees = args.GetNumber( FIRST_ENTITY_FUNCTION_PARAM_IDX + 2 );
 	
-	if ( targetEntity != nullptr )
-	{
-		targetEntity->RotateDegrees( pitchDegrees, yawDegrees, rollDegrees );
-	}
+	targetEntity->RotateDegrees( pitchDegrees, yawDegrees, rollDegrees );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void ZephyrGameEvents::MoveInDirection( EventArgs* args )
+void ZephyrGameEvents::MoveInDirection( ZephyrNativeCallArgs& args )
 {
-	GameEntity* targetEntity = GetTargetEntityFromArgs( args );
+	GameEntity* targetEntity = GetTargetEntityFromNativeArgs( args );
 	if ( targetEntity == nullptr )
 	{
 		return;
 	}
 
-	float speed = args->GetValue( "speed", 1.f );
-	Vec3 direction = args->GetValue( "direction", Vec3::ZERO );
+	float speed = args.GetNumber( FIRST_ENTITY_FUNCTION_PARAM_IDX );
+	Vec3 direction = args.GetVec3( FIRST_ENTITY_FUNCTION_PARAM_IDX + 1 );
 
 	targetEntity->MoveInDirection( speed, direction );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void ZephyrGameEvents::MoveInRelativeDirection( EventArgs* args )
+void ZephyrGameEvents::MoveInRelativeDirection( ZephyrNativeCallArgs& args )
 {
-	GameEntity* targetEntity = GetTargetEntityFromArgs( args );
+	GameEntity* targetEntity = GetTargetEntityFromNativeArgs( args );
 	if ( targetEntity == nullptr )
 	{
 		return;
 	}
 	
-	float speed = args->GetValue( "speed", 1.f );
-	Vec3 direction = args->GetValue( "direction", Vec3::ZERO );
+	float speed = args.GetNumber( FIRST_ENTITY_FUNCTION_PARAM_IDX );
+	Vec3 direction = args.GetVec3( FIRST_ENTITY_FUNCTION_PARAM_IDX + 1 );
 
 	targetEntity->MoveInRelativeDirection( speed, direction );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void ZephyrGameEvents::AddImpulse( EventArgs* args )
+void ZephyrGameEvents::AddImpulse( ZephyrNativeCallArgs& args )
 {
-	GameEntity* targetEntity = GetTargetEntityFromArgs( args );
+	GameEntity* targetEntity = GetTargetEntityFromNativeArgs( args );
 	if ( targetEntity == nullptr )
 	{
 		return;
 	}
 
-	Vec3 impulse = args->GetValue( "impulse", Vec3::ZERO );
+	Vec3 impulse = args.GetVec3( FIRST_ENTITY_FUNCTION_PARAM_IDX );
 
 	targetEntity->AddImpulse( impulse );
 }
@@ -720,3 +740,40 @@ GameEntity* ZephyrGameEvents::GetTargetEntityFromArgs( EventArgs* args )
 	return entity;
 }
 
+
+//-----------------------------------------------------------------------------------------------
+GameEntity* ZephyrGameEvents::GetTargetEntityFromNativeArgs( const ZephyrNativeCallArgs& args )
+{
+	EntityId targetId = args.GetEntity( TARGET_ENTITY_PARAM_IDX );
+	std::string targetName = args.GetString( TARGET_ENTITY_NAME_PARAM_IDX );
+
+	GameEntity* entity = (GameEntity*)g_game->GetEntityById( args.GetCallerId() );
+	if ( entity == nullptr )
+	{
+		return nullptr;
+	}
+
+	// Named entities are returned first
+	if ( !targetName.empty() )
+	{
+		entity = (GameEntity*)g_game->GetEntityByName( targetName );
+		if ( entity == nullptr )
+		{
+			g_devConsole->PrintError( Stringf( "Failed to find an entity with name '%s'", targetName.c_str() ) );
+			return nullptr;
+		}
+	}
+	// Id entities are tried next
+	else if ( targetId != INVALID_ENTITY_ID )
+	{
+		entity = (GameEntity*)g_game->GetEntityById( targetId );
+		if ( entity == nullptr )
+		{
+			g_devConsole->PrintWarning( Stringf( "Failed to find an entity with id '%i'", targetId ) );
+			return nullptr;
+		}
+	}
+
+	// If no name or id defined, send back the entity who called the function
+	return entity;
+}
@@ -45,14 +45,16 @@ private:
 	void Die( EventArgs* args );
 	//void DamageEntity( EventArgs* args );
 	void WarpToMap( EventArgs* args );
-	void RotateEntity( EventArgs* args );
 	void MoveInCircle( EventArgs* args );
-	void MoveInDirection( EventArgs* args );
-	void MoveInRelativeDirection( EventArgs* args );
-	void AddImpulse( EventArgs* args );
 	void GetEntityFromCameraRaytrace( EventArgs* args );
 	void GetEntityFromRaytrace( EventArgs* args );
 
+	// Native Entity Functions, scripts call these every frame so they skip the EventArgs map
+	static void RotateEntity( ZephyrNativeCallArgs& args );
+	static void MoveInDirection( ZephyrNativeCallArgs& args );
+	static void MoveInRelativeDirection( ZephyrNativeCallArgs& args );
+	static void AddImpulse( ZephyrNativeCallArgs& args );
+
 	// Input
 	void RegisterKeyEvent( EventArgs* args );
 	void UnRegisterKeyEvent( EventArgs* args );
@@ -72,4 +74,5 @@ private:
 
 private:
 	GameEntity* GetTargetEntityFromArgs( EventArgs* args );
+	static GameEntity* GetTargetEntityFromNativeArgs( const ZephyrNativeCallArgs& args );
 };
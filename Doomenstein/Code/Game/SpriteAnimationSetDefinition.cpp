@@ -1,7 +1,7 @@
 #include "Game/SpriteAnimationSetDefinition.hpp"
 #include "Engine/Core/DevConsole.hpp"
-#include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Framework/EntityCommandBuffer.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
@@ -72,7 +72,9 @@ void SpriteAnimationSetDefinition::AddFrameEvent( int frameNum, const std::strin
 
 
 //-----------------------------------------------------------------------------------------------
-void SpriteAnimationSetDefinition::FireFrameEvent( int frameNum, GameEntity* parent )
+// A null parent fires a global event
+//-----------------------------------------------------------------------------------------------
+void SpriteAnimationSetDefinition::QueueFrameEvent( int frameNum, const GameEntity* parent, EntityCommandBuffer& commands ) const
 {
 	auto iter = m_frameToEventNames.find( frameNum );
 	if ( iter == m_frameToEventNames.end() )
@@ -80,14 +82,7 @@ void SpriteAnimationSetDefinition::FireFrameEvent( int frameNum, GameEntity* par
 		return;
 	}
 
-	if ( parent == nullptr )
-	{
-		g_eventSystem->FireEvent( iter->second );
-	}
-	else
-	{
-		parent->FireScriptEvent( iter->second );
-	}
+	commands.FireEvent( parent != nullptr ? parent->GetId() : INVALID_ENTITY_ID, iter->second );
 }
 
 
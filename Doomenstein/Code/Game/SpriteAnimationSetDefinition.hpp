@@ -31,6 +31,10 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------------------------
+class EntityCommandBuffer;
+
+
 //-----------------------------------------------------------------------------------------------
 class SpriteAnimationSetDefinition
 {
@@ -41,7 +45,7 @@ public:
 	SpriteAnimDefinition*	GetSpriteAnimationDefForDirection( const Vec2& entityPos, float entityOrientationDegrees, const Camera& camera );
 
 	void					AddFrameEvent( int frameNum, const std::string& eventName );
-	void					FireFrameEvent( int frameNum, GameEntity* parent );
+	void					QueueFrameEvent( int frameNum, const GameEntity* parent, EntityCommandBuffer& commands ) const;
 
 	void					AdjustAnimationSpeed( float deltaSpeedModifier );
 
@@ -1,6 +1,13 @@
 #include "Game/TileMap.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Physics/PhysicsCommon.hpp"
@@ -12,6 +19,7 @@
 #include "Engine/Renderer/MeshUtils.hpp"
 #include "Engine/Renderer/GPUMesh.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
+#include "Engine/Time/Time.hpp"
 
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
@@ -19,6 +27,27 @@
 #include "Game/MapRegionTypeDefinition.hpp"
 #include "Game/MapMaterialTypeDefinition.hpp"
 
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#define TILE_MAP_RAYCAST_SIMD
+#include <emmintrin.h>
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+static const int CHUNK_SIZE_IN_TILES = 16;
+static const int MIN_RAYS_PER_RAYCAST_JOB = 256;
+
+
+//-----------------------------------------------------------------------------------------------
+static void KeepCloserImpact( RaycastResult& closestImpact, const RaycastResult& candidateImpact )
+{
+	if ( candidateImpact.didImpact
+		 && candidateImpact.impactDist < closestImpact.impactDist )
+	{
+		closestImpact = candidateImpact;
+	}
+}
+
 
 //-----------------------------------------------------------------------------------------------
 TileMap::TileMap( const MapData& mapData, World* world )
@@ -28,12 +57,18 @@ TileMap::TileMap( const MapData& mapData, World* world )
 
 	BuildCardinalDirectionsArray();
 	PopulateTiles( mapData.regionTypeDefs );
+	CreateChunks();
 }
 
 
 //-----------------------------------------------------------------------------------------------
 TileMap::~TileMap()
 {
+	for ( int chunkIdx = 0; chunkIdx < (int)m_chunks.size(); ++chunkIdx )
+	{
+		PTR_SAFE_DELETE( m_chunks[chunkIdx].gpuMesh );
+	}
+
 	PTR_SAFE_DELETE( m_cubeMesh );
 	PTR_SAFE_DELETE( m_testMaterial );
 }
@@ -43,13 +78,17 @@ TileMap::~TileMap()
 void TileMap::Load()
 {
 	g_game->SetCameraPositionAndYaw( m_playerStartPos, m_playerStartYaw );
+
+	RegisterVisibilityCommands();
+	g_eventSystem->RegisterMethodEvent( "tilemap_mesh_stats", "Usage: tilemap_mesh_stats rebuild=false. Print chunks and vertices remeshed last frame, rebuild=true remeshes every chunk next frame.", eUsageLocation::DEV_CONSOLE, this, &TileMap::PrintMeshStats );
+	g_eventSystem->RegisterMethodEvent( "benchmark_tilemap_raycasts", "Usage: benchmark_tilemap_raycasts rays=100000 maxDist=20. Compare batched raycasts with one Raycast per ray on this map.", eUsageLocation::DEV_CONSOLE, this, &TileMap::BenchmarkRaycasts );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void TileMap::Unload()
 {
-
+	g_eventSystem->DeRegisterObject( this );
 }
 
 
@@ -65,98 +104,182 @@ void TileMap::Update( float deltaSeconds )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Dirty chunks are meshed across the job system, this thread takes the first range and waits for
+// the rest since the gpu upload has to happen here
 //-----------------------------------------------------------------------------------------------
 void TileMap::UpdateMeshes()
 {
-	m_mesh.clear();
+	m_meshStats.numChunks = (int)m_chunks.size();
+	m_meshStats.numRebuiltChunks = 0;
+	m_meshStats.numGeneratedVertices = 0;
 
-	for ( int tileIdx = 0; tileIdx < (int)m_tiles.size(); ++tileIdx )
+	if ( m_dirtyChunkIndexes.empty() )
 	{
-		Tile& tile = m_tiles[tileIdx];
+		return;
+	}
 
-		if ( tile.m_regionTypeDef == nullptr )
+	int numDirtyChunks = (int)m_dirtyChunkIndexes.size();
+	if ( g_jobSystem != nullptr )
+	{
+		g_jobSystem->ParallelFor( numDirtyChunks, g_jobSystem->GetNumParallelForRanges( numDirtyChunks, 1 ), [this]( int rangeIdx, int firstDirtyIdx, int endDirtyIdx )
 		{
-			continue;
+			UNUSED( rangeIdx );
+			for ( int dirtyIdx = firstDirtyIdx; dirtyIdx < endDirtyIdx; ++dirtyIdx )
+			{
+				BuildChunkVertices( m_chunks[m_dirtyChunkIndexes[dirtyIdx]] );
+			}
+		} );
+	}
+	else
+	{
+		for ( int dirtyIdx = 0; dirtyIdx < numDirtyChunks; ++dirtyIdx )
+		{
+			BuildChunkVertices( m_chunks[m_dirtyChunkIndexes[dirtyIdx]] );
 		}
+	}
 
-		Vec2 mins( (float)tile.m_tileCoords.x, (float)tile.m_tileCoords.y );
-		Vec2 maxs( mins + Vec2( TILE_SIZE, TILE_SIZE ) );
+	for ( int dirtyIdx = 0; dirtyIdx < (int)m_dirtyChunkIndexes.size(); ++dirtyIdx )
+	{
+		TileMapChunk& chunk = m_chunks[m_dirtyChunkIndexes[dirtyIdx]];
+		UploadChunkMesh( chunk );
 
-		Vec3 vert0( mins, 0.f );
-		Vec3 vert1( maxs.x, mins.y, 0.f );
-		Vec3 vert2( mins.x, maxs.y, 0.f );
-		Vec3 vert3( maxs, 0.f );
+		++m_meshStats.numRebuiltChunks;
+		m_meshStats.numGeneratedVertices += (int)chunk.vertices.size();
+	}
 
-		Vec3 vert4( mins, TILE_SIZE );
-		Vec3 vert5( maxs.x, mins.y, TILE_SIZE );
-		Vec3 vert6( mins.x, maxs.y, TILE_SIZE );
-		Vec3 vert7( maxs, TILE_SIZE );
+	m_dirtyChunkIndexes.clear();
+}
 
-		if ( !tile.IsSolid() )
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::CreateChunks()
+{
+	m_chunkDimensions = IntVec2( ( m_dimensions.x + CHUNK_SIZE_IN_TILES - 1 ) / CHUNK_SIZE_IN_TILES,
+								 ( m_dimensions.y + CHUNK_SIZE_IN_TILES - 1 ) / CHUNK_SIZE_IN_TILES );
+
+	m_chunks.resize( m_chunkDimensions.x * m_chunkDimensions.y );
+	m_dirtyChunkIndexes.clear();
+
+	for ( int chunkY = 0; chunkY < m_chunkDimensions.y; ++chunkY )
+	{
+		for ( int chunkX = 0; chunkX < m_chunkDimensions.x; ++chunkX )
 		{
-			// Bottom face
-			Vec2 uvsAtMins, uvsAtMaxs;
-			MapMaterialTypeDefinition* materialTypeDef = tile.m_regionTypeDef->GetFloorMaterial();
-			materialTypeDef->GetSpriteSheet()->GetSpriteUVs( uvsAtMins, uvsAtMaxs, materialTypeDef->GetSpriteCoords() );
-			if ( materialTypeDef == nullptr )
-			{
-				return;
-			}
+			int chunkIdx = chunkX + chunkY * m_chunkDimensions.x;
 
-			AddTileFace( vert0, vert1, vert2, vert3, uvsAtMins, uvsAtMaxs );
+			TileMapChunk& chunk = m_chunks[chunkIdx];
+			chunk.mins = IntVec2( chunkX * CHUNK_SIZE_IN_TILES, chunkY * CHUNK_SIZE_IN_TILES );
+			chunk.maxs = IntVec2( Min( chunk.mins.x + CHUNK_SIZE_IN_TILES, m_dimensions.x ),
+								  Min( chunk.mins.y + CHUNK_SIZE_IN_TILES, m_dimensions.y ) );
+			chunk.isDirty = true;
 
-			// Top face
-			materialTypeDef = tile.m_regionTypeDef->GetCeilingMaterial();
-			materialTypeDef->GetSpriteSheet()->GetSpriteUVs( uvsAtMins, uvsAtMaxs, materialTypeDef->GetSpriteCoords() );
-			
-			if ( materialTypeDef == nullptr )
-			{
-				return;
-			}
+			m_dirtyChunkIndexes.push_back( chunkIdx );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Only reads tiles so chunks can be built on worker threads at the same time
+//-----------------------------------------------------------------------------------------------
+void TileMap::BuildChunkVertices( TileMapChunk& chunk ) const
+{
+	chunk.vertices.clear();
 
-			AddTileFace( vert5, vert4, vert7, vert6, uvsAtMins, uvsAtMaxs );
+	for ( int y = chunk.mins.y; y < chunk.maxs.y; ++y )
+	{
+		for ( int x = chunk.mins.x; x < chunk.maxs.x; ++x )
+		{
+			AddTileVertices( chunk.vertices, m_tiles[GetTileIndexFromTileCoords( x, y )] );
 		}
-		else
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::AddTileVertices( std::vector<Vertex_PCUTBN>& vertices, const Tile& tile ) const
+{
+	if ( tile.m_regionTypeDef == nullptr )
+	{
+		return;
+	}
+
+	Vec2 mins( (float)tile.m_tileCoords.x, (float)tile.m_tileCoords.y );
+	Vec2 maxs( mins + Vec2( TILE_SIZE, TILE_SIZE ) );
+
+	Vec3 vert0( mins, 0.f );
+	Vec3 vert1( maxs.x, mins.y, 0.f );
+	Vec3 vert2( mins.x, maxs.y, 0.f );
+	Vec3 vert3( maxs, 0.f );
+
+	Vec3 vert4( mins, TILE_SIZE );
+	Vec3 vert5( maxs.x, mins.y, TILE_SIZE );
+	Vec3 vert6( mins.x, maxs.y, TILE_SIZE );
+	Vec3 vert7( maxs, TILE_SIZE );
+
+	if ( !tile.IsSolid() )
+	{
+		// Bottom face
+		Vec2 uvsAtMins, uvsAtMaxs;
+		MapMaterialTypeDefinition* materialTypeDef = tile.m_regionTypeDef->GetFloorMaterial();
+		if ( materialTypeDef == nullptr )
 		{
-			Vec2 uvsAtMins, uvsAtMaxs;
-			MapMaterialTypeDefinition* materialTypeDef = tile.m_regionTypeDef->GetSideMaterial();
-			if ( materialTypeDef == nullptr )
-			{
-				return;
-			}
+			return;
+		}
 
-			materialTypeDef->GetSpriteSheet()->GetSpriteUVs( uvsAtMins, uvsAtMaxs, materialTypeDef->GetSpriteCoords() );
+		materialTypeDef->GetSpriteSheet()->GetSpriteUVs( uvsAtMins, uvsAtMaxs, materialTypeDef->GetSpriteCoords() );
+		AddTileFace( vertices, vert0, vert1, vert2, vert3, uvsAtMins, uvsAtMaxs );
 
-			// South face
-			if ( !IsAdjacentTileSolid( tile, eCardinalDirection::SOUTH ) )
-			{
-				AddTileFace( vert0, vert1, vert4, vert5, uvsAtMins, uvsAtMaxs );
-			}
+		// Top face
+		materialTypeDef = tile.m_regionTypeDef->GetCeilingMaterial();
+		if ( materialTypeDef == nullptr )
+		{
+			return;
+		}
 
-			// East face
-			if ( !IsAdjacentTileSolid( tile, eCardinalDirection::EAST ) )
-			{
-				AddTileFace( vert1, vert3, vert5, vert7, uvsAtMins, uvsAtMaxs );
-			}
+		materialTypeDef->GetSpriteSheet()->GetSpriteUVs( uvsAtMins, uvsAtMaxs, materialTypeDef->GetSpriteCoords() );
+		AddTileFace( vertices, vert5, vert4, vert7, vert6, uvsAtMins, uvsAtMaxs );
+	}
+	else
+	{
+		Vec2 uvsAtMins, uvsAtMaxs;
+		MapMaterialTypeDefinition* materialTypeDef = tile.m_regionTypeDef->GetSideMaterial();
+		if ( materialTypeDef == nullptr )
+		{
+			return;
+		}
 
-			// North face
-			if ( !IsAdjacentTileSolid( tile, eCardinalDirection::NORTH ) )
-			{
-				AddTileFace( vert3, vert2, vert7, vert6, uvsAtMins, uvsAtMaxs );
-			}
+		materialTypeDef->GetSpriteSheet()->GetSpriteUVs( uvsAtMins, uvsAtMaxs, materialTypeDef->GetSpriteCoords() );
 
-			// West face
-			if ( !IsAdjacentTileSolid( tile, eCardinalDirection::WEST ) )
-			{
-				AddTileFace( vert2, vert0, vert6, vert4, uvsAtMins, uvsAtMaxs );
-			}
+		// South face
+		if ( !IsAdjacentTileSolid( tile, eCardinalDirection::SOUTH ) )
+		{
+			AddTileFace( vertices, vert0, vert1, vert4, vert5, uvsAtMins, uvsAtMaxs );
+		}
+
+		// East face
+		if ( !IsAdjacentTileSolid( tile, eCardinalDirection::EAST ) )
+		{
+			AddTileFace( vertices, vert1, vert3, vert5, vert7, uvsAtMins, uvsAtMaxs );
+		}
+
+		// North face
+		if ( !IsAdjacentTileSolid( tile, eCardinalDirection::NORTH ) )
+		{
+			AddTileFace( vertices, vert3, vert2, vert7, vert6, uvsAtMins, uvsAtMaxs );
+		}
+
+		// West face
+		if ( !IsAdjacentTileSolid( tile, eCardinalDirection::WEST ) )
+		{
+			AddTileFace( vertices, vert2, vert0, vert6, vert4, uvsAtMins, uvsAtMaxs );
 		}
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void TileMap::AddTileFace( const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topLeft, const Vec3& topRight, const Vec2& uvMins, const Vec2& uvMaxs )
+void TileMap::AddTileFace( std::vector<Vertex_PCUTBN>& vertices, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topLeft, const Vec3& topRight, const Vec2& uvMins, const Vec2& uvMaxs )
 {
 	Vec3 right = bottomRight - bottomLeft;
 	Vec3 up = topLeft - bottomLeft;
@@ -164,13 +287,105 @@ void TileMap::AddTileFace( const Vec3& bottomLeft, const Vec3& bottomRight, cons
 	Vec3 normal = CrossProduct3D( right, up ).GetNormalized();
 	Vec3 tangent = right.GetNormalized();
 
-	m_mesh.push_back( Vertex_PCUTBN( bottomLeft, Rgba8::WHITE, uvMins, normal, tangent ) );
-	m_mesh.push_back( Vertex_PCUTBN( bottomRight, Rgba8::WHITE, Vec2( uvMaxs.x, uvMins.y ), normal, tangent ) );
-	m_mesh.push_back( Vertex_PCUTBN( topRight, Rgba8::WHITE, uvMaxs, normal, tangent ) );
+	vertices.push_back( Vertex_PCUTBN( bottomLeft, Rgba8::WHITE, uvMins, normal, tangent ) );
+	vertices.push_back( Vertex_PCUTBN( bottomRight, Rgba8::WHITE, Vec2( uvMaxs.x, uvMins.y ), normal, tangent ) );
+	vertices.push_back( Vertex_PCUTBN( topRight, Rgba8::WHITE, uvMaxs, normal, tangent ) );
 								
-	m_mesh.push_back( Vertex_PCUTBN( bottomLeft, Rgba8::WHITE, uvMins, normal, tangent ) );
-	m_mesh.push_back( Vertex_PCUTBN( topRight, Rgba8::WHITE, uvMaxs, normal, tangent ) );
-	m_mesh.push_back( Vertex_PCUTBN( topLeft, Rgba8::WHITE, Vec2( uvMins.x, uvMaxs.y ), normal, tangent ) );
+	vertices.push_back( Vertex_PCUTBN( bottomLeft, Rgba8::WHITE, uvMins, normal, tangent ) );
+	vertices.push_back( Vertex_PCUTBN( topRight, Rgba8::WHITE, uvMaxs, normal, tangent ) );
+	vertices.push_back( Vertex_PCUTBN( topLeft, Rgba8::WHITE, Vec2( uvMins.x, uvMaxs.y ), normal, tangent ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::UploadChunkMesh( TileMapChunk& chunk )
+{
+	chunk.isDirty = false;
+
+	// Empty chunks keep whatever buffer they had, Render skips them
+	if ( chunk.vertices.empty() )
+	{
+		return;
+	}
+
+	if ( chunk.gpuMesh == nullptr )
+	{
+		chunk.gpuMesh = new GPUMesh( g_renderer, chunk.vertices, std::vector<uint>() );
+		return;
+	}
+
+	chunk.gpuMesh->UpdateVertices( (uint)chunk.vertices.size(), &chunk.vertices[0] );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::SetTileRegionType( const IntVec2& tileCoords, MapRegionTypeDefinition* regionTypeDef )
+{
+	int tileIdx = GetTileIndexFromTileCoords( tileCoords );
+	if ( tileIdx < 0 )
+	{
+		return;
+	}
+
+	m_tiles[tileIdx].m_regionTypeDef = regionTypeDef;
+	UpdateSolidTile( tileIdx );
+	MarkTileMeshDirty( tileCoords );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Walls are culled against their neighbors, so a tile on a chunk edge dirties the chunk across it too
+//-----------------------------------------------------------------------------------------------
+void TileMap::MarkTileMeshDirty( const IntVec2& tileCoords )
+{
+	for ( int yOffset = -1; yOffset <= 1; ++yOffset )
+	{
+		for ( int xOffset = -1; xOffset <= 1; ++xOffset )
+		{
+			IntVec2 neighborCoords( tileCoords.x + xOffset, tileCoords.y + yOffset );
+			if ( GetTileIndexFromTileCoords( neighborCoords ) < 0 )
+			{
+				continue;
+			}
+
+			int chunkIdx = ( neighborCoords.x / CHUNK_SIZE_IN_TILES ) + ( neighborCoords.y / CHUNK_SIZE_IN_TILES ) * m_chunkDimensions.x;
+			TileMapChunk& chunk = m_chunks[chunkIdx];
+			if ( !chunk.isDirty )
+			{
+				chunk.isDirty = true;
+				m_dirtyChunkIndexes.push_back( chunkIdx );
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::MarkAllChunksDirty()
+{
+	for ( int chunkIdx = 0; chunkIdx < (int)m_chunks.size(); ++chunkIdx )
+	{
+		TileMapChunk& chunk = m_chunks[chunkIdx];
+		if ( !chunk.isDirty )
+		{
+			chunk.isDirty = true;
+			m_dirtyChunkIndexes.push_back( chunkIdx );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::PrintMeshStats( EventArgs* args )
+{
+	g_devConsole->PrintString( Stringf( "Map '%s': %i chunks", m_name.c_str(), m_meshStats.numChunks ) );
+	g_devConsole->PrintString( Stringf( "Last frame rebuilt %i chunks, generated %i vertices", m_meshStats.numRebuiltChunks, m_meshStats.numGeneratedVertices ) );
+
+	if ( args->GetValue( "rebuild", false ) )
+	{
+		MarkAllChunksDirty();
+		g_devConsole->PrintString( "Rebuilding every chunk next frame" );
+	}
 }
 
 
@@ -179,7 +394,7 @@ void TileMap::Render() const
 {
 	Map::Render();
 
-	if ( m_mesh.size() == 0 )
+	if ( m_chunks.empty() )
 	{
 		return;
 	}
@@ -191,7 +406,89 @@ void TileMap::Render() const
 	g_renderer->BindTexture( 0, g_renderer->CreateOrGetTextureFromFile( "Data/Images/Terrain_8x8.png" ) );
 	g_renderer->BindTexture( 1, g_renderer->CreateOrGetTextureFromFile( "Data/Images/Terrain_8x8_n.png" ) );
 
-	g_renderer->DrawVertexArray( m_mesh );
+	GatherVisibleChunks( g_game->GetWorldCamera()->GetWorldFrustum(), m_visibleChunkIndexes );
+
+	// A reused buffer keeps its old size when a remesh shrinks it, so only the chunk's own vertices
+	// are drawn
+	for ( int visibleIdx = 0; visibleIdx < (int)m_visibleChunkIndexes.size(); ++visibleIdx )
+	{
+		const TileMapChunk& chunk = m_chunks[m_visibleChunkIndexes[visibleIdx]];
+		g_renderer->BindVertexBuffer( chunk.gpuMesh->m_vertices );
+		g_renderer->Draw( (int)chunk.vertices.size() );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::GatherVisibleChunks( const Frustum& frustum, std::vector<int>& out_visibleChunkIndexes ) const
+{
+	out_visibleChunkIndexes.clear();
+	m_visibilityStats.numSubmittedChunks = 0;
+	m_visibilityStats.numFrustumCulledChunks = 0;
+
+	for ( int chunkIdx = 0; chunkIdx < (int)m_chunks.size(); ++chunkIdx )
+	{
+		const TileMapChunk& chunk = m_chunks[chunkIdx];
+		if ( chunk.gpuMesh == nullptr
+			 || chunk.vertices.empty() )
+		{
+			continue;
+		}
+
+		AABB3 chunkBounds( (float)chunk.mins.x, (float)chunk.mins.y, 0.f, 
+						   (float)chunk.maxs.x, (float)chunk.maxs.y, TILE_SIZE );
+		if ( IsFrustumCullingEnabled()
+			 && !frustum.DoesAABB3Overlap( chunkBounds ) )
+		{
+			++m_visibilityStats.numFrustumCulledChunks;
+			continue;
+		}
+
+		out_visibleChunkIndexes.push_back( chunkIdx );
+		++m_visibilityStats.numSubmittedChunks;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Walls run floor to ceiling so visibility is 2D, the entity is hidden when wall raycasts to its
+// center and both of its sides are all blocked
+//-----------------------------------------------------------------------------------------------
+bool TileMap::IsEntityOccluded( const Vec3& viewerPos, const GameEntity& entity ) const
+{
+	// A viewer inside a wall (e.g. flying through) would see everything as blocked
+	const Tile* viewerTile = GetTileFromWorldCoords( viewerPos.XY() );
+	if ( viewerTile == nullptr
+		 || viewerTile->IsSolid() )
+	{
+		return false;
+	}
+
+	Vec2 entityPos = entity.GetRenderPosition().XY();
+	Vec2 displacement = entityPos - viewerPos.XY();
+	float distance = displacement.GetLength();
+	float sideRadius = Max( entity.GetPhysicsRadius(), entity.m_entityDef.GetVisualSize().x * .5f );
+	if ( distance <= sideRadius )
+	{
+		return false;
+	}
+
+	Vec2 sideOffset = displacement.GetRotated90Degrees() * ( sideRadius / distance );
+	Vec2 targets[3] = { entityPos, entityPos + sideOffset, entityPos - sideOffset };
+
+	for ( int targetIdx = 0; targetIdx < 3; ++targetIdx )
+	{
+		Vec2 toTarget = targets[targetIdx] - viewerPos.XY();
+		float targetDistance = toTarget.GetLength();
+
+		RaycastResult result = RaycastAgainstWalls( viewerPos, Vec3( toTarget / targetDistance, 0.f ), targetDistance );
+		if ( !result.didImpact )
+		{
+			return false;
+		}
+	}
+
+	return true;
 }
 
 
@@ -220,33 +517,10 @@ RaycastResult TileMap::Raycast( const Vec3& startPos, const Vec3& forwardNormal,
 	RaycastResult closestImpact;
 	closestImpact.impactDist = maxDist;
 
-	RaycastResult floorResult = RaycastAgainstZPlane( startPos, forwardNormal, maxDist, 0.f );
-	if ( floorResult.didImpact
-		 && floorResult.impactDist < closestImpact.impactDist )
-	{
-		closestImpact = floorResult;
-	}
-
-	RaycastResult ceilingResult = RaycastAgainstZPlane( startPos, forwardNormal, maxDist, TILE_SIZE );
-	if ( ceilingResult.didImpact
-		 && ceilingResult.impactDist < closestImpact.impactDist )
-	{
-		closestImpact = ceilingResult;
-	}
-
-	RaycastResult wallsResult = RaycastAgainstWalls( startPos, forwardNormal, maxDist );
-	if ( wallsResult.didImpact
-		 && wallsResult.impactDist < closestImpact.impactDist )
-	{
-		closestImpact = wallsResult;
-	}
-
-	RaycastResult entitiesResult = RaycastAgainstEntitiesFast( startPos, forwardNormal, maxDist );
-	if ( entitiesResult.didImpact
-		 && entitiesResult.impactDist < closestImpact.impactDist )
-	{
-		closestImpact = entitiesResult;
-	}
+	KeepCloserImpact( closestImpact, RaycastAgainstZPlane( startPos, forwardNormal, maxDist, 0.f ) );
+	KeepCloserImpact( closestImpact, RaycastAgainstZPlane( startPos, forwardNormal, maxDist, TILE_SIZE ) );
+	KeepCloserImpact( closestImpact, RaycastAgainstWalls( startPos, forwardNormal, maxDist ) );
+	KeepCloserImpact( closestImpact, RaycastAgainstEntitiesFast( startPos, forwardNormal, maxDist ) );
 
 	return closestImpact;
 }
@@ -598,6 +872,292 @@ bool TileMap::DoesRayHitEntityAlongZ( RaycastResult& raycastResult, const Vec3&
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void TileMap::RaycastBatch( const std::vector<MapRay>& rays, std::vector<RaycastResult>& out_results ) const
+{
+	out_results.resize( rays.size() );
+	if ( rays.empty() )
+	{
+		return;
+	}
+
+	// Per call so batches can run from any number of threads at once
+	TileMapRaycastEntities raycastEntities;
+	GatherRaycastEntities( raycastEntities );
+
+	int numRays = (int)rays.size();
+	if ( g_jobSystem == nullptr )
+	{
+		RaycastBatchRange( rays, raycastEntities, 0, numRays, out_results );
+		return;
+	}
+
+	int numChunks = g_jobSystem->GetNumParallelForRanges( numRays, MIN_RAYS_PER_RAYCAST_JOB );
+	g_jobSystem->ParallelFor( numRays, numChunks, [&]( int chunkIdx, int firstRayIdx, int endRayIdx )
+	{
+		UNUSED( chunkIdx );
+		RaycastBatchRange( rays, raycastEntities, firstRayIdx, endRayIdx, out_results );
+	} );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::GatherRaycastEntities( TileMapRaycastEntities& out_raycastEntities ) const
+{
+	out_raycastEntities.positionsX.clear();
+	out_raycastEntities.positionsY.clear();
+	out_raycastEntities.radii.clear();
+	out_raycastEntities.entities.clear();
+
+	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	{
+		GameEntity* entity = m_entities[entityIdx];
+		if ( entity == nullptr
+			 || entity->IsPossessed() )
+		{
+			continue;
+		}
+
+		Vec3 position = entity->GetPosition();
+		out_raycastEntities.positionsX.push_back( position.x );
+		out_raycastEntities.positionsY.push_back( position.y );
+		out_raycastEntities.radii.push_back( entity->GetPhysicsRadius() );
+		out_raycastEntities.entities.push_back( entity );
+	}
+
+	// Far enough away that no ray's disc test can pass
+	while ( ( out_raycastEntities.entities.size() % 4 ) != 0 )
+	{
+		out_raycastEntities.positionsX.push_back( 1e30f );
+		out_raycastEntities.positionsY.push_back( 1e30f );
+		out_raycastEntities.radii.push_back( 0.f );
+		out_raycastEntities.entities.push_back( nullptr );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::RaycastBatchRange( const std::vector<MapRay>& rays, const TileMapRaycastEntities& raycastEntities, int firstRayIdx, int endRayIdx, std::vector<RaycastResult>& out_results ) const
+{
+	for ( int rayIdx = firstRayIdx; rayIdx < endRayIdx; ++rayIdx )
+	{
+		const MapRay& ray = rays[rayIdx];
+
+		RaycastResult closestImpact;
+		closestImpact.impactDist = ray.maxDist;
+
+		KeepCloserImpact( closestImpact, RaycastAgainstZPlane( ray.startPos, ray.forwardNormal, ray.maxDist, 0.f ) );
+		KeepCloserImpact( closestImpact, RaycastAgainstZPlane( ray.startPos, ray.forwardNormal, ray.maxDist, TILE_SIZE ) );
+		KeepCloserImpact( closestImpact, RaycastAgainstWalls( ray.startPos, ray.forwardNormal, ray.maxDist ) );
+		KeepCloserImpact( closestImpact, RaycastAgainstRaycastEntities( ray.startPos, ray.forwardNormal, ray.maxDist, raycastEntities ) );
+
+		out_results[rayIdx] = closestImpact;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Same disc math as RaycastAgainstEntitiesFast with the ray basis set up once, 4 discs are tested
+// per step and only the ones overlapping the ray in XY get the scalar height test, in entity order
+//-----------------------------------------------------------------------------------------------
+RaycastResult TileMap::RaycastAgainstRaycastEntities( const Vec3& startPos, const Vec3& forwardNormal, float maxDist, const TileMapRaycastEntities& raycastEntities ) const
+{
+	RaycastResult result;
+	result.startPos = startPos;
+	result.forwardNormal = forwardNormal;
+	result.maxDist = maxDist;
+	result.impactDist = maxDist;
+
+	// Straight up or down can't reach the side of a disc
+	float forwardLengthXY = forwardNormal.XY().GetLength();
+	if ( forwardLengthXY <= .000001f )
+	{
+		return result;
+	}
+
+	Vec2 iBasis = forwardNormal.XY() / forwardLengthXY;
+	Vec2 jBasis = iBasis.GetRotated90Degrees();
+	float inverseForwardLengthXY = 1.f / forwardLengthXY;
+
+#if defined( TILE_MAP_RAYCAST_SIMD )
+	const __m128 startX = _mm_set1_ps( startPos.x );
+	const __m128 startY = _mm_set1_ps( startPos.y );
+	const __m128 iBasisX = _mm_set1_ps( iBasis.x );
+	const __m128 iBasisY = _mm_set1_ps( iBasis.y );
+	const __m128 jBasisX = _mm_set1_ps( jBasis.x );
+	const __m128 jBasisY = _mm_set1_ps( jBasis.y );
+	const __m128 maxDistance = _mm_set1_ps( maxDist );
+	const __m128 zero = _mm_setzero_ps();
+#endif
+
+	int numPaddedEntities = (int)raycastEntities.entities.size();
+	for ( int firstEntityIdx = 0; firstEntityIdx < numPaddedEntities; firstEntityIdx += 4 )
+	{
+		float overlapMinDists[4];
+		int overlapMask = 0;
+
+#if defined( TILE_MAP_RAYCAST_SIMD )
+		__m128 displacementX = _mm_sub_ps( _mm_loadu_ps( &raycastEntities.positionsX[firstEntityIdx] ), startX );
+		__m128 displacementY = _mm_sub_ps( _mm_loadu_ps( &raycastEntities.positionsY[firstEntityIdx] ), startY );
+		__m128 radius = _mm_loadu_ps( &raycastEntities.radii[firstEntityIdx] );
+
+		__m128 alongRay = _mm_add_ps( _mm_mul_ps( iBasisX, displacementX ), _mm_mul_ps( iBasisY, displacementY ) );
+		__m128 acrossRay = _mm_add_ps( _mm_mul_ps( jBasisX, displacementX ), _mm_mul_ps( jBasisY, displacementY ) );
+
+		__m128 isInRange = _mm_and_ps( _mm_cmple_ps( _mm_sub_ps( alongRay, radius ), maxDistance ),
+									   _mm_cmpge_ps( _mm_add_ps( alongRay, radius ), zero ) );
+		__m128 aSquared = _mm_sub_ps( _mm_mul_ps( radius, radius ), _mm_mul_ps( acrossRay, acrossRay ) );
+		__m128 doesOverlap = _mm_and_ps( isInRange, _mm_cmpge_ps( aSquared, zero ) );
+
+		overlapMask = _mm_movemask_ps( doesOverlap );
+		if ( overlapMask == 0 )
+		{
+			continue;
+		}
+
+		__m128 overlapMinDist = _mm_max_ps( _mm_sub_ps( alongRay, _mm_sqrt_ps( _mm_max_ps( aSquared, zero ) ) ), zero );
+		_mm_storeu_ps( overlapMinDists, overlapMinDist );
+#else
+		for ( int laneIdx = 0; laneIdx < 4; ++laneIdx )
+		{
+			int entityIdx = firstEntityIdx + laneIdx;
+			Vec2 displacement( raycastEntities.positionsX[entityIdx] - startPos.x, raycastEntities.positionsY[entityIdx] - startPos.y );
+			float radius = raycastEntities.radii[entityIdx];
+			float alongRay = DotProduct2D( iBasis, displacement );
+			float acrossRay = DotProduct2D( jBasis, displacement );
+			float aSquared = ( radius * radius ) - ( acrossRay * acrossRay );
+
+			if ( alongRay - radius <= maxDist
+				 && alongRay + radius >= 0.f
+				 && aSquared >= 0.f )
+			{
+				overlapMask |= 1 << laneIdx;
+				overlapMinDists[laneIdx] = ClampMin( alongRay - sqrtf( aSquared ), 0.f );
+			}
+		}
+
+		if ( overlapMask == 0 )
+		{
+			continue;
+		}
+#endif
+
+		for ( int laneIdx = 0; laneIdx < 4; ++laneIdx )
+		{
+			if ( ( overlapMask & ( 1 << laneIdx ) ) == 0 )
+			{
+				continue;
+			}
+
+			float impactDist = overlapMinDists[laneIdx] * inverseForwardLengthXY;
+			if ( impactDist >= result.impactDist )
+			{
+				continue;
+			}
+
+			GameEntity* entity = raycastEntities.entities[firstEntityIdx + laneIdx];
+			if ( !DoesRayHitEntityAlongZ( result, startPos + forwardNormal * impactDist, *entity ) )
+			{
+				continue;
+			}
+
+			result.didImpact = true;
+			result.impactFraction = overlapMinDists[laneIdx] / maxDist;
+			result.impactDist = impactDist;
+			result.impactEntity = entity;
+		}
+	}
+
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Rays start in random open tiles so most of them travel before hitting something
+//-----------------------------------------------------------------------------------------------
+void TileMap::BenchmarkRaycasts( EventArgs* args )
+{
+	int numRays = args->GetValue( "rays", 100000 );
+	float maxDist = args->GetValue( "maxDist", 20.f );
+	if ( numRays <= 0
+		 || maxDist <= 0.f )
+	{
+		g_devConsole->PrintError( "benchmark_tilemap_raycasts: rays and maxDist must be positive" );
+		return;
+	}
+
+	std::vector<int> openTileIndexes;
+	for ( int tileIdx = 0; tileIdx < (int)m_solidTiles.size(); ++tileIdx )
+	{
+		if ( m_solidTiles[tileIdx] == 0 )
+		{
+			openTileIndexes.push_back( tileIdx );
+		}
+	}
+
+	if ( openTileIndexes.empty() )
+	{
+		g_devConsole->PrintError( "benchmark_tilemap_raycasts: map has no open tiles to cast from" );
+		return;
+	}
+
+	RandomNumberGenerator rng;
+	std::vector<MapRay> rays( numRays );
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		const Tile& tile = m_tiles[openTileIndexes[rng.RollRandomIntLessThan( (int)openTileIndexes.size() )]];
+
+		MapRay& ray = rays[rayIdx];
+		ray.startPos = Vec3( (float)tile.m_tileCoords.x + rng.RollRandomFloatZeroToAlmostOne(),
+							 (float)tile.m_tileCoords.y + rng.RollRandomFloatZeroToAlmostOne(),
+							 rng.RollRandomFloatInRange( .1f, .9f ) * TILE_SIZE );
+		ray.forwardNormal = Vec3( rng.RollRandomDirection2D(), rng.RollRandomFloatInRange( -.1f, .1f ) ).GetNormalized();
+		ray.maxDist = maxDist;
+	}
+
+	g_devConsole->PrintString( Stringf( "Casting %i rays against %ix%i tiles and %i entities, max distance %.1f", numRays, m_dimensions.x, m_dimensions.y, (int)m_entities.size(), maxDist ) );
+
+	std::vector<RaycastResult> singleResults( numRays );
+	double startTime = GetCurrentTimeSeconds();
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		singleResults[rayIdx] = Raycast( rays[rayIdx].startPos, rays[rayIdx].forwardNormal, rays[rayIdx].maxDist );
+	}
+	double singleSeconds = GetCurrentTimeSeconds() - startTime;
+
+	// One core, same work the batch does per job
+	std::vector<RaycastResult> batchResults( numRays );
+	TileMapRaycastEntities raycastEntities;
+	startTime = GetCurrentTimeSeconds();
+	GatherRaycastEntities( raycastEntities );
+	RaycastBatchRange( rays, raycastEntities, 0, numRays, batchResults );
+	double oneCoreSeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+	RaycastBatch( rays, batchResults );
+	double batchSeconds = GetCurrentTimeSeconds() - startTime;
+
+	int numMismatches = 0;
+	int numHits = 0;
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		const RaycastResult& singleResult = singleResults[rayIdx];
+		const RaycastResult& batchResult = batchResults[rayIdx];
+		numHits += batchResult.didImpact ? 1 : 0;
+		if ( singleResult.didImpact != batchResult.didImpact
+			 || singleResult.impactEntity != batchResult.impactEntity
+			 || !IsNearlyEqual( singleResult.impactDist, batchResult.impactDist, .001f ) )
+		{
+			++numMismatches;
+		}
+	}
+
+	g_devConsole->PrintString( Stringf( "  One Raycast per ray: %.2f ms", singleSeconds * 1000.0 ) );
+	g_devConsole->PrintString( Stringf( "  Batch on one core: %.2f ms (%.1fx)", oneCoreSeconds * 1000.0, singleSeconds / oneCoreSeconds ) );
+	g_devConsole->PrintString( Stringf( "  Batch on job system: %.2f ms (%.1fx), %i hits, %i mismatches", batchSeconds * 1000.0, singleSeconds / batchSeconds, numHits, numMismatches ) );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void TileMap::PopulateTiles( const std::vector<MapRegionTypeDefinition*>& regionTypeDefs )
 {
@@ -614,6 +1174,8 @@ void TileMap::CreateInitialTiles( const std::vector<MapRegionTypeDefinition*>& r
 		{
 			MapRegionTypeDefinition* regionTypeDef = regionTypeDefs[( y * m_dimensions.x ) + x];
 			m_tiles.push_back( Tile( IntVec2( x, y ), regionTypeDef ) );
+			m_solidTiles.push_back( 0 );
+			UpdateSolidTile( (int)m_tiles.size() - 1 );
 
 			if ( regionTypeDef->IsSolid() )
 			{
@@ -681,17 +1243,23 @@ bool TileMap::IsAdjacentTileSolid( const Tile& tile, eCardinalDirection directio
 
 
 //-----------------------------------------------------------------------------------------------
-bool TileMap::IsTileSolid( int xCoord, int yCoord ) const
+void TileMap::UpdateSolidTile( int tileIdx )
 {
-	const Tile* tile = GetTileFromTileCoords( xCoord, yCoord );
+	const Tile& tile = m_tiles[tileIdx];
+	m_solidTiles[tileIdx] = ( tile.m_regionTypeDef == nullptr || tile.IsSolid() ) ? 1 : 0;
+}
+
 
-	if ( tile == nullptr
-		 || tile->m_regionTypeDef == nullptr )
+//-----------------------------------------------------------------------------------------------
+bool TileMap::IsTileSolid( int xCoord, int yCoord ) const
+{
+	int tileIdx = GetTileIndexFromTileCoords( xCoord, yCoord );
+	if ( tileIdx < 0 )
 	{
 		return true;
 	}
 
-	return tile->IsSolid();
+	return m_solidTiles[tileIdx] != 0;
 }
 
 
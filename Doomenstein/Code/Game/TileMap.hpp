@@ -24,6 +24,45 @@ enum class eCardinalDirection
 };
 
 
+//-----------------------------------------------------------------------------------------------
+// A square block of tiles meshed together, the cpu vertices and gpu buffer are kept until a tile
+// in the chunk (or bordering it) changes
+//-----------------------------------------------------------------------------------------------
+struct TileMapChunk
+{
+public:
+	IntVec2 mins = IntVec2::ZERO;
+	IntVec2 maxs = IntVec2::ZERO;				// exclusive
+	std::vector<Vertex_PCUTBN> vertices;
+	GPUMesh* gpuMesh = nullptr;
+	bool isDirty = true;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct TileMapMeshStats
+{
+public:
+	int numChunks = 0;
+	int numRebuiltChunks = 0;
+	int numGeneratedVertices = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Entities flattened once per raycast batch so every ray streams through the same arrays.
+// Padded to a multiple of 4 with entries no ray can reach
+//-----------------------------------------------------------------------------------------------
+struct TileMapRaycastEntities
+{
+public:
+	std::vector<float> positionsX;
+	std::vector<float> positionsY;
+	std::vector<float> radii;
+	std::vector<GameEntity*> entities;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class TileMap : public Map
 {
@@ -46,13 +85,40 @@ public:
 	RaycastResult RaycastAgainstEntitiesFast( const Vec3& startPos, const Vec3& forwardNormal, float maxDist ) const;
 	bool DoesRayHitEntityAlongZ( RaycastResult& raycastResult, const Vec3& potentialImpactPos, const GameEntity& entity ) const;
 
+	// Entities are gathered once per batch and tested 4 at a time, large batches go to the job system
+	virtual void RaycastBatch( const std::vector<MapRay>& rays, std::vector<RaycastResult>& out_results ) const override;
+	void BenchmarkRaycasts( EventArgs* args );
+
+	// Tile edits only remesh the chunks they touch on the next UpdateMeshes
+	void SetTileRegionType( const IntVec2& tileCoords, MapRegionTypeDefinition* regionTypeDef );
+	void MarkTileMeshDirty( const IntVec2& tileCoords );
+	void MarkAllChunksDirty();
+	const TileMapMeshStats& GetLastMeshStats() const							{ return m_meshStats; }
+
+	void PrintMeshStats( EventArgs* args );
+
+	void GatherVisibleChunks( const Frustum& frustum, std::vector<int>& out_visibleChunkIndexes ) const;
+
+protected:
+	virtual bool IsEntityOccluded( const Vec3& viewerPos, const GameEntity& entity ) const override;
+
 private:
 	void				PopulateTiles( const std::vector<MapRegionTypeDefinition*>& regionTypeDefs );
 	void				CreateInitialTiles( const std::vector<MapRegionTypeDefinition*>& regionTypeDefs );
 
-	void				AddTileFace( const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topLeft, const Vec3& topRight, const Vec2& uvMins = Vec2::ZERO, const Vec2& uvMaxs = Vec2::ONE );
+	void				CreateChunks();
+	void				BuildChunkVertices( TileMapChunk& chunk ) const;
+	void				AddTileVertices( std::vector<Vertex_PCUTBN>& vertices, const Tile& tile ) const;
+	static void			AddTileFace( std::vector<Vertex_PCUTBN>& vertices, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topLeft, const Vec3& topRight, const Vec2& uvMins = Vec2::ZERO, const Vec2& uvMaxs = Vec2::ONE );
+	void				UploadChunkMesh( TileMapChunk& chunk );
+
+	// Batch raycasts
+	void				GatherRaycastEntities( TileMapRaycastEntities& out_raycastEntities ) const;
+	void				RaycastBatchRange( const std::vector<MapRay>& rays, const TileMapRaycastEntities& raycastEntities, int firstRayIdx, int endRayIdx, std::vector<RaycastResult>& out_results ) const;
+	RaycastResult		RaycastAgainstRaycastEntities( const Vec3& startPos, const Vec3& forwardNormal, float maxDist, const TileMapRaycastEntities& raycastEntities ) const;
 
 	// Tile helpers
+	void				UpdateSolidTile( int tileIdx );
 	bool				IsAdjacentTileSolid( const Tile& tile, eCardinalDirection direction ) const;
 	bool				IsTileSolid( int xCoord, int yCoord ) const;
 	int					GetTileIndexFromTileCoords( int xCoord, int yCoord ) const;
@@ -72,6 +138,7 @@ private:
 	Transform			m_raytraceTransform;
 
 	std::vector<Tile>	m_tiles;
+	std::vector<byte>	m_solidTiles;			// 1 per tile, kept next to each other so raycasts don't chase region defs
 	IntVec2				m_dimensions;
 
 	Vec2				m_cardinalDirectionOffsets[9];
@@ -82,5 +149,10 @@ private:
 
 	std::vector<Transform> m_cubeMeshTransforms;
 
-	std::vector<Vertex_PCUTBN> m_mesh;
+	// Map geometry, split into chunks so only edited parts are remeshed
+	std::vector<TileMapChunk> m_chunks;
+	IntVec2				m_chunkDimensions;
+	std::vector<int>	m_dirtyChunkIndexes;
+	TileMapMeshStats	m_meshStats;
+	mutable std::vector<int> m_visibleChunkIndexes;		// Render scratch, kept to reuse its memory
 };
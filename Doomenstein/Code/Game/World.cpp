@@ -78,6 +78,18 @@ void World::DebugRender() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void World::AddToFrameChecksum()
+{
+	if ( m_curMap == nullptr )
+	{
+		return;
+	}
+
+	m_curMap->AddToFrameChecksum();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void World::AddNewMap( const MapData& mapData )
 {
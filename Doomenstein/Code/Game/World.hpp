@@ -31,6 +31,8 @@ public:
 	void Render() const;
 	void DebugRender() const;
 
+	void AddToFrameChecksum();
+
 	void AddNewMap( const MapData& mapData );
 	void ChangeMap( const std::string& mapName );
 	// TODO: Remove the need for these and make a SpawnEntity(mapName) instead?
@@ -0,0 +1,139 @@
+#include "Engine/Core/ByteRingBuffer.hpp"
+
+#include <cstring>
+
+
+//-----------------------------------------------------------------------------------------------
+ByteRingBuffer::ByteRingBuffer( size_t capacity )
+{
+	Initialize( capacity );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ByteRingBuffer::~ByteRingBuffer()
+{
+	delete[] m_data;
+	m_data = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ByteRingBuffer::Initialize( size_t capacity )
+{
+	size_t powerOfTwoCapacity = 1;
+	while ( powerOfTwoCapacity < capacity )
+	{
+		powerOfTwoCapacity <<= 1;
+	}
+
+	delete[] m_data;
+	m_data = new char[powerOfTwoCapacity];
+	m_capacity = powerOfTwoCapacity;
+
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ByteRingBuffer::Clear()
+{
+	m_readCount = 0;
+	m_writeCount = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool ByteRingBuffer::Write( const void* data, size_t size )
+{
+	if ( size > GetFreeBytes() )
+	{
+		return false;
+	}
+
+	const char* srcBytes = reinterpret_cast<const char*>( data );
+	while ( size > 0 )
+	{
+		size_t regionSize = 0;
+		char* region = GetContiguousWriteRegion( regionSize );
+		size_t bytesToCopy = size < regionSize ? size : regionSize;
+
+		memcpy( region, srcBytes, bytesToCopy );
+		CommitWrite( bytesToCopy );
+
+		srcBytes += bytesToCopy;
+		size -= bytesToCopy;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+char* ByteRingBuffer::GetContiguousWriteRegion( size_t& out_size )
+{
+	size_t writeIdx = GetMaskedIndex( m_writeCount );
+	size_t bytesUntilWrap = m_capacity - writeIdx;
+	size_t freeBytes = GetFreeBytes();
+
+	out_size = freeBytes < bytesUntilWrap ? freeBytes : bytesUntilWrap;
+	return m_data + writeIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ByteRingBuffer::CommitWrite( size_t size )
+{
+	ASSERT_OR_DIE( size <= GetFreeBytes(), "ByteRingBuffer committed more bytes than it has free" );
+
+	m_writeCount += size;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+const char* ByteRingBuffer::GetContiguousReadRegion( size_t offset, size_t& out_size ) const
+{
+	size_t usedBytes = GetUsedBytes();
+	if ( offset >= usedBytes )
+	{
+		out_size = 0;
+		return nullptr;
+	}
+
+	size_t readIdx = GetMaskedIndex( m_readCount + offset );
+	size_t bytesUntilWrap = m_capacity - readIdx;
+	size_t bytesAvailable = usedBytes - offset;
+
+	out_size = bytesAvailable < bytesUntilWrap ? bytesAvailable : bytesUntilWrap;
+	return m_data + readIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ByteRingBuffer::CopyOut( size_t offset, void* out_data, size_t size ) const
+{
+	ASSERT_OR_DIE( offset + size <= GetUsedBytes(), "ByteRingBuffer tried to copy out more bytes than it holds" );
+
+	char* dstBytes = reinterpret_cast<char*>( out_data );
+	while ( size > 0 )
+	{
+		size_t regionSize = 0;
+		const char* region = GetContiguousReadRegion( offset, regionSize );
+		size_t bytesToCopy = size < regionSize ? size : regionSize;
+
+		memcpy( dstBytes, region, bytesToCopy );
+
+		dstBytes += bytesToCopy;
+		offset += bytesToCopy;
+		size -= bytesToCopy;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ByteRingBuffer::Consume( size_t size )
+{
+	ASSERT_OR_DIE( size <= GetUsedBytes(), "ByteRingBuffer consumed more bytes than it holds" );
+
+	m_readCount += size;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// Fixed capacity byte ring used for streaming data, capacity is rounded up to a power of 2 so
+// read and write positions can be free running counters masked into the storage
+//-----------------------------------------------------------------------------------------------
+class ByteRingBuffer
+{
+public:
+	ByteRingBuffer() = default;
+	explicit ByteRingBuffer( size_t capacity );
+	~ByteRingBuffer();
+
+	ByteRingBuffer( const ByteRingBuffer& ) = delete;
+	ByteRingBuffer& operator=( const ByteRingBuffer& ) = delete;
+
+	void Initialize( size_t capacity );
+	void Clear();
+
+	size_t GetCapacity() const											{ return m_capacity; }
+	size_t GetUsedBytes() const											{ return m_writeCount - m_readCount; }
+	size_t GetFreeBytes() const											{ return m_capacity - GetUsedBytes(); }
+	bool IsEmpty() const												{ return m_writeCount == m_readCount; }
+	bool IsFull() const													{ return GetUsedBytes() == m_capacity; }
+
+	// Writing
+	bool Write( const void* data, size_t size );						// All or nothing, false if there isn't room
+	char* GetContiguousWriteRegion( size_t& out_size );
+	void CommitWrite( size_t size );
+
+	// Reading, offsets are relative to the oldest unconsumed byte
+	const char* GetContiguousReadRegion( size_t offset, size_t& out_size ) const;
+	void CopyOut( size_t offset, void* out_data, size_t size ) const;
+	void Consume( size_t size );
+
+private:
+	size_t GetMaskedIndex( size_t counter ) const						{ return counter & ( m_capacity - 1 ); }
+
+private:
+	char* m_data = nullptr;
+	size_t m_capacity = 0;
+	size_t m_readCount = 0;
+	size_t m_writeCount = 0;
+};
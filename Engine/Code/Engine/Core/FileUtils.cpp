@@ -3,6 +3,7 @@
 #include "Engine/Core/StringUtils.hpp"
 
 #include <io.h>
+#include <sys/stat.h>
 #include <iostream>
 #include <fstream>
 
@@ -74,6 +75,35 @@ void* FileReadBinaryToNewBuffer( const std::string& filename, uint32_t* out_file
 }
 
 
+//-----------------------------------------------------------------------------------------------
+bool FileReadBinaryToBuffer( const std::string& filename, std::vector<byte>& out_buffer )
+{
+	FILE* fp;
+	fopen_s( &fp, filename.c_str(), "rb" );
+	if ( fp == nullptr )
+	{
+		return false;
+	}
+
+	// get size of file
+	fseek( fp, 0, SEEK_END );
+	long fileSize = ftell( fp );
+
+	// Resizing keeps the existing capacity so reused buffers don't reallocate
+	out_buffer.resize( fileSize );
+	if ( fileSize > 0 )
+	{
+		fseek( fp, 0, SEEK_SET );
+		size_t bytesRead = fread( &out_buffer[0], 1, fileSize, fp );
+		out_buffer.resize( bytesRead );
+	}
+
+	fclose( fp );
+
+	return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 bool WriteBufferToFile( const std::string& filename, byte* buffer, uint32_t bufferSize )
 {
@@ -92,6 +122,20 @@ bool WriteBufferToFile( const std::string& filename, byte* buffer, uint32_t buff
 }
 
 
+//-----------------------------------------------------------------------------------------------
+bool GetFileLastWriteTime( const std::string& filename, int64_t& out_lastWriteTime )
+{
+	struct _stat64 fileInfo;
+	if ( _stat64( filename.c_str(), &fileInfo ) != 0 )
+	{
+		return false;
+	}
+
+	out_lastWriteTime = (int64_t)fileInfo.st_mtime;
+	return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Strings SplitFileIntoLines( const std::string& filename )
 {
@@ -5,7 +5,9 @@
 //-----------------------------------------------------------------------------------------------
 void* FileReadToNewBuffer( const std::string& filename, uint32_t* out_fileSize = nullptr );
 void* FileReadBinaryToNewBuffer( const std::string& filename, uint32_t* out_fileSize = nullptr );
+bool  FileReadBinaryToBuffer( const std::string& filename, std::vector<byte>& out_buffer );
 bool  WriteBufferToFile( const std::string& filename, byte* buffer, uint32_t bufferSize );
+bool  GetFileLastWriteTime( const std::string& filename, int64_t& out_lastWriteTime );
 
 Strings SplitFileIntoLines( const std::string& filename );
 Strings GetFileNamesInFolder( const std::string& relativeFolderPath, const char* filePattern );
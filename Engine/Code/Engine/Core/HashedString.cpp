@@ -4,6 +4,7 @@
 
 //-----------------------------------------------------------------------------------------------
 std::map<uint32_t, std::string> HashedString::s_stringTable;
+std::shared_timed_mutex HashedString::s_stringTableMutex;
 
 
 //-----------------------------------------------------------------------------------------------
@@ -81,21 +82,24 @@ bool HashedString::operator!=( const HashedString& other )
 //-----------------------------------------------------------------------------------------------
 bool HashedString::AddToStringTable( const std::string& rawString )
 {
-	const auto& iter = s_stringTable.find( m_id );
-
-	if ( iter == s_stringTable.cend() )
 	{
-		s_stringTable[m_id] = rawString;
-		return true;
+		std::shared_lock<std::shared_timed_mutex> readLock( s_stringTableMutex );
+		if ( s_stringTable.find( m_id ) != s_stringTable.cend() )
+		{
+			return false;
+		}
 	}
 
-	return false;
+	// Another thread may have added it between the locks, emplace leaves the first one
+	std::unique_lock<std::shared_timed_mutex> writeLock( s_stringTableMutex );
+	return s_stringTable.emplace( m_id, rawString ).second;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 const std::string HashedString::GetRawString() const
 {
+	std::shared_lock<std::shared_timed_mutex> readLock( s_stringTableMutex );
 	const auto& iter = s_stringTable.find( m_id );
 
 	if ( iter == s_stringTable.cend() )
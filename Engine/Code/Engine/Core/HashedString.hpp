@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <map>
+#include <shared_mutex>
 #include <string>
 
 
@@ -29,5 +30,7 @@ private:
 private:
 	uint32_t m_id = 0U;
 
+	// Strings are hashed from job threads too, lookups share the lock and only new strings take it alone
 	static std::map<uint32_t, std::string> s_stringTable;
+	static std::shared_timed_mutex s_stringTableMutex;
 };
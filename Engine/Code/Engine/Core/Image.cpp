@@ -26,27 +26,22 @@ Image::Image( const char* imageFilePath )
 	// Set member variables from image data
 	m_dimensions = IntVec2( imageTexelSizeX, imageTexelSizeY );
 
-	// Reserve a spot for each texel in the image
-	int texelIndex = 0;
 	int numTexels = imageTexelSizeX * imageTexelSizeY;
-	m_rgbaTexels.reserve( numTexels );
+	m_rgbaTexels.resize( numTexels );
 
-	// Load data in rgb(a) chunks from raw image data
-	int numImageBytes = numTexels * numComponents;
-	for ( int imageDataIndex = 0; imageDataIndex < numImageBytes; imageDataIndex += numComponents )
+	// Rgba8 matches the rgba byte layout so 4 component images can be copied directly
+	static_assert( sizeof( Rgba8 ) == 4, "Rgba8 must be tightly packed to copy texel data directly" );
+	if ( numComponents == 4 )
 	{
-		unsigned char r = imageData[ imageDataIndex ];
-		unsigned char g = imageData[ imageDataIndex + 1 ];
-		unsigned char b = imageData[ imageDataIndex + 2 ];
-
-		unsigned char a = 255;
-		if ( numComponents == 4 )
+		memcpy( &m_rgbaTexels[0], imageData, numTexels * sizeof( Rgba8 ) );
+	}
+	else
+	{
+		for ( int texelIndex = 0; texelIndex < numTexels; ++texelIndex )
 		{
-			a = imageData[ imageDataIndex + 3 ];
+			const unsigned char* rgb = &imageData[texelIndex * numComponents];
+			m_rgbaTexels[texelIndex] = Rgba8( rgb[0], rgb[1], rgb[2], 255 );
 		}
-
-		m_rgbaTexels.push_back( Rgba8( r, g, b, a ) );
-		++texelIndex;
 	}
 
 	stbi_image_free( imageData );
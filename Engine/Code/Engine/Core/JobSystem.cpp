@@ -1,5 +1,6 @@
 #include "Engine/Core/JobSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
@@ -10,11 +11,38 @@
 //-----------------------------------------------------------------------------------------------
 Job::Job()
 {
-	static int s_nextJobId = 1;
+	// Jobs can be created on worker threads too
+	static std::atomic<int> s_nextJobId( 1 );
 	m_id = s_nextJobId++;
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// ParallelForJob
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+ParallelForJob::ParallelForJob( const ParallelForRangeFn& rangeFn, int rangeIdx, int firstIdx, int endIdx, std::atomic<int>& numPendingJobs )
+	: m_rangeFn( rangeFn )
+	, m_rangeIdx( rangeIdx )
+	, m_firstIdx( firstIdx )
+	, m_endIdx( endIdx )
+	, m_numPendingJobs( numPendingJobs )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ParallelForJob::Execute()
+{
+	m_rangeFn( m_rangeIdx, m_firstIdx, m_endIdx );
+
+	// Last touch of the caller's state, the function and count are gone once it stops waiting
+	--m_numPendingJobs;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // JobSystemWorkerThread
 //-----------------------------------------------------------------------------------------------
@@ -72,6 +100,13 @@ JobSystem::~JobSystem()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void JobSystem::BeginFrame()
+{
+	ClaimAndDeleteAllCompletedJobs();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void JobSystem::Shutdown()
 {
@@ -95,10 +130,17 @@ void JobSystem::CreateWorkerThreads( int numThreads )
 
 
 //-----------------------------------------------------------------------------------------------
-void JobSystem::QueueJob( Job* job )
+void JobSystem::QueueJob( Job* job, eJobPriority priority )
 {
 	m_queuedJobsMutex.lock();
-	m_queuedJobs.push_back( job );
+	if ( priority == eJobPriority::HIGH )
+	{
+		m_queuedHighPriorityJobs.push_back( job );
+	}
+	else
+	{
+		m_queuedJobs.push_back( job );
+	}
 	m_queuedJobsMutex.unlock();
 }
 
@@ -136,7 +178,12 @@ Job* JobSystem::GetBestAvailableJob()
 	Job* job = nullptr;
 
 	m_queuedJobsMutex.lock();
-	if ( !m_queuedJobs.empty() )
+	if ( !m_queuedHighPriorityJobs.empty() )
+	{
+		job = m_queuedHighPriorityJobs.front();
+		m_queuedHighPriorityJobs.pop_front();
+	}
+	else if ( !m_queuedJobs.empty() )
 	{
 		job = m_queuedJobs.front();
 		m_queuedJobs.pop_front();
@@ -148,6 +195,91 @@ Job* JobSystem::GetBestAvailableJob()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void JobSystem::ParallelFor( int numItems, int numRanges, const ParallelForRangeFn& rangeFn )
+{
+	if ( numItems <= 0 )
+	{
+		return;
+	}
+
+	numRanges = ClampMinMaxInt( numRanges, 1, numItems );
+	if ( numRanges == 1 )
+	{
+		rangeFn( 0, 0, numItems );
+		return;
+	}
+
+	int itemsPerRange = ( numItems + numRanges - 1 ) / numRanges;
+	std::atomic<int> numPendingJobs( numRanges - 1 );
+
+	for ( int rangeIdx = 1; rangeIdx < numRanges; ++rangeIdx )
+	{
+		int firstIdx = Min( rangeIdx * itemsPerRange, numItems );
+		int endIdx = Min( firstIdx + itemsPerRange, numItems );
+		QueueJob( new ParallelForJob( rangeFn, rangeIdx, firstIdx, endIdx, numPendingJobs ), eJobPriority::HIGH );
+	}
+
+	rangeFn( 0, 0, Min( itemsPerRange, numItems ) );
+
+	WaitForJobs( numPendingJobs );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// One range per worker plus one for the calling thread
+//-----------------------------------------------------------------------------------------------
+int JobSystem::GetNumParallelForRanges( int numItems, int minItemsPerRange ) const
+{
+	if ( m_workerThreads.empty() )
+	{
+		return 1;
+	}
+
+	return ClampMinMaxInt( numItems / Max( minItemsPerRange, 1 ), 1, (int)m_workerThreads.size() + 1 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Only high priority jobs are run here, picking up a background decode would hold up the wait
+// far longer than the jobs it's waiting on. Any high priority job will do, not just the ones
+// being waited on, since those may be waiting on others in turn
+//-----------------------------------------------------------------------------------------------
+void JobSystem::WaitForJobs( const std::atomic<int>& numPendingJobs )
+{
+	while ( numPendingJobs > 0 )
+	{
+		Job* job = GetHighPriorityJob();
+		if ( job != nullptr )
+		{
+			job->Execute();
+			PostCompletedJob( job );
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Job* JobSystem::GetHighPriorityJob()
+{
+	Job* job = nullptr;
+
+	m_queuedJobsMutex.lock();
+	if ( !m_queuedHighPriorityJobs.empty() )
+	{
+		job = m_queuedHighPriorityJobs.front();
+		m_queuedHighPriorityJobs.pop_front();
+	}
+	m_queuedJobsMutex.unlock();
+
+	return job;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void JobSystem::StopAllThreads()
 {
@@ -3,6 +3,7 @@
 #include <thread>
 #include <atomic>
 #include <deque>
+#include <functional>
 #include <vector>
 
 
@@ -20,6 +21,38 @@ protected:
 };
 
 
+//-----------------------------------------------------------------------------------------------
+// High priority jobs are ones something is waiting on this frame, they go ahead of background
+// work like texture decodes and get run by threads in WaitForJobs
+//-----------------------------------------------------------------------------------------------
+enum class eJobPriority
+{
+	NORMAL,
+	HIGH,
+};
+
+
+//-----------------------------------------------------------------------------------------------
+typedef std::function<void( int rangeIdx, int firstIdx, int endIdx )> ParallelForRangeFn;
+
+
+//-----------------------------------------------------------------------------------------------
+class ParallelForJob : public Job
+{
+public:
+	ParallelForJob( const ParallelForRangeFn& rangeFn, int rangeIdx, int firstIdx, int endIdx, std::atomic<int>& numPendingJobs );
+
+	virtual void Execute() override;
+
+private:
+	const ParallelForRangeFn& m_rangeFn;
+	int m_rangeIdx = 0;
+	int m_firstIdx = 0;
+	int m_endIdx = 0;
+	std::atomic<int>& m_numPendingJobs;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class JobSystemWorkerThread
 {
@@ -47,23 +80,36 @@ public:
 	~JobSystem();
 
 	void Startup() {}
-	void BeginFrame() {}
+	void BeginFrame();
 	void EndFrame() {}
 	void Shutdown();
 
 	void CreateWorkerThreads( int numThreads );
 	
-	void QueueJob( Job* job );
+	void QueueJob( Job* job, eJobPriority priority = eJobPriority::NORMAL );
 	void PostCompletedJob( Job* job );
 	void ClaimAndDeleteAllCompletedJobs();
 
 	Job* GetBestAvailableJob();
 
+	// Splits [0, numItems) into numRanges contiguous ranges, this thread runs range 0 and the rest
+	// go to the workers as high priority jobs. Returns once every range is done
+	void ParallelFor( int numItems, int numRanges, const ParallelForRangeFn& rangeFn );
+	int GetNumParallelForRanges( int numItems, int minItemsPerRange ) const;
+
+	// Runs queued high priority jobs on this thread until the count hits zero, so a wait started
+	// from inside a job can't stall every worker. Jobs must decrement the count as their last step
+	void WaitForJobs( const std::atomic<int>& numPendingJobs );
+
+	int GetNumWorkerThreads() const								{ return (int)m_workerThreads.size(); }
+
 private:
 	void StopAllThreads();
+	Job* GetHighPriorityJob();
 
 private:
 	std::deque<Job*>	m_queuedJobs;
+	std::deque<Job*>	m_queuedHighPriorityJobs;
 	std::mutex			m_queuedJobsMutex;
 	std::deque<Job*>	m_runningJobs;
 	std::mutex			m_runningJobsMutex;
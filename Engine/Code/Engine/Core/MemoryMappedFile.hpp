@@ -0,0 +1,32 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <string>
+
+
+//-----------------------------------------------------------------------------------------------
+// Read only view of a file mapped into the address space, pages are loaded by the os on first
+// access so large binary assets can be parsed and uploaded without an intermediate copy
+//-----------------------------------------------------------------------------------------------
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile() = default;
+	~MemoryMappedFile();
+
+	MemoryMappedFile( const MemoryMappedFile& ) = delete;
+	MemoryMappedFile& operator=( const MemoryMappedFile& ) = delete;
+
+	bool Open( const std::string& filename );
+	void Close();
+
+	bool		IsOpen() const											{ return m_data != nullptr; }
+	const byte*	GetData() const											{ return m_data; }
+	size_t		GetSize() const											{ return m_size; }
+
+private:
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+	const byte* m_data = nullptr;
+	size_t m_size = 0;
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Index of a name in NameIdRegistry<TAG>, the tag keeps ids from different registries apart
+//-----------------------------------------------------------------------------------------------
+template <typename TAG>
+struct NameId
+{
+public:
+	int index = -1;
+
+public:
+	NameId() = default;
+	explicit NameId( int nameIdx )
+		: index( nameIdx )
+	{}
+
+	bool IsValid() const											{ return index >= 0; }
+	bool operator==( const NameId& other ) const					{ return index == other.index; }
+	bool operator!=( const NameId& other ) const					{ return index != other.index; }
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Gives names read from data, like damage types and event names, dense ids in registration order
+// so runtime code can index flat arrays instead of hashing strings. Names are meant to be
+// registered while loading on the main thread, after that lookups are read only and safe from jobs
+//-----------------------------------------------------------------------------------------------
+template <typename TAG>
+class NameIdRegistry
+{
+public:
+	// Returns the existing id if the name is already registered
+	static NameId<TAG> RegisterName( const std::string& name )
+	{
+		std::map<std::string, int>& idsByName = GetIdsByName();
+		auto idIter = idsByName.find( name );
+		if ( idIter != idsByName.end() )
+		{
+			return NameId<TAG>( idIter->second );
+		}
+
+		std::vector<std::string>& names = GetNames();
+		int nameIdx = (int)names.size();
+		names.push_back( name );
+		idsByName[name] = nameIdx;
+
+		return NameId<TAG>( nameIdx );
+	}
+
+
+	// Returns an invalid id for names that were never registered
+	static NameId<TAG> GetId( const std::string& name )
+	{
+		const std::map<std::string, int>& idsByName = GetIdsByName();
+		auto idIter = idsByName.find( name );
+		if ( idIter == idsByName.end() )
+		{
+			return NameId<TAG>();
+		}
+
+		return NameId<TAG>( idIter->second );
+	}
+
+
+	static const std::string& GetName( const NameId<TAG>& id )
+	{
+		static const std::string s_invalidName;
+
+		const std::vector<std::string>& names = GetNames();
+		if ( id.index < 0
+			 || id.index >= (int)names.size() )
+		{
+			return s_invalidName;
+		}
+
+		return names[id.index];
+	}
+
+
+	static int GetNumNames()
+	{
+		return (int)GetNames().size();
+	}
+
+private:
+	static std::map<std::string, int>& GetIdsByName()
+	{
+		static std::map<std::string, int> s_idsByName;
+		return s_idsByName;
+	}
+
+	static std::vector<std::string>& GetNames()
+	{
+		static std::vector<std::string> s_names;
+		return s_names;
+	}
+};
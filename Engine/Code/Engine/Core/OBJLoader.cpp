@@ -3,6 +3,7 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/BatchTransform.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Vec4.hpp"
@@ -434,17 +435,18 @@ void ObjLoader::InvertIndexWindingOrder( std::vector<uint>& indices )
 //-----------------------------------------------------------------------------------------------
 void ObjLoader::TransformVerts( std::vector<Vertex_PCUTBN>& vertices, const Mat44& transform )
 {
-	for ( size_t vertIdx = 0; vertIdx < vertices.size(); ++vertIdx )
+	if ( vertices.empty() )
 	{
-		Vertex_PCUTBN& vertex = vertices[vertIdx];
-		
-		vertex.position = transform.TransformPosition3D( vertex.position );
-
-		Mat44 directionMatrix = transform.GetNormalizedDirectionMatrix3D();
-		vertex.normal = directionMatrix.TransformVector3D( vertex.normal );
-		vertex.tangent = directionMatrix.TransformVector3D( vertex.tangent );
-		vertex.bitangent = directionMatrix.TransformVector3D( vertex.bitangent );
+		return;
 	}
+
+	int numVertices = (int)vertices.size();
+	TransformPositions3DBatch( transform, (byte*)&vertices[0].position, numVertices, sizeof( Vertex_PCUTBN ) );
+
+	Mat44 directionMatrix = transform.GetNormalizedDirectionMatrix3D();
+	TransformVectors3DBatch( directionMatrix, (byte*)&vertices[0].normal, numVertices, sizeof( Vertex_PCUTBN ) );
+	TransformVectors3DBatch( directionMatrix, (byte*)&vertices[0].tangent, numVertices, sizeof( Vertex_PCUTBN ) );
+	TransformVectors3DBatch( directionMatrix, (byte*)&vertices[0].bitangent, numVertices, sizeof( Vertex_PCUTBN ) );
 }
 
 
@@ -0,0 +1,612 @@
+#include "Engine/Core/ReplaySystem.hpp"
+#include "Engine/Core/BufferParser.hpp"
+#include "Engine/Core/BufferWriter.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/HashUtils.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Time/Clock.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <algorithm>
+
+
+//-----------------------------------------------------------------------------------------------
+static const uint32_t REPLAY_FILE_ID = 0x594c5052;			// "RPLY"
+static const uint32_t REPLAY_FILE_VERSION = 1;
+static const uint32_t REPLAY_NUM_FRAMES_OFFSET = 12;
+static const int REPLAY_FRAMES_PER_FLUSH = 60;
+
+static const byte FRAME_HAS_KEY_CHANGES = BIT_FLAG( 0 );
+static const byte FRAME_HAS_CHARACTERS = BIT_FLAG( 1 );
+static const byte FRAME_HAS_MOUSE_POS = BIT_FLAG( 2 );
+static const byte FRAME_HAS_MOUSE_DELTA = BIT_FLAG( 3 );
+static const byte FRAME_HAS_MOUSE_WHEEL = BIT_FLAG( 4 );
+static const byte FRAME_HAS_EXTERNAL_EVENTS = BIT_FLAG( 5 );
+
+static const byte KEY_IS_PRESSED = BIT_FLAG( 0 );
+static const byte KEY_WAS_PRESSED_LAST_FRAME = BIT_FLAG( 1 );
+
+static const int NUM_WORST_FRAMES_TO_REPORT = 5;
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::Startup( const ReplaySystemParams& params )
+{
+	m_params = params;
+	m_sessionSeed = params.seed;
+
+	GUARANTEE_OR_DIE( m_params.inputSystem != nullptr, "ReplaySystem needs an input system" );
+
+	if ( !m_params.replayFilePath.empty() )
+	{
+		StartReplay();
+	}
+	else if ( !m_params.recordFilePath.empty() )
+	{
+		StartRecording();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::Shutdown()
+{
+	if ( m_mode == eReplayMode::RECORDING )
+	{
+		StopRecording();
+	}
+	else if ( m_mode == eReplayMode::REPLAYING )
+	{
+		FinishReplay();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::BeginFrame()
+{
+	if ( m_mode == eReplayMode::REPLAYING
+		 && m_frameIdx >= (int)m_replayFrames.size() )
+	{
+		FinishReplay();
+
+		if ( m_params.isHeadless )
+		{
+			g_eventSystem->FireEvent( "quit", nullptr, eUsageLocation::EVERYWHERE );
+		}
+	}
+
+	m_curFrame = ReplayFrame();
+
+	if ( m_mode == eReplayMode::REPLAYING )
+	{
+		Clock::MasterBeginFrame( m_replayFrames[m_frameIdx].deltaSeconds );
+	}
+	else
+	{
+		Clock::MasterBeginFrame();
+		m_curFrame.deltaSeconds = Clock::GetMaster()->GetLastUnscaledDeltaSeconds();
+	}
+
+	m_frameStartSeconds = GetCurrentTimeSeconds();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::UpdateInput()
+{
+	std::vector<ReplayExternalEvent> liveExternalEvents;
+	{
+		std::lock_guard<std::mutex> lock( m_externalEventsMutex );
+		liveExternalEvents.swap( m_queuedExternalEvents );
+	}
+
+	switch ( m_mode )
+	{
+		case eReplayMode::LIVE:
+		{
+			FireExternalEvents( liveExternalEvents );
+		}
+		break;
+
+		case eReplayMode::RECORDING:
+		{
+			InputFrameState liveState;
+			m_params.inputSystem->GetFrameState( liveState );
+
+			for ( int keyCode = 0; keyCode < MAX_KEY_CODES; ++keyCode )
+			{
+				if ( liveState.keyStates[keyCode] != m_inputState.keyStates[keyCode] )
+				{
+					ReplayKeyChange keyChange;
+					keyChange.keyCode = (byte)keyCode;
+					keyChange.keyState = liveState.keyStates[keyCode];
+					m_curFrame.keyChanges.push_back( keyChange );
+				}
+			}
+
+			m_curFrame.characters = liveState.characters;
+			m_curFrame.normalizedMouseClientPos = liveState.normalizedMouseClientPos;
+			m_curFrame.mouseMovementDelta = liveState.mouseMovementDelta;
+			m_curFrame.mouseWheelScrollAmountDelta = liveState.mouseWheelScrollAmountDelta;
+			m_curFrame.externalEvents = liveExternalEvents;
+
+			m_inputState = liveState;
+
+			FireExternalEvents( m_curFrame.externalEvents );
+		}
+		break;
+
+		case eReplayMode::REPLAYING:
+		{
+			// Live events are dropped, the recorded ones stand in for them
+			const ReplayFrame& replayFrame = m_replayFrames[m_frameIdx];
+			for ( int keyChangeIdx = 0; keyChangeIdx < (int)replayFrame.keyChanges.size(); ++keyChangeIdx )
+			{
+				const ReplayKeyChange& keyChange = replayFrame.keyChanges[keyChangeIdx];
+				m_inputState.keyStates[keyChange.keyCode] = keyChange.keyState;
+			}
+
+			m_inputState.characters = replayFrame.characters;
+			m_inputState.normalizedMouseClientPos = replayFrame.normalizedMouseClientPos;
+			m_inputState.mouseMovementDelta = replayFrame.mouseMovementDelta;
+			m_inputState.mouseWheelScrollAmountDelta = replayFrame.mouseWheelScrollAmountDelta;
+
+			m_params.inputSystem->SetFrameState( m_inputState );
+
+			FireExternalEvents( replayFrame.externalEvents );
+		}
+		break;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::EndFrame()
+{
+	m_curFrame.frameMilliseconds = (float)( ( GetCurrentTimeSeconds() - m_frameStartSeconds ) * 1000.0 );
+
+	switch ( m_mode )
+	{
+		case eReplayMode::RECORDING:
+		{
+			AppendFrameToRecording( m_curFrame );
+
+			if ( ( m_frameIdx + 1 ) % REPLAY_FRAMES_PER_FLUSH == 0 )
+			{
+				FlushRecording( m_frameIdx + 1 );
+			}
+		}
+		break;
+
+		case eReplayMode::REPLAYING:
+		{
+			m_replayFrameMilliseconds.push_back( m_curFrame.frameMilliseconds );
+
+			if ( m_firstDesyncFrameIdx == -1
+				 && m_curFrame.checksum != m_replayFrames[m_frameIdx].checksum )
+			{
+				m_firstDesyncFrameIdx = m_frameIdx;
+				g_devConsole->PrintError( Stringf( "Replay desynced on frame %i", m_frameIdx ) );
+			}
+		}
+		break;
+
+		case eReplayMode::LIVE: break;
+	}
+
+	++m_frameIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::QueueExternalEvent( const std::string& eventName, const std::vector<byte>& payload )
+{
+	ReplayExternalEvent externalEvent;
+	externalEvent.eventName = eventName;
+	externalEvent.payload = payload;
+
+	std::lock_guard<std::mutex> lock( m_externalEventsMutex );
+	m_queuedExternalEvents.push_back( externalEvent );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::AddToFrameChecksum( const void* data, size_t dataSize )
+{
+	m_curFrame.checksum = ( m_curFrame.checksum * 16777619U ) ^ Hash( (byte*)data, dataSize );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool ReplaySystem::StartRecording()
+{
+	fopen_s( &m_recordFile, m_params.recordFilePath.c_str(), "wb" );
+	if ( m_recordFile == nullptr )
+	{
+		g_devConsole->PrintError( Stringf( "Couldn't open '%s' to record a replay, running live", m_params.recordFilePath.c_str() ) );
+		return false;
+	}
+
+	m_recordingBuffer.clear();
+	BufferWriter writer( m_recordingBuffer );
+	writer.AppendUint32( REPLAY_FILE_ID );
+	writer.AppendUint32( REPLAY_FILE_VERSION );
+	writer.AppendUint32( m_sessionSeed );
+	writer.AppendUint32( 0 );								// Number of frames, patched on every flush
+
+	m_mode = eReplayMode::RECORDING;
+	m_frameIdx = 0;
+	m_inputState = InputFrameState();
+	m_lastMouseClientPos = Vec2::ZERO;
+
+	FlushRecording( 0 );
+
+	g_devConsole->PrintString( Stringf( "Recording replay to '%s'", m_params.recordFilePath.c_str() ) );
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::StopRecording()
+{
+	FlushRecording( m_frameIdx );
+
+	fclose( m_recordFile );
+	m_recordFile = nullptr;
+	m_mode = eReplayMode::LIVE;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Writes the buffered frames and patches the frame count in the header to match, so a session
+// that crashes still leaves a playable recording up to the last flush
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::FlushRecording( int numFramesRecorded )
+{
+	bool didWrite = fwrite( m_recordingBuffer.data(), sizeof( byte ), m_recordingBuffer.size(), m_recordFile ) == m_recordingBuffer.size();
+	m_recordingBuffer.clear();
+
+	std::vector<byte> numFramesBuffer;
+	BufferWriter writer( numFramesBuffer );
+	writer.AppendUint32( (uint32_t)numFramesRecorded );
+
+	didWrite = didWrite
+			   && fseek( m_recordFile, REPLAY_NUM_FRAMES_OFFSET, SEEK_SET ) == 0
+			   && fwrite( numFramesBuffer.data(), sizeof( byte ), numFramesBuffer.size(), m_recordFile ) == numFramesBuffer.size()
+			   && fseek( m_recordFile, 0, SEEK_END ) == 0
+			   && fflush( m_recordFile ) == 0;
+	if ( !didWrite )
+	{
+		g_devConsole->PrintError( Stringf( "Couldn't write replay to '%s'", m_params.recordFilePath.c_str() ) );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool ReplaySystem::StartReplay()
+{
+	std::vector<byte> buffer;
+	if ( !FileReadBinaryToBuffer( m_params.replayFilePath, buffer )
+		 || !ParseRecording( buffer ) )
+	{
+		g_devConsole->PrintError( Stringf( "Couldn't load replay '%s', running live", m_params.replayFilePath.c_str() ) );
+		m_replayFrames.clear();
+		return false;
+	}
+
+	m_mode = eReplayMode::REPLAYING;
+	m_frameIdx = 0;
+	m_inputState = InputFrameState();
+	m_replayFrameMilliseconds.clear();
+	m_replayFrameMilliseconds.reserve( m_replayFrames.size() );
+	m_firstDesyncFrameIdx = -1;
+
+	g_devConsole->PrintString( Stringf( "Replaying %i frames from '%s'", (int)m_replayFrames.size(), m_params.replayFilePath.c_str() ) );
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::FinishReplay()
+{
+	ReportReplayTimings();
+
+	m_mode = eReplayMode::LIVE;
+	m_replayFrames.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Input is stored as changes from the last frame, most frames only have the clock time
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::AppendFrameToRecording( const ReplayFrame& frame )
+{
+	byte flags = 0;
+	flags |= frame.keyChanges.empty() ? 0 : FRAME_HAS_KEY_CHANGES;
+	flags |= frame.characters.empty() ? 0 : FRAME_HAS_CHARACTERS;
+	flags |= frame.normalizedMouseClientPos == m_lastMouseClientPos ? 0 : FRAME_HAS_MOUSE_POS;
+	flags |= frame.mouseMovementDelta == Vec2::ZERO ? 0 : FRAME_HAS_MOUSE_DELTA;
+	flags |= frame.mouseWheelScrollAmountDelta == 0.f ? 0 : FRAME_HAS_MOUSE_WHEEL;
+	flags |= frame.externalEvents.empty() ? 0 : FRAME_HAS_EXTERNAL_EVENTS;
+
+	BufferWriter writer( m_recordingBuffer );
+	writer.AppendDouble( frame.deltaSeconds );
+	writer.AppendFloat( frame.frameMilliseconds );
+	writer.AppendUint32( frame.checksum );
+	writer.AppendByte( flags );
+
+	if ( flags & FRAME_HAS_KEY_CHANGES )
+	{
+		writer.AppendUshort( (unsigned short)frame.keyChanges.size() );
+		for ( int keyChangeIdx = 0; keyChangeIdx < (int)frame.keyChanges.size(); ++keyChangeIdx )
+		{
+			const ReplayKeyChange& keyChange = frame.keyChanges[keyChangeIdx];
+			byte keyFlags = 0;
+			keyFlags |= keyChange.keyState.IsPressed() ? KEY_IS_PRESSED : 0;
+			keyFlags |= keyChange.keyState.WasPressedLastFrame() ? KEY_WAS_PRESSED_LAST_FRAME : 0;
+
+			writer.AppendByte( keyChange.keyCode );
+			writer.AppendByte( keyFlags );
+			writer.AppendInt32( keyChange.keyState.GetNumTimesPressed() );
+			writer.AppendInt32( keyChange.keyState.GetNumTimesReleased() );
+		}
+	}
+
+	if ( flags & FRAME_HAS_CHARACTERS )
+	{
+		writer.AppendUshort( (unsigned short)frame.characters.size() );
+		for ( int charIdx = 0; charIdx < (int)frame.characters.size(); ++charIdx )
+		{
+			writer.AppendChar( frame.characters[charIdx] );
+		}
+	}
+
+	if ( flags & FRAME_HAS_MOUSE_POS )
+	{
+		writer.AppendVec2( frame.normalizedMouseClientPos );
+		m_lastMouseClientPos = frame.normalizedMouseClientPos;
+	}
+
+	if ( flags & FRAME_HAS_MOUSE_DELTA )
+	{
+		writer.AppendVec2( frame.mouseMovementDelta );
+	}
+
+	if ( flags & FRAME_HAS_MOUSE_WHEEL )
+	{
+		writer.AppendFloat( frame.mouseWheelScrollAmountDelta );
+	}
+
+	if ( flags & FRAME_HAS_EXTERNAL_EVENTS )
+	{
+		writer.AppendUshort( (unsigned short)frame.externalEvents.size() );
+		for ( int eventIdx = 0; eventIdx < (int)frame.externalEvents.size(); ++eventIdx )
+		{
+			const ReplayExternalEvent& externalEvent = frame.externalEvents[eventIdx];
+			writer.AppendStringZeroTerminated( externalEvent.eventName );
+			writer.AppendUint32( (uint32_t)externalEvent.payload.size() );
+			for ( int byteIdx = 0; byteIdx < (int)externalEvent.payload.size(); ++byteIdx )
+			{
+				writer.AppendByte( externalEvent.payload[byteIdx] );
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool ReplaySystem::ParseRecording( const std::vector<byte>& buffer )
+{
+	if ( buffer.size() < REPLAY_NUM_FRAMES_OFFSET + sizeof( uint32_t ) )
+	{
+		return false;
+	}
+
+	BufferParser parser( buffer );
+	if ( parser.ParseUint32() != REPLAY_FILE_ID
+		 || parser.ParseUint32() != REPLAY_FILE_VERSION )
+	{
+		return false;
+	}
+
+	m_sessionSeed = parser.ParseUint32();
+	int numFrames = (int)parser.ParseUint32();
+
+	m_replayFrames.clear();
+	m_replayFrames.resize( numFrames );
+
+	Vec2 lastMouseClientPos = Vec2::ZERO;
+	for ( int frameIdx = 0; frameIdx < numFrames; ++frameIdx )
+	{
+		ReplayFrame& frame = m_replayFrames[frameIdx];
+		frame.deltaSeconds = parser.ParseDouble();
+		frame.frameMilliseconds = parser.ParseFloat();
+		frame.checksum = parser.ParseUint32();
+		byte flags = parser.ParseByte();
+
+		if ( flags & FRAME_HAS_KEY_CHANGES )
+		{
+			int numKeyChanges = parser.ParseUshort();
+			frame.keyChanges.resize( numKeyChanges );
+			for ( int keyChangeIdx = 0; keyChangeIdx < numKeyChanges; ++keyChangeIdx )
+			{
+				ReplayKeyChange& keyChange = frame.keyChanges[keyChangeIdx];
+				keyChange.keyCode = parser.ParseByte();
+				byte keyFlags = parser.ParseByte();
+				int numTimesPressed = parser.ParseInt32();
+				int numTimesReleased = parser.ParseInt32();
+				keyChange.keyState.SetState( ( keyFlags & KEY_IS_PRESSED ) != 0, ( keyFlags & KEY_WAS_PRESSED_LAST_FRAME ) != 0, numTimesPressed, numTimesReleased );
+			}
+		}
+
+		if ( flags & FRAME_HAS_CHARACTERS )
+		{
+			int numCharacters = parser.ParseUshort();
+			for ( int charIdx = 0; charIdx < numCharacters; ++charIdx )
+			{
+				frame.characters.push_back( parser.ParseChar() );
+			}
+		}
+
+		if ( flags & FRAME_HAS_MOUSE_POS )
+		{
+			lastMouseClientPos = parser.ParseVec2();
+		}
+		frame.normalizedMouseClientPos = lastMouseClientPos;
+
+		if ( flags & FRAME_HAS_MOUSE_DELTA )
+		{
+			frame.mouseMovementDelta = parser.ParseVec2();
+		}
+
+		if ( flags & FRAME_HAS_MOUSE_WHEEL )
+		{
+			frame.mouseWheelScrollAmountDelta = parser.ParseFloat();
+		}
+
+		if ( flags & FRAME_HAS_EXTERNAL_EVENTS )
+		{
+			int numExternalEvents = parser.ParseUshort();
+			frame.externalEvents.resize( numExternalEvents );
+			for ( int eventIdx = 0; eventIdx < numExternalEvents; ++eventIdx )
+			{
+				ReplayExternalEvent& externalEvent = frame.externalEvents[eventIdx];
+				parser.ParseStringZeroTerminated( externalEvent.eventName );
+
+				int payloadSize = (int)parser.ParseUint32();
+				externalEvent.payload.resize( payloadSize );
+				for ( int byteIdx = 0; byteIdx < payloadSize; ++byteIdx )
+				{
+					externalEvent.payload[byteIdx] = parser.ParseByte();
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::ReportReplayTimings()
+{
+	std::vector<float> baselineFrameMilliseconds;
+	bool hasBaselineFile = !m_params.baselineTimingsFilePath.empty()
+							&& LoadBaselineTimings( baselineFrameMilliseconds );
+	if ( !hasBaselineFile )
+	{
+		for ( int frameIdx = 0; frameIdx < (int)m_replayFrames.size(); ++frameIdx )
+		{
+			baselineFrameMilliseconds.push_back( m_replayFrames[frameIdx].frameMilliseconds );
+		}
+	}
+
+	int numFrames = (int)std::min( baselineFrameMilliseconds.size(), m_replayFrameMilliseconds.size() );
+	if ( numFrames == 0 )
+	{
+		return;
+	}
+
+	baselineFrameMilliseconds.resize( numFrames );
+	std::vector<float> replayFrameMilliseconds( m_replayFrameMilliseconds.begin(), m_replayFrameMilliseconds.begin() + numFrames );
+
+	double baselineTotalMilliseconds = 0.0;
+	double replayTotalMilliseconds = 0.0;
+	std::vector<int> frameIndicesBySlowdown( numFrames );
+	for ( int frameIdx = 0; frameIdx < numFrames; ++frameIdx )
+	{
+		baselineTotalMilliseconds += baselineFrameMilliseconds[frameIdx];
+		replayTotalMilliseconds += replayFrameMilliseconds[frameIdx];
+		frameIndicesBySlowdown[frameIdx] = frameIdx;
+	}
+
+	std::sort( frameIndicesBySlowdown.begin(), frameIndicesBySlowdown.end(), [&]( int frameIdxA, int frameIdxB )
+	{
+		return replayFrameMilliseconds[frameIdxA] - baselineFrameMilliseconds[frameIdxA]
+			 > replayFrameMilliseconds[frameIdxB] - baselineFrameMilliseconds[frameIdxB];
+	} );
+
+	std::vector<float> sortedBaselineMilliseconds = baselineFrameMilliseconds;
+	std::vector<float> sortedReplayMilliseconds = replayFrameMilliseconds;
+	std::sort( sortedBaselineMilliseconds.begin(), sortedBaselineMilliseconds.end() );
+	std::sort( sortedReplayMilliseconds.begin(), sortedReplayMilliseconds.end() );
+	int percentile99Idx = ( numFrames * 99 ) / 100;
+
+	g_devConsole->PrintString( Stringf( "Replayed %i frames, compared to %s", numFrames, hasBaselineFile ? m_params.baselineTimingsFilePath.c_str() : "the recording" ) );
+	g_devConsole->PrintString( Stringf( "  Total: %.2f ms vs %.2f ms", replayTotalMilliseconds, baselineTotalMilliseconds ) );
+	g_devConsole->PrintString( Stringf( "  Mean: %.3f ms vs %.3f ms", replayTotalMilliseconds / (double)numFrames, baselineTotalMilliseconds / (double)numFrames ) );
+	g_devConsole->PrintString( Stringf( "  99th percentile: %.3f ms vs %.3f ms", sortedReplayMilliseconds[percentile99Idx], sortedBaselineMilliseconds[percentile99Idx] ) );
+	g_devConsole->PrintString( Stringf( "  Max: %.3f ms vs %.3f ms", sortedReplayMilliseconds[numFrames - 1], sortedBaselineMilliseconds[numFrames - 1] ) );
+
+	int numWorstFrames = std::min( numFrames, NUM_WORST_FRAMES_TO_REPORT );
+	for ( int worstFrameNum = 0; worstFrameNum < numWorstFrames; ++worstFrameNum )
+	{
+		int frameIdx = frameIndicesBySlowdown[worstFrameNum];
+		g_devConsole->PrintString( Stringf( "  Frame %i: %.3f ms vs %.3f ms", frameIdx, replayFrameMilliseconds[frameIdx], baselineFrameMilliseconds[frameIdx] ) );
+	}
+
+	if ( m_firstDesyncFrameIdx != -1 )
+	{
+		g_devConsole->PrintError( Stringf( "  Desynced from frame %i on, timings after that aren't comparable", m_firstDesyncFrameIdx ) );
+	}
+
+	if ( !m_params.timingsFilePath.empty() )
+	{
+		std::string timingsCsv = "frame,baselineMs,replayMs,diffMs\n";
+		for ( int frameIdx = 0; frameIdx < numFrames; ++frameIdx )
+		{
+			timingsCsv += Stringf( "%i,%.4f,%.4f,%.4f\n", frameIdx, baselineFrameMilliseconds[frameIdx], replayFrameMilliseconds[frameIdx],
+								   replayFrameMilliseconds[frameIdx] - baselineFrameMilliseconds[frameIdx] );
+		}
+
+		if ( !WriteBufferToFile( m_params.timingsFilePath, (byte*)timingsCsv.data(), (uint32_t)timingsCsv.size() ) )
+		{
+			g_devConsole->PrintError( Stringf( "Couldn't write replay timings to '%s'", m_params.timingsFilePath.c_str() ) );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads the replayMs column of a timings csv written by an earlier replay
+//-----------------------------------------------------------------------------------------------
+bool ReplaySystem::LoadBaselineTimings( std::vector<float>& out_frameMilliseconds ) const
+{
+	Strings lines = SplitFileIntoLines( m_params.baselineTimingsFilePath );
+	for ( int lineIdx = 1; lineIdx < (int)lines.size(); ++lineIdx )
+	{
+		Strings columns = SplitStringOnDelimiter( lines[lineIdx], ',' );
+		if ( columns.size() < 3 )
+		{
+			continue;
+		}
+
+		out_frameMilliseconds.push_back( (float)atof( columns[2].c_str() ) );
+	}
+
+	if ( out_frameMilliseconds.empty() )
+	{
+		g_devConsole->PrintError( Stringf( "Couldn't read baseline timings from '%s', comparing to the recording", m_params.baselineTimingsFilePath.c_str() ) );
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ReplaySystem::FireExternalEvents( const std::vector<ReplayExternalEvent>& externalEvents ) const
+{
+	for ( int eventIdx = 0; eventIdx < (int)externalEvents.size(); ++eventIdx )
+	{
+		const ReplayExternalEvent& externalEvent = externalEvents[eventIdx];
+
+		EventArgs args;
+		args.SetValue( "payload", std::string( externalEvent.payload.begin(), externalEvent.payload.end() ) );
+		g_eventSystem->FireEvent( externalEvent.eventName, &args, eUsageLocation::EVERYWHERE );
+	}
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Input/InputSystem.hpp"
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+struct ReplaySystemParams
+{
+	InputSystem* inputSystem = nullptr;
+	unsigned int seed = 0;								// Handed out by GetSessionSeed while live or recording
+
+	std::string recordFilePath;							// Records the whole session, streamed to the file as it runs
+	std::string replayFilePath;							// Plays a recording back from the first frame, wins over recording
+	bool isHeadless = false;							// No rendering, quits after the last replayed frame
+	std::string timingsFilePath;						// Per frame csv of baseline and replay times, written when the replay ends
+	std::string baselineTimingsFilePath;				// Timings csv from an earlier replay to compare against, defaults to the recorded times
+};
+
+
+//-----------------------------------------------------------------------------------------------
+enum class eReplayMode
+{
+	LIVE,
+	RECORDING,
+	REPLAYING,
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct ReplayExternalEvent
+{
+public:
+	std::string eventName;
+	std::vector<byte> payload;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct ReplayKeyChange
+{
+public:
+	byte keyCode = 0;
+	KeyButtonState keyState;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct ReplayFrame
+{
+public:
+	double deltaSeconds = 0.0;							// Unscaled master clock time
+	float frameMilliseconds = 0.f;						// Time spent between BeginFrame and EndFrame
+	uint32_t checksum = 0;
+	std::vector<ReplayKeyChange> keyChanges;			// Only keys that changed since the last frame
+	std::string characters;
+	Vec2 normalizedMouseClientPos = Vec2::ZERO;
+	Vec2 mouseMovementDelta = Vec2::ZERO;
+	float mouseWheelScrollAmountDelta = 0.f;
+	std::vector<ReplayExternalEvent> externalEvents;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Records everything that reaches the simulation from outside, per frame: master clock time,
+// keyboard and mouse state, the session seed and queued external events. Given the same start
+// the simulation only depends on those, so a replay rebuilds the session frame for frame, and
+// headless replays run as fast as the frames simulate, which makes them repeatable benchmarks.
+//
+// Frame order:
+//		ReplaySystem::BeginFrame()		in place of Clock::MasterBeginFrame()
+//		InputSystem::BeginFrame()
+//		ReplaySystem::UpdateInput()		saves or restores input and fires external events
+//		... game update, AddToFrameChecksum() ...
+//		ReplaySystem::EndFrame()		after every other system's EndFrame
+//-----------------------------------------------------------------------------------------------
+class ReplaySystem
+{
+public:
+	void Startup( const ReplaySystemParams& params );
+	void Shutdown();
+
+	void BeginFrame();
+	void UpdateInput();
+	void EndFrame();
+
+	eReplayMode		GetMode() const													{ return m_mode; }
+	bool			IsRecording() const												{ return m_mode == eReplayMode::RECORDING; }
+	bool			IsReplaying() const												{ return m_mode == eReplayMode::REPLAYING; }
+	bool			IsHeadless() const												{ return m_mode == eReplayMode::REPLAYING && m_params.isHeadless; }
+	int				GetFrameIndex() const											{ return m_frameIdx; }
+
+	// Seed everything random from this, replays give back the recorded one
+	unsigned int	GetSessionSeed() const											{ return m_sessionSeed; }
+
+	// Anything that reaches the simulation from outside, like network packets, should come through
+	// here instead of firing directly. Queued events fire during the next UpdateInput with the bytes
+	// in a "payload" string arg, replays drop live events and fire the recorded ones instead. Safe
+	// to call from any thread
+	void			QueueExternalEvent( const std::string& eventName, const std::vector<byte>& payload );
+
+	// Hash of simulation state for this frame, replays report the first frame that differs
+	void			AddToFrameChecksum( const void* data, size_t dataSize );
+
+private:
+	bool StartRecording();
+	void StopRecording();
+	bool StartReplay();
+	void FinishReplay();
+
+	void AppendFrameToRecording( const ReplayFrame& frame );
+	void FlushRecording( int numFramesRecorded );
+	bool ParseRecording( const std::vector<byte>& buffer );
+	void ReportReplayTimings();
+	bool LoadBaselineTimings( std::vector<float>& out_frameMilliseconds ) const;
+
+	void FireExternalEvents( const std::vector<ReplayExternalEvent>& externalEvents ) const;
+
+private:
+	ReplaySystemParams m_params;
+	eReplayMode m_mode = eReplayMode::LIVE;
+	unsigned int m_sessionSeed = 0;
+	int m_frameIdx = 0;
+
+	ReplayFrame m_curFrame;
+	double m_frameStartSeconds = 0.0;
+	InputFrameState m_inputState;						// Last recorded state, or the state rebuilt from the replay
+
+	FILE* m_recordFile = nullptr;
+	std::vector<byte> m_recordingBuffer;				// Frames not yet written to the file
+	Vec2 m_lastMouseClientPos = Vec2::ZERO;				// Last position written, the mouse is only saved when it moves
+
+	std::vector<ReplayFrame> m_replayFrames;
+	std::vector<float> m_replayFrameMilliseconds;
+	int m_firstDesyncFrameIdx = -1;
+
+	std::mutex m_externalEventsMutex;
+	std::vector<ReplayExternalEvent> m_queuedExternalEvents;
+};
@@ -1,4 +1,5 @@
 #include "Vertex_PCU.hpp"
+#include "Engine/Math/BatchTransform.hpp"
 #include "Engine/Math/MathUtils.hpp"
 
 
@@ -48,22 +49,18 @@ void Vertex_PCU::TransformVertexArray( Vertex_PCU* vertexArray, int vertexCount,
 		return;
 	}
 
-	for ( int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
-	{
-		Vertex_PCU& vertex = vertexArray[vertexIndex];
-		Vec2 vertexXY( vertex.m_position.x, vertex.m_position.y );
-		
-		Vec2 newPos = TransformPosition2D( vertexXY, uniformScale, orientationDegrees, translation );
-		
-		vertex.m_position.x = newPos.x;
-		vertex.m_position.y = newPos.y;
-	}
+	TransformPositionsXYBatch( uniformScale, orientationDegrees, translation, (byte*)&vertexArray[0].m_position, vertexCount, sizeof( Vertex_PCU ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Vertex_PCU::TransformVertexArray( std::vector<Vertex_PCU>& vertices, float uniformScale, float orientationDegrees, const Vec2& translation )
 {
+	if ( vertices.empty() )
+	{
+		return;
+	}
+
 	TransformVertexArray( &vertices[0], (int)vertices.size(), uniformScale, orientationDegrees, translation );
 }
 
@@ -76,22 +73,17 @@ void Vertex_PCU::TransformVertexArray( Vertex_PCU* vertexArray, int vertexCount,
 		return;
 	}
 
-	for ( int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
-	{
-		Vertex_PCU& vertex = vertexArray[vertexIndex];
-		Vec3 vertexXYZ( vertex.m_position.x, vertex.m_position.y, vertex.m_position.z );
-
-		Vec3 newPos = TransformPosition3DWithXYRotation( vertexXYZ, uniformScale, orientationDegrees, translation );
-
-		vertex.m_position.x = newPos.x;
-		vertex.m_position.y = newPos.y;
-		vertex.m_position.z = newPos.z;
-	}
+	TransformPositions3DWithXYRotationBatch( uniformScale, orientationDegrees, translation, (byte*)&vertexArray[0].m_position, vertexCount, sizeof( Vertex_PCU ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Vertex_PCU::TransformVertexArray( std::vector<Vertex_PCU>& vertices, float uniformScale, float orientationDegrees, const Vec3& translation )
 {
+	if ( vertices.empty() )
+	{
+		return;
+	}
+
 	TransformVertexArray( &vertices[0], (int)vertices.size(), uniformScale, orientationDegrees, translation );
 }
\ No newline at end of file
@@ -2,34 +2,122 @@
 
 
 //-----------------------------------------------------------------------------------------------
-EntityId Entity::s_nextEntityId = 1000;
-std::map<EntityId, std::string> Entity::s_entityNames;
+std::vector<Entity::IdSlot> Entity::s_idSlots;
+int Entity::s_firstFreeSlotIdx = -1;
+int Entity::s_lastFreeSlotIdx = -1;
 
 
 //-----------------------------------------------------------------------------------------------
 Entity::Entity()
 {
-	m_id = s_nextEntityId++;
-	s_entityNames[m_id] = "Unknown";
+	m_id = AllocateId();
+	s_idSlots[GetSlotIndex( m_id )].name = "Unknown";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Entity::~Entity()
+{
+	FreeId( m_id );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 std::string Entity::GetName() const
 {
-	return s_entityNames[m_id];
+	return GetName( m_id );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 std::string Entity::GetName( const EntityId& id )
 {
-	return s_entityNames[id];
+	if ( !IsAlive( id ) )
+	{
+		return "";
+	}
+
+	return s_idSlots[GetSlotIndex( id )].name;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::SetName( const std::string& name )
 {
-	s_entityNames[m_id] = name;
+	s_idSlots[GetSlotIndex( m_id )].name = name;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool Entity::IsAlive( const EntityId& id )
+{
+	if ( id < 0 )
+	{
+		return false;
+	}
+
+	int slotIdx = GetSlotIndex( id );
+	if ( slotIdx >= (int)s_idSlots.size() )
+	{
+		return false;
+	}
+
+	const IdSlot& slot = s_idSlots[slotIdx];
+	return slot.isInUse
+		&& slot.generation == ( id >> ENTITY_ID_SLOT_BITS );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+EntityId Entity::AllocateId()
+{
+	int slotIdx = s_firstFreeSlotIdx;
+	if ( slotIdx != -1 )
+	{
+		s_firstFreeSlotIdx = s_idSlots[slotIdx].nextFreeSlotIdx;
+		if ( s_firstFreeSlotIdx == -1 )
+		{
+			s_lastFreeSlotIdx = -1;
+		}
+	}
+	else
+	{
+		slotIdx = (int)s_idSlots.size();
+		GUARANTEE_OR_DIE( slotIdx <= ENTITY_ID_SLOT_MASK, "Ran out of entity id slots" );
+
+		s_idSlots.emplace_back();
+	}
+
+	IdSlot& slot = s_idSlots[slotIdx];
+	slot.generation = slot.generation >= ENTITY_ID_MAX_GENERATION ? 1 : slot.generation + 1;
+	slot.nextFreeSlotIdx = -1;
+	slot.isInUse = true;
+
+	return ( slot.generation << ENTITY_ID_SLOT_BITS ) | slotIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Entity::FreeId( const EntityId& id )
+{
+	if ( !IsAlive( id ) )
+	{
+		return;
+	}
+
+	int slotIdx = GetSlotIndex( id );
+	IdSlot& slot = s_idSlots[slotIdx];
+	slot.isInUse = false;
+	slot.name.clear();
+
+	if ( s_lastFreeSlotIdx == -1 )
+	{
+		s_firstFreeSlotIdx = slotIdx;
+	}
+	else
+	{
+		s_idSlots[s_lastFreeSlotIdx].nextFreeSlotIdx = slotIdx;
+	}
+
+	s_lastFreeSlotIdx = slotIdx;
 }
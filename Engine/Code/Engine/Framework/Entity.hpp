@@ -2,22 +2,48 @@
 #include "Engine/Core/EngineCommon.hpp"
 
 
+//-----------------------------------------------------------------------------------------------
+// The low bits of an id are a slot that's reused once the entity is destroyed, the high bits are
+// the slot's generation so an id kept after its entity dies never finds whatever reused the slot
+constexpr int ENTITY_ID_SLOT_BITS = 20;
+constexpr int ENTITY_ID_SLOT_MASK = ( 1 << ENTITY_ID_SLOT_BITS ) - 1;
+constexpr int ENTITY_ID_MAX_GENERATION = ( 1 << ( 31 - ENTITY_ID_SLOT_BITS ) ) - 1;
+
+
 //-----------------------------------------------------------------------------------------------
 class Entity
 {
 public:
 	Entity();
+	virtual ~Entity();
 
 	EntityId	GetId() const { return m_id; }
 	std::string	GetName() const;
 	void		SetName( const std::string& name );
 
 	static std::string GetName( const EntityId& id );
+	static bool IsAlive( const EntityId& id );
+	static int GetSlotIndex( const EntityId& id )							{ return id & ENTITY_ID_SLOT_MASK; }
+	static int GetNumSlots()												{ return (int)s_idSlots.size(); }
 
 protected:
 	EntityId		m_id = INVALID_ENTITY_ID;
 
+private:
+	static EntityId AllocateId();
+	static void FreeId( const EntityId& id );
+
+private:
+	struct IdSlot
+	{
+		int generation = 0;
+		int nextFreeSlotIdx = -1;
+		bool isInUse = false;
+		std::string name;
+	};
+
 	// Statics
-	static EntityId	s_nextEntityId;
-	static std::map<EntityId, std::string> s_entityNames;
+	static std::vector<IdSlot> s_idSlots;
+	static int s_firstFreeSlotIdx;						// Freed slots queue up at the back so generations wrap as late as possible
+	static int s_lastFreeSlotIdx;
 };
@@ -0,0 +1,100 @@
+#include "Engine/Framework/EntityCommandBuffer.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+EntityCommandBuffer::~EntityCommandBuffer()
+{
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityCommandBuffer::Spawn( EntityId spawnerId, const std::string& entityType, const Vec3& position, float yawDegrees )
+{
+	EntityCommand command;
+	command.type = eEntityCommandType::SPAWN;
+	command.entityId = spawnerId;
+	command.name = entityType;
+	command.position = position;
+	command.value = yawDegrees;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityCommandBuffer::Die( EntityId entityId )
+{
+	EntityCommand command;
+	command.type = eEntityCommandType::DIE;
+	command.entityId = entityId;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityCommandBuffer::Warp( EntityId entityId, const std::string& mapName, const Vec3& position, float yawDegrees )
+{
+	EntityCommand command;
+	command.type = eEntityCommandType::WARP;
+	command.entityId = entityId;
+	command.name = mapName;
+	command.position = position;
+	command.value = yawDegrees;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityCommandBuffer::Damage( EntityId entityId, float damage, const std::string& damageType, EntityId sourceId )
+{
+	EntityCommand command;
+	command.type = eEntityCommandType::DAMAGE;
+	command.entityId = entityId;
+	command.otherEntityId = sourceId;
+	command.name = damageType;
+	command.value = damage;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityCommandBuffer::MoveToInventory( EntityId itemId, EntityId ownerId )
+{
+	EntityCommand command;
+	command.type = eEntityCommandType::MOVE_TO_INVENTORY;
+	command.entityId = itemId;
+	command.otherEntityId = ownerId;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+EventArgs* EntityCommandBuffer::FireEvent( EntityId entityId, const std::string& eventName )
+{
+	EntityCommand command;
+	command.type = eEntityCommandType::FIRE_EVENT;
+	command.entityId = entityId;
+	command.name = eventName;
+	command.eventArgs = new EventArgs();
+
+	m_commands.push_back( command );
+	return command.eventArgs;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityCommandBuffer::Clear()
+{
+	for ( int commandIdx = 0; commandIdx < (int)m_commands.size(); ++commandIdx )
+	{
+		PTR_SAFE_DELETE( m_commands[commandIdx].eventArgs );
+	}
+
+	m_commands.clear();
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+enum class eEntityCommandType
+{
+	SPAWN,
+	DIE,
+	WARP,
+	DAMAGE,
+	FIRE_EVENT,
+	MOVE_TO_INVENTORY,
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct EntityCommand
+{
+public:
+	eEntityCommandType type = eEntityCommandType::FIRE_EVENT;
+	EntityId entityId = INVALID_ENTITY_ID;				// Entity the command acts on, the spawner for a spawn
+	EntityId otherEntityId = INVALID_ENTITY_ID;			// Damage source or inventory owner
+	std::string name;									// Entity type, destination map, damage type or event name
+	Vec3 position = Vec3::ZERO;
+	float value = 0.f;									// Spawn or warp yaw, damage amount
+	EventArgs* eventArgs = nullptr;						// Owned by the buffer
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Changes an entity can't make while other entities update beside it. Each update job records
+// into its own buffer and the game applies them all at the sync point after the jobs finish
+//-----------------------------------------------------------------------------------------------
+class EntityCommandBuffer
+{
+public:
+	EntityCommandBuffer() = default;
+	~EntityCommandBuffer();
+
+	EntityCommandBuffer( const EntityCommandBuffer& other ) = delete;
+	EntityCommandBuffer& operator=( const EntityCommandBuffer& other ) = delete;
+
+	void		Spawn( EntityId spawnerId, const std::string& entityType, const Vec3& position, float yawDegrees );
+	void		Die( EntityId entityId );
+	void		Warp( EntityId entityId, const std::string& mapName, const Vec3& position, float yawDegrees );
+	void		Damage( EntityId entityId, float damage, const std::string& damageType, EntityId sourceId = INVALID_ENTITY_ID );
+	void		MoveToInventory( EntityId itemId, EntityId ownerId );
+
+	// Fill in the returned args before the buffer is applied, an invalid id fires a global event
+	EventArgs*	FireEvent( EntityId entityId, const std::string& eventName );
+
+	const std::vector<EntityCommand>& GetCommands() const						{ return m_commands; }
+	int			GetNumCommands() const											{ return (int)m_commands.size(); }
+	bool		IsEmpty() const													{ return m_commands.empty(); }
+	void		Clear();
+
+private:
+	std::vector<EntityCommand> m_commands;
+};
@@ -0,0 +1,148 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Framework/Entity.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Packed list of entities with lookup by id through the id's slot. Removing swaps the last entity
+// into the hole, so loops never walk over dead space but the order isn't kept. Doesn't own the
+// entities, deleting them is up to the caller
+//-----------------------------------------------------------------------------------------------
+template <typename EntityType>
+class EntityStore
+{
+public:
+	void			Add( EntityType* entity );
+	bool			Remove( EntityType* entity );
+	void			RemoveAtIndex( int entityIdx );
+	void			Clear();
+
+	EntityType*		GetById( EntityId id ) const;
+	int				GetIndexOf( EntityId id ) const;
+	bool			Contains( EntityId id ) const								{ return GetIndexOf( id ) != -1; }
+
+	int				GetCount() const											{ return (int)m_entities.size(); }
+	bool			IsEmpty() const												{ return m_entities.empty(); }
+	EntityType*		operator[]( int entityIdx ) const							{ return m_entities[entityIdx]; }
+
+	typename std::vector<EntityType*>::const_iterator begin() const				{ return m_entities.begin(); }
+	typename std::vector<EntityType*>::const_iterator end() const				{ return m_entities.end(); }
+
+private:
+	std::vector<EntityType*> m_entities;
+	std::vector<int> m_entityIdxesBySlot;						// -1 for slots not in this store
+};
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename EntityType>
+void EntityStore<EntityType>::Add( EntityType* entity )
+{
+	GUARANTEE_OR_DIE( entity != nullptr, "Tried to add a null entity to an entity store" );
+
+	EntityId id = entity->GetId();
+	if ( Contains( id ) )
+	{
+		return;
+	}
+
+	int slotIdx = Entity::GetSlotIndex( id );
+	if ( slotIdx >= (int)m_entityIdxesBySlot.size() )
+	{
+		m_entityIdxesBySlot.resize( Entity::GetNumSlots(), -1 );
+	}
+
+	m_entityIdxesBySlot[slotIdx] = (int)m_entities.size();
+	m_entities.push_back( entity );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename EntityType>
+bool EntityStore<EntityType>::Remove( EntityType* entity )
+{
+	if ( entity == nullptr )
+	{
+		return false;
+	}
+
+	int entityIdx = GetIndexOf( entity->GetId() );
+	if ( entityIdx == -1 )
+	{
+		return false;
+	}
+
+	RemoveAtIndex( entityIdx );
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename EntityType>
+void EntityStore<EntityType>::RemoveAtIndex( int entityIdx )
+{
+	int lastEntityIdx = (int)m_entities.size() - 1;
+
+	m_entityIdxesBySlot[Entity::GetSlotIndex( m_entities[entityIdx]->GetId() )] = -1;
+
+	if ( entityIdx != lastEntityIdx )
+	{
+		m_entities[entityIdx] = m_entities[lastEntityIdx];
+		m_entityIdxesBySlot[Entity::GetSlotIndex( m_entities[entityIdx]->GetId() )] = entityIdx;
+	}
+
+	m_entities.pop_back();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename EntityType>
+void EntityStore<EntityType>::Clear()
+{
+	m_entities.clear();
+	m_entityIdxesBySlot.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename EntityType>
+EntityType* EntityStore<EntityType>::GetById( EntityId id ) const
+{
+	int entityIdx = GetIndexOf( id );
+	if ( entityIdx == -1 )
+	{
+		return nullptr;
+	}
+
+	return m_entities[entityIdx];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// The slot can be reused by a newer entity, so the full id still has to match
+//-----------------------------------------------------------------------------------------------
+template <typename EntityType>
+int EntityStore<EntityType>::GetIndexOf( EntityId id ) const
+{
+	if ( id < 0 )
+	{
+		return -1;
+	}
+
+	int slotIdx = Entity::GetSlotIndex( id );
+	if ( slotIdx >= (int)m_entityIdxesBySlot.size() )
+	{
+		return -1;
+	}
+
+	int entityIdx = m_entityIdxesBySlot[slotIdx];
+	if ( entityIdx == -1
+		 || m_entities[entityIdx]->GetId() != id )
+	{
+		return -1;
+	}
+
+	return entityIdx;
+}
@@ -0,0 +1,371 @@
+#include "Engine/Framework/EntityUpdateStage.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/HashUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Framework/Entity.hpp"
+#include "Engine/Framework/EntityStore.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Time/Time.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+// EntityUpdateStage
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+EntityUpdateStage::~EntityUpdateStage()
+{
+	PTR_VECTOR_SAFE_DELETE( m_commandBuffers );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityUpdateStage::RunRanges( EntityUpdateRangeFn updateRange, const void* entities, int numEntities, float deltaSeconds )
+{
+	ClearCommands();
+
+	double startTime = GetCurrentTimeSeconds();
+
+	int numChunks = GetNumChunks( numEntities );
+	while ( (int)m_commandBuffers.size() < numChunks )
+	{
+		m_commandBuffers.push_back( new EntityCommandBuffer() );
+	}
+	m_numUsedCommandBuffers = numChunks;
+
+	if ( numChunks == 1 )
+	{
+		updateRange( entities, 0, numEntities, deltaSeconds, *m_commandBuffers[0] );
+	}
+	else
+	{
+		g_jobSystem->ParallelFor( numEntities, numChunks, [&]( int chunkIdx, int firstEntityIdx, int endEntityIdx )
+		{
+			updateRange( entities, firstEntityIdx, endEntityIdx, deltaSeconds, *m_commandBuffers[chunkIdx] );
+		} );
+	}
+
+	m_stats.numEntities = numEntities;
+	m_stats.numChunks = numChunks;
+	m_stats.numCommands = 0;
+	for ( int bufferIdx = 0; bufferIdx < m_numUsedCommandBuffers; ++bufferIdx )
+	{
+		m_stats.numCommands += m_commandBuffers[bufferIdx]->GetNumCommands();
+	}
+	m_stats.updateMs = ( GetCurrentTimeSeconds() - startTime ) * 1000.0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void EntityUpdateStage::ClearCommands()
+{
+	for ( int bufferIdx = 0; bufferIdx < m_numUsedCommandBuffers; ++bufferIdx )
+	{
+		m_commandBuffers[bufferIdx]->Clear();
+	}
+
+	m_numUsedCommandBuffers = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int EntityUpdateStage::GetNumChunks( int numEntities ) const
+{
+	if ( !m_isParallelEnabled
+		 || g_jobSystem == nullptr
+		 || g_jobSystem->GetNumWorkerThreads() == 0 )
+	{
+		return 1;
+	}
+
+	return g_jobSystem->GetNumParallelForRanges( numEntities, m_minEntitiesPerJob );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Determinism check
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+// Stand in entity that does a little steering math and rolls every kind of command from noise
+// keyed on its serial number, so two worlds built the same way stay the same if the stage is right
+//-----------------------------------------------------------------------------------------------
+class UpdateTestEntity : public Entity
+{
+public:
+	UpdateTestEntity( int serialNum, EntityId targetId, const Vec3& position )
+		: m_serialNum( serialNum )
+		, m_targetId( targetId )
+		, m_position( position )
+	{
+		m_velocity = Vec3( Get1dNoiseZeroToOne( serialNum, 1 ) - .5f, Get1dNoiseZeroToOne( serialNum, 2 ) - .5f, 0.f ) * 8.f;
+	}
+
+	void UpdateInParallel( float deltaSeconds, EntityCommandBuffer& commands )
+	{
+		++m_numUpdates;
+		if ( m_ownerSerialNum != -1 )
+		{
+			return;
+		}
+
+		// Enough work per entity that splitting it up is worth measuring
+		Vec3 steering = Vec3::ZERO;
+		for ( int sampleIdx = 0; sampleIdx < 16; ++sampleIdx )
+		{
+			float angle = (float)( m_numUpdates + sampleIdx ) * .37f + (float)m_serialNum;
+			steering += Vec3( cosf( angle ), sinf( angle ), 0.f ) * ( 1.f / (float)( sampleIdx + 1 ) );
+		}
+
+		m_velocity += steering * deltaSeconds;
+		m_position += m_velocity * deltaSeconds;
+		if ( fabsf( m_position.x ) > 100.f ) { m_velocity.x = -m_velocity.x; }
+		if ( fabsf( m_position.y ) > 100.f ) { m_velocity.y = -m_velocity.y; }
+
+		uint roll = Get2dNoiseUint( m_serialNum, m_numUpdates, 7 ) % 1024;
+		if ( roll < 16 )
+		{
+			commands.Spawn( m_id, "UpdateTestEntity", m_position, 0.f );
+		}
+		else if ( roll < 48 )
+		{
+			commands.Damage( m_targetId, 10.f, "test", m_id );
+		}
+		else if ( roll < 112 )
+		{
+			EventArgs* args = commands.FireEvent( m_targetId, "OnPing" );
+			args->SetValue( "amount", m_serialNum % 5 + 1 );
+		}
+		else if ( roll < 116 )
+		{
+			commands.Warp( m_id, "other", -m_position, 0.f );
+		}
+		else if ( roll < 120 )
+		{
+			commands.MoveToInventory( m_id, m_targetId );
+		}
+		else if ( roll < 124 )
+		{
+			commands.Die( m_id );
+		}
+	}
+
+public:
+	int m_serialNum = 0;
+	EntityId m_targetId = INVALID_ENTITY_ID;
+	Vec3 m_position = Vec3::ZERO;
+	Vec3 m_velocity = Vec3::ZERO;
+	float m_health = 100.f;
+	bool m_isDead = false;
+	int m_numUpdates = 0;
+	int m_numEventsReceived = 0;
+	int m_mapIdx = 0;
+	int m_ownerSerialNum = -1;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+class UpdateTestWorld
+{
+public:
+	UpdateTestWorld( int numEntities, int maxEntities )
+		: m_maxEntities( maxEntities )
+	{
+		for ( int entityIdx = 0; entityIdx < numEntities; ++entityIdx )
+		{
+			Vec3 position( Get1dNoiseZeroToOne( entityIdx, 3 ) * 200.f - 100.f, Get1dNoiseZeroToOne( entityIdx, 4 ) * 200.f - 100.f, 0.f );
+			EntityId targetId = m_entities.IsEmpty() ? INVALID_ENTITY_ID : m_entities[m_entities.GetCount() - 1]->GetId();
+			m_entities.Add( new UpdateTestEntity( m_nextSerialNum++, targetId, position ) );
+		}
+	}
+
+	~UpdateTestWorld()
+	{
+		for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
+		{
+			UpdateTestEntity* entity = m_entities[entityIdx];
+			PTR_SAFE_DELETE( entity );
+		}
+	}
+
+	void Update( EntityUpdateStage& stage, float deltaSeconds )
+	{
+		stage.Run( m_entities, m_entities.GetCount(), deltaSeconds );
+
+		// Sync point
+		for ( int bufferIdx = 0; bufferIdx < stage.GetNumCommandBuffers(); ++bufferIdx )
+		{
+			const std::vector<EntityCommand>& commands = stage.GetCommandBuffer( bufferIdx ).GetCommands();
+			for ( int commandIdx = 0; commandIdx < (int)commands.size(); ++commandIdx )
+			{
+				ApplyCommand( commands[commandIdx] );
+			}
+		}
+		stage.ClearCommands();
+
+		for ( int entityIdx = m_entities.GetCount() - 1; entityIdx >= 0; --entityIdx )
+		{
+			UpdateTestEntity* entity = m_entities[entityIdx];
+			if ( entity->m_isDead )
+			{
+				m_entities.RemoveAtIndex( entityIdx );
+				PTR_SAFE_DELETE( entity );
+			}
+		}
+	}
+
+	void ApplyCommand( const EntityCommand& command )
+	{
+		++m_numCommandsApplied;
+
+		UpdateTestEntity* entity = m_entities.GetById( command.entityId );
+		UpdateTestEntity* otherEntity = m_entities.GetById( command.otherEntityId );
+		switch ( command.type )
+		{
+			case eEntityCommandType::SPAWN:
+			{
+				if ( m_entities.GetCount() < m_maxEntities )
+				{
+					m_entities.Add( new UpdateTestEntity( m_nextSerialNum++, command.entityId, command.position ) );
+				}
+			}
+			break;
+
+			case eEntityCommandType::DIE:
+			{
+				if ( entity != nullptr ) { entity->m_isDead = true; }
+			}
+			break;
+
+			case eEntityCommandType::WARP:
+			{
+				if ( entity != nullptr )
+				{
+					entity->m_position = command.position;
+					entity->m_mapIdx = 1 - entity->m_mapIdx;
+				}
+			}
+			break;
+
+			case eEntityCommandType::DAMAGE:
+			{
+				if ( entity != nullptr )
+				{
+					entity->m_health -= command.value;
+					entity->m_isDead = entity->m_isDead || entity->m_health <= 0.f;
+				}
+			}
+			break;
+
+			case eEntityCommandType::FIRE_EVENT:
+			{
+				if ( entity != nullptr ) { entity->m_numEventsReceived += command.eventArgs->GetValue( "amount", 1 ); }
+			}
+			break;
+
+			case eEntityCommandType::MOVE_TO_INVENTORY:
+			{
+				if ( entity != nullptr
+					 && otherEntity != nullptr )
+				{
+					entity->m_ownerSerialNum = otherEntity->m_serialNum;
+				}
+			}
+			break;
+		}
+	}
+
+	// Ids differ between worlds, so only state that doesn't depend on them goes in
+	uint32_t GetStateHash() const
+	{
+		std::vector<float> state;
+		state.reserve( m_entities.GetCount() * 10 + 1 );
+		state.push_back( (float)m_numCommandsApplied );
+		for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
+		{
+			const UpdateTestEntity& entity = *m_entities[entityIdx];
+			state.push_back( (float)entity.m_serialNum );
+			state.push_back( entity.m_position.x );
+			state.push_back( entity.m_position.y );
+			state.push_back( entity.m_velocity.x );
+			state.push_back( entity.m_velocity.y );
+			state.push_back( entity.m_health );
+			state.push_back( (float)entity.m_numEventsReceived );
+			state.push_back( (float)entity.m_mapIdx );
+			state.push_back( (float)entity.m_ownerSerialNum );
+			state.push_back( (float)entity.m_numUpdates );
+		}
+
+		return Hash( (byte*)state.data(), state.size() * sizeof( float ) );
+	}
+
+	int GetNumEntities() const															{ return m_entities.GetCount(); }
+	int GetNumCommandsApplied() const													{ return m_numCommandsApplied; }
+
+private:
+	EntityStore<UpdateTestEntity> m_entities;
+	int m_nextSerialNum = 0;
+	int m_maxEntities = 0;
+	int m_numCommandsApplied = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+bool VerifyEntityUpdateEvent( EventArgs* args )
+{
+	int numEntities = args->GetValue( "entities", 10000 );
+	int numFrames = args->GetValue( "frames", 60 );
+	if ( numEntities <= 0
+		 || numFrames <= 0 )
+	{
+		g_devConsole->PrintError( "verify_entity_update: entities and frames must be positive" );
+		return false;
+	}
+
+	g_devConsole->PrintString( Stringf( "Updating %i entities for %i frames serially and in parallel", numEntities, numFrames ) );
+
+	const float deltaSeconds = 1.f / 60.f;
+	UpdateTestWorld serialWorld( numEntities, numEntities * 2 );
+	UpdateTestWorld parallelWorld( numEntities, numEntities * 2 );
+
+	EntityUpdateStage serialStage;
+	serialStage.SetParallelEnabled( false );
+	EntityUpdateStage parallelStage;
+
+	double serialMs = 0.0;
+	double parallelMs = 0.0;
+	int firstMismatchFrame = -1;
+	for ( int frameIdx = 0; frameIdx < numFrames; ++frameIdx )
+	{
+		serialWorld.Update( serialStage, deltaSeconds );
+		serialMs += serialStage.GetStats().updateMs;
+
+		parallelWorld.Update( parallelStage, deltaSeconds );
+		parallelMs += parallelStage.GetStats().updateMs;
+
+		if ( firstMismatchFrame == -1
+			 && serialWorld.GetStateHash() != parallelWorld.GetStateHash() )
+		{
+			firstMismatchFrame = frameIdx;
+		}
+	}
+
+	g_devConsole->PrintString( Stringf( "  Serial: %.2f ms per frame", serialMs / (double)numFrames ) );
+	g_devConsole->PrintString( Stringf( "  Parallel: %.2f ms per frame in %i chunks", parallelMs / (double)numFrames, parallelStage.GetStats().numChunks ) );
+	g_devConsole->PrintString( Stringf( "  %i entities left, %i commands applied", parallelWorld.GetNumEntities(), parallelWorld.GetNumCommandsApplied() ) );
+
+	if ( firstMismatchFrame != -1 )
+	{
+		g_devConsole->PrintError( Stringf( "  Parallel update diverged from serial on frame %i", firstMismatchFrame ) );
+		return false;
+	}
+
+	g_devConsole->PrintString( "  Parallel update matched serial every frame", Rgba8::GREEN );
+	return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Framework/EntityCommandBuffer.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Updates entities [firstEntityIdx, endEntityIdx), touching nothing outside them
+typedef void ( *EntityUpdateRangeFn )( const void* entities, int firstEntityIdx, int endEntityIdx, float deltaSeconds, EntityCommandBuffer& commands );
+
+
+//-----------------------------------------------------------------------------------------------
+struct EntityUpdateStats
+{
+public:
+	int numEntities = 0;
+	int numChunks = 0;
+	int numCommands = 0;
+	double updateMs = 0.0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Splits entity updates into contiguous chunks on the job system, this thread takes the first.
+// Every chunk records its structural changes into its own command buffer, and the buffers are in
+// entity order, so applying them front to back gives the same result as updating serially
+//-----------------------------------------------------------------------------------------------
+class EntityUpdateStage
+{
+public:
+	EntityUpdateStage() {}
+	~EntityUpdateStage();
+
+	// Calls UpdateInParallel( deltaSeconds, commands ) on each entity, null entries are skipped
+	template <typename EntityContainer>
+	void Run( const EntityContainer& entities, int numEntities, float deltaSeconds );
+	void RunRanges( EntityUpdateRangeFn updateRange, const void* entities, int numEntities, float deltaSeconds );
+
+	int								GetNumCommandBuffers() const			{ return m_numUsedCommandBuffers; }
+	const EntityCommandBuffer&		GetCommandBuffer( int bufferIdx ) const	{ return *m_commandBuffers[bufferIdx]; }
+	void							ClearCommands();
+
+	void							SetParallelEnabled( bool isEnabled )	{ m_isParallelEnabled = isEnabled; }
+	bool							IsParallelEnabled() const				{ return m_isParallelEnabled; }
+	void							SetMinEntitiesPerJob( int minEntities )	{ m_minEntitiesPerJob = minEntities; }
+	const EntityUpdateStats&		GetStats() const						{ return m_stats; }
+
+private:
+	int GetNumChunks( int numEntities ) const;
+
+	template <typename EntityContainer>
+	static void UpdateEntityRange( const void* entities, int firstEntityIdx, int endEntityIdx, float deltaSeconds, EntityCommandBuffer& commands );
+
+private:
+	std::vector<EntityCommandBuffer*> m_commandBuffers;
+	int m_numUsedCommandBuffers = 0;
+
+	bool m_isParallelEnabled = true;
+	int m_minEntitiesPerJob = 32;
+	EntityUpdateStats m_stats;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename EntityContainer>
+void EntityUpdateStage::Run( const EntityContainer& entities, int numEntities, float deltaSeconds )
+{
+	RunRanges( &UpdateEntityRange<EntityContainer>, &entities, numEntities, deltaSeconds );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+template <typename EntityContainer>
+void EntityUpdateStage::UpdateEntityRange( const void* entities, int firstEntityIdx, int endEntityIdx, float deltaSeconds, EntityCommandBuffer& commands )
+{
+	const EntityContainer& container = *(const EntityContainer*)entities;
+	for ( int entityIdx = firstEntityIdx; entityIdx < endEntityIdx; ++entityIdx )
+	{
+		auto entity = container[entityIdx];
+		if ( entity == nullptr )
+		{
+			continue;
+		}
+
+		entity->UpdateInParallel( deltaSeconds, commands );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+bool VerifyEntityUpdateEvent( EventArgs* args );
@@ -354,6 +354,48 @@ const char* InputSystem::GetTextFromClipboard() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void InputSystem::GetFrameState( InputFrameState& out_state ) const
+{
+	for ( int keyCode = 0; keyCode < MAX_KEY_CODES; ++keyCode )
+	{
+		out_state.keyStates[keyCode] = m_keyStates[keyCode];
+	}
+
+	out_state.characters.clear();
+	std::queue<char> characters = m_characters;
+	while ( !characters.empty() )
+	{
+		out_state.characters.push_back( characters.front() );
+		characters.pop();
+	}
+
+	out_state.normalizedMouseClientPos = m_normalizedMouseClientPos;
+	out_state.mouseMovementDelta = m_mouseMovementDelta;
+	out_state.mouseWheelScrollAmountDelta = m_mouseWheelScrollAmountDelta;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void InputSystem::SetFrameState( const InputFrameState& state )
+{
+	for ( int keyCode = 0; keyCode < MAX_KEY_CODES; ++keyCode )
+	{
+		m_keyStates[keyCode] = state.keyStates[keyCode];
+	}
+
+	m_characters = std::queue<char>();
+	for ( int charIdx = 0; charIdx < (int)state.characters.size(); ++charIdx )
+	{
+		m_characters.push( state.characters[charIdx] );
+	}
+
+	m_normalizedMouseClientPos = state.normalizedMouseClientPos;
+	m_mouseMovementDelta = state.mouseMovementDelta;
+	m_mouseWheelScrollAmountDelta = state.mouseWheelScrollAmountDelta;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 const Vec2 InputSystem::GetCenterOfWindow()
 {
@@ -6,12 +6,28 @@
 #include "Engine/Math/Vec2.hpp"
 
 #include <queue>
+#include <string>
 
 
 //-----------------------------------------------------------------------------------------------
 class Window;
 
 
+//-----------------------------------------------------------------------------------------------
+// Everything keyboard and mouse input the game can read in a frame. Controllers are left out,
+// none of the games read them through a replay yet
+//-----------------------------------------------------------------------------------------------
+struct InputFrameState
+{
+public:
+	KeyButtonState keyStates[MAX_KEY_CODES];
+	std::string characters;
+	Vec2 normalizedMouseClientPos = Vec2::ZERO;
+	Vec2 mouseMovementDelta = Vec2::ZERO;
+	float mouseWheelScrollAmountDelta = 0.f;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class InputSystem
 {
@@ -68,6 +84,10 @@ public:
 
 	const char* GetTextFromClipboard() const;
 
+	// Replays save the state after BeginFrame and put it back in place of live input
+	void GetFrameState( InputFrameState& out_state ) const;
+	void SetFrameState( const InputFrameState& state );
+
 private:
 	const Vec2 GetCenterOfWindow();
 
@@ -90,3 +90,30 @@ int KeyButtonState::ConsumeAllKeyReleases()
 	m_isPressed = false;
 	return numReleases;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+void KeyButtonState::SetState( bool isPressed, bool wasPressedLastFrame, int numTimesPressed, int numTimesReleased )
+{
+	m_isPressed = isPressed;
+	m_wasPressedLastFrame = wasPressedLastFrame;
+	m_numTimesPressed = numTimesPressed;
+	m_numTimesReleased = numTimesReleased;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool KeyButtonState::operator==( const KeyButtonState& other ) const
+{
+	return m_isPressed == other.m_isPressed
+		&& m_wasPressedLastFrame == other.m_wasPressedLastFrame
+		&& m_numTimesPressed == other.m_numTimesPressed
+		&& m_numTimesReleased == other.m_numTimesReleased;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool KeyButtonState::operator!=( const KeyButtonState& other ) const
+{
+	return !( *this == other );
+}
@@ -15,6 +15,14 @@ public:
 	int		ConsumeAllKeyPresses();
 	int		ConsumeAllKeyReleases();
 
+	// Replays
+	bool	WasPressedLastFrame() const			{ return m_wasPressedLastFrame; }
+	int		GetNumTimesPressed() const			{ return m_numTimesPressed; }
+	int		GetNumTimesReleased() const			{ return m_numTimesReleased; }
+	void	SetState( bool isPressed, bool wasPressedLastFrame, int numTimesPressed, int numTimesReleased );
+	bool	operator==( const KeyButtonState& other ) const;
+	bool	operator!=( const KeyButtonState& other ) const;
+
 private:
 	bool m_isPressed = false;
 	bool m_wasPressedLastFrame = false;
@@ -0,0 +1,408 @@
+#include "Engine/Math/BatchTransform.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <cfloat>
+#include <vector>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#define BATCH_TRANSFORM_SIMD
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+// SIMD level selection
+//-----------------------------------------------------------------------------------------------
+static eSimdLevel DetectSupportedSimdLevel()
+{
+#if defined( BATCH_TRANSFORM_SIMD )
+	int cpuInfo[4];
+	__cpuid( cpuInfo, 0 );
+	int maxFunctionId = cpuInfo[0];
+
+	__cpuid( cpuInfo, 1 );
+	bool hasFMA =		( cpuInfo[2] & ( 1 << 12 ) ) != 0;
+	bool hasOSXSAVE =	( cpuInfo[2] & ( 1 << 27 ) ) != 0;
+	bool hasAVX =		( cpuInfo[2] & ( 1 << 28 ) ) != 0;
+
+	// The os also has to save the ymm registers on context switches before avx is usable
+	if ( maxFunctionId >= 7
+		 && hasFMA
+		 && hasOSXSAVE
+		 && hasAVX
+		 && ( _xgetbv( 0 ) & 0x6 ) == 0x6 )
+	{
+		__cpuidex( cpuInfo, 7, 0 );
+		bool hasAVX2 = ( cpuInfo[1] & ( 1 << 5 ) ) != 0;
+		if ( hasAVX2 )
+		{
+			return eSimdLevel::AVX2;
+		}
+	}
+
+	// SSE2 is part of the x64 baseline and the default arch for 32 bit builds
+	return eSimdLevel::SSE2;
+#else
+	return eSimdLevel::SCALAR;
+#endif
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static eSimdLevel s_supportedSimdLevel = DetectSupportedSimdLevel();
+static eSimdLevel s_batchTransformSimdLevel = s_supportedSimdLevel;
+
+
+//-----------------------------------------------------------------------------------------------
+eSimdLevel GetSupportedSimdLevel()
+{
+	return s_supportedSimdLevel;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+eSimdLevel GetBatchTransformSimdLevel()
+{
+	return s_batchTransformSimdLevel;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SetBatchTransformSimdLevel( eSimdLevel simdLevel )
+{
+	s_batchTransformSimdLevel = (int)simdLevel <= (int)s_supportedSimdLevel ? simdLevel : s_supportedSimdLevel;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+const char* GetSimdLevelName( eSimdLevel simdLevel )
+{
+	switch ( simdLevel )
+	{
+		case eSimdLevel::SCALAR:	return "Scalar";
+		case eSimdLevel::SSE2:		return "SSE2";
+		case eSimdLevel::AVX2:		return "AVX2";
+	}
+
+	return "Unknown";
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scalar
+//-----------------------------------------------------------------------------------------------
+static void TransformPoints3DScalar( const Mat44& transform, byte* firstPoint, int count, int strideBytes, bool isPosition )
+{
+	for ( int pointIdx = 0; pointIdx < count; ++pointIdx )
+	{
+		Vec3& point = *(Vec3*)( firstPoint + (size_t)pointIdx * strideBytes );
+		point = isPosition ? transform.TransformPosition3D( point ) : transform.TransformVector3D( point );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static AABB3 GetBoundsOfPoints3DScalar( const byte* firstPoint, int count, int strideBytes )
+{
+	const Vec3& firstPosition = *(const Vec3*)firstPoint;
+	AABB3 bounds( firstPosition, firstPosition );
+
+	for ( int pointIdx = 1; pointIdx < count; ++pointIdx )
+	{
+		const Vec3& point = *(const Vec3*)( firstPoint + (size_t)pointIdx * strideBytes );
+		bounds.mins = Vec3( Min( bounds.mins.x, point.x ), Min( bounds.mins.y, point.y ), Min( bounds.mins.z, point.z ) );
+		bounds.maxs = Vec3( Max( bounds.maxs.x, point.x ), Max( bounds.maxs.y, point.y ), Max( bounds.maxs.z, point.z ) );
+	}
+
+	return bounds;
+}
+
+
+#if defined( BATCH_TRANSFORM_SIMD )
+//-----------------------------------------------------------------------------------------------
+// SSE2
+// Mat44 is basis major so each basis is one register and a point is x*I + y*J + z*K + T,
+// this keeps the math in the same order as Mat44::TransformPosition3D
+//-----------------------------------------------------------------------------------------------
+static inline void StoreXYZ( float* point, const __m128& result )
+{
+	_mm_storel_pi( (__m64*)point, result );
+	_mm_store_ss( point + 2, _mm_movehl_ps( result, result ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void TransformPoints3DSSE2( const Mat44& transform, byte* firstPoint, int count, int strideBytes, bool isPosition )
+{
+	const __m128 iBasis = _mm_loadu_ps( &transform.Ix );
+	const __m128 jBasis = _mm_loadu_ps( &transform.Jx );
+	const __m128 kBasis = _mm_loadu_ps( &transform.Kx );
+	const __m128 translation = isPosition ? _mm_loadu_ps( &transform.Tx ) : _mm_setzero_ps();
+
+	for ( int pointIdx = 0; pointIdx < count; ++pointIdx )
+	{
+		float* point = (float*)( firstPoint + (size_t)pointIdx * strideBytes );
+
+		__m128 xy = _mm_add_ps( _mm_mul_ps( iBasis, _mm_set1_ps( point[0] ) ), _mm_mul_ps( jBasis, _mm_set1_ps( point[1] ) ) );
+		__m128 zt = _mm_add_ps( _mm_mul_ps( kBasis, _mm_set1_ps( point[2] ) ), translation );
+
+		StoreXYZ( point, _mm_add_ps( xy, zt ) );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static AABB3 GetBoundsOfPoints3DSSE2( const byte* firstPoint, int count, int strideBytes )
+{
+	__m128 mins = _mm_set1_ps( FLT_MAX );
+	__m128 maxs = _mm_set1_ps( -FLT_MAX );
+
+	for ( int pointIdx = 0; pointIdx < count; ++pointIdx )
+	{
+		const float* point = (const float*)( firstPoint + (size_t)pointIdx * strideBytes );
+
+		// Load exactly 3 floats, reading a full register could run off the end of a packed array
+		__m128 xy = _mm_castpd_ps( _mm_load_sd( (const double*)point ) );
+		__m128 xyz = _mm_movelh_ps( xy, _mm_load_ss( point + 2 ) );
+
+		mins = _mm_min_ps( mins, xyz );
+		maxs = _mm_max_ps( maxs, xyz );
+	}
+
+	AABB3 bounds;
+	StoreXYZ( &bounds.mins.x, mins );
+	StoreXYZ( &bounds.maxs.x, maxs );
+	return bounds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// AVX2
+// Two points per iteration, the matrix is duplicated into both 128 bit lanes
+//-----------------------------------------------------------------------------------------------
+static inline __m256 BroadcastPair( float valueA, float valueB )
+{
+	return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_set1_ps( valueA ) ), _mm_set1_ps( valueB ), 1 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void TransformPoints3DAVX2( const Mat44& transform, byte* firstPoint, int count, int strideBytes, bool isPosition )
+{
+	const __m256 iBasis = _mm256_broadcast_ps( (const __m128*)&transform.Ix );
+	const __m256 jBasis = _mm256_broadcast_ps( (const __m128*)&transform.Jx );
+	const __m256 kBasis = _mm256_broadcast_ps( (const __m128*)&transform.Kx );
+	const __m256 translation = isPosition ? _mm256_broadcast_ps( (const __m128*)&transform.Tx ) : _mm256_setzero_ps();
+
+	int pointIdx = 0;
+	for ( ; pointIdx + 1 < count; pointIdx += 2 )
+	{
+		float* pointA = (float*)( firstPoint + (size_t)pointIdx * strideBytes );
+		float* pointB = (float*)( firstPoint + (size_t)( pointIdx + 1 ) * strideBytes );
+
+		__m256 result = _mm256_fmadd_ps( kBasis, BroadcastPair( pointA[2], pointB[2] ), translation );
+		result = _mm256_fmadd_ps( jBasis, BroadcastPair( pointA[1], pointB[1] ), result );
+		result = _mm256_fmadd_ps( iBasis, BroadcastPair( pointA[0], pointB[0] ), result );
+
+		StoreXYZ( pointA, _mm256_castps256_ps128( result ) );
+		StoreXYZ( pointB, _mm256_extractf128_ps( result, 1 ) );
+	}
+
+	// Avoid the sse transition penalty since the rest of the engine isn't built with /arch:AVX
+	_mm256_zeroupper();
+
+	if ( pointIdx < count )
+	{
+		TransformPoints3DSSE2( transform, firstPoint + (size_t)pointIdx * strideBytes, count - pointIdx, strideBytes, isPosition );
+	}
+}
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+static void TransformPoints3D( const Mat44& transform, byte* firstPoint, int count, int strideBytes, bool isPosition )
+{
+	if ( firstPoint == nullptr
+		 || count <= 0 )
+	{
+		return;
+	}
+
+	switch ( s_batchTransformSimdLevel )
+	{
+#if defined( BATCH_TRANSFORM_SIMD )
+		case eSimdLevel::AVX2:	TransformPoints3DAVX2( transform, firstPoint, count, strideBytes, isPosition ); return;
+		case eSimdLevel::SSE2:	TransformPoints3DSSE2( transform, firstPoint, count, strideBytes, isPosition ); return;
+#endif
+		default:				TransformPoints3DScalar( transform, firstPoint, count, strideBytes, isPosition ); return;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Public API
+//-----------------------------------------------------------------------------------------------
+void TransformPositions3DBatch( const Mat44& transform, byte* firstPosition, int count, int strideBytes )
+{
+	TransformPoints3D( transform, firstPosition, count, strideBytes, true );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TransformVectors3DBatch( const Mat44& transform, byte* firstVector, int count, int strideBytes )
+{
+	TransformPoints3D( transform, firstVector, count, strideBytes, false );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TransformPositionsXYBatch( float uniformScale, float rotationDegrees, const Vec2& translation, byte* firstPosition, int count, int strideBytes )
+{
+	float cosScaled = CosDegrees( rotationDegrees ) * uniformScale;
+	float sinScaled = SinDegrees( rotationDegrees ) * uniformScale;
+
+	Mat44 transform;
+	transform.Ix = cosScaled;
+	transform.Iy = sinScaled;
+	transform.Jx = -sinScaled;
+	transform.Jy = cosScaled;
+	transform.Tx = translation.x;
+	transform.Ty = translation.y;
+
+	TransformPoints3D( transform, firstPosition, count, strideBytes, true );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TransformPositions3DWithXYRotationBatch( float uniformScale, float rotationDegrees, const Vec3& translation, byte* firstPosition, int count, int strideBytes )
+{
+	float cosScaled = CosDegrees( rotationDegrees ) * uniformScale;
+	float sinScaled = SinDegrees( rotationDegrees ) * uniformScale;
+
+	Mat44 transform;
+	transform.Ix = cosScaled;
+	transform.Iy = sinScaled;
+	transform.Jx = -sinScaled;
+	transform.Jy = cosScaled;
+	transform.Kz = uniformScale;
+	transform.Tx = translation.x;
+	transform.Ty = translation.y;
+	transform.Tz = translation.z;
+
+	TransformPoints3D( transform, firstPosition, count, strideBytes, true );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AABB2 GetBoundsOfPositions2DBatch( const byte* firstPosition, int count, int strideBytes )
+{
+	AABB3 bounds3D = GetBoundsOfPositions3DBatch( firstPosition, count, strideBytes );
+
+	return AABB2( bounds3D.mins.x, bounds3D.mins.y, bounds3D.maxs.x, bounds3D.maxs.y );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AABB3 GetBoundsOfPositions3DBatch( const byte* firstPosition, int count, int strideBytes )
+{
+	if ( firstPosition == nullptr
+		 || count <= 0 )
+	{
+		return AABB3();
+	}
+
+#if defined( BATCH_TRANSFORM_SIMD )
+	if ( s_batchTransformSimdLevel != eSimdLevel::SCALAR )
+	{
+		return GetBoundsOfPoints3DSSE2( firstPosition, count, strideBytes );
+	}
+#endif
+
+	return GetBoundsOfPoints3DScalar( firstPosition, count, strideBytes );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+//-----------------------------------------------------------------------------------------------
+bool BenchmarkBatchTransformEvent( EventArgs* args )
+{
+	int numVertices = args->GetValue( "vertices", 1000000 );
+	int numIterations = args->GetValue( "iterations", 10 );
+	if ( numVertices <= 0
+		 || numIterations <= 0 )
+	{
+		g_devConsole->PrintError( "benchmark_batch_transform: vertices and iterations must be positive" );
+		return false;
+	}
+
+	std::vector<Vertex_PCU> sourceVertices;
+	sourceVertices.reserve( numVertices );
+	for ( int vertIdx = 0; vertIdx < numVertices; ++vertIdx )
+	{
+		float fraction = (float)vertIdx / (float)numVertices;
+		sourceVertices.push_back( Vertex_PCU( Vec3( fraction, 1.f - fraction, fraction * .5f ), Rgba8::WHITE, Vec2::ZERO ) );
+	}
+
+	Mat44 transform = Mat44::CreateZRotationDegrees( 33.f );
+	transform.PushTransform( Mat44::CreateTranslation3D( Vec3( 1.f, 2.f, 3.f ) ) );
+
+	std::vector<Vertex_PCU> vertices;
+	eSimdLevel originalSimdLevel = s_batchTransformSimdLevel;
+
+	g_devConsole->PrintString( Stringf( "Transforming %i Vertex_PCU %i times, supported simd level: %s", numVertices, numIterations, GetSimdLevelName( s_supportedSimdLevel ) ) );
+
+	// Per vertex Mat44 transform as the baseline everything else is compared against
+	vertices = sourceVertices;
+	double startTime = GetCurrentTimeSeconds();
+	for ( int iteration = 0; iteration < numIterations; ++iteration )
+	{
+		for ( int vertIdx = 0; vertIdx < numVertices; ++vertIdx )
+		{
+			vertices[vertIdx].m_position = transform.TransformPosition3D( vertices[vertIdx].m_position );
+		}
+	}
+	double baselineSeconds = GetCurrentTimeSeconds() - startTime;
+	g_devConsole->PrintString( Stringf( "  Per vertex Mat44: %.2f ms", baselineSeconds * 1000.0 / (double)numIterations ) );
+
+	for ( int simdLevelIdx = 0; simdLevelIdx <= (int)s_supportedSimdLevel; ++simdLevelIdx )
+	{
+		SetBatchTransformSimdLevel( (eSimdLevel)simdLevelIdx );
+
+		vertices = sourceVertices;
+		startTime = GetCurrentTimeSeconds();
+		for ( int iteration = 0; iteration < numIterations; ++iteration )
+		{
+			TransformPositions3DBatch( transform, (byte*)&vertices[0].m_position, numVertices, sizeof( Vertex_PCU ) );
+		}
+		double transformSeconds = GetCurrentTimeSeconds() - startTime;
+
+		startTime = GetCurrentTimeSeconds();
+		AABB3 bounds;
+		for ( int iteration = 0; iteration < numIterations; ++iteration )
+		{
+			bounds = GetBoundsOfPositions3DBatch( (byte*)&vertices[0].m_position, numVertices, sizeof( Vertex_PCU ) );
+		}
+		double boundsSeconds = GetCurrentTimeSeconds() - startTime;
+
+		g_devConsole->PrintString( Stringf( "  %s batch: transform %.2f ms (%.2fx), bounds %.2f ms, bounds size (%.2f, %.2f, %.2f)",
+											GetSimdLevelName( (eSimdLevel)simdLevelIdx ),
+											transformSeconds * 1000.0 / (double)numIterations,
+											baselineSeconds / transformSeconds,
+											boundsSeconds * 1000.0 / (double)numIterations,
+											bounds.maxs.x - bounds.mins.x, bounds.maxs.y - bounds.mins.y, bounds.maxs.z - bounds.mins.z ) );
+	}
+
+	SetBatchTransformSimdLevel( originalSimdLevel );
+
+	return false;
+}
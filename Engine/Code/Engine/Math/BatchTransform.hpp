@@ -0,0 +1,45 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+struct Mat44;
+struct Vec2;
+struct Vec3;
+
+
+//-----------------------------------------------------------------------------------------------
+enum class eSimdLevel
+{
+	SCALAR,
+	SSE2,
+	AVX2,
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Transforms over whole arrays of positions. Each array is walked with a byte stride so the same
+// functions work on packed Vec3 arrays and on the position member of any vertex type, e.g.
+//		TransformPositions3DBatch( transform, (byte*)&vertices[0].m_position, (int)vertices.size(), sizeof( Vertex_PCU ) );
+//
+// Work is done with SSE2 or AVX2 when the cpu supports it and falls back to scalar math otherwise
+//-----------------------------------------------------------------------------------------------
+eSimdLevel	GetSupportedSimdLevel();
+eSimdLevel	GetBatchTransformSimdLevel();
+void		SetBatchTransformSimdLevel( eSimdLevel simdLevel );		// Clamped to the supported level, mainly for benchmarking
+const char* GetSimdLevelName( eSimdLevel simdLevel );
+
+void		TransformPositions3DBatch( const Mat44& transform, byte* firstPosition, int count, int strideBytes );		// Assumes w = 1
+void		TransformVectors3DBatch( const Mat44& transform, byte* firstVector, int count, int strideBytes );			// Assumes w = 0
+void		TransformPositionsXYBatch( float uniformScale, float rotationDegrees, const Vec2& translation,				// z is unchanged
+									   byte* firstPosition, int count, int strideBytes );
+void		TransformPositions3DWithXYRotationBatch( float uniformScale, float rotationDegrees, const Vec3& translation,
+													 byte* firstPosition, int count, int strideBytes );
+
+AABB2		GetBoundsOfPositions2DBatch( const byte* firstPosition, int count, int strideBytes );
+AABB3		GetBoundsOfPositions3DBatch( const byte* firstPosition, int count, int strideBytes );
+
+// Console commands
+bool		BenchmarkBatchTransformEvent( EventArgs* args );
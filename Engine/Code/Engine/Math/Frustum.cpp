@@ -0,0 +1,90 @@
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec4.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+static void SetPlane( Frustum& frustum, eFrustumPlane plane, const Vec4& coefficients )
+{
+	Vec3 normal( coefficients.x, coefficients.y, coefficients.z );
+	float normalLength = normal.GetLength();
+	if ( normalLength == 0.f )
+	{
+		frustum.m_planeNormals[plane] = Vec3::ZERO;
+		frustum.m_planeDistances[plane] = 0.f;
+		return;
+	}
+
+	frustum.m_planeNormals[plane] = normal / normalLength;
+	frustum.m_planeDistances[plane] = -coefficients.w / normalLength;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Gribb/Hartmann plane extraction, each plane is a sum or difference of rows of the matrix
+//-----------------------------------------------------------------------------------------------
+Frustum Frustum::CreateFromWorldToClipMatrix( const Mat44& worldToClip )
+{
+	const Mat44& m = worldToClip;
+	Vec4 rowX( m.Ix, m.Jx, m.Kx, m.Tx );
+	Vec4 rowY( m.Iy, m.Jy, m.Ky, m.Ty );
+	Vec4 rowZ( m.Iz, m.Jz, m.Kz, m.Tz );
+	Vec4 rowW( m.Iw, m.Jw, m.Kw, m.Tw );
+
+	Frustum frustum;
+	SetPlane( frustum, FRUSTUM_PLANE_LEFT, rowW + rowX );
+	SetPlane( frustum, FRUSTUM_PLANE_RIGHT, rowW - rowX );
+	SetPlane( frustum, FRUSTUM_PLANE_BOTTOM, rowW + rowY );
+	SetPlane( frustum, FRUSTUM_PLANE_TOP, rowW - rowY );
+	SetPlane( frustum, FRUSTUM_PLANE_NEAR, rowZ );
+	SetPlane( frustum, FRUSTUM_PLANE_FAR, rowW - rowZ );
+
+	return frustum;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool Frustum::IsPointInside( const Vec3& point ) const
+{
+	return DoesSphereOverlap( point, 0.f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool Frustum::DoesSphereOverlap( const Vec3& center, float radius ) const
+{
+	for ( int planeIdx = 0; planeIdx < NUM_FRUSTUM_PLANES; ++planeIdx )
+	{
+		float signedDistance = DotProduct3D( m_planeNormals[planeIdx], center ) - m_planeDistances[planeIdx];
+		if ( signedDistance < -radius )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Only the corner furthest along each plane's normal needs testing
+//-----------------------------------------------------------------------------------------------
+bool Frustum::DoesAABB3Overlap( const AABB3& box ) const
+{
+	for ( int planeIdx = 0; planeIdx < NUM_FRUSTUM_PLANES; ++planeIdx )
+	{
+		const Vec3& normal = m_planeNormals[planeIdx];
+		Vec3 furthestCorner( normal.x >= 0.f ? box.maxs.x : box.mins.x,
+							 normal.y >= 0.f ? box.maxs.y : box.mins.y,
+							 normal.z >= 0.f ? box.maxs.z : box.mins.z );
+
+		if ( DotProduct3D( normal, furthestCorner ) - m_planeDistances[planeIdx] < 0.f )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
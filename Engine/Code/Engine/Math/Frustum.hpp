@@ -0,0 +1,44 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+struct AABB3;
+struct Mat44;
+
+
+//-----------------------------------------------------------------------------------------------
+enum eFrustumPlane
+{
+	FRUSTUM_PLANE_LEFT,
+	FRUSTUM_PLANE_RIGHT,
+	FRUSTUM_PLANE_BOTTOM,
+	FRUSTUM_PLANE_TOP,
+	FRUSTUM_PLANE_NEAR,
+	FRUSTUM_PLANE_FAR,
+
+	NUM_FRUSTUM_PLANES
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Six inward facing world space planes, a point is inside when it's in front of every plane.
+// Overlap tests are conservative: shapes near a corner may pass without touching the frustum
+//-----------------------------------------------------------------------------------------------
+struct Frustum
+{
+public:
+	Vec3 m_planeNormals[NUM_FRUSTUM_PLANES];
+	float m_planeDistances[NUM_FRUSTUM_PLANES] = {};	// dot( normal, point ) - distance >= 0 inside
+
+public:
+	Frustum() = default;
+	~Frustum() = default;
+
+	// Planes from a D3D style world to clip matrix, clip z runs 0 to 1
+	static Frustum CreateFromWorldToClipMatrix( const Mat44& worldToClip );
+
+	bool		IsPointInside( const Vec3& point ) const;
+	bool		DoesSphereOverlap( const Vec3& center, float radius ) const;
+	bool		DoesAABB3Overlap( const AABB3& box ) const;
+};
@@ -0,0 +1,677 @@
+#include "Engine/Math/NoiseGrid.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/SmoothNoise.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <cstring>
+#include <math.h>
+#include <vector>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#define NOISE_GRID_SIMD
+#include <emmintrin.h>
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+// These have to match SmoothNoise.cpp exactly or the grids drift from the per sample functions
+static const float OCTAVE_OFFSET = 0.636764989593174f;
+static const float PERLIN_2D_NORMALIZER = 1.f / 0.662578106f;
+static const float PERLIN_2D_GRADIENTS_X[8] = { +0.923879533f, +0.382683432f, -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f, +0.382683432f, +0.923879533f };
+static const float PERLIN_2D_GRADIENTS_Y[8] = { +0.382683432f, +0.923879533f, +0.923879533f, +0.382683432f, -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f };
+
+static const int MIN_SAMPLES_PER_JOB = 16384;
+static bool s_areNoiseGridJobsEnabled = true;
+
+
+//-----------------------------------------------------------------------------------------------
+enum class eNoiseGridType
+{
+	FRACTAL,
+	PERLIN,
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct NoiseGridParams
+{
+public:
+	eNoiseGridType type = eNoiseGridType::FRACTAL;
+	float* outValues = nullptr;
+	int width = 0;
+	int height = 0;
+	float originX = 0.f;
+	float originY = 0.f;
+	float stepX = 1.f;
+	float stepY = 1.f;
+	float invScale = 1.f;
+	unsigned int numOctaves = 1;
+	float octavePersistence = 0.5f;
+	float octaveScale = 2.f;
+	bool renormalize = true;
+	unsigned int seed = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// One row's worth of working data, every array is per sample except the lattice columns
+//-----------------------------------------------------------------------------------------------
+struct NoiseGridRowScratch
+{
+public:
+	std::vector<float> posX;			// This octave's x
+	std::vector<float> cellMinX;
+	std::vector<float> totalNoise;
+	std::vector<float> corners[8];		// SW, SE, NW, NE values, or for Perlin each corner's gradient x then y
+	std::vector<float> lattice[4];		// South and north values per lattice column, or south x, south y, north x, north y gradients
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Lattice lookups
+//-----------------------------------------------------------------------------------------------
+static void SetPerlinCornerGradients( NoiseGridRowScratch& scratch, int sampleIdx, unsigned int noiseSW, unsigned int noiseSE, unsigned int noiseNW, unsigned int noiseNE )
+{
+	scratch.corners[0][sampleIdx] = PERLIN_2D_GRADIENTS_X[noiseSW & 0x00000007];
+	scratch.corners[1][sampleIdx] = PERLIN_2D_GRADIENTS_Y[noiseSW & 0x00000007];
+	scratch.corners[2][sampleIdx] = PERLIN_2D_GRADIENTS_X[noiseSE & 0x00000007];
+	scratch.corners[3][sampleIdx] = PERLIN_2D_GRADIENTS_Y[noiseSE & 0x00000007];
+	scratch.corners[4][sampleIdx] = PERLIN_2D_GRADIENTS_X[noiseNW & 0x00000007];
+	scratch.corners[5][sampleIdx] = PERLIN_2D_GRADIENTS_Y[noiseNW & 0x00000007];
+	scratch.corners[6][sampleIdx] = PERLIN_2D_GRADIENTS_X[noiseNE & 0x00000007];
+	scratch.corners[7][sampleIdx] = PERLIN_2D_GRADIENTS_Y[noiseNE & 0x00000007];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Fills cellMinX and the corner arrays for this octave. Neighboring samples mostly share lattice
+// columns, so each column along the row is hashed once and the samples index into them
+//-----------------------------------------------------------------------------------------------
+static void GatherCorners( eNoiseGridType type, int width, NoiseGridRowScratch& scratch, int indexSouthY, unsigned int seed )
+{
+	int indexNorthY = indexSouthY + 1;
+	for ( int sampleIdx = 0; sampleIdx < width; ++sampleIdx )
+	{
+		scratch.cellMinX[sampleIdx] = floorf( scratch.posX[sampleIdx] );
+	}
+
+	// x only grows or only shrinks along a row, so the end samples bound the columns it touches
+	double firstColumn = (double)Min( scratch.cellMinX[0], scratch.cellMinX[width - 1] );
+	double lastColumn = (double)Max( scratch.cellMinX[0], scratch.cellMinX[width - 1] ) + 1.0;
+	double numColumns = lastColumn - firstColumn + 1.0;
+
+	// Steps wider than a cell touch more columns than there are samples, hash those per sample instead
+	if ( !( numColumns <= (double)( 2 * width + 2 ) ) )
+	{
+		for ( int sampleIdx = 0; sampleIdx < width; ++sampleIdx )
+		{
+			int indexWestX = (int)scratch.cellMinX[sampleIdx];
+			int indexEastX = indexWestX + 1;
+			if ( type == eNoiseGridType::PERLIN )
+			{
+				SetPerlinCornerGradients( scratch, sampleIdx,
+										  Get2dNoiseUint( indexWestX, indexSouthY, seed ), Get2dNoiseUint( indexEastX, indexSouthY, seed ),
+										  Get2dNoiseUint( indexWestX, indexNorthY, seed ), Get2dNoiseUint( indexEastX, indexNorthY, seed ) );
+			}
+			else
+			{
+				scratch.corners[0][sampleIdx] = Get2dNoiseZeroToOne( indexWestX, indexSouthY, seed );
+				scratch.corners[1][sampleIdx] = Get2dNoiseZeroToOne( indexEastX, indexSouthY, seed );
+				scratch.corners[2][sampleIdx] = Get2dNoiseZeroToOne( indexWestX, indexNorthY, seed );
+				scratch.corners[3][sampleIdx] = Get2dNoiseZeroToOne( indexEastX, indexNorthY, seed );
+			}
+		}
+
+		return;
+	}
+
+	int firstIndexX = (int)firstColumn;
+	int numLatticeColumns = (int)numColumns;
+	for ( int latticeIdx = 0; latticeIdx < 4; ++latticeIdx )
+	{
+		scratch.lattice[latticeIdx].resize( numLatticeColumns );
+	}
+
+	for ( int columnIdx = 0; columnIdx < numLatticeColumns; ++columnIdx )
+	{
+		int indexX = firstIndexX + columnIdx;
+		if ( type == eNoiseGridType::PERLIN )
+		{
+			unsigned int noiseSouth = Get2dNoiseUint( indexX, indexSouthY, seed ) & 0x00000007;
+			unsigned int noiseNorth = Get2dNoiseUint( indexX, indexNorthY, seed ) & 0x00000007;
+			scratch.lattice[0][columnIdx] = PERLIN_2D_GRADIENTS_X[noiseSouth];
+			scratch.lattice[1][columnIdx] = PERLIN_2D_GRADIENTS_Y[noiseSouth];
+			scratch.lattice[2][columnIdx] = PERLIN_2D_GRADIENTS_X[noiseNorth];
+			scratch.lattice[3][columnIdx] = PERLIN_2D_GRADIENTS_Y[noiseNorth];
+		}
+		else
+		{
+			scratch.lattice[0][columnIdx] = Get2dNoiseZeroToOne( indexX, indexSouthY, seed );
+			scratch.lattice[1][columnIdx] = Get2dNoiseZeroToOne( indexX, indexNorthY, seed );
+		}
+	}
+
+	for ( int sampleIdx = 0; sampleIdx < width; ++sampleIdx )
+	{
+		int columnIdx = (int)scratch.cellMinX[sampleIdx] - firstIndexX;
+		if ( type == eNoiseGridType::PERLIN )
+		{
+			scratch.corners[0][sampleIdx] = scratch.lattice[0][columnIdx];
+			scratch.corners[1][sampleIdx] = scratch.lattice[1][columnIdx];
+			scratch.corners[2][sampleIdx] = scratch.lattice[0][columnIdx + 1];
+			scratch.corners[3][sampleIdx] = scratch.lattice[1][columnIdx + 1];
+			scratch.corners[4][sampleIdx] = scratch.lattice[2][columnIdx];
+			scratch.corners[5][sampleIdx] = scratch.lattice[3][columnIdx];
+			scratch.corners[6][sampleIdx] = scratch.lattice[2][columnIdx + 1];
+			scratch.corners[7][sampleIdx] = scratch.lattice[3][columnIdx + 1];
+		}
+		else
+		{
+			scratch.corners[0][sampleIdx] = scratch.lattice[0][columnIdx];
+			scratch.corners[1][sampleIdx] = scratch.lattice[0][columnIdx + 1];
+			scratch.corners[2][sampleIdx] = scratch.lattice[1][columnIdx];
+			scratch.corners[3][sampleIdx] = scratch.lattice[1][columnIdx + 1];
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Scalar blending, the same operations in the same order as SmoothNoise.cpp. Used for the samples
+// left over after the SIMD lanes and for builds without SSE2
+//-----------------------------------------------------------------------------------------------
+static void BlendFractalOctaveScalar( NoiseGridRowScratch& scratch, int firstSampleIdx, int endSampleIdx, float weightSouth, float weightNorth, float amplitude, float octaveScale )
+{
+	for ( int sampleIdx = firstSampleIdx; sampleIdx < endSampleIdx; ++sampleIdx )
+	{
+		float weightEast = SmoothStep3( scratch.posX[sampleIdx] - scratch.cellMinX[sampleIdx] );
+		float weightWest = 1.f - weightEast;
+
+		float blendSouth = ( weightEast * scratch.corners[1][sampleIdx] ) + ( weightWest * scratch.corners[0][sampleIdx] );
+		float blendNorth = ( weightEast * scratch.corners[3][sampleIdx] ) + ( weightWest * scratch.corners[2][sampleIdx] );
+		float blendTotal = ( weightSouth * blendSouth ) + ( weightNorth * blendNorth );
+		float noiseThisOctave = 2.f * ( blendTotal - 0.5f );
+
+		scratch.totalNoise[sampleIdx] += noiseThisOctave * amplitude;
+		scratch.posX[sampleIdx] *= octaveScale;
+		scratch.posX[sampleIdx] += OCTAVE_OFFSET;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void BlendPerlinOctaveScalar( NoiseGridRowScratch& scratch, int firstSampleIdx, int endSampleIdx, float displacementSouthY, float displacementNorthY,
+									 float weightSouth, float weightNorth, float amplitude, float octaveScale )
+{
+	for ( int sampleIdx = firstSampleIdx; sampleIdx < endSampleIdx; ++sampleIdx )
+	{
+		float cellMinX = scratch.cellMinX[sampleIdx];
+		float cellMaxX = cellMinX + 1.f;
+		float displacementWestX = scratch.posX[sampleIdx] - cellMinX;
+		float displacementEastX = scratch.posX[sampleIdx] - cellMaxX;
+
+		float dotSouthWest = ( scratch.corners[0][sampleIdx] * displacementWestX ) + ( scratch.corners[1][sampleIdx] * displacementSouthY );
+		float dotSouthEast = ( scratch.corners[2][sampleIdx] * displacementEastX ) + ( scratch.corners[3][sampleIdx] * displacementSouthY );
+		float dotNorthWest = ( scratch.corners[4][sampleIdx] * displacementWestX ) + ( scratch.corners[5][sampleIdx] * displacementNorthY );
+		float dotNorthEast = ( scratch.corners[6][sampleIdx] * displacementEastX ) + ( scratch.corners[7][sampleIdx] * displacementNorthY );
+
+		float weightEast = SmoothStep3( displacementWestX );
+		float weightWest = 1.f - weightEast;
+
+		float blendSouth = ( weightEast * dotSouthEast ) + ( weightWest * dotSouthWest );
+		float blendNorth = ( weightEast * dotNorthEast ) + ( weightWest * dotNorthWest );
+		float blendTotal = ( weightSouth * blendSouth ) + ( weightNorth * blendNorth );
+		float noiseThisOctave = blendTotal * PERLIN_2D_NORMALIZER;
+
+		scratch.totalNoise[sampleIdx] += noiseThisOctave * amplitude;
+		scratch.posX[sampleIdx] *= octaveScale;
+		scratch.posX[sampleIdx] += OCTAVE_OFFSET;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RenormalizeScalar( float* totalNoise, int firstSampleIdx, int endSampleIdx, float totalAmplitude )
+{
+	for ( int sampleIdx = firstSampleIdx; sampleIdx < endSampleIdx; ++sampleIdx )
+	{
+		float noise = totalNoise[sampleIdx] / totalAmplitude;
+		noise = ( noise * 0.5f ) + 0.5f;
+		noise = SmoothStep3( noise );
+		totalNoise[sampleIdx] = ( noise * 2.0f ) - 1.f;
+	}
+}
+
+
+#if defined( NOISE_GRID_SIMD )
+//-----------------------------------------------------------------------------------------------
+// SSE2, four samples at a time. No fused multiply-adds so every lane rounds like the scalar code
+//-----------------------------------------------------------------------------------------------
+static inline __m128 SmoothStep3SSE2( const __m128& t )
+{
+	__m128 tSquared = _mm_mul_ps( t, t );
+	return _mm_sub_ps( _mm_mul_ps( _mm_set1_ps( 3.f ), tSquared ), _mm_mul_ps( _mm_set1_ps( 2.f ), _mm_mul_ps( tSquared, t ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static inline __m128 Blend4SSE2( const __m128& weightA, const __m128& valueA, const __m128& weightB, const __m128& valueB )
+{
+	return _mm_add_ps( _mm_mul_ps( weightA, valueA ), _mm_mul_ps( weightB, valueB ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static inline void AccumulateOctaveSSE2( NoiseGridRowScratch& scratch, int sampleIdx, const __m128& posX, const __m128& noiseThisOctave, const __m128& amplitude, const __m128& octaveScale )
+{
+	__m128 totalNoise = _mm_add_ps( _mm_loadu_ps( &scratch.totalNoise[sampleIdx] ), _mm_mul_ps( noiseThisOctave, amplitude ) );
+	_mm_storeu_ps( &scratch.totalNoise[sampleIdx], totalNoise );
+	_mm_storeu_ps( &scratch.posX[sampleIdx], _mm_add_ps( _mm_mul_ps( posX, octaveScale ), _mm_set1_ps( OCTAVE_OFFSET ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int BlendFractalOctaveSSE2( NoiseGridRowScratch& scratch, int width, float weightSouth, float weightNorth, float amplitude, float octaveScale )
+{
+	__m128 one = _mm_set1_ps( 1.f );
+	__m128 half = _mm_set1_ps( 0.5f );
+	__m128 two = _mm_set1_ps( 2.f );
+	__m128 weightSouth4 = _mm_set1_ps( weightSouth );
+	__m128 weightNorth4 = _mm_set1_ps( weightNorth );
+	__m128 amplitude4 = _mm_set1_ps( amplitude );
+	__m128 octaveScale4 = _mm_set1_ps( octaveScale );
+
+	int endSampleIdx = width & ~3;
+	for ( int sampleIdx = 0; sampleIdx < endSampleIdx; sampleIdx += 4 )
+	{
+		__m128 posX = _mm_loadu_ps( &scratch.posX[sampleIdx] );
+		__m128 weightEast = SmoothStep3SSE2( _mm_sub_ps( posX, _mm_loadu_ps( &scratch.cellMinX[sampleIdx] ) ) );
+		__m128 weightWest = _mm_sub_ps( one, weightEast );
+
+		__m128 blendSouth = Blend4SSE2( weightEast, _mm_loadu_ps( &scratch.corners[1][sampleIdx] ), weightWest, _mm_loadu_ps( &scratch.corners[0][sampleIdx] ) );
+		__m128 blendNorth = Blend4SSE2( weightEast, _mm_loadu_ps( &scratch.corners[3][sampleIdx] ), weightWest, _mm_loadu_ps( &scratch.corners[2][sampleIdx] ) );
+		__m128 blendTotal = Blend4SSE2( weightSouth4, blendSouth, weightNorth4, blendNorth );
+		__m128 noiseThisOctave = _mm_mul_ps( two, _mm_sub_ps( blendTotal, half ) );
+
+		AccumulateOctaveSSE2( scratch, sampleIdx, posX, noiseThisOctave, amplitude4, octaveScale4 );
+	}
+
+	return endSampleIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int BlendPerlinOctaveSSE2( NoiseGridRowScratch& scratch, int width, float displacementSouthY, float displacementNorthY,
+								  float weightSouth, float weightNorth, float amplitude, float octaveScale )
+{
+	__m128 one = _mm_set1_ps( 1.f );
+	__m128 normalizer = _mm_set1_ps( PERLIN_2D_NORMALIZER );
+	__m128 displacementSouthY4 = _mm_set1_ps( displacementSouthY );
+	__m128 displacementNorthY4 = _mm_set1_ps( displacementNorthY );
+	__m128 weightSouth4 = _mm_set1_ps( weightSouth );
+	__m128 weightNorth4 = _mm_set1_ps( weightNorth );
+	__m128 amplitude4 = _mm_set1_ps( amplitude );
+	__m128 octaveScale4 = _mm_set1_ps( octaveScale );
+
+	int endSampleIdx = width & ~3;
+	for ( int sampleIdx = 0; sampleIdx < endSampleIdx; sampleIdx += 4 )
+	{
+		__m128 posX = _mm_loadu_ps( &scratch.posX[sampleIdx] );
+		__m128 cellMinX = _mm_loadu_ps( &scratch.cellMinX[sampleIdx] );
+		__m128 displacementWestX = _mm_sub_ps( posX, cellMinX );
+		__m128 displacementEastX = _mm_sub_ps( posX, _mm_add_ps( cellMinX, one ) );
+
+		__m128 dotSouthWest = Blend4SSE2( _mm_loadu_ps( &scratch.corners[0][sampleIdx] ), displacementWestX, _mm_loadu_ps( &scratch.corners[1][sampleIdx] ), displacementSouthY4 );
+		__m128 dotSouthEast = Blend4SSE2( _mm_loadu_ps( &scratch.corners[2][sampleIdx] ), displacementEastX, _mm_loadu_ps( &scratch.corners[3][sampleIdx] ), displacementSouthY4 );
+		__m128 dotNorthWest = Blend4SSE2( _mm_loadu_ps( &scratch.corners[4][sampleIdx] ), displacementWestX, _mm_loadu_ps( &scratch.corners[5][sampleIdx] ), displacementNorthY4 );
+		__m128 dotNorthEast = Blend4SSE2( _mm_loadu_ps( &scratch.corners[6][sampleIdx] ), displacementEastX, _mm_loadu_ps( &scratch.corners[7][sampleIdx] ), displacementNorthY4 );
+
+		__m128 weightEast = SmoothStep3SSE2( displacementWestX );
+		__m128 weightWest = _mm_sub_ps( one, weightEast );
+
+		__m128 blendSouth = Blend4SSE2( weightEast, dotSouthEast, weightWest, dotSouthWest );
+		__m128 blendNorth = Blend4SSE2( weightEast, dotNorthEast, weightWest, dotNorthWest );
+		__m128 blendTotal = Blend4SSE2( weightSouth4, blendSouth, weightNorth4, blendNorth );
+		__m128 noiseThisOctave = _mm_mul_ps( blendTotal, normalizer );
+
+		AccumulateOctaveSSE2( scratch, sampleIdx, posX, noiseThisOctave, amplitude4, octaveScale4 );
+	}
+
+	return endSampleIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int RenormalizeSSE2( float* totalNoise, int width, float totalAmplitude )
+{
+	__m128 totalAmplitude4 = _mm_set1_ps( totalAmplitude );
+	__m128 half = _mm_set1_ps( 0.5f );
+	__m128 one = _mm_set1_ps( 1.f );
+	__m128 two = _mm_set1_ps( 2.f );
+
+	int endSampleIdx = width & ~3;
+	for ( int sampleIdx = 0; sampleIdx < endSampleIdx; sampleIdx += 4 )
+	{
+		__m128 noise = _mm_div_ps( _mm_loadu_ps( &totalNoise[sampleIdx] ), totalAmplitude4 );
+		noise = _mm_add_ps( _mm_mul_ps( noise, half ), half );
+		noise = SmoothStep3SSE2( noise );
+		_mm_storeu_ps( &totalNoise[sampleIdx], _mm_sub_ps( _mm_mul_ps( noise, two ), one ) );
+	}
+
+	return endSampleIdx;
+}
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+// Grid rows
+//-----------------------------------------------------------------------------------------------
+static void ComputeNoiseGridRows( const NoiseGridParams& params, int firstRow, int endRow )
+{
+	if ( firstRow >= endRow )
+	{
+		return;
+	}
+
+	int width = params.width;
+	NoiseGridRowScratch scratch;
+	scratch.posX.resize( width );
+	scratch.cellMinX.resize( width );
+	scratch.totalNoise.resize( width );
+	for ( int cornerIdx = 0; cornerIdx < 8; ++cornerIdx )
+	{
+		scratch.corners[cornerIdx].resize( width );
+	}
+
+	// Amplitudes don't depend on position, so every sample ends up with the same total
+	std::vector<float> amplitudes( params.numOctaves );
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	for ( unsigned int octaveNum = 0; octaveNum < params.numOctaves; ++octaveNum )
+	{
+		amplitudes[octaveNum] = currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= params.octavePersistence;
+	}
+
+	for ( int rowIdx = firstRow; rowIdx < endRow; ++rowIdx )
+	{
+		float posY = params.originY + (float)rowIdx * params.stepY;
+		float currentPosY = posY * params.invScale;
+
+		for ( int sampleIdx = 0; sampleIdx < width; ++sampleIdx )
+		{
+			float posX = params.originX + (float)sampleIdx * params.stepX;
+			scratch.posX[sampleIdx] = posX * params.invScale;
+			scratch.totalNoise[sampleIdx] = 0.f;
+		}
+
+		unsigned int seed = params.seed;
+		for ( unsigned int octaveNum = 0; octaveNum < params.numOctaves; ++octaveNum )
+		{
+			// Everything in y is shared by the whole row
+			float cellMinY = floorf( currentPosY );
+			float cellMaxY = cellMinY + 1.f;
+			float displacementSouthY = currentPosY - cellMinY;
+			float displacementNorthY = currentPosY - cellMaxY;
+			float weightNorth = SmoothStep3( displacementSouthY );
+			float weightSouth = 1.f - weightNorth;
+
+			GatherCorners( params.type, width, scratch, (int)cellMinY, seed );
+
+			int firstScalarSampleIdx = 0;
+			if ( params.type == eNoiseGridType::PERLIN )
+			{
+#if defined( NOISE_GRID_SIMD )
+				firstScalarSampleIdx = BlendPerlinOctaveSSE2( scratch, width, displacementSouthY, displacementNorthY, weightSouth, weightNorth, amplitudes[octaveNum], params.octaveScale );
+#endif
+				BlendPerlinOctaveScalar( scratch, firstScalarSampleIdx, width, displacementSouthY, displacementNorthY, weightSouth, weightNorth, amplitudes[octaveNum], params.octaveScale );
+			}
+			else
+			{
+#if defined( NOISE_GRID_SIMD )
+				firstScalarSampleIdx = BlendFractalOctaveSSE2( scratch, width, weightSouth, weightNorth, amplitudes[octaveNum], params.octaveScale );
+#endif
+				BlendFractalOctaveScalar( scratch, firstScalarSampleIdx, width, weightSouth, weightNorth, amplitudes[octaveNum], params.octaveScale );
+			}
+
+			currentPosY *= params.octaveScale;
+			currentPosY += OCTAVE_OFFSET;
+			++seed;
+		}
+
+		if ( params.renormalize
+			 && totalAmplitude > 0.f )
+		{
+			int firstScalarSampleIdx = 0;
+#if defined( NOISE_GRID_SIMD )
+			firstScalarSampleIdx = RenormalizeSSE2( scratch.totalNoise.data(), width, totalAmplitude );
+#endif
+			RenormalizeScalar( scratch.totalNoise.data(), firstScalarSampleIdx, width, totalAmplitude );
+		}
+
+		memcpy( params.outValues + (size_t)rowIdx * width, scratch.totalNoise.data(), width * sizeof( float ) );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Splits the rows into contiguous bands, this thread takes the first
+//-----------------------------------------------------------------------------------------------
+static void ComputeNoiseGrid( const NoiseGridParams& params )
+{
+	if ( params.outValues == nullptr
+		 || params.width <= 0
+		 || params.height <= 0 )
+	{
+		return;
+	}
+
+	if ( !s_areNoiseGridJobsEnabled
+		 || g_jobSystem == nullptr )
+	{
+		ComputeNoiseGridRows( params, 0, params.height );
+		return;
+	}
+
+	int minRowsPerBand = Max( MIN_SAMPLES_PER_JOB / params.width, 1 );
+	int numBands = g_jobSystem->GetNumParallelForRanges( params.height, minRowsPerBand );
+	g_jobSystem->ParallelFor( params.height, numBands, [&]( int bandIdx, int firstRow, int endRow )
+	{
+		UNUSED( bandIdx );
+		ComputeNoiseGridRows( params, firstRow, endRow );
+	} );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static NoiseGridParams MakeNoiseGridParams( eNoiseGridType type, float* outValues, int width, int height, const Vec2& origin, const Vec2& step,
+											float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	NoiseGridParams params;
+	params.type = type;
+	params.outValues = outValues;
+	params.width = width;
+	params.height = height;
+	params.originX = origin.x;
+	params.originY = origin.y;
+	params.stepX = step.x;
+	params.stepY = step.y;
+	params.invScale = ( 1.f / scale );
+	params.numOctaves = numOctaves;
+	params.octavePersistence = octavePersistence;
+	params.octaveScale = octaveScale;
+	params.renormalize = renormalize;
+	params.seed = seed;
+
+	return params;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseGrid( float* outValues, int width, int height, const Vec2& origin, const Vec2& step,
+								float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	ComputeNoiseGrid( MakeNoiseGridParams( eNoiseGridType::FRACTAL, outValues, width, height, origin, step, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Compute2dPerlinNoiseGrid( float* outValues, int width, int height, const Vec2& origin, const Vec2& step,
+							   float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	ComputeNoiseGrid( MakeNoiseGridParams( eNoiseGridType::PERLIN, outValues, width, height, origin, step, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SetNoiseGridJobsEnabled( bool areJobsEnabled )
+{
+	s_areNoiseGridJobsEnabled = areJobsEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+//-----------------------------------------------------------------------------------------------
+typedef float ( *Noise2dFn )( float posX, float posY, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed );
+typedef void ( *NoiseGrid2dFn )( float* outValues, int width, int height, const Vec2& origin, const Vec2& step,
+								 float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed );
+
+
+//-----------------------------------------------------------------------------------------------
+struct NoiseGridCheck
+{
+public:
+	int width = 0;
+	int height = 0;
+	Vec2 origin;
+	Vec2 step;
+	float scale = 1.f;
+	bool renormalize = true;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static void ComputeNoiseGridPerSample( Noise2dFn noiseFn, float* outValues, int width, int height, const Vec2& origin, const Vec2& step,
+									   float scale, unsigned int numOctaves, bool renormalize, unsigned int seed )
+{
+	for ( int rowIdx = 0; rowIdx < height; ++rowIdx )
+	{
+		for ( int sampleIdx = 0; sampleIdx < width; ++sampleIdx )
+		{
+			float posX = origin.x + (float)sampleIdx * step.x;
+			float posY = origin.y + (float)rowIdx * step.y;
+			outValues[rowIdx * width + sampleIdx] = noiseFn( posX, posY, scale, numOctaves, 0.5f, 2.f, renormalize, seed );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int CountMismatchedBits( const std::vector<float>& expectedValues, const std::vector<float>& values )
+{
+	int numMismatches = 0;
+	for ( int valueIdx = 0; valueIdx < (int)expectedValues.size(); ++valueIdx )
+	{
+		if ( memcmp( &expectedValues[valueIdx], &values[valueIdx], sizeof( float ) ) != 0 )
+		{
+			++numMismatches;
+		}
+	}
+
+	return numMismatches;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool BenchmarkNoiseGridEvent( EventArgs* args )
+{
+	int width = args->GetValue( "width", 1024 );
+	int height = args->GetValue( "height", 1024 );
+	int numOctaves = args->GetValue( "octaves", 4 );
+	unsigned int seed = (unsigned int)args->GetValue( "seed", 7 );
+	if ( width <= 0
+		 || height <= 0
+		 || numOctaves <= 0 )
+	{
+		g_devConsole->PrintError( "benchmark_noise_grid: width, height and octaves must be positive" );
+		return false;
+	}
+
+	// Odd widths leave SIMD tails, negative steps walk rows backwards, and big steps skip the lattice columns
+	NoiseGridCheck checks[] =
+	{
+		{ 37, 13, Vec2( -5.3f, -7.1f ), Vec2( .37f, .29f ), 3.f, true },
+		{ 29, 7, Vec2( 1000.25f, -3.5f ), Vec2( -1.7f, 2.3f ), .5f, false },
+		{ 17, 5, Vec2( 3.f, 9.f ), Vec2( 250.f, 3.f ), 1.f, true },
+		{ 64, 3, Vec2( 0.f, 0.f ), Vec2( 1.f, 1.f ), 16.f, true },
+	};
+
+	const char* noiseNames[] = { "Fractal", "Perlin" };
+	Noise2dFn noiseFns[] = { &Compute2dFractalNoise, &Compute2dPerlinNoise };
+	NoiseGrid2dFn noiseGridFns[] = { &Compute2dFractalNoiseGrid, &Compute2dPerlinNoiseGrid };
+
+	g_devConsole->PrintString( Stringf( "Noise grid %ix%i, %i octaves", width, height, numOctaves ) );
+
+	for ( int noiseIdx = 0; noiseIdx < 2; ++noiseIdx )
+	{
+		int numCheckMismatches = 0;
+		for ( int checkIdx = 0; checkIdx < (int)( sizeof( checks ) / sizeof( checks[0] ) ); ++checkIdx )
+		{
+			const NoiseGridCheck& check = checks[checkIdx];
+			std::vector<float> expectedValues( check.width * check.height );
+			std::vector<float> gridValues( check.width * check.height );
+			ComputeNoiseGridPerSample( noiseFns[noiseIdx], expectedValues.data(), check.width, check.height, check.origin, check.step, check.scale, numOctaves, check.renormalize, seed );
+			noiseGridFns[noiseIdx]( gridValues.data(), check.width, check.height, check.origin, check.step, check.scale, numOctaves, 0.5f, 2.f, check.renormalize, seed );
+			numCheckMismatches += CountMismatchedBits( expectedValues, gridValues );
+		}
+
+		Vec2 origin( -37.25f, 12.5f );
+		Vec2 step( .125f, .125f );
+		float scale = 8.f;
+		std::vector<float> expectedValues( width * height );
+		std::vector<float> gridValues( width * height );
+
+		double startTime = GetCurrentTimeSeconds();
+		ComputeNoiseGridPerSample( noiseFns[noiseIdx], expectedValues.data(), width, height, origin, step, scale, numOctaves, true, seed );
+		double perSampleSeconds = GetCurrentTimeSeconds() - startTime;
+
+		SetNoiseGridJobsEnabled( false );
+		startTime = GetCurrentTimeSeconds();
+		noiseGridFns[noiseIdx]( gridValues.data(), width, height, origin, step, scale, numOctaves, 0.5f, 2.f, true, seed );
+		double gridSeconds = GetCurrentTimeSeconds() - startTime;
+		int numGridMismatches = CountMismatchedBits( expectedValues, gridValues );
+
+		SetNoiseGridJobsEnabled( true );
+		startTime = GetCurrentTimeSeconds();
+		noiseGridFns[noiseIdx]( gridValues.data(), width, height, origin, step, scale, numOctaves, 0.5f, 2.f, true, seed );
+		double jobsSeconds = GetCurrentTimeSeconds() - startTime;
+		int numJobsMismatches = CountMismatchedBits( expectedValues, gridValues );
+
+		double numMillionSamples = (double)width * (double)height / 1000000.0;
+		g_devConsole->PrintString( Stringf( "  %s: per sample %.2f ms (%.1f M/s), grid %.2f ms (%.2fx), grid with jobs %.2f ms (%.2fx)",
+											noiseNames[noiseIdx],
+											perSampleSeconds * 1000.0, numMillionSamples / perSampleSeconds,
+											gridSeconds * 1000.0, perSampleSeconds / gridSeconds,
+											jobsSeconds * 1000.0, perSampleSeconds / jobsSeconds ) );
+
+		int numMismatches = numCheckMismatches + numGridMismatches + numJobsMismatches;
+		if ( numMismatches == 0 )
+		{
+			g_devConsole->PrintString( "  Every grid value matches the per sample function bit for bit" );
+		}
+		else
+		{
+			g_devConsole->PrintError( Stringf( "  %i grid values differ from the per sample function", numMismatches ) );
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+struct Vec2;
+
+
+//-----------------------------------------------------------------------------------------------
+// Whole grid versions of the 2D noise functions in SmoothNoise.hpp. Sample ( x, y ) is written to
+// outValues[y * width + x] and is bit for bit the value of
+//		Compute2dPerlinNoise( origin.x + (float)x * step.x, origin.y + (float)y * step.y, scale, ... )
+//
+// Rows share their y math, lattice hashes are computed once per lattice column instead of four
+// times per sample, blending runs in SSE2 lanes, and large grids are split into bands of rows
+// on the job system
+//-----------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseGrid( float* outValues, int width, int height, const Vec2& origin, const Vec2& step,
+								float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+void Compute2dPerlinNoiseGrid( float* outValues, int width, int height, const Vec2& origin, const Vec2& step,
+							   float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+
+void SetNoiseGridJobsEnabled( bool areJobsEnabled );		// Mainly for benchmarking
+
+// Console commands
+bool BenchmarkNoiseGridEvent( EventArgs* args );
@@ -0,0 +1,560 @@
+#include "Engine/Math/OBB3BVH.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <algorithm>
+
+
+//-----------------------------------------------------------------------------------------------
+static const int MAX_BOXES_PER_LEAF = 4;
+static const int MAX_TRAVERSAL_STACK_SIZE = 64;
+static const int MIN_RAYS_PER_BATCH_JOB = 64;
+static const float PARALLEL_RAY_EPSILON = 1e-7f;
+
+
+//-----------------------------------------------------------------------------------------------
+static float GetAxisValue( const Vec3& vec, int axisIdx )
+{
+	switch ( axisIdx )
+	{
+		case 0: return vec.x;
+		case 1: return vec.y;
+		default: return vec.z;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void GrowBoundsToIncludePoint( AABB3& bounds, const Vec3& point )
+{
+	bounds.mins = Vec3( Min( bounds.mins.x, point.x ), Min( bounds.mins.y, point.y ), Min( bounds.mins.z, point.z ) );
+	bounds.maxs = Vec3( Max( bounds.maxs.x, point.x ), Max( bounds.maxs.y, point.y ), Max( bounds.maxs.z, point.z ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Components too close to 0 get a huge inverse instead of inf so slab math never makes a NaN
+//-----------------------------------------------------------------------------------------------
+static Vec3 GetInverseForward( const Vec3& forwardNormal )
+{
+	return Vec3( fabsf( forwardNormal.x ) > PARALLEL_RAY_EPSILON ? 1.f / forwardNormal.x : 1e30f,
+				 fabsf( forwardNormal.y ) > PARALLEL_RAY_EPSILON ? 1.f / forwardNormal.y : 1e30f,
+				 fabsf( forwardNormal.z ) > PARALLEL_RAY_EPSILON ? 1.f / forwardNormal.z : 1e30f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void RunRaycastRange( const OBB3BVH& bvh, const std::vector<OBB3Ray>& rays, int firstRayIdx, int endRayIdx,
+							 OBB3RaycastHit* out_hits, byte* out_didHit )
+{
+	for ( int rayIdx = firstRayIdx; rayIdx < endRayIdx; ++rayIdx )
+	{
+		if ( out_hits != nullptr )
+		{
+			out_hits[rayIdx] = bvh.Raycast( rays[rayIdx] );
+		}
+		else
+		{
+			out_didHit[rayIdx] = bvh.RaycastAny( rays[rayIdx] ) ? 1 : 0;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Each range of rays writes only its own results, so any number of batches can run at once
+//-----------------------------------------------------------------------------------------------
+static void RunRaycastBatch( const OBB3BVH& bvh, const std::vector<OBB3Ray>& rays, OBB3RaycastHit* out_hits, byte* out_didHit )
+{
+	int numRays = (int)rays.size();
+	if ( g_jobSystem == nullptr )
+	{
+		RunRaycastRange( bvh, rays, 0, numRays, out_hits, out_didHit );
+		return;
+	}
+
+	int numChunks = g_jobSystem->GetNumParallelForRanges( numRays, MIN_RAYS_PER_BATCH_JOB );
+	g_jobSystem->ParallelFor( numRays, numChunks, [&]( int chunkIdx, int firstRayIdx, int endRayIdx )
+	{
+		UNUSED( chunkIdx );
+		RunRaycastRange( bvh, rays, firstRayIdx, endRayIdx, out_hits, out_didHit );
+	} );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void OBB3BVH::Build( const std::vector<OBB3>& boxes )
+{
+	Clear();
+
+	if ( boxes.empty() )
+	{
+		return;
+	}
+
+	int numBoxes = (int)boxes.size();
+	m_boxes = boxes;
+	m_boxBounds.reserve( numBoxes );
+	m_boxIndexes.reserve( numBoxes );
+	for ( int boxIdx = 0; boxIdx < numBoxes; ++boxIdx )
+	{
+		m_boxBounds.push_back( GetBoundsOfOBB3( m_boxes[boxIdx] ) );
+		m_boxIndexes.push_back( boxIdx );
+	}
+
+	// A full binary tree with at least one box per leaf never needs more than 2n - 1 nodes
+	m_nodes.reserve( 2 * numBoxes );
+	m_nodes.emplace_back();
+	BuildNode( 0, 0, numBoxes, 1 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void OBB3BVH::Clear()
+{
+	m_boxes.clear();
+	m_boxBounds.clear();
+	m_boxIndexes.clear();
+	m_nodes.clear();
+	m_depth = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void OBB3BVH::BuildNode( int nodeIdx, int firstBoxIdx, int numBoxes, int depth )
+{
+	m_depth = Max( m_depth, depth );
+
+	const AABB3& firstBounds = m_boxBounds[m_boxIndexes[firstBoxIdx]];
+	AABB3 bounds = firstBounds;
+	AABB3 centerBounds( firstBounds.GetCenter(), firstBounds.GetCenter() );
+	for ( int boxIdx = firstBoxIdx + 1; boxIdx < firstBoxIdx + numBoxes; ++boxIdx )
+	{
+		const AABB3& boxBounds = m_boxBounds[m_boxIndexes[boxIdx]];
+		GrowBoundsToIncludePoint( bounds, boxBounds.mins );
+		GrowBoundsToIncludePoint( bounds, boxBounds.maxs );
+		GrowBoundsToIncludePoint( centerBounds, boxBounds.GetCenter() );
+	}
+
+	m_nodes[nodeIdx].bounds = bounds;
+
+	Vec3 centerExtents = centerBounds.GetDimensions();
+	int splitAxis = 0;
+	if ( centerExtents.y > GetAxisValue( centerExtents, splitAxis ) ) { splitAxis = 1; }
+	if ( centerExtents.z > GetAxisValue( centerExtents, splitAxis ) ) { splitAxis = 2; }
+
+	// Stacked boxes with the same center can't be split, they all stay in one leaf
+	if ( numBoxes <= MAX_BOXES_PER_LEAF
+		 || GetAxisValue( centerExtents, splitAxis ) <= 0.f )
+	{
+		m_nodes[nodeIdx].firstChildOrBoxIdx = firstBoxIdx;
+		m_nodes[nodeIdx].numBoxes = numBoxes;
+		return;
+	}
+
+	int midBoxIdx = firstBoxIdx + ( numBoxes / 2 );
+	const std::vector<AABB3>& boxBounds = m_boxBounds;
+	std::nth_element( m_boxIndexes.begin() + firstBoxIdx, m_boxIndexes.begin() + midBoxIdx, m_boxIndexes.begin() + firstBoxIdx + numBoxes,
+					  [&boxBounds, splitAxis]( int boxIdx, int otherBoxIdx )
+	{
+		return GetAxisValue( boxBounds[boxIdx].GetCenter(), splitAxis ) < GetAxisValue( boxBounds[otherBoxIdx].GetCenter(), splitAxis );
+	} );
+
+	int leftChildIdx = (int)m_nodes.size();
+	m_nodes.emplace_back();
+	m_nodes.emplace_back();
+
+	m_nodes[nodeIdx].firstChildOrBoxIdx = leftChildIdx;
+	m_nodes[nodeIdx].numBoxes = 0;
+
+	BuildNode( leftChildIdx, firstBoxIdx, midBoxIdx - firstBoxIdx, depth + 1 );
+	BuildNode( leftChildIdx + 1, midBoxIdx, firstBoxIdx + numBoxes - midBoxIdx, depth + 1 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+OBB3RaycastHit OBB3BVH::Raycast( const OBB3Ray& ray, OBB3BVHQueryStats* out_stats ) const
+{
+	OBB3RaycastHit hit;
+	Traverse( ray, false, hit, out_stats );
+	return hit;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool OBB3BVH::RaycastAny( const OBB3Ray& ray, OBB3BVHQueryStats* out_stats ) const
+{
+	OBB3RaycastHit hit;
+	return Traverse( ray, true, hit, out_stats );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void OBB3BVH::RaycastBatch( const std::vector<OBB3Ray>& rays, std::vector<OBB3RaycastHit>& out_hits ) const
+{
+	out_hits.resize( rays.size() );
+	if ( rays.empty() )
+	{
+		return;
+	}
+
+	RunRaycastBatch( *this, rays, &out_hits[0], nullptr );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void OBB3BVH::RaycastAnyBatch( const std::vector<OBB3Ray>& rays, std::vector<byte>& out_didHit ) const
+{
+	out_didHit.resize( rays.size() );
+	if ( rays.empty() )
+	{
+		return;
+	}
+
+	RunRaycastBatch( *this, rays, nullptr, &out_didHit[0] );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Children are pushed far then near so the near one is visited first, and every popped node is
+// tested against the closest hit so far so whole subtrees behind it are skipped
+//-----------------------------------------------------------------------------------------------
+bool OBB3BVH::Traverse( const OBB3Ray& ray, bool stopAtAnyHit, OBB3RaycastHit& out_hit, OBB3BVHQueryStats* out_stats ) const
+{
+	if ( m_nodes.empty() )
+	{
+		return false;
+	}
+
+	Vec3 inverseForward = GetInverseForward( ray.forwardNormal );
+	float closestDist = ray.maxDist;
+
+	int nodeStack[MAX_TRAVERSAL_STACK_SIZE];
+	float entryDistStack[MAX_TRAVERSAL_STACK_SIZE];
+	int stackSize = 0;
+
+	float rootEntryDist = 0.f;
+	if ( !DoesRayOverlapAABB3( ray.startPos, inverseForward, closestDist, m_nodes[0].bounds, rootEntryDist ) )
+	{
+		return false;
+	}
+
+	nodeStack[stackSize] = 0;
+	entryDistStack[stackSize] = rootEntryDist;
+	++stackSize;
+
+	while ( stackSize > 0 )
+	{
+		--stackSize;
+		if ( entryDistStack[stackSize] > closestDist )
+		{
+			continue;
+		}
+
+		const OBB3BVHNode& node = m_nodes[nodeStack[stackSize]];
+		if ( out_stats != nullptr )
+		{
+			++out_stats->numNodesVisited;
+		}
+
+		if ( node.numBoxes > 0 )
+		{
+			for ( int leafIdx = node.firstChildOrBoxIdx; leafIdx < node.firstChildOrBoxIdx + node.numBoxes; ++leafIdx )
+			{
+				int boxIdx = m_boxIndexes[leafIdx];
+				if ( out_stats != nullptr )
+				{
+					++out_stats->numBoxTests;
+				}
+
+				float impactDist = 0.f;
+				Vec3 impactNormal;
+				if ( !RaycastVsOBB3( ray.startPos, ray.forwardNormal, closestDist, m_boxes[boxIdx], impactDist, impactNormal ) )
+				{
+					continue;
+				}
+
+				// Ties go to the lower box index so results don't depend on the build order
+				if ( out_hit.didImpact
+					 && ( impactDist > out_hit.impactDist
+						  || ( impactDist == out_hit.impactDist && boxIdx > out_hit.boxIdx ) ) )
+				{
+					continue;
+				}
+
+				out_hit.didImpact = true;
+				out_hit.boxIdx = boxIdx;
+				out_hit.impactDist = impactDist;
+				out_hit.impactPos = ray.startPos + ray.forwardNormal * impactDist;
+				out_hit.impactSurfaceNormal = impactNormal;
+				closestDist = impactDist;
+
+				if ( stopAtAnyHit )
+				{
+					return true;
+				}
+			}
+
+			continue;
+		}
+
+		int leftChildIdx = node.firstChildOrBoxIdx;
+		int rightChildIdx = leftChildIdx + 1;
+		float leftEntryDist = 0.f;
+		float rightEntryDist = 0.f;
+		bool isLeftHit = DoesRayOverlapAABB3( ray.startPos, inverseForward, closestDist, m_nodes[leftChildIdx].bounds, leftEntryDist );
+		bool isRightHit = DoesRayOverlapAABB3( ray.startPos, inverseForward, closestDist, m_nodes[rightChildIdx].bounds, rightEntryDist );
+
+		ASSERT_OR_DIE( stackSize + 2 <= MAX_TRAVERSAL_STACK_SIZE, "OBB3BVH traversal stack overflow" );
+		if ( isLeftHit && isRightHit )
+		{
+			bool isLeftNearer = leftEntryDist <= rightEntryDist;
+			nodeStack[stackSize] = isLeftNearer ? rightChildIdx : leftChildIdx;
+			entryDistStack[stackSize] = isLeftNearer ? rightEntryDist : leftEntryDist;
+			++stackSize;
+			nodeStack[stackSize] = isLeftNearer ? leftChildIdx : rightChildIdx;
+			entryDistStack[stackSize] = isLeftNearer ? leftEntryDist : rightEntryDist;
+			++stackSize;
+		}
+		else if ( isLeftHit )
+		{
+			nodeStack[stackSize] = leftChildIdx;
+			entryDistStack[stackSize] = leftEntryDist;
+			++stackSize;
+		}
+		else if ( isRightHit )
+		{
+			nodeStack[stackSize] = rightChildIdx;
+			entryDistStack[stackSize] = rightEntryDist;
+			++stackSize;
+		}
+	}
+
+	return out_hit.didImpact;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AABB3 GetBoundsOfOBB3( const OBB3& box )
+{
+	Vec3 kBasis = box.GetKBasisNormal();
+	Vec3 halfExtents( fabsf( box.m_iBasis.x ) * box.m_halfDimensions.x + fabsf( box.m_jBasis.x ) * box.m_halfDimensions.y + fabsf( kBasis.x ) * box.m_halfDimensions.z,
+					  fabsf( box.m_iBasis.y ) * box.m_halfDimensions.x + fabsf( box.m_jBasis.y ) * box.m_halfDimensions.y + fabsf( kBasis.y ) * box.m_halfDimensions.z,
+					  fabsf( box.m_iBasis.z ) * box.m_halfDimensions.x + fabsf( box.m_jBasis.z ) * box.m_halfDimensions.y + fabsf( kBasis.z ) * box.m_halfDimensions.z );
+
+	return AABB3( box.m_center - halfExtents, box.m_center + halfExtents );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool RaycastVsOBB3( const Vec3& startPos, const Vec3& forwardNormal, float maxDist, const OBB3& box, float& out_impactDist, Vec3& out_impactNormal )
+{
+	Vec3 axes[3] = { box.m_iBasis, box.m_jBasis, box.GetKBasisNormal() };
+	float halfDimensions[3] = { box.m_halfDimensions.x, box.m_halfDimensions.y, box.m_halfDimensions.z };
+	Vec3 centerToStart = startPos - box.m_center;
+
+	float entryDist = -1e30f;
+	float exitDist = maxDist;
+	Vec3 entryNormal = -forwardNormal;
+
+	for ( int axisIdx = 0; axisIdx < 3; ++axisIdx )
+	{
+		float localStart = DotProduct3D( centerToStart, axes[axisIdx] );
+		float localForward = DotProduct3D( forwardNormal, axes[axisIdx] );
+
+		if ( fabsf( localForward ) <= PARALLEL_RAY_EPSILON )
+		{
+			// Parallel to this slab, either always between its faces or never
+			if ( fabsf( localStart ) > halfDimensions[axisIdx] )
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		float inverseLocalForward = 1.f / localForward;
+		float nearDist = ( -halfDimensions[axisIdx] - localStart ) * inverseLocalForward;
+		float farDist = ( halfDimensions[axisIdx] - localStart ) * inverseLocalForward;
+		if ( nearDist > farDist )
+		{
+			float tempDist = nearDist;
+			nearDist = farDist;
+			farDist = tempDist;
+		}
+
+		if ( nearDist > entryDist )
+		{
+			entryDist = nearDist;
+			entryNormal = localForward > 0.f ? -axes[axisIdx] : axes[axisIdx];
+		}
+
+		exitDist = Min( exitDist, farDist );
+		if ( entryDist > exitDist )
+		{
+			return false;
+		}
+	}
+
+	if ( exitDist < 0.f )
+	{
+		return false;
+	}
+
+	if ( entryDist <= 0.f )
+	{
+		out_impactDist = 0.f;
+		out_impactNormal = -forwardNormal;
+		return true;
+	}
+
+	out_impactDist = entryDist;
+	out_impactNormal = entryNormal;
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool DoesRayOverlapAABB3( const Vec3& startPos, const Vec3& inverseForward, float maxDist, const AABB3& bounds, float& out_entryDist )
+{
+	float xDist1 = ( bounds.mins.x - startPos.x ) * inverseForward.x;
+	float xDist2 = ( bounds.maxs.x - startPos.x ) * inverseForward.x;
+	float yDist1 = ( bounds.mins.y - startPos.y ) * inverseForward.y;
+	float yDist2 = ( bounds.maxs.y - startPos.y ) * inverseForward.y;
+	float zDist1 = ( bounds.mins.z - startPos.z ) * inverseForward.z;
+	float zDist2 = ( bounds.maxs.z - startPos.z ) * inverseForward.z;
+
+	float entryDist = Max( Max( Min( xDist1, xDist2 ), Min( yDist1, yDist2 ) ), Max( Min( zDist1, zDist2 ), 0.f ) );
+	float exitDist = Min( Min( Max( xDist1, xDist2 ), Max( yDist1, yDist2 ) ), Min( Max( zDist1, zDist2 ), maxDist ) );
+
+	out_entryDist = entryDist;
+	return entryDist <= exitDist;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+//-----------------------------------------------------------------------------------------------
+bool BenchmarkOBB3BVHEvent( EventArgs* args )
+{
+	int numWalls = args->GetValue( "walls", 10000 );
+	int numRays = args->GetValue( "rays", 10000 );
+	float maxDist = args->GetValue( "maxDist", 50.f );
+	if ( numWalls <= 0
+		 || numRays <= 0
+		 || maxDist <= 0.f )
+	{
+		g_devConsole->PrintError( "benchmark_obb3_bvh: walls, rays, and maxDist must be positive" );
+		return false;
+	}
+
+	// Thin upright walls scattered over a square roughly as dense as a line map
+	RandomNumberGenerator rng;
+	float halfWorldSize = sqrtf( (float)numWalls ) * 5.f;
+
+	std::vector<OBB3> walls;
+	walls.reserve( numWalls );
+	for ( int wallIdx = 0; wallIdx < numWalls; ++wallIdx )
+	{
+		Vec2 direction = rng.RollRandomDirection2D();
+		Vec3 center( rng.RollRandomFloatInRange( -halfWorldSize, halfWorldSize ), rng.RollRandomFloatInRange( -halfWorldSize, halfWorldSize ), 1.f );
+		Vec3 dimensions( rng.RollRandomFloatInRange( 1.f, 8.f ), .2f, 2.f );
+		walls.push_back( OBB3( center, dimensions, Vec3( direction, 0.f ), Vec3( direction.GetRotated90Degrees(), 0.f ) ) );
+	}
+
+	std::vector<OBB3Ray> rays;
+	rays.reserve( numRays );
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		OBB3Ray ray;
+		ray.startPos = Vec3( rng.RollRandomFloatInRange( -halfWorldSize, halfWorldSize ), rng.RollRandomFloatInRange( -halfWorldSize, halfWorldSize ), rng.RollRandomFloatInRange( .1f, 1.9f ) );
+		ray.forwardNormal = Vec3( rng.RollRandomDirection2D(), 0.f );
+		ray.maxDist = maxDist;
+		rays.push_back( ray );
+	}
+
+	g_devConsole->PrintString( Stringf( "Casting %i rays against %i walls, max distance %.1f", numRays, numWalls, maxDist ) );
+
+	double startTime = GetCurrentTimeSeconds();
+	OBB3BVH bvh;
+	bvh.Build( walls );
+	double buildSeconds = GetCurrentTimeSeconds() - startTime;
+	g_devConsole->PrintString( Stringf( "  Build: %.2f ms, %i nodes, depth %i", buildSeconds * 1000.0, bvh.GetNumNodes(), bvh.GetDepth() ) );
+
+	// Every wall against every ray as the baseline the hierarchy has to match
+	std::vector<OBB3RaycastHit> bruteForceHits( numRays );
+	startTime = GetCurrentTimeSeconds();
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		const OBB3Ray& ray = rays[rayIdx];
+		OBB3RaycastHit& hit = bruteForceHits[rayIdx];
+		float closestDist = ray.maxDist;
+		for ( int wallIdx = 0; wallIdx < numWalls; ++wallIdx )
+		{
+			float impactDist = 0.f;
+			Vec3 impactNormal;
+			if ( RaycastVsOBB3( ray.startPos, ray.forwardNormal, closestDist, walls[wallIdx], impactDist, impactNormal )
+				 && ( !hit.didImpact || impactDist < hit.impactDist ) )
+			{
+				hit.didImpact = true;
+				hit.boxIdx = wallIdx;
+				hit.impactDist = impactDist;
+				closestDist = impactDist;
+			}
+		}
+	}
+	double bruteForceSeconds = GetCurrentTimeSeconds() - startTime;
+	g_devConsole->PrintString( Stringf( "  Brute force nearest: %.2f ms", bruteForceSeconds * 1000.0 ) );
+
+	std::vector<OBB3RaycastHit> bvhHits( numRays );
+	OBB3BVHQueryStats queryStats;
+	startTime = GetCurrentTimeSeconds();
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		bvhHits[rayIdx] = bvh.Raycast( rays[rayIdx], &queryStats );
+	}
+	double nearestSeconds = GetCurrentTimeSeconds() - startTime;
+
+	int numMismatches = 0;
+	int numHits = 0;
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		numHits += bvhHits[rayIdx].didImpact ? 1 : 0;
+		if ( bvhHits[rayIdx].didImpact != bruteForceHits[rayIdx].didImpact
+			 || ( bvhHits[rayIdx].didImpact && !IsNearlyEqual( bvhHits[rayIdx].impactDist, bruteForceHits[rayIdx].impactDist, .0001f ) ) )
+		{
+			++numMismatches;
+		}
+	}
+
+	g_devConsole->PrintString( Stringf( "  BVH nearest: %.2f ms (%.1fx), %i hits, %i mismatches, %.1f nodes and %.1f walls tested per ray",
+										nearestSeconds * 1000.0, bruteForceSeconds / nearestSeconds, numHits, numMismatches,
+										(float)queryStats.numNodesVisited / (float)numRays, (float)queryStats.numBoxTests / (float)numRays ) );
+
+	startTime = GetCurrentTimeSeconds();
+	int numAnyHits = 0;
+	for ( int rayIdx = 0; rayIdx < numRays; ++rayIdx )
+	{
+		numAnyHits += bvh.RaycastAny( rays[rayIdx] ) ? 1 : 0;
+	}
+	double anySeconds = GetCurrentTimeSeconds() - startTime;
+	g_devConsole->PrintString( Stringf( "  BVH any hit: %.2f ms, %i hits", anySeconds * 1000.0, numAnyHits ) );
+
+	startTime = GetCurrentTimeSeconds();
+	bvh.RaycastBatch( rays, bvhHits );
+	double batchSeconds = GetCurrentTimeSeconds() - startTime;
+
+	std::vector<byte> didHit;
+	startTime = GetCurrentTimeSeconds();
+	bvh.RaycastAnyBatch( rays, didHit );
+	double anyBatchSeconds = GetCurrentTimeSeconds() - startTime;
+
+	g_devConsole->PrintString( Stringf( "  BVH batch nearest: %.2f ms, batch any hit: %.2f ms", batchSeconds * 1000.0, anyBatchSeconds * 1000.0 ) );
+
+	return false;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+struct OBB3Ray
+{
+public:
+	Vec3 startPos;
+	Vec3 forwardNormal;
+	float maxDist = 0.f;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct OBB3RaycastHit
+{
+public:
+	bool didImpact = false;
+	int boxIdx = -1;						// Index into the boxes the hierarchy was built from
+	float impactDist = 0.f;
+	Vec3 impactPos;
+	Vec3 impactSurfaceNormal;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct OBB3BVHNode
+{
+public:
+	AABB3 bounds;
+	int firstChildOrBoxIdx = 0;				// Right child is always firstChild + 1
+	int numBoxes = 0;						// 0 for interior nodes
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct OBB3BVHQueryStats
+{
+public:
+	int numNodesVisited = 0;
+	int numBoxTests = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Static bounding volume hierarchy over a fixed set of OBB3s. Built once top down by splitting
+// the longest axis of the box centers at the median, nodes are stored depth first in one array
+// with siblings next to each other. Boxes can't be moved after Build, rebuild instead
+//-----------------------------------------------------------------------------------------------
+class OBB3BVH
+{
+public:
+	void Build( const std::vector<OBB3>& boxes );
+	void Clear();
+
+	bool IsEmpty() const														{ return m_nodes.empty(); }
+	int GetNumNodes() const														{ return (int)m_nodes.size(); }
+	int GetNumBoxes() const														{ return (int)m_boxes.size(); }
+	int GetDepth() const														{ return m_depth; }
+
+	// Closest hit along the ray, any hit stops at the first box it finds so it suits line of sight
+	OBB3RaycastHit Raycast( const OBB3Ray& ray, OBB3BVHQueryStats* out_stats = nullptr ) const;
+	bool RaycastAny( const OBB3Ray& ray, OBB3BVHQueryStats* out_stats = nullptr ) const;
+
+	// Batches are split across the job system and give the same results as querying one by one
+	void RaycastBatch( const std::vector<OBB3Ray>& rays, std::vector<OBB3RaycastHit>& out_hits ) const;
+	void RaycastAnyBatch( const std::vector<OBB3Ray>& rays, std::vector<byte>& out_didHit ) const;
+
+private:
+	void BuildNode( int nodeIdx, int firstBoxIdx, int numBoxes, int depth );
+	bool Traverse( const OBB3Ray& ray, bool stopAtAnyHit, OBB3RaycastHit& out_hit, OBB3BVHQueryStats* out_stats ) const;
+
+private:
+	std::vector<OBB3> m_boxes;
+	std::vector<AABB3> m_boxBounds;
+	std::vector<int> m_boxIndexes;			// Leaves reference ranges of this, reordered while building
+	std::vector<OBB3BVHNode> m_nodes;
+	int m_depth = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Slab tests, the OBB3 test happens in box space so no matrix is needed. A ray starting inside
+// a box hits it at distance 0 facing back along the ray
+//-----------------------------------------------------------------------------------------------
+AABB3	GetBoundsOfOBB3( const OBB3& box );
+bool	RaycastVsOBB3( const Vec3& startPos, const Vec3& forwardNormal, float maxDist, const OBB3& box, float& out_impactDist, Vec3& out_impactNormal );
+bool	DoesRayOverlapAABB3( const Vec3& startPos, const Vec3& inverseForward, float maxDist, const AABB3& bounds, float& out_entryDist );
+
+// Console commands
+bool	BenchmarkOBB3BVHEvent( EventArgs* args );
@@ -264,6 +264,26 @@ void Polygon2::GetClosestEdge( const Vec2& point, Vec2* out_start, Vec2* out_end
 }
 
 
+//-----------------------------------------------------------------------------------------------
+Vec2 Polygon2::GetFarthestPointInDirection( const Vec2& direction ) const
+{
+	float farthestDist = -INFINITY;
+	Vec2 farthestPt( Vec2::ZERO );
+
+	for ( int pointIdx = 0; pointIdx < (int)m_points.size(); ++pointIdx )
+	{
+		float distToPoint = DotProduct2D( m_points[pointIdx], direction );
+		if ( distToPoint > farthestDist )
+		{
+			farthestDist = distToPoint;
+			farthestPt = m_points[pointIdx];
+		}
+	}
+
+	return farthestPt;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 ConvexHull2D Polygon2::GenerateConvexHull() const
 {
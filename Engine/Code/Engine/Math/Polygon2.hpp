@@ -35,6 +35,7 @@ public:
 	Vec2 GetClosestPoint( const Vec2& point ) const;
 	Vec2 GetClosestPointOnEdge( const Vec2& point ) const;
 	void GetClosestEdge( const Vec2& point, Vec2* out_start, Vec2* out_end ) const;
+	Vec2 GetFarthestPointInDirection( const Vec2& direction ) const;
 
 	ConvexHull2D GenerateConvexHull() const;
 
@@ -1,6 +1,90 @@
 #include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
 #include "Engine/Math/RawNoise.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <cstring>
+#include <vector>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#define RANDOM_FILL_SIMD
+#include <emmintrin.h>
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+// Has to match Get1dNoiseUint in RawNoise.hpp or the fills drift from the single rolls
+static const unsigned int BIT_NOISE1 = 0xd2a80a23;
+static const unsigned int BIT_NOISE2 = 0xa884f197;
+static const unsigned int BIT_NOISE3 = 0x1b56c4e9;
+
+static const unsigned int SUB_STREAM_SALT = 0x5eed5a17;
+
+
+//-----------------------------------------------------------------------------------------------
+// Positions wrap instead of overflowing so long running streams stay well defined
+static int GetPositionAfter( int position, int numRolls )
+{
+	return (int)( (unsigned int)position + (unsigned int)numRolls );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static float ConvertToZeroToOneInclusive( unsigned int randomVal )
+{
+	float scaleFactor = 1.f / (float)0xFFFFFFFF;
+	return (float)randomVal * scaleFactor;
+}
+
+
+#if defined( RANDOM_FILL_SIMD )
+//-----------------------------------------------------------------------------------------------
+// SSE2 has no 32 bit multiply that keeps the low bits, so multiply the even and odd lanes apart
+static inline __m128i MultiplyUints4( __m128i a, __m128i b )
+{
+	__m128i evenProducts = _mm_mul_epu32( a, b );
+	__m128i oddProducts = _mm_mul_epu32( _mm_srli_si128( a, 4 ), _mm_srli_si128( b, 4 ) );
+	return _mm_unpacklo_epi32( _mm_shuffle_epi32( evenProducts, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+							   _mm_shuffle_epi32( oddProducts, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static inline __m128i Get1dNoiseUints4( __m128i positions, __m128i seeds )
+{
+	__m128i mangledBits = MultiplyUints4( positions, _mm_set1_epi32( (int)BIT_NOISE1 ) );
+	mangledBits = _mm_add_epi32( mangledBits, seeds );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 7 ) );
+	mangledBits = _mm_add_epi32( mangledBits, _mm_set1_epi32( (int)BIT_NOISE2 ) );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 8 ) );
+	mangledBits = MultiplyUints4( mangledBits, _mm_set1_epi32( (int)BIT_NOISE3 ) );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 11 ) );
+	return mangledBits;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// cvtepi32 only takes signed ints, converting the two 16 bit halves is exact so the sum rounds
+// once, the same as the scalar ( float ) cast
+//-----------------------------------------------------------------------------------------------
+static inline __m128 ConvertUintsToFloats4( __m128i values )
+{
+	__m128 highHalves = _mm_cvtepi32_ps( _mm_srli_epi32( values, 16 ) );
+	__m128 lowHalves = _mm_cvtepi32_ps( _mm_and_si128( values, _mm_set1_epi32( 0xFFFF ) ) );
+	return _mm_add_ps( _mm_mul_ps( highHalves, _mm_set1_ps( 65536.f ) ), lowHalves );
+}
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+RandomNumberGenerator::RandomNumberGenerator( unsigned int seed, int position )
+	: m_seed( seed )
+	, m_position( position )
+{
+}
 
 
 //-----------------------------------------------------------------------------------------------
@@ -45,8 +129,7 @@ float RandomNumberGenerator::RollRandomFloatZeroToOneInclusive()
 {
 	unsigned int randomVal = Get1dNoiseUint( m_position++, m_seed );
 
-	float scaleFactor = 1.f / (float)0xFFFFFFFF;
-	return (float)randomVal * scaleFactor;
+	return ConvertToZeroToOneInclusive( randomVal );
 }
 
 
@@ -80,9 +163,251 @@ Vec2 RandomNumberGenerator::RollRandomDirection2D()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+unsigned int RandomNumberGenerator::RollRandomUint()
+{
+	return Get1dNoiseUint( m_position++, m_seed );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomUints( unsigned int* outValues, int count )
+{
+	if ( count <= 0 )
+	{
+		return;
+	}
+
+	int valueIdx = 0;
+
+#if defined( RANDOM_FILL_SIMD )
+	__m128i seeds = _mm_set1_epi32( (int)m_seed );
+	__m128i positions = _mm_add_epi32( _mm_set1_epi32( m_position ), _mm_setr_epi32( 0, 1, 2, 3 ) );
+	__m128i positionStep = _mm_set1_epi32( 4 );
+	for ( ; valueIdx + 4 <= count; valueIdx += 4 )
+	{
+		_mm_storeu_si128( (__m128i*)( outValues + valueIdx ), Get1dNoiseUints4( positions, seeds ) );
+		positions = _mm_add_epi32( positions, positionStep );
+	}
+#endif
+
+	for ( ; valueIdx < count; ++valueIdx )
+	{
+		outValues[valueIdx] = Get1dNoiseUint( GetPositionAfter( m_position, valueIdx ), m_seed );
+	}
+
+	SkipAhead( count );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomIntsLessThan( int* outValues, int count, int maxNotInclusive )
+{
+	FillRandomIntsInRange( outValues, count, 0, maxNotInclusive - 1 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Integer division has no SIMD form, only the hashing is batched. Values go through a small
+// buffer so the output is only written once
+//-----------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomIntsInRange( int* outValues, int count, int minInclusive, int maxInclusive )
+{
+	int range = maxInclusive - minInclusive + 1;
+
+	const int BUFFER_SIZE = 64;
+	unsigned int randomVals[BUFFER_SIZE];
+	for ( int firstValueIdx = 0; firstValueIdx < count; firstValueIdx += BUFFER_SIZE )
+	{
+		int numValues = count - firstValueIdx < BUFFER_SIZE ? count - firstValueIdx : BUFFER_SIZE;
+		FillRandomUints( randomVals, numValues );
+
+		int* chunkValues = outValues + firstValueIdx;
+		for ( int valueIdx = 0; valueIdx < numValues; ++valueIdx )
+		{
+			chunkValues[valueIdx] = minInclusive + (int)( randomVals[valueIdx] % range );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomFloatsZeroToOneInclusive( float* outValues, int count )
+{
+	FillRandomFloatsInRange( outValues, count, 0.f, 1.f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomFloatsInRange( float* outValues, int count, float minInclusive, float maxInclusive )
+{
+	if ( count <= 0 )
+	{
+		return;
+	}
+
+	float range = maxInclusive - minInclusive;
+	int valueIdx = 0;
+
+#if defined( RANDOM_FILL_SIMD )
+	__m128i seeds = _mm_set1_epi32( (int)m_seed );
+	__m128i positions = _mm_add_epi32( _mm_set1_epi32( m_position ), _mm_setr_epi32( 0, 1, 2, 3 ) );
+	__m128i positionStep = _mm_set1_epi32( 4 );
+	__m128 scaleFactors = _mm_set1_ps( 1.f / (float)0xFFFFFFFF );
+	__m128 mins = _mm_set1_ps( minInclusive );
+	__m128 ranges = _mm_set1_ps( range );
+	for ( ; valueIdx + 4 <= count; valueIdx += 4 )
+	{
+		__m128 zeroToOnes = _mm_mul_ps( ConvertUintsToFloats4( Get1dNoiseUints4( positions, seeds ) ), scaleFactors );
+		_mm_storeu_ps( outValues + valueIdx, _mm_add_ps( mins, _mm_mul_ps( zeroToOnes, ranges ) ) );
+		positions = _mm_add_epi32( positions, positionStep );
+	}
+#endif
+
+	for ( ; valueIdx < count; ++valueIdx )
+	{
+		unsigned int randomVal = Get1dNoiseUint( GetPositionAfter( m_position, valueIdx ), m_seed );
+		outValues[valueIdx] = minInclusive + ConvertToZeroToOneInclusive( randomVal ) * range;
+	}
+
+	SkipAhead( count );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+RandomNumberGenerator RandomNumberGenerator::GetSubStream( unsigned int streamId ) const
+{
+	unsigned int streamSeedBase = Get1dNoiseUint( (int)m_seed, SUB_STREAM_SALT );
+	return RandomNumberGenerator( Get1dNoiseUint( (int)streamId, streamSeedBase ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+unsigned int RandomNumberGenerator::GetRandomUintAtPosition( int position ) const
+{
+	return Get1dNoiseUint( position, m_seed );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RandomNumberGenerator::SkipAhead( int numRolls )
+{
+	m_position = GetPositionAfter( m_position, numRolls );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void RandomNumberGenerator::Reset( unsigned int seed )
 {
 	m_seed = seed;
 	m_position = 0;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+static int CountMismatchedBits( const void* expectedValues, const void* values, int count )
+{
+	int numMismatches = 0;
+	for ( int valueIdx = 0; valueIdx < count; ++valueIdx )
+	{
+		if ( memcmp( (const unsigned int*)expectedValues + valueIdx, (const unsigned int*)values + valueIdx, sizeof( unsigned int ) ) != 0 )
+		{
+			++numMismatches;
+		}
+	}
+
+	return numMismatches;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool BenchmarkRandomFillEvent( EventArgs* args )
+{
+	int count = args->GetValue( "count", 1 << 20 );
+	unsigned int seed = (unsigned int)args->GetValue( "seed", 7 );
+	if ( count <= 0 )
+	{
+		g_devConsole->PrintError( "benchmark_random_fill: count must be positive" );
+		return false;
+	}
+
+	int startPosition = 12345;
+	RandomNumberGenerator rollRng( seed, startPosition );
+	RandomNumberGenerator fillRng( seed, startPosition );
+
+	std::vector<float> expectedFloats( count );
+	std::vector<float> filledFloats( count );
+	std::vector<int> expectedInts( count );
+	std::vector<int> filledInts( count );
+
+	g_devConsole->PrintString( Stringf( "Random fill of %i values", count ) );
+
+	double startTime = GetCurrentTimeSeconds();
+	for ( int valueIdx = 0; valueIdx < count; ++valueIdx )
+	{
+		expectedFloats[valueIdx] = rollRng.RollRandomFloatInRange( -3.5f, 12.25f );
+	}
+	double rollSeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+	fillRng.FillRandomFloatsInRange( filledFloats.data(), count, -3.5f, 12.25f );
+	double fillSeconds = GetCurrentTimeSeconds() - startTime;
+
+	int numFloatMismatches = CountMismatchedBits( expectedFloats.data(), filledFloats.data(), count );
+	g_devConsole->PrintString( Stringf( "  Floats: rolls %.2f ms, fill %.2f ms (%.2fx)", rollSeconds * 1000.0, fillSeconds * 1000.0, rollSeconds / fillSeconds ) );
+
+	startTime = GetCurrentTimeSeconds();
+	for ( int valueIdx = 0; valueIdx < count; ++valueIdx )
+	{
+		expectedInts[valueIdx] = rollRng.RollRandomIntInRange( -50, 1000 );
+	}
+	rollSeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+	fillRng.FillRandomIntsInRange( filledInts.data(), count, -50, 1000 );
+	fillSeconds = GetCurrentTimeSeconds() - startTime;
+
+	int numIntMismatches = CountMismatchedBits( expectedInts.data(), filledInts.data(), count );
+	g_devConsole->PrintString( Stringf( "  Ints: rolls %.2f ms, fill %.2f ms (%.2fx)", rollSeconds * 1000.0, fillSeconds * 1000.0, rollSeconds / fillSeconds ) );
+
+	// Odd counts leave SIMD tails
+	int tailCount = count < 7 ? count : 7;
+	for ( int valueIdx = 0; valueIdx < tailCount; ++valueIdx )
+	{
+		expectedFloats[valueIdx] = rollRng.RollRandomFloatZeroToOneInclusive();
+	}
+	fillRng.FillRandomFloatsZeroToOneInclusive( filledFloats.data(), tailCount );
+	numFloatMismatches += CountMismatchedBits( expectedFloats.data(), filledFloats.data(), tailCount );
+
+	// Jumping ahead and random access land on the same rolls as rolling there one at a time
+	RandomNumberGenerator skipRng( seed, startPosition );
+	skipRng.SkipAhead( ( 2 * count ) + tailCount );
+	int numStreamMismatches = 0;
+	if ( skipRng.GetPosition() != rollRng.GetPosition()
+		 || fillRng.GetPosition() != rollRng.GetPosition()
+		 || skipRng.GetRandomUintAtPosition( startPosition ) != RandomNumberGenerator( seed, startPosition ).RollRandomUint()
+		 || skipRng.RollRandomUint() != rollRng.RollRandomUint() )
+	{
+		++numStreamMismatches;
+	}
+
+	// Sub-streams depend on the id and seed only
+	RandomNumberGenerator subStream = RandomNumberGenerator( seed ).GetSubStream( 3 );
+	if ( subStream.RollRandomUint() != rollRng.GetSubStream( 3 ).RollRandomUint()
+		 || subStream.GetSeed() == RandomNumberGenerator( seed ).GetSubStream( 4 ).GetSeed() )
+	{
+		++numStreamMismatches;
+	}
+
+	int numMismatches = numFloatMismatches + numIntMismatches + numStreamMismatches;
+	if ( numMismatches == 0 )
+	{
+		g_devConsole->PrintString( "  Every fill matches the single rolls bit for bit" );
+	}
+	else
+	{
+		g_devConsole->PrintError( Stringf( "  %i floats, %i ints and %i stream checks differ from the single rolls", numFloatMismatches, numIntMismatches, numStreamMismatches ) );
+	}
+
+	return false;
+}
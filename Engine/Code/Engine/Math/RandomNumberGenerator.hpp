@@ -1,14 +1,23 @@
 #pragma once
+#include "Engine/Core/EngineCommon.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
 struct Vec2;
 
 
+//-----------------------------------------------------------------------------------------------
+// Counter based, roll n of a generator is Get1dNoiseUint( n, seed ), so any roll can be computed
+// without the ones before it. Code that runs in parallel or has to replay the same way should own
+// a sub-stream ( one per entity, system or job ) instead of sharing a generator, then its rolls
+// don't depend on what anything else rolled first
 //-----------------------------------------------------------------------------------------------
 class RandomNumberGenerator
 {
 public:
+	RandomNumberGenerator() = default;
+	explicit RandomNumberGenerator( unsigned int seed, int position = 0 );
+
 	int 	RollRandomIntLessThan( int maxNotInclusive );
 	int		RollRandomIntInRange( int minInclusive, int maxInclusive );
 	float	RollRandomFloatLessThan( float maxNotInclusive );
@@ -17,6 +26,25 @@ public:
 	float	RollRandomFloatZeroToAlmostOne();
 	bool	RollPercentChance( float probabilityOfReturningTrue );
 	Vec2	RollRandomDirection2D();
+	unsigned int RollRandomUint();
+
+	// Bulk versions, each fill gives the same values bit for bit as calling its Roll function
+	// count times and leaves the generator at the same position
+	void	FillRandomUints( unsigned int* outValues, int count );
+	void	FillRandomIntsLessThan( int* outValues, int count, int maxNotInclusive );
+	void	FillRandomIntsInRange( int* outValues, int count, int minInclusive, int maxInclusive );
+	void	FillRandomFloatsZeroToOneInclusive( float* outValues, int count );
+	void	FillRandomFloatsInRange( float* outValues, int count, float minInclusive, float maxInclusive );
+
+	// Seeded from this generator's seed and the id only, so the same id always gives the same stream
+	// no matter how far this generator has rolled
+	RandomNumberGenerator GetSubStream( unsigned int streamId ) const;
+
+	unsigned int GetRandomUintAtPosition( int position ) const;
+	void	SkipAhead( int numRolls );
+	void	SetPosition( int position )													{ m_position = position; }
+	int		GetPosition() const															{ return m_position; }
+	unsigned int GetSeed() const														{ return m_seed; }
 
 	void	Reset( unsigned int seed = 0 );
 
@@ -24,3 +52,7 @@ private:
 	unsigned int	m_seed = 0;
 	int				m_position = 0;
 };
+
+
+// Console commands
+bool BenchmarkRandomFillEvent( EventArgs* args );
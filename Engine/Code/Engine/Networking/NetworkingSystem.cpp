@@ -155,19 +155,30 @@ TCPSocket* NetworkingSystem::ConnectTCPClientToServer( const std::string& host,
 //-----------------------------------------------------------------------------------------------
 void NetworkingSystem::ProcessTCPCommunication()
 {
-	// Check if we are a server that's listening
-	if ( m_tcpServer->IsListening() )
+	m_tcpReceivedMessages.clear();
+
+	// Check if we are a server that's listening or still has connected clients
+	if ( m_tcpServer->IsListening()
+		 || m_tcpServer->GetNumConnections() > 0 )
 	{
-		if ( !m_serverSocket.IsValid() )
+		m_tcpServer->Service();
+
+		for ( int connectionId : m_tcpServer->GetNewConnectionIds() )
 		{
-			CheckForNewTCPClientConnection();
+			TCPConnection* connection = m_tcpServer->GetConnection( connectionId );
+			g_devConsole->PrintString( Stringf( "Client %i connected from: %s", connectionId, connection->GetAddress().c_str() ) );
+
+			SendServerListeningMessage( connectionId );
 		}
-		else
+
+		for ( const TCPFrameView& frame : m_tcpServer->GetReceivedFrames() )
 		{
-			if ( m_serverSocket.IsDataAvailable() )
-			{
-				ReceiveMessageFromTCPClient();
-			}
+			ProcessFrameFromTCPClient( frame );
+		}
+
+		for ( int connectionId : m_tcpServer->GetClosedConnectionIds() )
+		{
+			g_devConsole->PrintString( Stringf( "Client %i disconnected", connectionId ) );
 		}
 	}
 	// Check if we are a client
@@ -182,27 +193,11 @@ void NetworkingSystem::ProcessTCPCommunication()
 
 
 //-----------------------------------------------------------------------------------------------
-void NetworkingSystem::CheckForNewTCPClientConnection()
+void NetworkingSystem::SendServerListeningMessage( int connectionId )
 {
-	m_serverSocket = m_tcpServer->Accept();
-
-	if ( !m_serverSocket.IsValid() )
-	{
-		return;
-	}
-
-	// We found a new connection, send a server listening and print connection info
-	g_devConsole->PrintString( Stringf( "Client connected from: %s", m_serverSocket.GetAddress().c_str() ) );
-
 	std::string gameName( "Doomenstein" );
-	std::array<char, 256> buffer;
-	MessageHeader* msg = reinterpret_cast<MessageHeader*>( &buffer[0] );
-	msg->id = (uint16_t)eMessasgeProtocolIds::SERVER_LISTENING;
-	msg->size = ( uint16_t )gameName.size();
 
-	memcpy( &buffer[4], gameName.c_str(), msg->size );
-
-	m_serverSocket.Send( &buffer[0], gameName.size() + 4 );
+	m_tcpServer->SendFrame( connectionId, (uint16_t)eMessasgeProtocolIds::SERVER_LISTENING, gameName.c_str(), gameName.size() );
 }
 
 
@@ -221,31 +216,27 @@ void NetworkingSystem::ReceiveMessageFromTCPServer()
 	{
 		case (uint16_t)eMessasgeProtocolIds::SERVER_LISTENING:
 		{
-			const char* dataStr = data.GetData() + 4;
-
-			g_devConsole->PrintString( Stringf( "Connected to game: %s", dataStr ) );
+			g_devConsole->PrintString( Stringf( "Connected to game: %s", std::string( data.GetPayload(), header->size ).c_str() ) );
 		}
 		break;
 
 		case (uint16_t)eMessasgeProtocolIds::SERVER_DISCONNECTING:
 		{
 			m_clientSocket.Close();
-			m_serverSocket.Close();
 			g_devConsole->PrintString( Stringf( "Server disconnected" ) );
 		}
 		break;
 
 		case (uint16_t)eMessasgeProtocolIds::TEXT:
 		{
-			const char* dataStr = data.GetData() + 4;
-
-			g_devConsole->PrintString( Stringf( "Received from server: %s", dataStr ) );
+			g_devConsole->PrintString( Stringf( "Received from server: %s", std::string( data.GetPayload(), header->size ).c_str() ) );
 		}
 		break;
 
 		case (uint16_t)eMessasgeProtocolIds::DATA:
 		{
-			m_tcpReceivedMessages.push_back( data );
+			// The socket's receive buffer isn't touched again until next frame
+			m_tcpReceivedMessages.emplace_back( INVALID_TCP_CONNECTION_ID, header->id, header->size, data.GetPayload() );
 		}
 		break;
 
@@ -260,42 +251,31 @@ void NetworkingSystem::ReceiveMessageFromTCPServer()
 
 
 //-----------------------------------------------------------------------------------------------
-void NetworkingSystem::ReceiveMessageFromTCPClient()
+void NetworkingSystem::ProcessFrameFromTCPClient( const TCPFrameView& frame )
 {
-	TCPData data = m_serverSocket.Receive();
-	if ( data.GetData() == nullptr )
-	{
-		return;
-	}
-
-	// Process message
-	const MessageHeader* header = reinterpret_cast<const MessageHeader*>( data.GetData() );
-	switch ( header->id )
+	switch ( frame.id )
 	{
 		case (uint16_t)eMessasgeProtocolIds::TEXT:
 		{
-			const char* dataStr = data.GetData() + 4;
-			g_devConsole->PrintString( Stringf( "Received from client: %s", dataStr ) );
+			g_devConsole->PrintString( Stringf( "Received from client %i: %s", frame.connectionId, frame.GetPayloadAsString().c_str() ) );
 		}
 		break;
 
 		case (uint16_t)eMessasgeProtocolIds::CLIENT_DISCONNECTING:
 		{
-			m_clientSocket.Close();
-			m_serverSocket.Close();
-			g_devConsole->PrintString( Stringf( "Client disconnected" ) );
+			m_tcpServer->CloseConnection( frame.connectionId );
 		}
 		break;
 
 		case (uint16_t)eMessasgeProtocolIds::DATA:
 		{
-			m_tcpReceivedMessages.push_back( data );
+			m_tcpReceivedMessages.push_back( frame );
 		}
 		break;
 
 		default:
 		{
-			g_devConsole->PrintError( Stringf( "Received msg with unknown id: %i", header->id ) );
+			g_devConsole->PrintError( Stringf( "Received msg with unknown id: %i from client %i", frame.id, frame.connectionId ) );
 			return;
 		}
 		break;	
@@ -654,77 +634,70 @@ void NetworkingSystem::DisconnectTCPServer( EventArgs* args )
 //-----------------------------------------------------------------------------------------------
 void NetworkingSystem::DisconnectTCPServer()
 {
-	if ( m_serverSocket.IsValid() )
-	{
-		ServerDisconnectingMsg msg;
-		msg.header.id = (uint16_t)eMessasgeProtocolIds::SERVER_DISCONNECTING;
-		msg.header.size = 0;
-
-		m_serverSocket.Send( reinterpret_cast<char*>( &msg ), msg.GetSize() );
-	}
-
-	m_serverSocket.Close();
+	m_tcpServer->BroadcastFrame( (uint16_t)eMessasgeProtocolIds::SERVER_DISCONNECTING, nullptr, 0 );
+	m_tcpServer->CloseAllConnections();
+	m_tcpReceivedMessages.clear();
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void NetworkingSystem::SendTCPMessage( void* data, size_t dataSize )
 {
-	std::array<char, 256> buffer;
-	MessageHeader* msgHeader = reinterpret_cast<MessageHeader*>( &buffer[0] );
-
-	msgHeader->id = (uint16_t)eMessasgeProtocolIds::DATA;
-	msgHeader->size = (uint16_t)dataSize;
-
-	memcpy( &buffer[4], data, msgHeader->size );
-
 	// Send from server to clients
-	if ( m_serverSocket.IsValid() )
+	if ( m_tcpServer->GetNumConnections() > 0 )
 	{
-		m_serverSocket.Send( &buffer[0], msgHeader->size + 4 );
+		int numQueued = m_tcpServer->BroadcastFrame( (uint16_t)eMessasgeProtocolIds::DATA, data, dataSize );
+		if ( numQueued < m_tcpServer->GetNumConnections() )
+		{
+			g_devConsole->PrintError( Stringf( "Networking System: message dropped for %i slow client(s)", m_tcpServer->GetNumConnections() - numQueued ) );
+		}
 	}
 
 	// Send from client to servers
 	else if ( m_clientSocket.IsValid() )
 	{
+		std::array<char, 256> buffer;
+		MessageHeader* msgHeader = reinterpret_cast<MessageHeader*>( &buffer[0] );
+
+		msgHeader->id = (uint16_t)eMessasgeProtocolIds::DATA;
+		msgHeader->size = (uint16_t)dataSize;
+
+		memcpy( &buffer[4], data, msgHeader->size );
+
 		m_clientSocket.Send( &buffer[0], msgHeader->size + 4 );
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void NetworkingSystem::SendTCPTextMessage( const std::string& text )
+bool NetworkingSystem::SendTCPMessageToConnection( int connectionId, void* data, size_t dataSize )
 {
-	std::array<char, 256> buffer;
-	MessageHeader* msgHeader = reinterpret_cast<MessageHeader*>( &buffer[0] );
-
-	msgHeader->id = (uint16_t)eMessasgeProtocolIds::TEXT;
-	msgHeader->size = (uint16_t)text.size();
+	return m_tcpServer->SendFrame( connectionId, (uint16_t)eMessasgeProtocolIds::DATA, data, dataSize );
+}
 
-	memcpy( &buffer[4], text.c_str(), msgHeader->size );
 
+//-----------------------------------------------------------------------------------------------
+void NetworkingSystem::SendTCPTextMessage( const std::string& text )
+{
 	// Send from server to clients
-	if ( m_serverSocket.IsValid() )
+	if ( m_tcpServer->GetNumConnections() > 0 )
 	{
-		m_serverSocket.Send( &buffer[0], msgHeader->size + 4 );
+		m_tcpServer->BroadcastFrame( (uint16_t)eMessasgeProtocolIds::TEXT, text.c_str(), text.size() );
 	}
 
 	// Send from client to servers
 	else if ( m_clientSocket.IsValid() )
 	{
-		m_clientSocket.Send( &buffer[0], msgHeader->size + 4 );
-	}
-}
+		std::array<char, 256> buffer;
+		MessageHeader* msgHeader = reinterpret_cast<MessageHeader*>( &buffer[0] );
 
+		msgHeader->id = (uint16_t)eMessasgeProtocolIds::TEXT;
+		msgHeader->size = (uint16_t)text.size();
 
-//-----------------------------------------------------------------------------------------------
-std::vector<TCPData> NetworkingSystem::ReceiveTCPMessages()
-{
-	std::vector<TCPData> newMessages = m_tcpReceivedMessages;
+		memcpy( &buffer[4], text.c_str(), msgHeader->size );
 
-	m_tcpReceivedMessages.clear();
-
-	return newMessages;
+		m_clientSocket.Send( &buffer[0], msgHeader->size + 4 );
+	}
 }
 
 
@@ -4,6 +4,7 @@
 #include "Engine/Core/SynchronizedNonBlockingQueue.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Networking/MessageProtocols.hpp"
+#include "Engine/Networking/TCPConnection.hpp"
 #include "Engine/Networking/TCPSocket.hpp"
 #include "Engine/Networking/UDPSocket.hpp"
 
@@ -97,9 +98,11 @@ public:
 	void DisconnectTCPClient();
 	void DisconnectTCPServer();
 	void SendTCPMessage( void* data, size_t dataSize );
+	bool SendTCPMessageToConnection( int connectionId, void* data, size_t dataSize );
 	void SendTCPTextMessage( const std::string& text );
 
-	std::vector<TCPData> ReceiveTCPMessages();
+	// Views are valid until the next BeginFrame
+	const std::vector<TCPFrameView>& ReceiveTCPMessages() const				{ return m_tcpReceivedMessages; }
 	std::vector<UDPData>& ReceiveUDPMessages();
 
 	// UDP
@@ -112,9 +115,9 @@ public:
 private:
 	// TCP
 	void ProcessTCPCommunication();
-	void CheckForNewTCPClientConnection();
+	void SendServerListeningMessage( int connectionId );
 	void ReceiveMessageFromTCPServer();
-	void ReceiveMessageFromTCPClient();
+	void ProcessFrameFromTCPClient( const TCPFrameView& frame );
 
 	// UDP
 	void ProcessUDPCommunication();
@@ -138,13 +141,12 @@ private:
 	UniqueMessageId GetNextUniqueMessageId();
 
 private:
-	// Just one server for now, can be array later
+	// One server with many client connections, or one client connected to a remote server
 	TCPServer* m_tcpServer = nullptr;
 	TCPClient* m_tcpClient = nullptr;
-	TCPSocket m_serverSocket;
 	TCPSocket m_clientSocket;
 
-	std::vector<TCPData> m_tcpReceivedMessages;
+	std::vector<TCPFrameView> m_tcpReceivedMessages;
 	std::vector<UDPData> m_udpReceivedMessages;
 
 	std::map<int, UDPSocket*> m_outgoingUDPSockets;
@@ -0,0 +1,212 @@
+#include "Engine/Networking/TCPConnection.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#include <array>
+
+
+//-----------------------------------------------------------------------------------------------
+TCPConnection::TCPConnection( int id, SOCKET socket, size_t receiveBufferSize, size_t sendBufferSize )
+	: m_id( id )
+	, m_socket( socket )
+	, m_receiveBuffer( receiveBufferSize )
+	, m_sendBuffer( sendBufferSize )
+{
+	GUARANTEE_OR_DIE( m_receiveBuffer.GetCapacity() >= sizeof( MessageHeader ) + TCP_MAX_FRAME_PAYLOAD_SIZE, "TCPConnection receive buffer is too small to hold a full frame" );
+
+	m_wrappedFrameScratch.resize( TCP_MAX_FRAME_PAYLOAD_SIZE );
+	m_address = QueryPeerAddress();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+TCPConnection::~TCPConnection()
+{
+	Close();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TCPConnection::QueueFrame( uint16_t id, const void* payload, size_t payloadSize )
+{
+	if ( !IsOpen() )
+	{
+		return false;
+	}
+
+	if ( payloadSize > TCP_MAX_FRAME_PAYLOAD_SIZE )
+	{
+		LOG_ERROR( "Networking System: frame of size '%i' is larger than the max frame size", (int)payloadSize );
+		return false;
+	}
+
+	if ( m_sendBuffer.GetFreeBytes() < sizeof( MessageHeader ) + payloadSize )
+	{
+		++m_numRejectedFrames;
+		return false;
+	}
+
+	MessageHeader header;
+	header.id = id;
+	header.size = (uint16_t)payloadSize;
+
+	m_sendBuffer.Write( &header, sizeof( header ) );
+	if ( payloadSize > 0 )
+	{
+		m_sendBuffer.Write( payload, payloadSize );
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TCPConnection::ReceiveAvailableData()
+{
+	while ( IsOpen() )
+	{
+		size_t regionSize = 0;
+		char* region = m_receiveBuffer.GetContiguousWriteRegion( regionSize );
+		if ( regionSize == 0 )
+		{
+			// Receive buffer is full, leave the rest in the socket so tcp flow control pushes back on the sender
+			return true;
+		}
+
+		int iResult = recv( m_socket, region, (int)regionSize, 0 );
+		if ( iResult == 0 )
+		{
+			return false;
+		}
+
+		if ( iResult == SOCKET_ERROR )
+		{
+			int errorCode = WSAGetLastError();
+			if ( errorCode == WSAEWOULDBLOCK )
+			{
+				return true;
+			}
+
+			LOG_ERROR( "Networking System: recv failed with '%i'", errorCode );
+			return false;
+		}
+
+		m_receiveBuffer.CommitWrite( (size_t)iResult );
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TCPConnection::FlushSendBuffer()
+{
+	while ( HasPendingSends() )
+	{
+		size_t regionSize = 0;
+		const char* region = m_sendBuffer.GetContiguousReadRegion( 0, regionSize );
+
+		int iResult = send( m_socket, region, (int)regionSize, 0 );
+		if ( iResult == SOCKET_ERROR )
+		{
+			int errorCode = WSAGetLastError();
+			if ( errorCode == WSAEWOULDBLOCK )
+			{
+				return true;
+			}
+
+			LOG_ERROR( "Networking System: send failed with '%i'", errorCode );
+			return false;
+		}
+
+		m_sendBuffer.Consume( (size_t)iResult );
+	}
+
+	return IsOpen();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPConnection::ParseFrames( std::vector<TCPFrameView>& out_frames )
+{
+	bool hasUsedScratch = false;
+
+	while ( m_receiveBuffer.GetUsedBytes() - m_parsedBytes >= sizeof( MessageHeader ) )
+	{
+		MessageHeader header;
+		m_receiveBuffer.CopyOut( m_parsedBytes, &header, sizeof( header ) );
+
+		size_t frameSize = sizeof( MessageHeader ) + header.size;
+		if ( m_receiveBuffer.GetUsedBytes() - m_parsedBytes < frameSize )
+		{
+			// Wait for the rest of the frame
+			return;
+		}
+
+		size_t payloadOffset = m_parsedBytes + sizeof( MessageHeader );
+		const char* payload = nullptr;
+		if ( header.size > 0 )
+		{
+			size_t contiguousSize = 0;
+			payload = m_receiveBuffer.GetContiguousReadRegion( payloadOffset, contiguousSize );
+			if ( contiguousSize < header.size )
+			{
+				// Only one frame per release can straddle the end of the ring
+				if ( hasUsedScratch )
+				{
+					return;
+				}
+
+				m_receiveBuffer.CopyOut( payloadOffset, &m_wrappedFrameScratch[0], header.size );
+				payload = &m_wrappedFrameScratch[0];
+				hasUsedScratch = true;
+			}
+		}
+
+		out_frames.emplace_back( m_id, header.id, header.size, payload );
+		m_parsedBytes += frameSize;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPConnection::ReleaseParsedFrames()
+{
+	m_receiveBuffer.Consume( m_parsedBytes );
+	m_parsedBytes = 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPConnection::Close()
+{
+	if ( m_socket != INVALID_SOCKET )
+	{
+		closesocket( m_socket );
+		m_socket = INVALID_SOCKET;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+std::string TCPConnection::QueryPeerAddress() const
+{
+	std::array<char, 128> addressStr;
+
+	sockaddr clientAddr;
+	int addrSize = sizeof( clientAddr );
+	int iResult = getpeername( m_socket, &clientAddr, &addrSize );
+	if ( iResult == SOCKET_ERROR )
+	{
+		return "";
+	}
+
+	DWORD outlen = (DWORD)addressStr.size();
+	iResult = WSAAddressToStringA( &clientAddr, addrSize, NULL, &addressStr[0], &outlen );
+	if ( iResult == SOCKET_ERROR )
+	{
+		return "";
+	}
+
+	return std::string( &addressStr[0] );
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "Engine/Core/ByteRingBuffer.hpp"
+#include "Engine/Networking/NetworkingCommon.hpp"
+#include "Engine/Networking/MessageProtocols.hpp"
+
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int INVALID_TCP_CONNECTION_ID = -1;
+constexpr size_t TCP_MAX_FRAME_PAYLOAD_SIZE = 0xFFFF;
+constexpr size_t TCP_DEFAULT_RECEIVE_BUFFER_SIZE = 128 * 1024;
+constexpr size_t TCP_DEFAULT_SEND_BUFFER_SIZE = 128 * 1024;
+
+
+//-----------------------------------------------------------------------------------------------
+// A single length-prefixed frame, the payload points into the owning connection's receive buffer
+// and is only valid until the next time the owner is serviced
+//-----------------------------------------------------------------------------------------------
+struct TCPFrameView
+{
+public:
+	int connectionId = INVALID_TCP_CONNECTION_ID;
+	uint16_t id = 0;
+	uint16_t size = 0;
+	const char* payload = nullptr;
+
+public:
+	TCPFrameView() = default;
+	TCPFrameView( int connectionId, uint16_t id, uint16_t size, const char* payload )
+		: connectionId( connectionId )
+		, id( id )
+		, size( size )
+		, payload( payload )
+	{}
+
+	std::string GetPayloadAsString() const						{ return std::string( payload, size ); }
+};
+
+
+//-----------------------------------------------------------------------------------------------
+class TCPConnection
+{
+	friend class TCPServer;
+
+public:
+	TCPConnection( int id, SOCKET socket, size_t receiveBufferSize = TCP_DEFAULT_RECEIVE_BUFFER_SIZE, size_t sendBufferSize = TCP_DEFAULT_SEND_BUFFER_SIZE );
+	~TCPConnection();
+
+	int				GetId() const								{ return m_id; }
+	SOCKET			GetSocket() const							{ return m_socket; }
+	bool			IsOpen() const								{ return m_socket != INVALID_SOCKET; }
+	std::string		GetAddress() const							{ return m_address; }
+
+	bool			CanReceive() const							{ return IsOpen() && !m_receiveBuffer.IsFull(); }
+	bool			HasPendingSends() const						{ return IsOpen() && !m_sendBuffer.IsEmpty(); }
+	size_t			GetPendingSendBytes() const					{ return m_sendBuffer.GetUsedBytes(); }
+	int				GetNumRejectedFrames() const				{ return m_numRejectedFrames; }
+
+	// Returns false when the send buffer is full, callers should hold the frame and retry later
+	bool QueueFrame( uint16_t id, const void* payload, size_t payloadSize );
+
+	bool ReceiveAvailableData();
+	bool FlushSendBuffer();
+	void ParseFrames( std::vector<TCPFrameView>& out_frames );
+	void ReleaseParsedFrames();
+
+	void Close();
+
+private:
+	std::string QueryPeerAddress() const;
+
+private:
+	int m_id = INVALID_TCP_CONNECTION_ID;
+	SOCKET m_socket = INVALID_SOCKET;
+	std::string m_address;
+
+	ByteRingBuffer m_receiveBuffer;
+	ByteRingBuffer m_sendBuffer;
+
+	// Frames handed out since the last release, only a frame straddling the end of the
+	// receive ring is copied into the scratch buffer to give it a contiguous payload
+	size_t m_parsedBytes = 0;
+	std::vector<char> m_wrappedFrameScratch;
+
+	int m_numRejectedFrames = 0;
+};
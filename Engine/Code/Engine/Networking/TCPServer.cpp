@@ -7,10 +7,21 @@
 
 
 //-----------------------------------------------------------------------------------------------
-TCPServer::TCPServer( eBlockingMode mode )
+TCPServer::TCPServer( eBlockingMode mode, int maxConnections )
 	: m_blockingMode( mode )
+	, m_maxConnections( maxConnections )
 {
 	FD_ZERO( &m_listenSet );
+
+	m_connections.reserve( maxConnections );
+	m_pollFds.reserve( maxConnections + 1 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+TCPServer::~TCPServer()
+{
+	CloseAllConnections();
 }
 
 
@@ -62,6 +73,7 @@ bool TCPServer::Bind( int port )
 
 	freeaddrinfo( addrInfoOut );
 
+	m_listenPort = port;
 	return true;
 }
 
@@ -134,3 +146,242 @@ TCPSocket TCPServer::Accept()
 
 	return TCPSocket( socket, m_blockingMode );
 }
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPServer::Service()
+{
+	ReleaseReceivedFrames();
+	RemoveClosedConnections();
+
+	m_newConnectionIds.clear();
+	m_closedConnectionIds.clear();
+
+	if ( !m_isListening
+		 && m_connections.empty() )
+	{
+		return;
+	}
+
+	// Poll the listen socket and every connection at once instead of selecting on each socket
+	m_pollFds.clear();
+
+	WSAPOLLFD listenFd;
+	listenFd.fd = m_listenSocket;
+	listenFd.events = m_isListening ? POLLRDNORM : 0;
+	listenFd.revents = 0;
+	m_pollFds.push_back( listenFd );
+
+	for ( int connectionIdx = 0; connectionIdx < (int)m_connections.size(); ++connectionIdx )
+	{
+		TCPConnection* connection = m_connections[connectionIdx];
+
+		WSAPOLLFD connectionFd;
+		connectionFd.fd = connection->GetSocket();
+		connectionFd.events = 0;
+		connectionFd.revents = 0;
+
+		// A full receive buffer stops reading so tcp flow control applies backpressure to the client
+		if ( connection->CanReceive() )
+		{
+			connectionFd.events |= POLLRDNORM;
+		}
+
+		if ( connection->HasPendingSends() )
+		{
+			connectionFd.events |= POLLWRNORM;
+		}
+
+		m_pollFds.push_back( connectionFd );
+	}
+
+	// The listen socket is invalid once listening stops, skip it so poll doesn't reject the set
+	WSAPOLLFD* pollFds = m_isListening ? &m_pollFds[0] : &m_pollFds[1];
+	ULONG numPollFds = m_isListening ? (ULONG)m_pollFds.size() : (ULONG)m_pollFds.size() - 1;
+	if ( numPollFds == 0 )
+	{
+		return;
+	}
+
+	int iResult = WSAPoll( pollFds, numPollFds, 0 );
+	if ( iResult == SOCKET_ERROR )
+	{
+		g_devConsole->PrintError( Stringf( "Networking System: WSAPoll failed with '%i'", WSAGetLastError() ) );
+		return;
+	}
+
+	// Connections are serviced before accepting so new connections don't shift the poll indices
+	for ( int connectionIdx = 0; connectionIdx < (int)m_connections.size(); ++connectionIdx )
+	{
+		TCPConnection* connection = m_connections[connectionIdx];
+		const WSAPOLLFD& connectionFd = m_pollFds[connectionIdx + 1];
+
+		bool isStillOpen = true;
+		if ( connectionFd.revents & ( POLLRDNORM | POLLHUP ) )
+		{
+			isStillOpen = connection->ReceiveAvailableData();
+		}
+
+		if ( isStillOpen
+			 && ( connectionFd.revents & POLLWRNORM ) )
+		{
+			isStillOpen = connection->FlushSendBuffer();
+		}
+
+		if ( connectionFd.revents & ( POLLERR | POLLNVAL ) )
+		{
+			isStillOpen = false;
+		}
+
+		// Frames received before a disconnect are still handed out this service
+		connection->ParseFrames( m_receivedFrames );
+
+		if ( !isStillOpen )
+		{
+			connection->Close();
+			m_closedConnectionIds.push_back( connection->GetId() );
+		}
+	}
+
+	if ( m_isListening
+		 && ( m_pollFds[0].revents & POLLRDNORM ) )
+	{
+		AcceptNewConnections();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPServer::CloseAllConnections()
+{
+	ReleaseReceivedFrames();
+
+	for ( int connectionIdx = 0; connectionIdx < (int)m_connections.size(); ++connectionIdx )
+	{
+		m_connections[connectionIdx]->FlushSendBuffer();
+		m_connections[connectionIdx]->Close();
+	}
+
+	PTR_VECTOR_SAFE_DELETE( m_connections );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TCPServer::SendFrame( int connectionId, uint16_t id, const void* payload, size_t payloadSize )
+{
+	TCPConnection* connection = GetConnection( connectionId );
+	if ( connection == nullptr )
+	{
+		return false;
+	}
+
+	return connection->QueueFrame( id, payload, payloadSize );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int TCPServer::BroadcastFrame( uint16_t id, const void* payload, size_t payloadSize )
+{
+	int numQueued = 0;
+	for ( int connectionIdx = 0; connectionIdx < (int)m_connections.size(); ++connectionIdx )
+	{
+		if ( m_connections[connectionIdx]->QueueFrame( id, payload, payloadSize ) )
+		{
+			++numQueued;
+		}
+	}
+
+	return numQueued;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPServer::CloseConnection( int connectionId )
+{
+	TCPConnection* connection = GetConnection( connectionId );
+	if ( connection == nullptr
+		 || !connection->IsOpen() )
+	{
+		return;
+	}
+
+	// Give queued frames like a disconnect notice a chance to go out before closing
+	connection->FlushSendBuffer();
+	connection->Close();
+	m_closedConnectionIds.push_back( connectionId );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+TCPConnection* TCPServer::GetConnection( int connectionId ) const
+{
+	for ( int connectionIdx = 0; connectionIdx < (int)m_connections.size(); ++connectionIdx )
+	{
+		if ( m_connections[connectionIdx]->GetId() == connectionId )
+		{
+			return m_connections[connectionIdx];
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPServer::ReleaseReceivedFrames()
+{
+	for ( int connectionIdx = 0; connectionIdx < (int)m_connections.size(); ++connectionIdx )
+	{
+		m_connections[connectionIdx]->ReleaseParsedFrames();
+	}
+
+	m_receivedFrames.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPServer::RemoveClosedConnections()
+{
+	int numConnections = (int)m_connections.size();
+	for ( int connectionIdx = numConnections - 1; connectionIdx >= 0; --connectionIdx )
+	{
+		TCPConnection*& connection = m_connections[connectionIdx];
+		if ( !connection->IsOpen() )
+		{
+			PTR_SAFE_DELETE( connection );
+			connection = m_connections.back();
+			m_connections.pop_back();
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TCPServer::AcceptNewConnections()
+{
+	while ( true )
+	{
+		SOCKET socket = accept( m_listenSocket, NULL, NULL );
+		if ( socket == INVALID_SOCKET )
+		{
+			int errorCode = WSAGetLastError();
+			if ( errorCode != WSAEWOULDBLOCK )
+			{
+				g_devConsole->PrintError( Stringf( "Networking System: client socket accept failed with '%i'", errorCode ) );
+			}
+			return;
+		}
+
+		if ( (int)m_connections.size() >= m_maxConnections )
+		{
+			g_devConsole->PrintError( Stringf( "Networking System: rejected client, server already has the max of '%i' connections", m_maxConnections ) );
+			closesocket( socket );
+			continue;
+		}
+
+		// Sockets accepted from the non-blocking listen socket are non-blocking too
+		TCPConnection* connection = new TCPConnection( m_nextConnectionId++, socket );
+		m_connections.push_back( connection );
+		m_newConnectionIds.push_back( connection->GetId() );
+	}
+}
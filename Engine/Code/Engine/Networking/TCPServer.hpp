@@ -1,5 +1,8 @@
 #pragma once
 #include "Engine/Networking/NetworkingCommon.hpp"
+#include "Engine/Networking/TCPConnection.hpp"
+
+#include <vector>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -12,10 +15,10 @@ class TCPServer
 	friend class NetworkingSystem;
 
 private:
-	TCPServer( eBlockingMode mode = eBlockingMode::BLOCKING );
+	TCPServer( eBlockingMode mode = eBlockingMode::BLOCKING, int maxConnections = 32 );
 
 public:
-	~TCPServer() = default;
+	~TCPServer();
 
 	bool IsListening() const								{ return m_isListening; }
 
@@ -24,6 +27,25 @@ public:
 	bool StopListening();
 	TCPSocket Accept();
 
+	// Multiple client connections
+	void Service();
+	void CloseAllConnections();
+
+	bool SendFrame( int connectionId, uint16_t id, const void* payload, size_t payloadSize );
+	int BroadcastFrame( uint16_t id, const void* payload, size_t payloadSize );
+	void CloseConnection( int connectionId );
+
+	const std::vector<TCPFrameView>& GetReceivedFrames() const		{ return m_receivedFrames; }
+	const std::vector<int>& GetNewConnectionIds() const				{ return m_newConnectionIds; }
+	const std::vector<int>& GetClosedConnectionIds() const			{ return m_closedConnectionIds; }
+	int GetNumConnections() const									{ return (int)m_connections.size(); }
+	TCPConnection* GetConnection( int connectionId ) const;
+
+private:
+	void ReleaseReceivedFrames();
+	void RemoveClosedConnections();
+	void AcceptNewConnections();
+
 private:
 	eBlockingMode m_blockingMode = eBlockingMode::INVALID;
 	FD_SET m_listenSet;
@@ -32,4 +54,14 @@ private:
 
 	bool m_isListening = false;
 	int m_listenPort = -1;
+
+	int m_maxConnections = 0;
+	int m_nextConnectionId = 0;
+	std::vector<TCPConnection*> m_connections;
+	std::vector<WSAPOLLFD> m_pollFds;
+
+	// Reused every service so steady state receiving doesn't allocate
+	std::vector<TCPFrameView> m_receivedFrames;
+	std::vector<int> m_newConnectionIds;
+	std::vector<int> m_closedConnectionIds;
 };
@@ -0,0 +1,1221 @@
+#include "Engine/Pathfinding/GridPathfinder.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <algorithm>
+
+
+//-----------------------------------------------------------------------------------------------
+static const float DIAGONAL_STEP_COST = 1.41421356f;
+static const int MIN_PATHS_PER_BATCH_JOB = 4;
+static const int MAX_CACHED_PATHS = 4096;
+static const int MAX_FLOW_FIELDS = 8;
+static const int MAX_STALE_PATH_RETRIES = 2;				// Past this a stale answer is delivered as is
+
+// Orthogonal steps first so ties in the flow field prefer straight moves
+static const int NUM_STEP_DIRECTIONS = 8;
+static const IntVec2 STEP_DIRECTIONS[NUM_STEP_DIRECTIONS] =
+{
+	IntVec2( 1, 0 ), IntVec2( -1, 0 ), IntVec2( 0, 1 ), IntVec2( 0, -1 ),
+	IntVec2( 1, 1 ), IntVec2( -1, 1 ), IntVec2( 1, -1 ), IntVec2( -1, -1 )
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct PathOpenNode
+{
+	float priority = 0.f;
+	int cellIdx = 0;
+
+	bool operator<( const PathOpenNode& other ) const				{ return priority > other.priority; }		// Min heap
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static float GetOctileDistance( int xCoord, int yCoord, int otherXCoord, int otherYCoord )
+{
+	int xDist = abs( otherXCoord - xCoord );
+	int yDist = abs( otherYCoord - yCoord );
+	return (float)( xDist + yDist ) + ( DIAGONAL_STEP_COST - 2.f ) * (float)Min( xDist, yDist );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static float GetStepCost( int xDir, int yDir )
+{
+	return ( xDir != 0 && yDir != 0 ) ? DIAGONAL_STEP_COST : 1.f;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Diagonals need both side cells open, which also makes every step reversible
+//-----------------------------------------------------------------------------------------------
+static bool CanStep( const PathGrid& grid, int xCoord, int yCoord, int xDir, int yDir )
+{
+	if ( !grid.IsWalkable( xCoord + xDir, yCoord + yDir ) )
+	{
+		return false;
+	}
+
+	if ( xDir != 0
+		 && yDir != 0 )
+	{
+		return grid.IsWalkable( xCoord + xDir, yCoord )
+			&& grid.IsWalkable( xCoord, yCoord + yDir );
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int GetDirectionSign( int value )
+{
+	return ( value > 0 ) - ( value < 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Works for A* and JPS paths, cells are joined by straight or diagonal runs of steps
+//-----------------------------------------------------------------------------------------------
+static bool IsPathWalkable( const PathGrid& grid, const std::vector<IntVec2>& path )
+{
+	if ( path.empty()
+		 || !grid.IsWalkable( path[0] ) )
+	{
+		return false;
+	}
+
+	for ( int pathIdx = 1; pathIdx < (int)path.size(); ++pathIdx )
+	{
+		IntVec2 cell = path[pathIdx - 1];
+		const IntVec2& nextCell = path[pathIdx];
+		int xDir = GetDirectionSign( nextCell.x - cell.x );
+		int yDir = GetDirectionSign( nextCell.y - cell.y );
+
+		while ( cell != nextCell )
+		{
+			if ( !CanStep( grid, cell.x, cell.y, xDir, yDir ) )
+			{
+				return false;
+			}
+
+			cell.x += xDir;
+			cell.y += yDir;
+		}
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void BuildPathFromParents( const PathGrid& grid, const std::vector<int>& parents, int goalIdx, std::vector<IntVec2>& out_path )
+{
+	out_path.clear();
+	for ( int cellIdx = goalIdx; cellIdx >= 0; cellIdx = parents[cellIdx] )
+	{
+		out_path.push_back( IntVec2( cellIdx % grid.dimensions.x, cellIdx / grid.dimensions.x ) );
+	}
+
+	std::reverse( out_path.begin(), out_path.end() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool PathGrid::IsInBounds( int xCoord, int yCoord ) const
+{
+	return xCoord >= 0
+		&& xCoord < dimensions.x
+		&& yCoord >= 0
+		&& yCoord < dimensions.y;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool PathGrid::IsWalkable( int xCoord, int yCoord ) const
+{
+	if ( !IsInBounds( xCoord, yCoord ) )
+	{
+		return false;
+	}
+
+	return solidCells[GetCellIndex( xCoord, yCoord )] == 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool FindPathAStar( const PathGrid& grid, const IntVec2& start, const IntVec2& goal, std::vector<IntVec2>& out_path, PathSearchStats* out_stats )
+{
+	out_path.clear();
+	if ( !grid.IsWalkable( start )
+		 || !grid.IsWalkable( goal ) )
+	{
+		return false;
+	}
+
+	int numCells = grid.GetNumCells();
+	int goalIdx = grid.GetCellIndex( goal );
+	std::vector<float> costs( numCells, INFINITY );
+	std::vector<int> parents( numCells, -1 );
+	std::vector<byte> isClosed( numCells, 0 );
+	std::vector<PathOpenNode> openNodes;
+
+	int startIdx = grid.GetCellIndex( start );
+	costs[startIdx] = 0.f;
+	openNodes.push_back( { GetOctileDistance( start.x, start.y, goal.x, goal.y ), startIdx } );
+
+	int numNodesExpanded = 0;
+	while ( !openNodes.empty() )
+	{
+		std::pop_heap( openNodes.begin(), openNodes.end() );
+		int cellIdx = openNodes.back().cellIdx;
+		openNodes.pop_back();
+
+		// Cells get pushed again when a cheaper way in turns up, the stale copies are skipped here
+		if ( isClosed[cellIdx] != 0 )
+		{
+			continue;
+		}
+
+		isClosed[cellIdx] = 1;
+		++numNodesExpanded;
+
+		if ( cellIdx == goalIdx )
+		{
+			BuildPathFromParents( grid, parents, goalIdx, out_path );
+			if ( out_stats != nullptr )
+			{
+				out_stats->numNodesExpanded += numNodesExpanded;
+				out_stats->pathCost = costs[goalIdx];
+			}
+
+			return true;
+		}
+
+		int xCoord = cellIdx % grid.dimensions.x;
+		int yCoord = cellIdx / grid.dimensions.x;
+		for ( int dirIdx = 0; dirIdx < NUM_STEP_DIRECTIONS; ++dirIdx )
+		{
+			const IntVec2& direction = STEP_DIRECTIONS[dirIdx];
+			if ( !CanStep( grid, xCoord, yCoord, direction.x, direction.y ) )
+			{
+				continue;
+			}
+
+			int neighborX = xCoord + direction.x;
+			int neighborY = yCoord + direction.y;
+			int neighborIdx = grid.GetCellIndex( neighborX, neighborY );
+			float neighborCost = costs[cellIdx] + GetStepCost( direction.x, direction.y );
+			if ( isClosed[neighborIdx] != 0
+				 || neighborCost >= costs[neighborIdx] )
+			{
+				continue;
+			}
+
+			costs[neighborIdx] = neighborCost;
+			parents[neighborIdx] = cellIdx;
+			openNodes.push_back( { neighborCost + GetOctileDistance( neighborX, neighborY, goal.x, goal.y ), neighborIdx } );
+			std::push_heap( openNodes.begin(), openNodes.end() );
+		}
+	}
+
+	if ( out_stats != nullptr )
+	{
+		out_stats->numNodesExpanded += numNodesExpanded;
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Walks from x,y in one direction until it finds a cell worth expanding: the goal, a cell with a
+// forced neighbor, or for diagonals a cell whose straight runs find one. Since diagonals can't cut
+// corners a straight run turns forced where a wall beside it ends
+//-----------------------------------------------------------------------------------------------
+static bool Jump( const PathGrid& grid, int xCoord, int yCoord, int xDir, int yDir, const IntVec2& goal, IntVec2& out_jumpPoint )
+{
+	while ( grid.IsWalkable( xCoord, yCoord ) )
+	{
+		if ( xCoord == goal.x
+			 && yCoord == goal.y )
+		{
+			out_jumpPoint = IntVec2( xCoord, yCoord );
+			return true;
+		}
+
+		if ( xDir != 0
+			 && yDir != 0 )
+		{
+			IntVec2 unusedJumpPoint;
+			if ( Jump( grid, xCoord + xDir, yCoord, xDir, 0, goal, unusedJumpPoint )
+				 || Jump( grid, xCoord, yCoord + yDir, 0, yDir, goal, unusedJumpPoint ) )
+			{
+				out_jumpPoint = IntVec2( xCoord, yCoord );
+				return true;
+			}
+
+			if ( !grid.IsWalkable( xCoord + xDir, yCoord )
+				 || !grid.IsWalkable( xCoord, yCoord + yDir ) )
+			{
+				return false;
+			}
+		}
+		else if ( xDir != 0 )
+		{
+			if ( ( grid.IsWalkable( xCoord, yCoord + 1 ) && !grid.IsWalkable( xCoord - xDir, yCoord + 1 ) )
+				 || ( grid.IsWalkable( xCoord, yCoord - 1 ) && !grid.IsWalkable( xCoord - xDir, yCoord - 1 ) ) )
+			{
+				out_jumpPoint = IntVec2( xCoord, yCoord );
+				return true;
+			}
+		}
+		else
+		{
+			if ( ( grid.IsWalkable( xCoord + 1, yCoord ) && !grid.IsWalkable( xCoord + 1, yCoord - yDir ) )
+				 || ( grid.IsWalkable( xCoord - 1, yCoord ) && !grid.IsWalkable( xCoord - 1, yCoord - yDir ) ) )
+			{
+				out_jumpPoint = IntVec2( xCoord, yCoord );
+				return true;
+			}
+		}
+
+		xCoord += xDir;
+		yCoord += yDir;
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Directions worth jumping in from a cell reached by moving along xDir,yDir. A straight move only
+// stops where a side opens up, so both sides are always worth a look. The start cell tries all 8
+//-----------------------------------------------------------------------------------------------
+static int GetPrunedDirections( const PathGrid& grid, int xCoord, int yCoord, int xDir, int yDir, IntVec2* out_directions )
+{
+	int numDirections = 0;
+	if ( xDir == 0
+		 && yDir == 0 )
+	{
+		for ( int dirIdx = 0; dirIdx < NUM_STEP_DIRECTIONS; ++dirIdx )
+		{
+			if ( CanStep( grid, xCoord, yCoord, STEP_DIRECTIONS[dirIdx].x, STEP_DIRECTIONS[dirIdx].y ) )
+			{
+				out_directions[numDirections++] = STEP_DIRECTIONS[dirIdx];
+			}
+		}
+
+		return numDirections;
+	}
+
+	if ( xDir != 0
+		 && yDir != 0 )
+	{
+		bool isXOpen = grid.IsWalkable( xCoord + xDir, yCoord );
+		bool isYOpen = grid.IsWalkable( xCoord, yCoord + yDir );
+		if ( isYOpen )				{ out_directions[numDirections++] = IntVec2( 0, yDir ); }
+		if ( isXOpen )				{ out_directions[numDirections++] = IntVec2( xDir, 0 ); }
+		if ( isXOpen && isYOpen
+			 && grid.IsWalkable( xCoord + xDir, yCoord + yDir ) )
+		{
+			out_directions[numDirections++] = IntVec2( xDir, yDir );
+		}
+	}
+	else if ( xDir != 0 )
+	{
+		bool isForwardOpen = grid.IsWalkable( xCoord + xDir, yCoord );
+		bool isUpOpen = grid.IsWalkable( xCoord, yCoord + 1 );
+		bool isDownOpen = grid.IsWalkable( xCoord, yCoord - 1 );
+		if ( isForwardOpen )
+		{
+			out_directions[numDirections++] = IntVec2( xDir, 0 );
+			if ( isUpOpen && grid.IsWalkable( xCoord + xDir, yCoord + 1 ) )		{ out_directions[numDirections++] = IntVec2( xDir, 1 ); }
+			if ( isDownOpen && grid.IsWalkable( xCoord + xDir, yCoord - 1 ) )		{ out_directions[numDirections++] = IntVec2( xDir, -1 ); }
+		}
+		if ( isUpOpen )				{ out_directions[numDirections++] = IntVec2( 0, 1 ); }
+		if ( isDownOpen )			{ out_directions[numDirections++] = IntVec2( 0, -1 ); }
+	}
+	else
+	{
+		bool isForwardOpen = grid.IsWalkable( xCoord, yCoord + yDir );
+		bool isRightOpen = grid.IsWalkable( xCoord + 1, yCoord );
+		bool isLeftOpen = grid.IsWalkable( xCoord - 1, yCoord );
+		if ( isForwardOpen )
+		{
+			out_directions[numDirections++] = IntVec2( 0, yDir );
+			if ( isRightOpen && grid.IsWalkable( xCoord + 1, yCoord + yDir ) )		{ out_directions[numDirections++] = IntVec2( 1, yDir ); }
+			if ( isLeftOpen && grid.IsWalkable( xCoord - 1, yCoord + yDir ) )		{ out_directions[numDirections++] = IntVec2( -1, yDir ); }
+		}
+		if ( isRightOpen )			{ out_directions[numDirections++] = IntVec2( 1, 0 ); }
+		if ( isLeftOpen )			{ out_directions[numDirections++] = IntVec2( -1, 0 ); }
+	}
+
+	return numDirections;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// A* over jump points. Each jump is one straight or diagonal run so its cost is the octile
+// distance, and the path costs match plain A*
+//-----------------------------------------------------------------------------------------------
+bool FindPathJPS( const PathGrid& grid, const IntVec2& start, const IntVec2& goal, std::vector<IntVec2>& out_path, PathSearchStats* out_stats )
+{
+	out_path.clear();
+	if ( !grid.IsWalkable( start )
+		 || !grid.IsWalkable( goal ) )
+	{
+		return false;
+	}
+
+	int numCells = grid.GetNumCells();
+	int goalIdx = grid.GetCellIndex( goal );
+	std::vector<float> costs( numCells, INFINITY );
+	std::vector<int> parents( numCells, -1 );
+	std::vector<byte> isClosed( numCells, 0 );
+	std::vector<PathOpenNode> openNodes;
+
+	int startIdx = grid.GetCellIndex( start );
+	costs[startIdx] = 0.f;
+	openNodes.push_back( { GetOctileDistance( start.x, start.y, goal.x, goal.y ), startIdx } );
+
+	int numNodesExpanded = 0;
+	IntVec2 directions[NUM_STEP_DIRECTIONS];
+	while ( !openNodes.empty() )
+	{
+		std::pop_heap( openNodes.begin(), openNodes.end() );
+		int cellIdx = openNodes.back().cellIdx;
+		openNodes.pop_back();
+
+		if ( isClosed[cellIdx] != 0 )
+		{
+			continue;
+		}
+
+		isClosed[cellIdx] = 1;
+		++numNodesExpanded;
+
+		if ( cellIdx == goalIdx )
+		{
+			BuildPathFromParents( grid, parents, goalIdx, out_path );
+			if ( out_stats != nullptr )
+			{
+				out_stats->numNodesExpanded += numNodesExpanded;
+				out_stats->pathCost = costs[goalIdx];
+			}
+
+			return true;
+		}
+
+		int xCoord = cellIdx % grid.dimensions.x;
+		int yCoord = cellIdx / grid.dimensions.x;
+		int xDir = 0;
+		int yDir = 0;
+		int parentIdx = parents[cellIdx];
+		if ( parentIdx >= 0 )
+		{
+			xDir = GetDirectionSign( xCoord - parentIdx % grid.dimensions.x );
+			yDir = GetDirectionSign( yCoord - parentIdx / grid.dimensions.x );
+		}
+
+		int numDirections = GetPrunedDirections( grid, xCoord, yCoord, xDir, yDir, directions );
+		for ( int dirIdx = 0; dirIdx < numDirections; ++dirIdx )
+		{
+			IntVec2 jumpPoint;
+			if ( !Jump( grid, xCoord + directions[dirIdx].x, yCoord + directions[dirIdx].y, directions[dirIdx].x, directions[dirIdx].y, goal, jumpPoint ) )
+			{
+				continue;
+			}
+
+			int jumpPointIdx = grid.GetCellIndex( jumpPoint );
+			float jumpPointCost = costs[cellIdx] + GetOctileDistance( xCoord, yCoord, jumpPoint.x, jumpPoint.y );
+			if ( isClosed[jumpPointIdx] != 0
+				 || jumpPointCost >= costs[jumpPointIdx] )
+			{
+				continue;
+			}
+
+			costs[jumpPointIdx] = jumpPointCost;
+			parents[jumpPointIdx] = cellIdx;
+			openNodes.push_back( { jumpPointCost + GetOctileDistance( jumpPoint.x, jumpPoint.y, goal.x, goal.y ), jumpPointIdx } );
+			std::push_heap( openNodes.begin(), openNodes.end() );
+		}
+	}
+
+	if ( out_stats != nullptr )
+	{
+		out_stats->numNodesExpanded += numNodesExpanded;
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool FindPathOnGrid( const PathGrid& grid, const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm, std::vector<IntVec2>& out_path, PathSearchStats* out_stats )
+{
+	switch ( algorithm )
+	{
+		case ePathAlgorithm::A_STAR: return FindPathAStar( grid, start, goal, out_path, out_stats );
+		case ePathAlgorithm::JUMP_POINT_SEARCH: return FindPathJPS( grid, start, goal, out_path, out_stats );
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool GridFlowField::IsSettled( const PathGrid& grid, const IntVec2& cell ) const
+{
+	if ( !grid.IsInBounds( cell.x, cell.y ) )
+	{
+		return false;
+	}
+
+	return m_isSettled[grid.GetCellIndex( cell )] != 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float GridFlowField::GetDistance( const PathGrid& grid, const IntVec2& cell ) const
+{
+	if ( !IsSettled( grid, cell ) )
+	{
+		return INFINITY;
+	}
+
+	return m_distances[grid.GetCellIndex( cell )];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool GridFlowField::GetDirectionToGoal( const PathGrid& grid, const IntVec2& cell, Vec2& out_direction ) const
+{
+	if ( !IsSettled( grid, cell )
+		 || cell == m_goal )
+	{
+		return false;
+	}
+
+	float bestDistance = INFINITY;
+	int bestDirIdx = -1;
+	for ( int dirIdx = 0; dirIdx < NUM_STEP_DIRECTIONS; ++dirIdx )
+	{
+		const IntVec2& direction = STEP_DIRECTIONS[dirIdx];
+		if ( !CanStep( grid, cell.x, cell.y, direction.x, direction.y ) )
+		{
+			continue;
+		}
+
+		int neighborIdx = grid.GetCellIndex( cell.x + direction.x, cell.y + direction.y );
+		if ( m_isSettled[neighborIdx] == 0 )
+		{
+			continue;
+		}
+
+		float distance = m_distances[neighborIdx] + GetStepCost( direction.x, direction.y );
+		if ( distance < bestDistance )
+		{
+			bestDistance = distance;
+			bestDirIdx = dirIdx;
+		}
+	}
+
+	if ( bestDirIdx < 0 )
+	{
+		return false;
+	}
+
+	out_direction = Vec2( (float)STEP_DIRECTIONS[bestDirIdx].x, (float)STEP_DIRECTIONS[bestDirIdx].y ).GetNormalized();
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool GridFlowField::GetDirectionAwayFromGoal( const PathGrid& grid, const IntVec2& cell, Vec2& out_direction ) const
+{
+	if ( !IsSettled( grid, cell ) )
+	{
+		return false;
+	}
+
+	float bestDistance = m_distances[grid.GetCellIndex( cell )];
+	int bestDirIdx = -1;
+	for ( int dirIdx = 0; dirIdx < NUM_STEP_DIRECTIONS; ++dirIdx )
+	{
+		const IntVec2& direction = STEP_DIRECTIONS[dirIdx];
+		if ( !CanStep( grid, cell.x, cell.y, direction.x, direction.y ) )
+		{
+			continue;
+		}
+
+		int neighborIdx = grid.GetCellIndex( cell.x + direction.x, cell.y + direction.y );
+		if ( m_isSettled[neighborIdx] != 0
+			 && m_distances[neighborIdx] > bestDistance )
+		{
+			bestDistance = m_distances[neighborIdx];
+			bestDirIdx = dirIdx;
+		}
+	}
+
+	if ( bestDirIdx < 0 )
+	{
+		return false;
+	}
+
+	out_direction = Vec2( (float)STEP_DIRECTIONS[bestDirIdx].x, (float)STEP_DIRECTIONS[bestDirIdx].y ).GetNormalized();
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridFlowField::Begin( const PathGrid& grid, const IntVec2& goal )
+{
+	m_goal = goal;
+	m_distances.assign( grid.GetNumCells(), INFINITY );
+	m_isSettled.assign( grid.GetNumCells(), 0 );
+	m_openCells.clear();
+
+	if ( grid.IsWalkable( goal ) )
+	{
+		int goalIdx = grid.GetCellIndex( goal );
+		m_distances[goalIdx] = 0.f;
+		m_openCells.push_back( { 0.f, goalIdx } );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int GridFlowField::Advance( const PathGrid& grid, int maxCellsToSettle )
+{
+	int numCellsSettled = 0;
+	while ( !m_openCells.empty()
+			&& numCellsSettled < maxCellsToSettle )
+	{
+		std::pop_heap( m_openCells.begin(), m_openCells.end() );
+		int cellIdx = m_openCells.back().cellIdx;
+		m_openCells.pop_back();
+
+		if ( m_isSettled[cellIdx] != 0 )
+		{
+			continue;
+		}
+
+		m_isSettled[cellIdx] = 1;
+		++numCellsSettled;
+
+		int xCoord = cellIdx % grid.dimensions.x;
+		int yCoord = cellIdx / grid.dimensions.x;
+		for ( int dirIdx = 0; dirIdx < NUM_STEP_DIRECTIONS; ++dirIdx )
+		{
+			const IntVec2& direction = STEP_DIRECTIONS[dirIdx];
+			if ( !CanStep( grid, xCoord, yCoord, direction.x, direction.y ) )
+			{
+				continue;
+			}
+
+			int neighborIdx = grid.GetCellIndex( xCoord + direction.x, yCoord + direction.y );
+			float neighborDistance = m_distances[cellIdx] + GetStepCost( direction.x, direction.y );
+			if ( m_isSettled[neighborIdx] != 0
+				 || neighborDistance >= m_distances[neighborIdx] )
+			{
+				continue;
+			}
+
+			m_distances[neighborIdx] = neighborDistance;
+			m_openCells.push_back( { neighborDistance, neighborIdx } );
+			std::push_heap( m_openCells.begin(), m_openCells.end() );
+		}
+	}
+
+	return numCellsSettled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+PathBatchJob::PathBatchJob( GridPathfinder& pathfinder, int firstRequestIdx, int endRequestIdx )
+	: m_pathfinder( pathfinder )
+	, m_firstRequestIdx( firstRequestIdx )
+	, m_endRequestIdx( endRequestIdx )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void PathBatchJob::Execute()
+{
+	m_pathfinder.RunBatchRange( m_firstRequestIdx, m_endRequestIdx );
+
+	// Last touch of the pathfinder, it may be gone by the time this job is claimed
+	--m_pathfinder.m_numPendingBatchJobs;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+GridPathfinder::GridPathfinder()
+	: m_numPendingBatchJobs( 0 )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+GridPathfinder::~GridPathfinder()
+{
+	if ( g_jobSystem != nullptr )
+	{
+		g_jobSystem->WaitForJobs( m_numPendingBatchJobs );
+	}
+
+	PTR_VECTOR_SAFE_DELETE( m_flowFields );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::SetGrid( const IntVec2& dimensions, const std::vector<byte>& solidCells )
+{
+	GUARANTEE_OR_DIE( (int)solidCells.size() == dimensions.x * dimensions.y, "Path grid cells don't match its dimensions" );
+
+	// A batch in flight searches its own copy. On collect its paths are checked against the new cells,
+	// and only the ones that are now blocked or found nothing go back in the queue
+	m_grid.dimensions = dimensions;
+	m_grid.solidCells = solidCells;
+	++m_gridVersion;
+	m_stats = GridPathfinderStats();
+
+	InvalidateCaches();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::SetCellSolid( const IntVec2& cell, bool isSolid )
+{
+	if ( !m_grid.IsInBounds( cell.x, cell.y ) )
+	{
+		return;
+	}
+
+	byte& solidCell = m_grid.solidCells[m_grid.GetCellIndex( cell )];
+	if ( ( solidCell != 0 ) == isSolid )
+	{
+		return;
+	}
+
+	solidCell = isSolid ? 1 : 0;
+	++m_gridVersion;
+
+	InvalidateCaches();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::InvalidateCaches()
+{
+	m_pathCache.clear();
+
+	for ( int fieldIdx = 0; fieldIdx < (int)m_flowFields.size(); ++fieldIdx )
+	{
+		m_flowFields[fieldIdx]->Begin( m_grid, m_flowFields[fieldIdx]->m_goal );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool GridPathfinder::FindPath( const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm, std::vector<IntVec2>& out_path )
+{
+	++m_stats.numRequests;
+
+	GridPathRequest request;
+	request.start = start;
+	request.goal = goal;
+	request.algorithm = algorithm;
+
+	GridPathResult result;
+	if ( GetCachedPath( request, result ) )
+	{
+		++m_stats.numCacheHits;
+		out_path = result.path;
+		return result.didFindPath;
+	}
+
+	PathSearchStats searchStats;
+	result.didFindPath = FindPathOnGrid( m_grid, start, goal, algorithm, result.path, &searchStats );
+	++m_stats.numSearches;
+	m_stats.numNodesExpanded += searchStats.numNodesExpanded;
+
+	result.start = start;
+	result.goal = goal;
+	AddCachedPath( result, algorithm );
+
+	out_path = result.path;
+	return result.didFindPath;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int GridPathfinder::RequestPath( int ownerId, const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm )
+{
+	++m_stats.numRequests;
+
+	GridPathRequest request;
+	request.requestId = m_nextRequestId++;
+	request.ownerId = ownerId;
+	request.start = start;
+	request.goal = goal;
+	request.algorithm = algorithm;
+	m_queuedRequests.push_back( request );
+
+	return request.requestId;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::Update()
+{
+	++m_updateNum;
+
+	CollectFinishedBatch();
+	DispatchQueuedRequests();
+	AdvanceFlowFields();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::ClaimCompletedResults( std::vector<GridPathResult>& out_results )
+{
+	out_results.clear();
+	out_results.swap( m_completedResults );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::FinishPendingRequests()
+{
+	while ( m_isBatchInFlight
+			|| !m_queuedRequests.empty() )
+	{
+		if ( g_jobSystem != nullptr )
+		{
+			g_jobSystem->WaitForJobs( m_numPendingBatchJobs );
+		}
+
+		CollectFinishedBatch();
+		DispatchQueuedRequests();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::CollectFinishedBatch()
+{
+	if ( !m_isBatchInFlight
+		 || m_numPendingBatchJobs > 0 )
+	{
+		return;
+	}
+
+	m_isBatchInFlight = false;
+
+	bool isGridUnchanged = m_batchGridVersion == m_gridVersion;
+	for ( int resultIdx = 0; resultIdx < (int)m_batchResults.size(); ++resultIdx )
+	{
+		m_stats.numNodesExpanded += m_batchNodesExpanded[resultIdx];
+
+		GridPathRequest& request = m_batchRequests[resultIdx];
+		GridPathResult& result = m_batchResults[resultIdx];
+		if ( isGridUnchanged )
+		{
+			AddCachedPath( result, request.algorithm );
+			m_completedResults.push_back( std::move( result ) );
+			continue;
+		}
+
+		// Searched on an older grid. A path that's still open is good enough to follow but may not be
+		// the shortest anymore, so it isn't cached. Failed searches may have a way through now
+		bool isStillUsable = result.didFindPath && IsPathWalkable( m_grid, result.path );
+		if ( !isStillUsable
+			 && request.numRetries < MAX_STALE_PATH_RETRIES )
+		{
+			++request.numRetries;
+			m_queuedRequests.push_back( request );
+			continue;
+		}
+
+		m_completedResults.push_back( std::move( result ) );
+	}
+
+	m_batchRequests.clear();
+	m_batchResults.clear();
+	m_batchNodesExpanded.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::DispatchQueuedRequests()
+{
+	if ( m_isBatchInFlight
+		 || m_queuedRequests.empty() )
+	{
+		return;
+	}
+
+	// Cached answers go straight back, the rest make up the batch
+	for ( int requestIdx = 0; requestIdx < (int)m_queuedRequests.size(); ++requestIdx )
+	{
+		const GridPathRequest& request = m_queuedRequests[requestIdx];
+
+		GridPathResult result;
+		if ( GetCachedPath( request, result ) )
+		{
+			++m_stats.numCacheHits;
+			m_completedResults.push_back( std::move( result ) );
+			continue;
+		}
+
+		m_batchRequests.push_back( request );
+	}
+
+	m_queuedRequests.clear();
+
+	int numRequests = (int)m_batchRequests.size();
+	if ( numRequests == 0 )
+	{
+		return;
+	}
+
+	if ( m_batchGridVersion != m_gridVersion
+		 || m_batchGrid.dimensions != m_grid.dimensions )
+	{
+		m_batchGrid = m_grid;
+		m_batchGridVersion = m_gridVersion;
+	}
+
+	m_batchResults.resize( numRequests );
+	m_batchNodesExpanded.assign( numRequests, 0 );
+	m_isBatchInFlight = true;
+	++m_stats.numBatches;
+	m_stats.numSearches += numRequests;
+
+	if ( g_jobSystem == nullptr
+		 || g_jobSystem->GetNumWorkerThreads() == 0 )
+	{
+		RunBatchRange( 0, numRequests );
+		CollectFinishedBatch();
+		return;
+	}
+
+	// Nothing waits on these, so this thread doesn't take a chunk. They're wanted by the next Update
+	// though, so they go ahead of background jobs
+	int numChunks = ClampMinMaxInt( numRequests / MIN_PATHS_PER_BATCH_JOB, 1, g_jobSystem->GetNumWorkerThreads() );
+	int requestsPerChunk = ( numRequests + numChunks - 1 ) / numChunks;
+	m_numPendingBatchJobs = numChunks;
+
+	for ( int chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx )
+	{
+		int firstRequestIdx = Min( chunkIdx * requestsPerChunk, numRequests );
+		int endRequestIdx = Min( firstRequestIdx + requestsPerChunk, numRequests );
+		g_jobSystem->QueueJob( new PathBatchJob( *this, firstRequestIdx, endRequestIdx ), eJobPriority::HIGH );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::RunBatchRange( int firstRequestIdx, int endRequestIdx )
+{
+	for ( int requestIdx = firstRequestIdx; requestIdx < endRequestIdx; ++requestIdx )
+	{
+		const GridPathRequest& request = m_batchRequests[requestIdx];
+
+		GridPathResult& result = m_batchResults[requestIdx];
+		result.requestId = request.requestId;
+		result.ownerId = request.ownerId;
+		result.start = request.start;
+		result.goal = request.goal;
+		result.wasCached = false;
+
+		PathSearchStats searchStats;
+		result.didFindPath = FindPathOnGrid( m_batchGrid, request.start, request.goal, request.algorithm, result.path, &searchStats );
+		m_batchNodesExpanded[requestIdx] = searchStats.numNodesExpanded;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::AdvanceFlowFields()
+{
+	m_stats.numFlowFields = (int)m_flowFields.size();
+	m_stats.numFlowFieldCellsSettled = 0;
+
+	int cellsLeftThisUpdate = m_maxFlowFieldCellsPerUpdate;
+	for ( int fieldIdx = 0; fieldIdx < (int)m_flowFields.size(); ++fieldIdx )
+	{
+		if ( cellsLeftThisUpdate <= 0 )
+		{
+			break;
+		}
+
+		GridFlowField& field = *m_flowFields[fieldIdx];
+		if ( field.IsComplete() )
+		{
+			continue;
+		}
+
+		int numCellsSettled = field.Advance( m_grid, cellsLeftThisUpdate );
+		cellsLeftThisUpdate -= numCellsSettled;
+		m_stats.numFlowFieldCellsSettled += numCellsSettled;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+const GridFlowField* GridPathfinder::GetOrStartFlowField( const IntVec2& goal )
+{
+	if ( !m_grid.IsWalkable( goal ) )
+	{
+		return nullptr;
+	}
+
+	int leastRecentFieldIdx = 0;
+	for ( int fieldIdx = 0; fieldIdx < (int)m_flowFields.size(); ++fieldIdx )
+	{
+		GridFlowField& field = *m_flowFields[fieldIdx];
+		if ( field.m_goal == goal )
+		{
+			field.m_lastUsedUpdateNum = m_updateNum;
+			return &field;
+		}
+
+		if ( field.m_lastUsedUpdateNum < m_flowFields[leastRecentFieldIdx]->m_lastUsedUpdateNum )
+		{
+			leastRecentFieldIdx = fieldIdx;
+		}
+	}
+
+	GridFlowField* field = nullptr;
+	if ( (int)m_flowFields.size() < MAX_FLOW_FIELDS )
+	{
+		field = new GridFlowField();
+		m_flowFields.push_back( field );
+	}
+	else
+	{
+		field = m_flowFields[leastRecentFieldIdx];
+	}
+
+	field->Begin( m_grid, goal );
+	field->m_lastUsedUpdateNum = m_updateNum;
+
+	return field;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool GridPathfinder::GetFlowDirection( const IntVec2& goal, const IntVec2& cell, Vec2& out_direction )
+{
+	const GridFlowField* field = GetOrStartFlowField( goal );
+	if ( field == nullptr )
+	{
+		return false;
+	}
+
+	return field->GetDirectionToGoal( m_grid, cell, out_direction );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool GridPathfinder::GetFleeDirection( const IntVec2& goal, const IntVec2& cell, Vec2& out_direction )
+{
+	const GridFlowField* field = GetOrStartFlowField( goal );
+	if ( field == nullptr )
+	{
+		return false;
+	}
+
+	return field->GetDirectionAwayFromGoal( m_grid, cell, out_direction );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+uint64_t GridPathfinder::GetCacheKey( const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm ) const
+{
+	uint64_t startIdx = (uint64_t)m_grid.GetCellIndex( start );
+	uint64_t goalIdx = (uint64_t)m_grid.GetCellIndex( goal );
+
+	return ( startIdx << 33 ) | ( goalIdx << 1 ) | ( algorithm == ePathAlgorithm::JUMP_POINT_SEARCH ? 1 : 0 );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool GridPathfinder::GetCachedPath( const GridPathRequest& request, GridPathResult& out_result ) const
+{
+	if ( !m_grid.IsInBounds( request.start.x, request.start.y )
+		 || !m_grid.IsInBounds( request.goal.x, request.goal.y ) )
+	{
+		return false;
+	}
+
+	auto cachedPathIter = m_pathCache.find( GetCacheKey( request.start, request.goal, request.algorithm ) );
+	if ( cachedPathIter == m_pathCache.end() )
+	{
+		return false;
+	}
+
+	out_result.requestId = request.requestId;
+	out_result.ownerId = request.ownerId;
+	out_result.start = request.start;
+	out_result.goal = request.goal;
+	out_result.didFindPath = !cachedPathIter->second.empty();
+	out_result.wasCached = true;
+	out_result.path = cachedPathIter->second;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GridPathfinder::AddCachedPath( const GridPathResult& result, ePathAlgorithm algorithm )
+{
+	if ( !m_grid.IsInBounds( result.start.x, result.start.y )
+		 || !m_grid.IsInBounds( result.goal.x, result.goal.y ) )
+	{
+		return;
+	}
+
+	// Cheaper than tracking use, a full cache just starts over
+	if ( (int)m_pathCache.size() >= MAX_CACHED_PATHS )
+	{
+		m_pathCache.clear();
+	}
+
+	m_pathCache[GetCacheKey( result.start, result.goal, algorithm )] = result.path;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+//-----------------------------------------------------------------------------------------------
+bool BenchmarkPathfindingEvent( EventArgs* args )
+{
+	int gridSize = args->GetValue( "size", 128 );
+	int numPaths = args->GetValue( "paths", 1000 );
+	float solidFraction = args->GetValue( "density", .3f );
+	if ( gridSize <= 1
+		 || numPaths <= 0
+		 || solidFraction < 0.f
+		 || solidFraction >= 1.f )
+	{
+		g_devConsole->PrintError( "benchmark_pathfinding: size and paths must be positive, density between 0 and 1" );
+		return false;
+	}
+
+	RandomNumberGenerator rng;
+	IntVec2 dimensions( gridSize, gridSize );
+	std::vector<byte> solidCells( gridSize * gridSize, 0 );
+	std::vector<IntVec2> openCells;
+	for ( int yCoord = 0; yCoord < gridSize; ++yCoord )
+	{
+		for ( int xCoord = 0; xCoord < gridSize; ++xCoord )
+		{
+			if ( rng.RollPercentChance( solidFraction ) )
+			{
+				solidCells[xCoord + yCoord * gridSize] = 1;
+				continue;
+			}
+
+			openCells.push_back( IntVec2( xCoord, yCoord ) );
+		}
+	}
+
+	if ( openCells.size() < 2 )
+	{
+		g_devConsole->PrintError( "benchmark_pathfinding: grid has no open cells, lower density" );
+		return false;
+	}
+
+	std::vector<GridPathRequest> requests( numPaths );
+	for ( int pathIdx = 0; pathIdx < numPaths; ++pathIdx )
+	{
+		requests[pathIdx].start = openCells[rng.RollRandomIntLessThan( (int)openCells.size() )];
+		requests[pathIdx].goal = openCells[rng.RollRandomIntLessThan( (int)openCells.size() )];
+	}
+
+	PathGrid grid;
+	grid.dimensions = dimensions;
+	grid.solidCells = solidCells;
+
+	g_devConsole->PrintString( Stringf( "Finding %i paths on a %ix%i grid, %.0f%% solid", numPaths, gridSize, gridSize, solidFraction * 100.f ) );
+
+	std::vector<IntVec2> path;
+	std::vector<float> aStarCosts( numPaths, -1.f );
+	PathSearchStats aStarStats;
+	int numFound = 0;
+	double startTime = GetCurrentTimeSeconds();
+	for ( int pathIdx = 0; pathIdx < numPaths; ++pathIdx )
+	{
+		if ( FindPathAStar( grid, requests[pathIdx].start, requests[pathIdx].goal, path, &aStarStats ) )
+		{
+			aStarCosts[pathIdx] = aStarStats.pathCost;
+			++numFound;
+		}
+	}
+	double aStarSeconds = GetCurrentTimeSeconds() - startTime;
+	g_devConsole->PrintString( Stringf( "  A*: %.2f ms, %i found, %.1f nodes expanded per path",
+										aStarSeconds * 1000.0, numFound, (float)aStarStats.numNodesExpanded / (float)numPaths ) );
+
+	PathSearchStats jpsStats;
+	int numMismatches = 0;
+	startTime = GetCurrentTimeSeconds();
+	for ( int pathIdx = 0; pathIdx < numPaths; ++pathIdx )
+	{
+		bool didFindPath = FindPathJPS( grid, requests[pathIdx].start, requests[pathIdx].goal, path, &jpsStats );
+		if ( didFindPath != ( aStarCosts[pathIdx] >= 0.f )
+			 || ( didFindPath && !IsNearlyEqual( jpsStats.pathCost, aStarCosts[pathIdx], .01f ) ) )
+		{
+			++numMismatches;
+		}
+	}
+	double jpsSeconds = GetCurrentTimeSeconds() - startTime;
+	g_devConsole->PrintString( Stringf( "  JPS: %.2f ms (%.1fx), %i cost mismatches, %.1f nodes expanded per path",
+										jpsSeconds * 1000.0, aStarSeconds / jpsSeconds, numMismatches, (float)jpsStats.numNodesExpanded / (float)numPaths ) );
+
+	GridPathfinder pathfinder;
+	pathfinder.SetGrid( dimensions, solidCells );
+
+	std::vector<GridPathResult> results;
+	startTime = GetCurrentTimeSeconds();
+	for ( int pathIdx = 0; pathIdx < numPaths; ++pathIdx )
+	{
+		pathfinder.RequestPath( pathIdx, requests[pathIdx].start, requests[pathIdx].goal );
+	}
+	pathfinder.FinishPendingRequests();
+	pathfinder.ClaimCompletedResults( results );
+	double batchSeconds = GetCurrentTimeSeconds() - startTime;
+
+	startTime = GetCurrentTimeSeconds();
+	for ( int pathIdx = 0; pathIdx < numPaths; ++pathIdx )
+	{
+		pathfinder.RequestPath( pathIdx, requests[pathIdx].start, requests[pathIdx].goal );
+	}
+	pathfinder.FinishPendingRequests();
+	pathfinder.ClaimCompletedResults( results );
+	double cachedSeconds = GetCurrentTimeSeconds() - startTime;
+
+	const GridPathfinderStats& stats = pathfinder.GetStats();
+	g_devConsole->PrintString( Stringf( "  JPS batch: %.2f ms over %i jobs max, again from cache: %.2f ms, %i of %i requests cached",
+										batchSeconds * 1000.0, g_jobSystem != nullptr ? g_jobSystem->GetNumWorkerThreads() : 0,
+										cachedSeconds * 1000.0, stats.numCacheHits, stats.numRequests ) );
+
+	// One shared goal, how long a full flow field takes to settle
+	pathfinder.SetFlowFieldBudget( gridSize * gridSize );
+	startTime = GetCurrentTimeSeconds();
+	pathfinder.GetOrStartFlowField( requests[0].goal );
+	pathfinder.Update();
+	double flowFieldSeconds = GetCurrentTimeSeconds() - startTime;
+	g_devConsole->PrintString( Stringf( "  Flow field: %.2f ms, %i cells settled", flowFieldSeconds * 1000.0, pathfinder.GetStats().numFlowFieldCellsSettled ) );
+
+	return false;
+}
@@ -0,0 +1,234 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+class GridPathfinder;
+
+
+//-----------------------------------------------------------------------------------------------
+enum class ePathAlgorithm
+{
+	A_STAR,
+	JUMP_POINT_SEARCH
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Walkability the searches run on. Searches only read it so every job in a batch shares one copy
+//-----------------------------------------------------------------------------------------------
+struct PathGrid
+{
+public:
+	IntVec2 dimensions = IntVec2::ZERO;
+	std::vector<byte> solidCells;
+
+public:
+	bool IsInBounds( int xCoord, int yCoord ) const;
+	bool IsWalkable( int xCoord, int yCoord ) const;				// Out of bounds isn't walkable
+	bool IsWalkable( const IntVec2& cell ) const						{ return IsWalkable( cell.x, cell.y ); }
+	int GetCellIndex( int xCoord, int yCoord ) const					{ return xCoord + yCoord * dimensions.x; }
+	int GetCellIndex( const IntVec2& cell ) const						{ return cell.x + cell.y * dimensions.x; }
+	int GetNumCells() const												{ return dimensions.x * dimensions.y; }
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct PathSearchStats
+{
+public:
+	int numNodesExpanded = 0;
+	float pathCost = 0.f;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// 8 way movement, diagonals only when both side cells are open so paths never clip a corner.
+// A* returns every cell from start to goal, JPS only the jump points, which are always joined by
+// straight or diagonal runs of open cells
+//-----------------------------------------------------------------------------------------------
+bool FindPathAStar( const PathGrid& grid, const IntVec2& start, const IntVec2& goal, std::vector<IntVec2>& out_path, PathSearchStats* out_stats = nullptr );
+bool FindPathJPS( const PathGrid& grid, const IntVec2& start, const IntVec2& goal, std::vector<IntVec2>& out_path, PathSearchStats* out_stats = nullptr );
+bool FindPathOnGrid( const PathGrid& grid, const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm, std::vector<IntVec2>& out_path, PathSearchStats* out_stats = nullptr );
+
+
+//-----------------------------------------------------------------------------------------------
+struct GridPathRequest
+{
+public:
+	int requestId = -1;
+	int ownerId = -1;							// Caller's id for whoever asked, e.g. an entity id
+	IntVec2 start = IntVec2::ZERO;
+	IntVec2 goal = IntVec2::ZERO;
+	ePathAlgorithm algorithm = ePathAlgorithm::JUMP_POINT_SEARCH;
+	int numRetries = 0;							// Times its answer was thrown out because the grid changed mid search
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct GridPathResult
+{
+public:
+	int requestId = -1;
+	int ownerId = -1;
+	IntVec2 start = IntVec2::ZERO;
+	IntVec2 goal = IntVec2::ZERO;
+	bool didFindPath = false;
+	bool wasCached = false;
+	std::vector<IntVec2> path;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Distance to one goal from every reachable cell, so any number of agents heading to the same
+// goal can steer from a lookup. Built as a Dijkstra flood that can stop after a budget of cells
+// and carry on later, cells are usable as soon as they're settled
+//-----------------------------------------------------------------------------------------------
+class GridFlowField
+{
+	friend class GridPathfinder;
+
+public:
+	const IntVec2& GetGoal() const										{ return m_goal; }
+	bool IsComplete() const												{ return m_openCells.empty(); }
+	bool IsSettled( const PathGrid& grid, const IntVec2& cell ) const;
+	float GetDistance( const PathGrid& grid, const IntVec2& cell ) const;
+
+	// False until the cell is settled, or at the goal
+	bool GetDirectionToGoal( const PathGrid& grid, const IntVec2& cell, Vec2& out_direction ) const;
+	bool GetDirectionAwayFromGoal( const PathGrid& grid, const IntVec2& cell, Vec2& out_direction ) const;
+
+private:
+	void Begin( const PathGrid& grid, const IntVec2& goal );
+	int Advance( const PathGrid& grid, int maxCellsToSettle );
+
+private:
+	struct OpenCell
+	{
+		float distance = 0.f;
+		int cellIdx = 0;
+
+		bool operator<( const OpenCell& other ) const					{ return distance > other.distance; }		// Min heap
+	};
+
+	IntVec2 m_goal = IntVec2::ZERO;
+	std::vector<float> m_distances;
+	std::vector<byte> m_isSettled;
+	std::vector<OpenCell> m_openCells;
+	uint m_lastUsedUpdateNum = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct GridPathfinderStats
+{
+public:
+	int numRequests = 0;						// Since the grid was set
+	int numCacheHits = 0;
+	int numSearches = 0;
+	int numBatches = 0;
+	int numNodesExpanded = 0;
+	int numFlowFieldCellsSettled = 0;			// Last update
+	int numFlowFields = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+class PathBatchJob : public Job
+{
+public:
+	PathBatchJob( GridPathfinder& pathfinder, int firstRequestIdx, int endRequestIdx );
+
+	virtual void Execute() override;
+
+private:
+	GridPathfinder& m_pathfinder;
+	int m_firstRequestIdx = 0;
+	int m_endRequestIdx = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Paths and flow fields over a grid of solid cells. Requested paths are queued and sent to the
+// job system as one batch per Update, answers come back through ClaimCompletedResults on a later
+// Update. Finished paths are cached until a cell changes, which also rebuilds every flow field.
+// A path searched on a grid that has changed since is still delivered if every cell on it is
+// still open, otherwise it's searched again a bounded number of times
+//-----------------------------------------------------------------------------------------------
+class GridPathfinder
+{
+	friend class PathBatchJob;
+
+public:
+	GridPathfinder();
+	~GridPathfinder();
+
+	void SetGrid( const IntVec2& dimensions, const std::vector<byte>& solidCells );
+	void SetCellSolid( const IntVec2& cell, bool isSolid );
+	const PathGrid& GetGrid() const										{ return m_grid; }
+	uint GetGridVersion() const											{ return m_gridVersion; }
+	bool IsWalkable( const IntVec2& cell ) const						{ return m_grid.IsWalkable( cell ); }
+
+	// Runs on this thread, goes through the cache
+	bool FindPath( const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm, std::vector<IntVec2>& out_path );
+
+	int RequestPath( int ownerId, const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm = ePathAlgorithm::JUMP_POINT_SEARCH );
+	void Update();
+	void ClaimCompletedResults( std::vector<GridPathResult>& out_results );
+	void FinishPendingRequests();
+
+	// The field starts building on the first ask and keeps going a budget of cells per Update
+	const GridFlowField* GetOrStartFlowField( const IntVec2& goal );
+	bool GetFlowDirection( const IntVec2& goal, const IntVec2& cell, Vec2& out_direction );
+	bool GetFleeDirection( const IntVec2& goal, const IntVec2& cell, Vec2& out_direction );
+	void SetFlowFieldBudget( int maxCellsPerUpdate )					{ m_maxFlowFieldCellsPerUpdate = maxCellsPerUpdate; }
+
+	const GridPathfinderStats& GetStats() const							{ return m_stats; }
+
+private:
+	void InvalidateCaches();
+	void CollectFinishedBatch();
+	void DispatchQueuedRequests();
+	void RunBatchRange( int firstRequestIdx, int endRequestIdx );
+	void AdvanceFlowFields();
+
+	uint64_t GetCacheKey( const IntVec2& start, const IntVec2& goal, ePathAlgorithm algorithm ) const;
+	bool GetCachedPath( const GridPathRequest& request, GridPathResult& out_result ) const;
+	void AddCachedPath( const GridPathResult& result, ePathAlgorithm algorithm );
+
+private:
+	PathGrid m_grid;
+	uint m_gridVersion = 0;
+	uint m_updateNum = 0;
+	int m_nextRequestId = 1;
+
+	std::unordered_map<uint64_t, std::vector<IntVec2>> m_pathCache;		// Failed searches are cached as empty paths
+	std::vector<GridPathRequest> m_queuedRequests;
+	std::vector<GridPathResult> m_completedResults;
+
+	// The batch in flight, jobs only touch these
+	PathGrid m_batchGrid;
+	uint m_batchGridVersion = 0;
+	std::vector<GridPathRequest> m_batchRequests;
+	std::vector<GridPathResult> m_batchResults;
+	std::vector<int> m_batchNodesExpanded;
+	std::atomic<int> m_numPendingBatchJobs;
+	bool m_isBatchInFlight = false;
+
+	std::vector<GridFlowField*> m_flowFields;
+	int m_maxFlowFieldCellsPerUpdate = 8192;
+
+	GridPathfinderStats m_stats;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+bool BenchmarkPathfindingEvent( EventArgs* args );
@@ -1,4 +1,5 @@
 #include "Engine/Physics/2D/DiscCollider.hpp"
+#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
@@ -15,6 +15,9 @@ public:
 	virtual const Vec3 GetClosestPoint( const Vec3& pos ) const override;
 	virtual bool Contains( const Vec3& pos ) const override;
 
+	virtual float GetBoundingRadius() const override							{ return m_radius; }
+	virtual float GetSweepRadius() const override								{ return m_radius; }
+
 	//virtual unsigned int CheckIfOutsideScreen( const AABB2& screenBounds, bool checkForCompletelyOffScreen ) const override;
 	const AABB2 CalculateWorldBounds();
 	AABB2 GetWorldBounds() const						{ return m_worldBounds; }
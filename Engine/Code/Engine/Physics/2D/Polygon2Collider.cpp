@@ -1,5 +1,6 @@
 #include "Engine/Physics/2D/Polygon2Collider.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -51,6 +52,14 @@ bool Polygon2Collider::Contains( const Vec3& pos ) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+float Polygon2Collider::GetBoundingRadius() const
+{
+	const AABB2& bounds = m_polygon.m_boundingBox;
+	return GetDistance2D( bounds.GetCenter(), m_worldPosition.XY() ) + bounds.GetDimensions().GetLength() * .5f;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 //unsigned int PolygonCollider2D::CheckIfOutsideScreen( const AABB2& screenBounds, bool checkForCompletelyOffScreen ) const
 //{
@@ -143,22 +152,7 @@ float Polygon2Collider::CalculateMoment( float mass )
 //-----------------------------------------------------------------------------------------------
 Vec2 Polygon2Collider::GetFarthestPointInDirection( const Vec2& direction ) const
 {
-	const std::vector<Vec2>& points = m_polygon.GetPoints();
-
-	float farthestDist = -INFINITY;
-	Vec2 farthestPt( Vec2::ZERO );
-	
-	for ( int pointIdx = 0; pointIdx < (int)points.size(); ++pointIdx )
-	{
-		float distToPoint = DotProduct2D( points[pointIdx], direction );
-		if ( distToPoint > farthestDist )
-		{
-			farthestDist = distToPoint;
-			farthestPt = points[pointIdx];
-		}
-	}
-
-	return farthestPt;
+	return m_polygon.GetFarthestPointInDirection( direction );
 }
 
 
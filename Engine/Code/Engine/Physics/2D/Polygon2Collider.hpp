@@ -22,6 +22,8 @@ public:
 	virtual const Vec3 GetClosestPoint( const Vec3& pos ) const override;
 	virtual bool Contains( const Vec3& pos ) const override;
 
+	virtual float GetBoundingRadius() const override;
+
 	//virtual unsigned int CheckIfOutsideScreen( const AABB2& screenBounds, bool checkForCompletelyOffScreen ) const override;
 	virtual const AABB2 GetWorldBounds() const										{ return m_polygon.m_boundingBox; }
 
@@ -0,0 +1,247 @@
+#include "Engine/Physics/2D/TileGridCollider.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Physics/Rigidbody.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+TileGridCollider::TileGridCollider()
+{
+	m_type = COLLIDER_TILE_GRID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileGridCollider::SetSolidCells( const IntVec2& dimensions, const std::vector<byte>& solidCells, bool mergeRects )
+{
+	GUARANTEE_OR_DIE( (int)solidCells.size() == dimensions.x * dimensions.y, "Tile grid collider cells don't match its dimensions" );
+
+	m_dimensions = dimensions;
+	m_solidCells = solidCells;
+
+	MergeSolidCells( mergeRects );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Grows each rect right along its row then up while every cell of the next row is solid and
+// unclaimed. Not the fewest rects possible but close on tile maps and linear in the cell count
+//-----------------------------------------------------------------------------------------------
+void TileGridCollider::MergeSolidCells( bool mergeRects )
+{
+	m_rects.clear();
+	m_cellRectIndexes.assign( m_solidCells.size(), -1 );
+
+	for ( int yCoord = 0; yCoord < m_dimensions.y; ++yCoord )
+	{
+		for ( int xCoord = 0; xCoord < m_dimensions.x; ++xCoord )
+		{
+			int cellIdx = xCoord + yCoord * m_dimensions.x;
+			if ( m_solidCells[cellIdx] == 0
+				 || m_cellRectIndexes[cellIdx] >= 0 )
+			{
+				continue;
+			}
+
+			TileGridRect rect;
+			rect.mins = IntVec2( xCoord, yCoord );
+			rect.maxs = IntVec2( xCoord + 1, yCoord + 1 );
+
+			if ( mergeRects )
+			{
+				while ( rect.maxs.x < m_dimensions.x
+						&& m_solidCells[rect.maxs.x + yCoord * m_dimensions.x] != 0
+						&& m_cellRectIndexes[rect.maxs.x + yCoord * m_dimensions.x] < 0 )
+				{
+					++rect.maxs.x;
+				}
+
+				bool canGrowUp = true;
+				while ( canGrowUp
+						&& rect.maxs.y < m_dimensions.y )
+				{
+					for ( int rowX = rect.mins.x; rowX < rect.maxs.x; ++rowX )
+					{
+						int rowCellIdx = rowX + rect.maxs.y * m_dimensions.x;
+						if ( m_solidCells[rowCellIdx] == 0
+							 || m_cellRectIndexes[rowCellIdx] >= 0 )
+						{
+							canGrowUp = false;
+							break;
+						}
+					}
+
+					if ( canGrowUp )
+					{
+						++rect.maxs.y;
+					}
+				}
+			}
+
+			int rectIdx = (int)m_rects.size();
+			m_rects.push_back( rect );
+
+			for ( int rectY = rect.mins.y; rectY < rect.maxs.y; ++rectY )
+			{
+				for ( int rectX = rect.mins.x; rectX < rect.maxs.x; ++rectX )
+				{
+					m_cellRectIndexes[rectX + rectY * m_dimensions.x] = rectIdx;
+				}
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileGridCollider::UpdateWorldShape()
+{
+	m_worldPosition = m_localPosition;
+
+	if ( m_rigidbody != nullptr )
+	{
+		m_worldPosition += m_rigidbody->GetWorldPosition();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+const Vec3 TileGridCollider::GetClosestPoint( const Vec3& pos ) const
+{
+	Vec2 closestPoint = pos.XY();
+	float closestDistSquared = INFINITY;
+
+	for ( int rectIdx = 0; rectIdx < (int)m_rects.size(); ++rectIdx )
+	{
+		Vec2 pointOnRect = GetNearestPointOnAABB2D( pos.XY(), GetWorldRect( rectIdx ) );
+		float distSquared = GetDistanceSquared2D( pointOnRect, pos.XY() );
+		if ( distSquared < closestDistSquared )
+		{
+			closestDistSquared = distSquared;
+			closestPoint = pointOnRect;
+		}
+	}
+
+	return Vec3( closestPoint, 0.f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TileGridCollider::Contains( const Vec3& pos ) const
+{
+	Vec2 cellCoords = ( pos.XY() - m_worldPosition.XY() ) / m_cellSize;
+	if ( cellCoords.x < 0.f
+		 || cellCoords.y < 0.f )
+	{
+		return false;
+	}
+
+	return IsCellSolid( (int)cellCoords.x, (int)cellCoords.y );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float TileGridCollider::GetBoundingRadius() const
+{
+	// The world position is a corner, so reach to the far one
+	return ( Vec2( (float)m_dimensions.x, (float)m_dimensions.y ) * m_cellSize ).GetLength();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AABB2 TileGridCollider::GetWorldBounds() const
+{
+	Vec2 gridMins = m_worldPosition.XY();
+	return AABB2( gridMins, gridMins + Vec2( (float)m_dimensions.x, (float)m_dimensions.y ) * m_cellSize );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AABB2 TileGridCollider::GetWorldRect( int rectIdx ) const
+{
+	const TileGridRect& rect = m_rects[rectIdx];
+
+	Vec2 gridMins = m_worldPosition.XY();
+	return AABB2( gridMins + Vec2( (float)rect.mins.x, (float)rect.mins.y ) * m_cellSize,
+				  gridMins + Vec2( (float)rect.maxs.x, (float)rect.maxs.y ) * m_cellSize );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int TileGridCollider::GetNumSolidCells() const
+{
+	int numSolidCells = 0;
+	for ( int cellIdx = 0; cellIdx < (int)m_solidCells.size(); ++cellIdx )
+	{
+		if ( m_solidCells[cellIdx] != 0 )
+		{
+			++numSolidCells;
+		}
+	}
+
+	return numSolidCells;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TileGridCollider::IsCellSolid( int xCoord, int yCoord ) const
+{
+	if ( xCoord < 0
+		 || xCoord >= m_dimensions.x
+		 || yCoord < 0
+		 || yCoord >= m_dimensions.y )
+	{
+		return false;
+	}
+
+	return m_solidCells[xCoord + yCoord * m_dimensions.x] != 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Each rect is a box with its share of the mass, moved to the world position with parallel axis
+//-----------------------------------------------------------------------------------------------
+float TileGridCollider::CalculateMoment( float mass )
+{
+	int numSolidCells = GetNumSolidCells();
+	if ( numSolidCells == 0 )
+	{
+		return 0.f;
+	}
+
+	float massPerCell = mass / (float)numSolidCells;
+	float totalI = 0.f;
+
+	for ( int rectIdx = 0; rectIdx < (int)m_rects.size(); ++rectIdx )
+	{
+		AABB2 rect = GetWorldRect( rectIdx );
+		Vec2 dimensions = rect.GetDimensions();
+		Vec2 centerOffset = rect.GetCenter() - m_worldPosition.XY();
+
+		const TileGridRect& cellRect = m_rects[rectIdx];
+		float rectMass = massPerCell * (float)( ( cellRect.maxs.x - cellRect.mins.x ) * ( cellRect.maxs.y - cellRect.mins.y ) );
+
+		totalI += rectMass * ( DotProduct2D( dimensions, dimensions ) / 12.f + DotProduct2D( centerOffset, centerOffset ) );
+	}
+
+	return totalI;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileGridCollider::DebugRender( const Rgba8& borderColor, const Rgba8& fillColor ) const
+{
+	UNUSED( borderColor ); UNUSED( fillColor );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Collider* TileGridCollider::Create( ColliderParams* params )
+{
+	TileGridCollider* collider = new TileGridCollider();
+	collider->m_localPosition = params->GetValue( "localPosition", Vec3::ZERO );
+	collider->m_cellSize = params->GetValue( "cellSize", 1.f );
+
+	return collider;
+}
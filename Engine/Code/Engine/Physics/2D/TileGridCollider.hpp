@@ -0,0 +1,121 @@
+#pragma once
+#include "Engine/Physics/Collider.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+// Run of solid cells, in cells with exclusive maxs
+struct TileGridRect
+{
+public:
+	IntVec2 mins;
+	IntVec2 maxs;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// One static collider for every solid tile of a grid. The world position is the mins corner of
+// cell 0,0 and cells are row major from there. Solid cells are merged greedily into rectangles so
+// long walls become one box, and queries only look at the rectangles under the cells they overlap
+//-----------------------------------------------------------------------------------------------
+class TileGridCollider : public Collider
+{
+public:
+	TileGridCollider();
+
+	// Non zero cells are solid, merging off gives one rect per solid cell
+	void SetSolidCells( const IntVec2& dimensions, const std::vector<byte>& solidCells, bool mergeRects = true );
+
+	virtual void UpdateWorldShape() override;
+
+	// queries
+	virtual const Vec3 GetClosestPoint( const Vec3& pos ) const override;
+	virtual bool Contains( const Vec3& pos ) const override;
+
+	virtual float GetBoundingRadius() const override;
+
+	AABB2 GetWorldBounds() const;
+	AABB2 GetWorldRect( int rectIdx ) const;
+	int GetNumRects() const														{ return (int)m_rects.size(); }
+	int GetNumSolidCells() const;
+	const IntVec2& GetDimensions() const										{ return m_dimensions; }
+	float GetCellSize() const													{ return m_cellSize; }
+	bool IsCellSolid( int xCoord, int yCoord ) const;
+
+	// Calls visitor( rectIdx ) once for each rect covering a solid cell under the bounds
+	template <typename RectVisitor>
+	void ForEachRectOverlappingBounds( const AABB2& worldBounds, RectVisitor visitor ) const;
+
+	virtual float CalculateMoment( float mass ) override;
+
+	// debug helpers
+	virtual void DebugRender( const Rgba8& borderColor, const Rgba8& fillColor ) const override;
+
+	// factory create
+	static Collider* Create( ColliderParams* params );
+
+protected:
+	virtual ~TileGridCollider() {}
+
+private:
+	void MergeSolidCells( bool mergeRects );
+
+private:
+	IntVec2 m_dimensions = IntVec2::ZERO;
+	float m_cellSize = 1.f;
+	std::vector<byte> m_solidCells;
+	std::vector<int> m_cellRectIndexes;			// -1 for open cells
+	std::vector<TileGridRect> m_rects;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// A rect is visited from the first of its cells inside the query, so no visited list is needed
+// and this stays safe to call from narrowphase jobs
+//-----------------------------------------------------------------------------------------------
+template <typename RectVisitor>
+void TileGridCollider::ForEachRectOverlappingBounds( const AABB2& worldBounds, RectVisitor visitor ) const
+{
+	if ( m_rects.empty() )
+	{
+		return;
+	}
+
+	Vec2 gridMins = m_worldPosition.XY();
+	int minX = ClampMinMaxInt( (int)floorf( ( worldBounds.mins.x - gridMins.x ) / m_cellSize ), 0, m_dimensions.x - 1 );
+	int minY = ClampMinMaxInt( (int)floorf( ( worldBounds.mins.y - gridMins.y ) / m_cellSize ), 0, m_dimensions.y - 1 );
+	int maxX = ClampMinMaxInt( (int)floorf( ( worldBounds.maxs.x - gridMins.x ) / m_cellSize ), 0, m_dimensions.x - 1 );
+	int maxY = ClampMinMaxInt( (int)floorf( ( worldBounds.maxs.y - gridMins.y ) / m_cellSize ), 0, m_dimensions.y - 1 );
+
+	if ( worldBounds.maxs.x < gridMins.x
+		 || worldBounds.maxs.y < gridMins.y
+		 || worldBounds.mins.x > gridMins.x + (float)m_dimensions.x * m_cellSize
+		 || worldBounds.mins.y > gridMins.y + (float)m_dimensions.y * m_cellSize )
+	{
+		return;
+	}
+
+	for ( int yCoord = minY; yCoord <= maxY; ++yCoord )
+	{
+		for ( int xCoord = minX; xCoord <= maxX; ++xCoord )
+		{
+			int rectIdx = m_cellRectIndexes[xCoord + yCoord * m_dimensions.x];
+			if ( rectIdx < 0 )
+			{
+				continue;
+			}
+
+			const TileGridRect& rect = m_rects[rectIdx];
+			if ( xCoord == Max( rect.mins.x, minX )
+				 && yCoord == Max( rect.mins.y, minY ) )
+			{
+				visitor( rectIdx );
+			}
+		}
+	}
+}
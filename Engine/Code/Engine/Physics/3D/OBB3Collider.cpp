@@ -1,4 +1,5 @@
 #include "Engine/Physics/3D/OBB3Collider.hpp"
+#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 
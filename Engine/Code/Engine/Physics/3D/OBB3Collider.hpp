@@ -21,6 +21,8 @@ public:
 	virtual const Vec3 GetClosestPoint( const Vec3& pos ) const override;
 	virtual bool Contains( const Vec3& pos ) const override;
 
+	virtual float GetBoundingRadius() const override		{ return m_outerRadius; }
+
 	virtual float CalculateMoment( float mass ) override;
 
 	// debug helpers
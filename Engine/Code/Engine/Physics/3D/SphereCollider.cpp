@@ -1,4 +1,5 @@
 #include "Engine/Physics/3D/SphereCollider.hpp"
+#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Physics/Manifold.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
@@ -19,6 +19,9 @@ public:
 	virtual const Vec3 GetClosestPoint( const Vec3& pos ) const override;
 	virtual bool Contains( const Vec3& pos ) const override;
 
+	virtual float GetBoundingRadius() const override							{ return m_radius; }
+	virtual float GetSweepRadius() const override								{ return m_radius; }
+
 	virtual float CalculateMoment( float mass ) override;
 
 	// debug helpers
@@ -12,6 +12,9 @@ typedef bool ( *CollisionCheckCallback )( const Collider*, const Collider* );
 
 int Collider::s_nextId = 1000;
 
+static const float SWEEP_TOLERANCE = .001f;
+static const int MAX_SWEEP_ITERATIONS = 16;
+
 
 //-----------------------------------------------------------------------------------------------
 Collider::Collider()
@@ -34,6 +37,60 @@ bool Collider::Contains( const Vec2& pos ) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+float Collider::GetDistanceToSurface( const Vec3& pos ) const
+{
+	if ( Contains( pos ) )
+	{
+		return 0.f;
+	}
+
+	return GetDistance3D( GetClosestPoint( pos ), pos );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Conservative advancement, a sphere can always move its gap to this collider without touching
+// it so keep stepping by the gap until it closes or the sweep ends. Treats this collider as still
+//-----------------------------------------------------------------------------------------------
+bool Collider::SweepSphere( const Vec3& start, const Vec3& displacement, float radius, float& out_timeOfImpact ) const
+{
+	float sweepLength = displacement.GetLength();
+	if ( sweepLength == 0.f )
+	{
+		return false;
+	}
+
+	// Already touching at the start, that contact belongs to the discrete pass
+	if ( GetDistanceToSurface( start ) - radius <= SWEEP_TOLERANCE )
+	{
+		return false;
+	}
+
+	float time = 0.f;
+	for ( int iterationNum = 0; iterationNum < MAX_SWEEP_ITERATIONS; ++iterationNum )
+	{
+		float gap = GetDistanceToSurface( start + displacement * time ) - radius;
+		if ( gap <= SWEEP_TOLERANCE )
+		{
+			out_timeOfImpact = time;
+			return true;
+		}
+
+		time += gap / sweepLength;
+		if ( time > 1.f )
+		{
+			return false;
+		}
+	}
+
+	// Still closing in after every iteration is a shallow approach, which converges slowly. Stopping
+	// at the time reached is safe since every step kept a gap, and the discrete pass takes it from there
+	out_timeOfImpact = time;
+	return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 float Collider::GetBounceWith( const Collider* otherCollider ) const
 {
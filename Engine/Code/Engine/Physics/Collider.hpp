@@ -24,6 +24,7 @@ enum eColliderType
 	// 2D
 	COLLIDER_DISC = 0,
 	COLLIDER_POLYGON,
+	COLLIDER_TILE_GRID,
 	
 	NUM_2D_COLLIDER_TYPES,
 
@@ -61,6 +62,12 @@ public:
 	virtual const Vec3 GetClosestPoint( const Vec3& pos ) const = 0;
 	virtual bool Contains( const Vec2& pos ) const;
 	virtual bool Contains( const Vec3& pos ) const = 0;
+	float GetDistanceToSurface( const Vec3& pos ) const;		// 0 when inside
+
+	// Swept queries for continuous collision, only round colliders can be swept
+	virtual float GetBoundingRadius() const = 0;				// around the world position
+	virtual float GetSweepRadius() const										{ return 0.f; }
+	bool SweepSphere( const Vec3& start, const Vec3& displacement, float radius, float& out_timeOfImpact ) const;
 
 	//virtual Manifold GetCollisionManifold( const Collider* other ) const = 0;
 	float GetBounceWith( const Collider* otherCollider ) const;
@@ -27,12 +27,12 @@ template <class CollisionPolicy>
 class CollisionResolver
 {
 public:
-	static void ResolveCollisions( std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum );
+	static void ResolveCollisions( std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum, PhysicsStepStats& stats );
 
 protected:
-	static void DetectCollisions( const std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum );
+	static void DetectCollisions( const std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum, PhysicsStepStats& stats );
 	static void ClearOldCollisions( CollisionVector& collisions, uint frameNum );
-	static void ResolveCollisions( CollisionVector& collisions );
+	static void ResolveCollisions( CollisionVector& collisions, PhysicsStepStats& stats );
 	static void ResolveCollision( const Collision& collision );
 	static void CorrectCollidingRigidbodies( Rigidbody* rigidbody1, Rigidbody* rigidbody2, const Manifold& collisionManifold );
 	 
@@ -40,6 +40,7 @@ protected:
 	static void AddOrUpdateCollision( CollisionVector& collisions, const Collision& collision );
 
 	static bool DoesCollisionInvolveATrigger( const Collision& collision );
+	static bool IsCollisionAtRest( const Collision& collision );
 };
 
 #include "Engine/Physics/CollisionResolver.inl"
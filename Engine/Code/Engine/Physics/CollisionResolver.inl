@@ -1,16 +1,19 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Physics/Collider.hpp"
+#include "Engine/Physics/PhysicsJobs.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
 #include "Engine/Physics/CollisionResolvers/CollisionPolicies.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
 template <class CollisionPolicy>
-void CollisionResolver<CollisionPolicy>::ResolveCollisions( std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum )
+void CollisionResolver<CollisionPolicy>::ResolveCollisions( std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum, PhysicsStepStats& stats )
 {
-	DetectCollisions( colliders, collisions, frameNum );					// determine all pairs of intersecting colliders
+	DetectCollisions( colliders, collisions, frameNum, stats );				// determine all pairs of intersecting colliders
 	ClearOldCollisions( collisions, frameNum );
-	ResolveCollisions( collisions );
+	ResolveCollisions( collisions, stats );
+
+	stats.numContacts = (int)collisions.size();
 }
 
 
@@ -23,10 +26,30 @@ bool CollisionResolver<CollisionPolicy>::DoesCollisionInvolveATrigger( const Col
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Neither body can move so the contact can't change, sleeping and static pairs keep their last result
+//-----------------------------------------------------------------------------------------------
+template <class CollisionPolicy>
+bool CollisionResolver<CollisionPolicy>::IsCollisionAtRest( const Collision& collision )
+{
+	return collision.myCollider->IsEnabled()
+		&& collision.theirCollider->IsEnabled()
+		&& collision.myCollider->GetRigidbody()->IsAtRest()
+		&& collision.theirCollider->GetRigidbody()->IsAtRest();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Broadphase filtering is cheap and stays serial, the manifold tests run across the job system and
+// come back in pair order so collision events fire in the same order as a serial run
 //-----------------------------------------------------------------------------------------------
 template <class CollisionPolicy>
-void CollisionResolver<CollisionPolicy>::DetectCollisions( const std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum )
+void CollisionResolver<CollisionPolicy>::DetectCollisions( const std::vector<Collider*>& colliders, CollisionVector& collisions, uint frameNum, PhysicsStepStats& stats )
 {
+	static std::vector<ColliderPair> s_pairs;
+	static std::vector<NarrowphaseContact> s_contacts;
+	s_pairs.clear();
+
 	for ( int colliderIdx = 0; colliderIdx < (int)colliders.size(); ++colliderIdx )
 	{
 		Collider* collider = colliders[colliderIdx];
@@ -36,6 +59,8 @@ void CollisionResolver<CollisionPolicy>::DetectCollisions( const std::vector<Col
 			continue;
 		}
 
+		bool isColliderAtRest = collider->GetRigidbody()->IsAtRest();
+
 		// Check intersection with other game objects
 		for ( int otherColliderIdx = colliderIdx + 1; otherColliderIdx < (int)colliders.size(); ++otherColliderIdx )
 		{
@@ -52,34 +77,48 @@ void CollisionResolver<CollisionPolicy>::DetectCollisions( const std::vector<Col
 				continue;
 			}
 
-			// Skip if colliders on non-interacting layers
-			if ( !DoPhysicsLayersInteract( collider->GetRigidbody()->GetLayer(),
-										   otherCollider->GetRigidbody()->GetLayer() ) )
+			// Skip if neither collider can move, e.g. sleeping vs sleeping or sleeping vs static
+			if ( isColliderAtRest
+				 && otherCollider->GetRigidbody()->IsAtRest() )
 			{
 				continue;
 			}
 
-			Manifold collisionManifold = CollisionPolicy::GetCollisionManifoldForColliders( collider, otherCollider );
-			
-			// Skip if no collision
-			if ( collisionManifold.normal == Vec3::ZERO )
+			// Skip if colliders on non-interacting layers
+			if ( !DoPhysicsLayersInteract( collider->GetRigidbody()->GetLayer(),
+										   otherCollider->GetRigidbody()->GetLayer() ) )
 			{
 				continue;
 			}
 
-			Collision collision;
-			collision.id = IntVec2( Min( collider->GetId(), otherCollider->GetId() ), Max( collider->GetId(), otherCollider->GetId() ) );
-			collision.frameNum = frameNum;
-			collision.myCollider = collider;
-			collision.theirCollider = otherCollider;
-			// Only set manifold if not triggers
-			if ( !DoesCollisionInvolveATrigger( collision ) )
-			{
-				collision.collisionManifold = collisionManifold;
-			}
+			ColliderPair pair;
+			pair.collider = collider;
+			pair.otherCollider = otherCollider;
+			s_pairs.push_back( pair );
+		}
+	}
+
+	stats.numPairsTested = (int)s_pairs.size();
+	GenerateNarrowphaseContacts( s_pairs, &CollisionPolicy::GetCollisionManifoldForColliders, s_contacts, stats );
 
-			AddOrUpdateCollision( collisions, collision );
+	for ( int contactIdx = 0; contactIdx < (int)s_contacts.size(); ++contactIdx )
+	{
+		const NarrowphaseContact& contact = s_contacts[contactIdx];
+		Collider* collider = s_pairs[contact.pairIdx].collider;
+		Collider* otherCollider = s_pairs[contact.pairIdx].otherCollider;
+
+		Collision collision;
+		collision.id = IntVec2( Min( collider->GetId(), otherCollider->GetId() ), Max( collider->GetId(), otherCollider->GetId() ) );
+		collision.frameNum = frameNum;
+		collision.myCollider = collider;
+		collision.theirCollider = otherCollider;
+		// Only set manifold if not triggers
+		if ( !DoesCollisionInvolveATrigger( collision ) )
+		{
+			collision.collisionManifold = contact.manifold;
 		}
+
+		AddOrUpdateCollision( collisions, collision );
 	}
 }
 
@@ -180,6 +219,14 @@ void CollisionResolver<CollisionPolicy>::ClearOldCollisions( CollisionVector& co
 	for ( int colIdx = 0; colIdx < (int)collisions.size(); ++colIdx )
 	{
 		Collision& collision = collisions[colIdx];
+		// Resting pairs aren't retested, they stay in contact until one of the bodies wakes
+		if ( collision.frameNum != frameNum
+			 && IsCollisionAtRest( collision ) )
+		{
+			collision.frameNum = frameNum;
+			continue;
+		}
+
 		// Check if collision is old
 		if ( collision.frameNum != frameNum )
 		{
@@ -200,18 +247,28 @@ void CollisionResolver<CollisionPolicy>::ClearOldCollisions( CollisionVector& co
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Contacts are colored so no two in a batch write the same body, each batch is solved in parallel
 //-----------------------------------------------------------------------------------------------
 template <class CollisionPolicy>
-void CollisionResolver<CollisionPolicy>::ResolveCollisions( CollisionVector& collisions )
+void CollisionResolver<CollisionPolicy>::ResolveCollisions( CollisionVector& collisions, PhysicsStepStats& stats )
 {
+	static std::vector<int> s_collisionIndexesToSolve;
+	static std::vector< std::vector<int> > s_colorBatches;
+	s_collisionIndexesToSolve.clear();
+
 	for ( int collisionIdx = 0; collisionIdx < (int)collisions.size(); ++collisionIdx )
 	{
-		Collision& collision = collisions[collisionIdx];
-		if ( !DoesCollisionInvolveATrigger( collision ) )
+		const Collision& collision = collisions[collisionIdx];
+		if ( !DoesCollisionInvolveATrigger( collision )
+			 && !IsCollisionAtRest( collision ) )
 		{
-			ResolveCollision( collision );
+			s_collisionIndexesToSolve.push_back( collisionIdx );
 		}
 	}
+
+	BuildContactColorBatches( collisions, s_collisionIndexesToSolve, s_colorBatches );
+	SolveContactColorBatches( collisions, s_colorBatches, &CollisionResolver<CollisionPolicy>::ResolveCollision, stats );
 }
 
 
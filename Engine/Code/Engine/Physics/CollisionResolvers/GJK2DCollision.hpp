@@ -6,6 +6,7 @@
 #include "Engine/Physics/Rigidbody.hpp"
 #include "Engine/Physics/2D/DiscCollider.hpp"
 #include "Engine/Physics/2D/Polygon2Collider.hpp"
+#include "Engine/Physics/2D/TileGridCollider.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 
 
@@ -14,26 +15,26 @@ typedef Manifold( *CollisionManifoldGenerationCallback )( const Collider*, const
 
 
 //-----------------------------------------------------------------------------------------------
-static Vec2 GetSupportPoint( const Polygon2Collider* polygonCollider1, const Polygon2Collider* polygonCollider2, const Vec2& direction )
+static Vec2 GetSupportPoint( const Polygon2& polygon1, const Polygon2& polygon2, const Vec2& direction )
 {
-	return polygonCollider1->GetFarthestPointInDirection( direction ) - polygonCollider2->GetFarthestPointInDirection( -direction );
+	return polygon1.GetFarthestPointInDirection( direction ) - polygon2.GetFarthestPointInDirection( -direction );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-static std::vector<Vec2> GetSimplexForGJKCollision( const Polygon2Collider* polygonCollider1, const Polygon2Collider* polygonCollider2 )
+static std::vector<Vec2> GetSimplexForGJKCollision( const Polygon2& polygon1, const Polygon2& polygon2 )
 {
 	// Initial point calculation
-	Vec2 direction = polygonCollider2->GetWorldPosition().XY() - polygonCollider1->GetWorldPosition().XY();
-	Vec2 supportPoint0 = GetSupportPoint( polygonCollider1, polygonCollider2, direction );
-	Vec2 supportPoint1 = GetSupportPoint( polygonCollider1, polygonCollider2, -direction );
+	Vec2 direction = polygon2.GetCenterOfMass() - polygon1.GetCenterOfMass();
+	Vec2 supportPoint0 = GetSupportPoint( polygon1, polygon2, direction );
+	Vec2 supportPoint1 = GetSupportPoint( polygon1, polygon2, -direction );
 
 	Vec2 supportEdge01 = supportPoint1 - supportPoint0;
 	direction = TripleProduct2D( supportEdge01, -supportPoint0, supportEdge01 );
 
 	while ( true )
 	{
-		Vec2 supportPoint2 = GetSupportPoint( polygonCollider1, polygonCollider2, direction );
+		Vec2 supportPoint2 = GetSupportPoint( polygon1, polygon2, direction );
 
 		// If the new support point equals an existing one, we've hit the edge of the polygon so we know there is no intersection
 		if ( supportPoint2 == supportPoint0
@@ -184,15 +185,15 @@ static bool GetClippedSegmentToSegment( const Vec2& segmentToClipStart, const Ve
 
 
 //-----------------------------------------------------------------------------------------------
-static void GetContactEdgeBetweenPolygons( const Polygon2Collider* polygonCollider1, const Polygon2Collider* polygonCollider2,
+static void GetContactEdgeBetweenPolygons( const Polygon2& polygon1, const Polygon2& polygon2,
 										   const Vec2& normal, float penetrationDepth,
 										   Vec3* out_contactMin, Vec3* out_contactMax )
 {
-	Vec2 pointOnB = polygonCollider2->GetFarthestPointInDirection( normal );
+	Vec2 pointOnB = polygon2.GetFarthestPointInDirection( normal );
 	Plane2D referencePlane( normal, pointOnB );
 
 	// Find every point of polygon2 that lies within a tolerance of the reference plane
-	const std::vector<Vec2>& pointsOfB = polygonCollider2->m_polygon.GetPoints();
+	const std::vector<Vec2>& pointsOfB = polygon2.GetPoints();
 	std::vector<Vec2> pointsAlongReferencePlane;
 	for ( int pointIdx = 0; pointIdx < (int)pointsOfB.size(); ++pointIdx )
 	{
@@ -242,11 +243,11 @@ static void GetContactEdgeBetweenPolygons( const Polygon2Collider* polygonCollid
 	// For each edge in polygon1, clip to reference edge and keep track of max and min clipped points
 	maxDistAlongTangent = -INFINITY;
 	minDistAlongTangent = INFINITY;
-	for ( int edgeIdx = 0; edgeIdx < polygonCollider1->m_polygon.GetEdgeCount(); ++edgeIdx )
+	for ( int edgeIdx = 0; edgeIdx < polygon1.GetEdgeCount(); ++edgeIdx )
 	{
 		Vec2 edgeStart;
 		Vec2 edgeEnd;
-		polygonCollider1->m_polygon.GetEdge( edgeIdx, &edgeStart, &edgeEnd );
+		polygon1.GetEdge( edgeIdx, &edgeStart, &edgeEnd );
 
 		Vec3 clippedMin;
 		Vec3 clippedMax;
@@ -292,18 +293,9 @@ static void GetContactEdgeBetweenPolygons( const Polygon2Collider* polygonCollid
 
 
 //-----------------------------------------------------------------------------------------------
-static Manifold PolygonVPolygonCollisionManifoldGenerator( const Collider* collider1, const Collider* collider2 )
+static Manifold GetPolygonVPolygonManifold( const Polygon2& polygon1, const Polygon2& polygon2 )
 {
-	// this function is only called if the types tell me these casts are safe - so no need to a dynamic cast or type checks here.
-	const Polygon2Collider* polygonCollider1 = (const Polygon2Collider*)collider1;
-	const Polygon2Collider* polygonCollider2 = (const Polygon2Collider*)collider2;
-
-	if ( !DoAABBsOverlap2D( polygonCollider1->GetWorldBounds(), polygonCollider2->GetWorldBounds() ) )
-	{
-		return Manifold();
-	}
-
-	std::vector<Vec2> simplex = GetSimplexForGJKCollision( polygonCollider1, polygonCollider2 );
+	std::vector<Vec2> simplex = GetSimplexForGJKCollision( polygon1, polygon2 );
 	if ( simplex.size() == 0 )
 	{
 		return Manifold();
@@ -327,7 +319,7 @@ static Manifold PolygonVPolygonCollisionManifoldGenerator( const Collider* colli
 		Vec2 normal = ( endEdge - startEdge ).GetRotatedMinus90Degrees();
 		normal.Normalize();
 
-		Vec2 nextSupportPoint = GetSupportPoint( polygonCollider1, polygonCollider2, normal );
+		Vec2 nextSupportPoint = GetSupportPoint( polygon1, polygon2, normal );
 		float distFromOriginToEdge = DotProduct2D( startEdge, normal );
 
 		if ( IsNearlyEqual( DotProduct2D( nextSupportPoint, normal ), distFromOriginToEdge, .0001f ) )
@@ -339,7 +331,7 @@ static Manifold PolygonVPolygonCollisionManifoldGenerator( const Collider* colli
 			manifold.contactPoint2 = Vec3( endEdge, 0.f );
 
 			// For this next algorithm we need to use the normal from 2 to 1
-			GetContactEdgeBetweenPolygons( polygonCollider1, polygonCollider2, -normal, distFromOriginToEdge, &manifold.contactPoint1, &manifold.contactPoint2 );
+			GetContactEdgeBetweenPolygons( polygon1, polygon2, -normal, distFromOriginToEdge, &manifold.contactPoint1, &manifold.contactPoint2 );
 			return manifold;
 		}
 		else
@@ -363,12 +355,143 @@ static Manifold PolygonVPolygonCollisionManifoldGenerator( const Collider* colli
 }
 
 
+//-----------------------------------------------------------------------------------------------
+static Manifold PolygonVPolygonCollisionManifoldGenerator( const Collider* collider1, const Collider* collider2 )
+{
+	// this function is only called if the types tell me these casts are safe - so no need to a dynamic cast or type checks here.
+	const Polygon2Collider* polygonCollider1 = (const Polygon2Collider*)collider1;
+	const Polygon2Collider* polygonCollider2 = (const Polygon2Collider*)collider2;
+
+	if ( !DoAABBsOverlap2D( polygonCollider1->GetWorldBounds(), polygonCollider2->GetWorldBounds() ) )
+	{
+		return Manifold();
+	}
+
+	return GetPolygonVPolygonManifold( polygonCollider1->m_polygon, polygonCollider2->m_polygon );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Same conventions as disc vs polygon, the normal points from the disc into the box
+//-----------------------------------------------------------------------------------------------
+static bool GetDiscVAABB2Manifold( const Vec3& discCenter, float discRadius, const AABB2& box, Manifold& out_manifold )
+{
+	Vec2 center = discCenter.XY();
+	Vec2 closestPointOnBox = GetNearestPointOnAABB2D( center, box );
+	Vec2 discToBox = closestPointOnBox - center;
+	float distToBox = discToBox.GetLength();
+
+	Vec2 normal;
+	float penetrationDepth = 0.f;
+	if ( distToBox > 0.f )
+	{
+		if ( distToBox >= discRadius )
+		{
+			return false;
+		}
+
+		normal = discToBox / distToBox;
+		penetrationDepth = discRadius - distToBox;
+	}
+	else
+	{
+		// Center is inside, push out through the nearest side
+		float distToLeft = center.x - box.mins.x;
+		float distToRight = box.maxs.x - center.x;
+		float distToBottom = center.y - box.mins.y;
+		float distToTop = box.maxs.y - center.y;
+		float distToSide = Min( Min( distToLeft, distToRight ), Min( distToBottom, distToTop ) );
+
+		if ( distToSide == distToLeft )			{ normal = Vec2( 1.f, 0.f ); }
+		else if ( distToSide == distToRight )	{ normal = Vec2( -1.f, 0.f ); }
+		else if ( distToSide == distToBottom )	{ normal = Vec2( 0.f, 1.f ); }
+		else									{ normal = Vec2( 0.f, -1.f ); }
+
+		penetrationDepth = discRadius + distToSide;
+	}
+
+	out_manifold.normal = Vec3( normal, 0.f );
+	out_manifold.penetrationDepth = penetrationDepth;
+
+	Vec3 closestPointOnDiscToBox = discCenter + ( out_manifold.normal * discRadius );
+	out_manifold.contactPoint1 = closestPointOnDiscToBox - ( out_manifold.normal * penetrationDepth * .5f );
+	out_manifold.contactPoint2 = out_manifold.contactPoint1;
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Only the rects under the disc are tested. A pair can only hold one manifold so the deepest
+// rect wins, the rest are picked up on later steps once that one is resolved
+//-----------------------------------------------------------------------------------------------
+static Manifold DiscVTileGridCollisionManifoldGenerator( const Collider* collider1, const Collider* collider2 )
+{
+	// this function is only called if the types tell me these casts are safe - so no need to a dynamic cast or type checks here.
+	const DiscCollider* discCollider = (const DiscCollider*)collider1;
+	const TileGridCollider* tileGridCollider = (const TileGridCollider*)collider2;
+
+	Manifold deepestManifold;
+	tileGridCollider->ForEachRectOverlappingBounds( discCollider->GetWorldBounds(), [&]( int rectIdx )
+	{
+		Manifold manifold;
+		if ( GetDiscVAABB2Manifold( discCollider->GetWorldPosition(), discCollider->m_radius, tileGridCollider->GetWorldRect( rectIdx ), manifold )
+			 && manifold.penetrationDepth > deepestManifold.penetrationDepth )
+		{
+			deepestManifold = manifold;
+		}
+	} );
+
+	return deepestManifold;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Manifold PolygonVTileGridCollisionManifoldGenerator( const Collider* collider1, const Collider* collider2 )
+{
+	// this function is only called if the types tell me these casts are safe - so no need to a dynamic cast or type checks here.
+	const Polygon2Collider* polygonCollider = (const Polygon2Collider*)collider1;
+	const TileGridCollider* tileGridCollider = (const TileGridCollider*)collider2;
+
+	const AABB2 polygonBounds = polygonCollider->GetWorldBounds();
+
+	Manifold deepestManifold;
+	tileGridCollider->ForEachRectOverlappingBounds( polygonBounds, [&]( int rectIdx )
+	{
+		AABB2 rect = tileGridCollider->GetWorldRect( rectIdx );
+		if ( !DoAABBsOverlap2D( polygonBounds, rect ) )
+		{
+			return;
+		}
+
+		Manifold manifold = GetPolygonVPolygonManifold( polygonCollider->m_polygon, rect.GetAsPolygon2() );
+		if ( manifold.normal != Vec3::ZERO
+			 && manifold.penetrationDepth > deepestManifold.penetrationDepth )
+		{
+			deepestManifold = manifold;
+		}
+	} );
+
+	return deepestManifold;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Manifold TileGridVTileGridCollisionManifoldGenerator( const Collider* collider1, const Collider* collider2 )
+{
+	// Grids are static level geometry and never push each other
+	UNUSED( collider1 ); UNUSED( collider2 );
+	return Manifold();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // a "matrix" lookup is just a 2D array
 static CollisionManifoldGenerationCallback g_ManifoldGenerators[NUM_2D_COLLIDER_TYPES * NUM_2D_COLLIDER_TYPES] = {
-	/*             disc,                         polygon, */
-	/*    disc */  DiscVDiscCollisionManifoldGenerator,      nullptr,
-	/* polygon */  DiscVPolygonCollisionManifoldGenerator,   PolygonVPolygonCollisionManifoldGenerator
+	/*               disc,                                       polygon,                                       tile grid */
+	/*      disc */  DiscVDiscCollisionManifoldGenerator,        nullptr,                                       nullptr,
+	/*   polygon */  DiscVPolygonCollisionManifoldGenerator,     PolygonVPolygonCollisionManifoldGenerator,     nullptr,
+	/* tile grid */  DiscVTileGridCollisionManifoldGenerator,    PolygonVTileGridCollisionManifoldGenerator,    TileGridVTileGridCollisionManifoldGenerator
 };
 
 
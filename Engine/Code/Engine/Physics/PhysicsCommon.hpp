@@ -42,13 +42,76 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------------------------
+// An island sleeps once every body in it has stayed under both speeds for secondsBeforeSleep
+struct PhysicsSleepSettings
+{
+public:
+	bool isSleepEnabled = true;
+	float linearSleepSpeed = .05f;
+	float angularSleepSpeed = .05f;			// radians per second
+	float secondsBeforeSleep = .5f;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct PhysicsStepStats
+{
+public:
+	int numAwakeBodies = 0;
+	int numSleepingBodies = 0;
+	int numIslands = 0;
+	int numSleepingIslands = 0;
+	int numPairsTested = 0;
+	int numContacts = 0;
+	int numNarrowphaseJobs = 0;
+	int numContactColors = 0;
+	int numSweptBodies = 0;
+	int numTimeOfImpactHits = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct PhysicsFrameStats
+{
+public:
+	int numSubsteps = 0;
+	float stepDeltaSeconds = 0.f;			// Larger than the fixed step when adaptive stepping kicked in
+	float droppedSeconds = 0.f;				// Time the substep budget couldn't cover
+	float interpolationFraction = 0.f;		// Leftover accumulator time as a fraction of a step
+};
+
+
 //-----------------------------------------------------------------------------------------------
 typedef void ( *AffectorFn )( Rigidbody* rigidbody );
+
+
+//-----------------------------------------------------------------------------------------------
+enum class eAffectorType
+{
+	PER_BODY,			// Calls perBodyFn on each dynamic rigidbody
+	UNIFORM_FORCE,		// Adds force to every dynamic rigidbody in one pass over the store
+	DRAG,				// Adds every dynamic rigidbody's drag force in one pass over the store
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct PhysicsAffector
+{
+public:
+	std::string name;
+	eAffectorType type = eAffectorType::PER_BODY;
+	AffectorFn perBodyFn = nullptr;
+	Vec3 force = Vec3::ZERO;
+};
+
+
+//-----------------------------------------------------------------------------------------------
 // TODO: Change these from pointers to flat data
 typedef std::vector<Rigidbody*> RigidbodyVector;
 typedef std::vector<Collider*> ColliderVector;
 typedef std::vector<Collision> CollisionVector;
-typedef std::map<std::string, AffectorFn> AffectorMap;
+typedef std::vector<PhysicsAffector> AffectorVector;
 
 typedef std::string ColliderId;
 typedef NamedProperties ColliderParams;
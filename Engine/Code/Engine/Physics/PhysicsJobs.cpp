@@ -0,0 +1,259 @@
+#include "Engine/Physics/PhysicsJobs.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Physics/Collider.hpp"
+#include "Engine/Physics/PhysicsScene.hpp"
+#include "Engine/Physics/Rigidbody.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+static bool s_isParallelPhysicsEnabled = true;
+static const int MIN_PAIRS_PER_NARROWPHASE_JOB = 64;
+static const int MIN_CONTACTS_PER_SOLVE_JOB = 32;
+
+static std::vector< std::vector<NarrowphaseContact> > s_chunkContactBuffers;
+
+// Scratch space for coloring, indexed by store body index
+static std::vector<uint64_t> s_bodyUsedColorMasks;
+static std::vector<int> s_bodyHighestColors;
+
+
+//-----------------------------------------------------------------------------------------------
+static int GetNumChunksForWork( int numItems, int minItemsPerChunk )
+{
+	if ( !s_isParallelPhysicsEnabled
+		 || g_jobSystem == nullptr
+		 || g_jobSystem->GetNumWorkerThreads() == 0 )
+	{
+		return 1;
+	}
+
+	return g_jobSystem->GetNumParallelForRanges( numItems, minItemsPerChunk );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void GenerateContacts( const std::vector<ColliderPair>& pairs, int firstPairIdx, int endPairIdx, ManifoldGeneratorFn manifoldGenerator,
+							  std::vector<NarrowphaseContact>& out_contacts )
+{
+	for ( int pairIdx = firstPairIdx; pairIdx < endPairIdx; ++pairIdx )
+	{
+		const ColliderPair& pair = pairs[pairIdx];
+
+		NarrowphaseContact contact;
+		contact.manifold = manifoldGenerator( pair.collider, pair.otherCollider );
+		if ( contact.manifold.normal == Vec3::ZERO )
+		{
+			continue;
+		}
+
+		contact.pairIdx = pairIdx;
+		out_contacts.push_back( contact );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void SolveContacts( const CollisionVector& collisions, const std::vector<int>& collisionIndexes, int firstIdx, int endIdx,
+						   ContactSolverFn contactSolver )
+{
+	for ( int idx = firstIdx; idx < endIdx; ++idx )
+	{
+		contactSolver( collisions[collisionIndexes[idx]] );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Free functions
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+bool IsParallelPhysicsEnabled()
+{
+	return s_isParallelPhysicsEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SetParallelPhysicsEnabled( bool isEnabled )
+{
+	s_isParallelPhysicsEnabled = isEnabled;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GenerateNarrowphaseContacts( const std::vector<ColliderPair>& pairs, ManifoldGeneratorFn manifoldGenerator,
+								  std::vector<NarrowphaseContact>& out_contacts, PhysicsStepStats& stats )
+{
+	out_contacts.clear();
+
+	int numPairs = (int)pairs.size();
+	int numChunks = GetNumChunksForWork( numPairs, MIN_PAIRS_PER_NARROWPHASE_JOB );
+	stats.numNarrowphaseJobs = numChunks;
+
+	if ( numChunks == 1 )
+	{
+		GenerateContacts( pairs, 0, numPairs, manifoldGenerator, out_contacts );
+		return;
+	}
+
+	if ( (int)s_chunkContactBuffers.size() < numChunks )
+	{
+		s_chunkContactBuffers.resize( numChunks );
+	}
+
+	// First chunk goes straight into the output since it comes first in pair order anyway
+	g_jobSystem->ParallelFor( numPairs, numChunks, [&]( int chunkIdx, int firstPairIdx, int endPairIdx )
+	{
+		std::vector<NarrowphaseContact>& contactBuffer = chunkIdx == 0 ? out_contacts : s_chunkContactBuffers[chunkIdx];
+		if ( chunkIdx > 0 )
+		{
+			contactBuffer.clear();
+		}
+
+		GenerateContacts( pairs, firstPairIdx, endPairIdx, manifoldGenerator, contactBuffer );
+	} );
+
+	for ( int chunkIdx = 1; chunkIdx < numChunks; ++chunkIdx )
+	{
+		const std::vector<NarrowphaseContact>& contactBuffer = s_chunkContactBuffers[chunkIdx];
+		out_contacts.insert( out_contacts.end(), contactBuffer.begin(), contactBuffer.end() );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Only bodies a solve writes to conflict, static bodies are read only
+//-----------------------------------------------------------------------------------------------
+static int GetWritableBodyIndex( const Collider* collider )
+{
+	Rigidbody* rigidbody = collider->GetRigidbody();
+	if ( rigidbody->GetSimulationMode() == SIMULATION_MODE_STATIC )
+	{
+		return -1;
+	}
+
+	return rigidbody->GetPhysicsScene()->rigidbodyStore.GetBodyIndex( rigidbody->GetHandle() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void BuildContactColorBatches( const CollisionVector& collisions, const std::vector<int>& collisionIndexesToSolve,
+							   std::vector< std::vector<int> >& out_colorBatches )
+{
+	for ( int batchIdx = 0; batchIdx < (int)out_colorBatches.size(); ++batchIdx )
+	{
+		out_colorBatches[batchIdx].clear();
+	}
+
+	if ( collisionIndexesToSolve.empty() )
+	{
+		out_colorBatches.clear();
+		return;
+	}
+
+	const Collision& firstCollision = collisions[collisionIndexesToSolve[0]];
+	int numBodies = firstCollision.myCollider->GetRigidbody()->GetPhysicsScene()->rigidbodyStore.GetNumBodies();
+	s_bodyUsedColorMasks.assign( numBodies, 0 );
+	s_bodyHighestColors.assign( numBodies, -1 );
+
+	int numColors = 0;
+	for ( int idx = 0; idx < (int)collisionIndexesToSolve.size(); ++idx )
+	{
+		int collisionIdx = collisionIndexesToSolve[idx];
+		const Collision& collision = collisions[collisionIdx];
+
+		int bodyIdx = GetWritableBodyIndex( collision.myCollider );
+		int otherBodyIdx = GetWritableBodyIndex( collision.theirCollider );
+
+		uint64_t usedColorMask = 0;
+		int highestUsedColor = -1;
+		if ( bodyIdx >= 0 )
+		{
+			usedColorMask |= s_bodyUsedColorMasks[bodyIdx];
+			highestUsedColor = Max( highestUsedColor, s_bodyHighestColors[bodyIdx] );
+		}
+		if ( otherBodyIdx >= 0 )
+		{
+			usedColorMask |= s_bodyUsedColorMasks[otherBodyIdx];
+			highestUsedColor = Max( highestUsedColor, s_bodyHighestColors[otherBodyIdx] );
+		}
+
+		// Lowest color neither body is in yet, past the mask just go after the highest color either is in
+		int color = 0;
+		while ( color < 64
+				&& ( usedColorMask & ( 1ULL << color ) ) != 0 )
+		{
+			++color;
+		}
+		if ( color == 64 )
+		{
+			color = highestUsedColor + 1;
+		}
+
+		if ( bodyIdx >= 0 )
+		{
+			if ( color < 64 ) { s_bodyUsedColorMasks[bodyIdx] |= ( 1ULL << color ); }
+			s_bodyHighestColors[bodyIdx] = Max( s_bodyHighestColors[bodyIdx], color );
+		}
+		if ( otherBodyIdx >= 0 )
+		{
+			if ( color < 64 ) { s_bodyUsedColorMasks[otherBodyIdx] |= ( 1ULL << color ); }
+			s_bodyHighestColors[otherBodyIdx] = Max( s_bodyHighestColors[otherBodyIdx], color );
+		}
+
+		if ( color >= (int)out_colorBatches.size() )
+		{
+			out_colorBatches.resize( color + 1 );
+		}
+
+		out_colorBatches[color].push_back( collisionIdx );
+		numColors = Max( numColors, color + 1 );
+	}
+
+	out_colorBatches.resize( numColors );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SolveContactColorBatches( const CollisionVector& collisions, const std::vector< std::vector<int> >& colorBatches,
+							   ContactSolverFn contactSolver, PhysicsStepStats& stats )
+{
+	stats.numContactColors = (int)colorBatches.size();
+
+	for ( int batchIdx = 0; batchIdx < (int)colorBatches.size(); ++batchIdx )
+	{
+		const std::vector<int>& batch = colorBatches[batchIdx];
+
+		int numContacts = (int)batch.size();
+		int numChunks = GetNumChunksForWork( numContacts, MIN_CONTACTS_PER_SOLVE_JOB );
+		if ( numChunks == 1 )
+		{
+			SolveContacts( collisions, batch, 0, numContacts, contactSolver );
+			continue;
+		}
+
+		// Returns once the whole batch is solved, the next one may share bodies with it
+		g_jobSystem->ParallelFor( numContacts, numChunks, [&]( int chunkIdx, int firstIdx, int endIdx )
+		{
+			UNUSED( chunkIdx );
+			SolveContacts( collisions, batch, firstIdx, endIdx, contactSolver );
+		} );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool SetParallelPhysicsEvent( EventArgs* args )
+{
+	s_isParallelPhysicsEnabled = args->GetValue( "enabled", !s_isParallelPhysicsEnabled );
+
+	g_devConsole->PrintString( Stringf( "Parallel physics %s", s_isParallelPhysicsEnabled ? "enabled" : "disabled" ) );
+	return false;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Physics/Manifold.hpp"
+#include "Engine/Physics/PhysicsCommon.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+class Collider;
+
+
+//-----------------------------------------------------------------------------------------------
+typedef Manifold ( *ManifoldGeneratorFn )( const Collider* collider, const Collider* otherCollider );
+typedef void ( *ContactSolverFn )( const Collision& collision );
+
+
+//-----------------------------------------------------------------------------------------------
+struct ColliderPair
+{
+public:
+	Collider* collider = nullptr;
+	Collider* otherCollider = nullptr;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct NarrowphaseContact
+{
+public:
+	int pairIdx = -1;
+	Manifold manifold;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Splits broadphase pairs and colored contact batches across the job system. Both are
+// deterministic for any number of threads: contacts are merged back in pair order and bodies
+// touched by one batch are disjoint, so the order within a batch doesn't matter
+//-----------------------------------------------------------------------------------------------
+bool IsParallelPhysicsEnabled();
+void SetParallelPhysicsEnabled( bool isEnabled );
+
+void GenerateNarrowphaseContacts( const std::vector<ColliderPair>& pairs, ManifoldGeneratorFn manifoldGenerator,
+								  std::vector<NarrowphaseContact>& out_contacts, PhysicsStepStats& stats );
+
+// Greedy graph coloring in collision order, batches are solved one after another
+void BuildContactColorBatches( const CollisionVector& collisions, const std::vector<int>& collisionIndexesToSolve,
+							   std::vector< std::vector<int> >& out_colorBatches );
+void SolveContactColorBatches( const CollisionVector& collisions, const std::vector< std::vector<int> >& colorBatches,
+							   ContactSolverFn contactSolver, PhysicsStepStats& stats );
+
+// Console commands
+bool SetParallelPhysicsEvent( EventArgs* args );
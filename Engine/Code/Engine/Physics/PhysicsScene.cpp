@@ -2,6 +2,7 @@
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
@@ -9,7 +10,10 @@ void PhysicsScene::DebugRender() const
 {
 	for ( int rigidbodyIdx = 0; rigidbodyIdx < (int)rigidbodies.size(); ++rigidbodyIdx )
 	{
-		rigidbodies[rigidbodyIdx]->DebugRender( Rgba8::YELLOW, Rgba8::RED );
+		if ( rigidbodies[rigidbodyIdx] != nullptr )
+		{
+			rigidbodies[rigidbodyIdx]->DebugRender( Rgba8::YELLOW, Rgba8::RED );
+		}
 	}
 }
 
@@ -32,6 +36,19 @@ Rigidbody* PhysicsScene::CreateRigidbody()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+Rigidbody* PhysicsScene::GetRigidbody( const RigidbodyHandle& handle ) const
+{
+	int bodyIdx = rigidbodyStore.GetBodyIndex( handle );
+	if ( bodyIdx < 0 )
+	{
+		return nullptr;
+	}
+
+	return rigidbodyStore.GetOwner( bodyIdx );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Collider* PhysicsScene::CreateCollider( const ColliderId& type, ColliderParams* params )
 {
@@ -92,14 +109,66 @@ void PhysicsScene::Reset()
 //-----------------------------------------------------------------------------------------------
 void PhysicsScene::AddAffector( const std::string& name, AffectorFn affectorFunc )
 {
-	affectors[name] = affectorFunc;
+	PhysicsAffector affector;
+	affector.name = name;
+	affector.type = eAffectorType::PER_BODY;
+	affector.perBodyFn = affectorFunc;
+
+	AddAffector( affector );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void PhysicsScene::AddUniformForceAffector( const std::string& name, const Vec3& force )
+{
+	PhysicsAffector affector;
+	affector.name = name;
+	affector.type = eAffectorType::UNIFORM_FORCE;
+	affector.force = force;
+
+	AddAffector( affector );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void PhysicsScene::AddDragAffector( const std::string& name )
+{
+	PhysicsAffector affector;
+	affector.name = name;
+	affector.type = eAffectorType::DRAG;
+
+	AddAffector( affector );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void PhysicsScene::AddAffector( const PhysicsAffector& affector )
+{
+	// Adding an existing name replaces it in place so the apply order doesn't change
+	for ( int affectorIdx = 0; affectorIdx < (int)affectors.size(); ++affectorIdx )
+	{
+		if ( affectors[affectorIdx].name == affector.name )
+		{
+			affectors[affectorIdx] = affector;
+			return;
+		}
+	}
+
+	affectors.push_back( affector );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void PhysicsScene::RemoveAffector( const std::string& name )
 {
-	affectors.erase( name );
+	for ( int affectorIdx = 0; affectorIdx < (int)affectors.size(); ++affectorIdx )
+	{
+		if ( affectors[affectorIdx].name == name )
+		{
+			affectors.erase( affectors.begin() + affectorIdx );
+			return;
+		}
+	}
 }
 
 
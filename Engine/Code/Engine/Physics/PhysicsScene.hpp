@@ -3,6 +3,7 @@
 #include "Engine/Physics/Collider.hpp"
 #include "Engine/Physics/PhysicsCommon.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
+#include "Engine/Physics/RigidbodyStore.hpp"
 
 #include <vector>
 
@@ -11,8 +12,10 @@
 struct PhysicsScene 
 {
 public:
-	AffectorMap affectors;
+	AffectorVector affectors;
+	PhysicsSleepSettings sleepSettings;
 
+	RigidbodyStore rigidbodyStore;		// simulation data for every rigidbody, indexed by handle
 	RigidbodyVector rigidbodies;
 	ColliderVector colliders;
 	CollisionVector collisions;
@@ -27,10 +30,13 @@ public:
 	void Reset();
 
 	void AddAffector( const std::string& name, AffectorFn affectorFunc );
+	void AddUniformForceAffector( const std::string& name, const Vec3& force );
+	void AddDragAffector( const std::string& name );
 	void RemoveAffector( const std::string& name );
 
 	Rigidbody* CreateRigidbodyForEntity( const EntityId& parentEntityId );
 	Rigidbody* CreateRigidbody();
+	Rigidbody* GetRigidbody( const RigidbodyHandle& handle ) const;		// nullptr once the rigidbody is destroyed
 	Collider* CreateCollider( const ColliderId& type, ColliderParams* params );
 	Collider* CreateTrigger( const ColliderId& type, ColliderParams* params );
 
@@ -39,6 +45,8 @@ public:
 	void CleanupDestroyedObjects();
 
 private:
+	void AddAffector( const PhysicsAffector& affector );
+
 	void DestroyAllRigidbodies();
 	void DestroyAllColliders();
 };
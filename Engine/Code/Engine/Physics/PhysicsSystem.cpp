@@ -1,14 +1,26 @@
 #include "Engine/Physics/PhysicsSystem.hpp"
+#include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Physics/Collider.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
+#include "Engine/Physics/RigidbodyStore.hpp"
 #include "Engine/Time/Clock.hpp"
-#include "Engine/Time/Timer.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include <cfloat>
 
 
 //-----------------------------------------------------------------------------------------------
 static float s_fixedDeltaSeconds = 1.0f / 120.0f;
+static int s_maxSubstepsPerFrame = 8;
+static bool s_isAdaptiveStepEnabled = true;
+static float s_maxAdaptiveStepScale = 2.f;
+static float s_continuousContactSkin = .01f;		// how far a swept body is left inside what it hit so the discrete pass sees the contact
 
 
 //-----------------------------------------------------------------------------------------------
@@ -21,71 +33,372 @@ void PhysicsSystemBase::Startup( Clock* gameClock )
 	}
 
 	m_physicsClock = new Clock( m_gameClock );
-	m_stepTimer = new Timer( m_physicsClock );
-
-	m_stepTimer->SetSeconds( s_fixedDeltaSeconds );
+	m_accumulatedSeconds = 0.0;
 
 	g_eventSystem->RegisterEvent( "set_physics_update", "Usage: set_physics_update hz=NUMBER. Set rate of physics update in hz.", eUsageLocation::DEV_CONSOLE, SetPhysicsUpdateRate );
+	g_eventSystem->RegisterEvent( "set_physics_step_budget", "Usage: set_physics_step_budget maxSubsteps=8 adaptive=true maxStepScale=2. Limit catch up steps per frame.", eUsageLocation::DEV_CONSOLE, SetPhysicsStepBudget );
+	g_eventSystem->RegisterEvent( "set_physics_parallel", "Usage: set_physics_parallel enabled=true. Run narrowphase and contact solving on the job system.", eUsageLocation::DEV_CONSOLE, SetParallelPhysicsEvent );
+	g_eventSystem->RegisterMethodEvent( "physics_stats", "Print awake bodies, islands and pairs tested in the last physics step", eUsageLocation::DEV_CONSOLE, this, &PhysicsSystemBase::PrintPhysicsStats );
+	g_eventSystem->RegisterEvent( "benchmark_physics_integration", "Usage: benchmark_physics_integration bodies=10000 steps=120. Compare the pooled rigidbody store with per object bodies.", eUsageLocation::DEV_CONSOLE, BenchmarkRigidbodyIntegration );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void PhysicsSystemBase::Update( PhysicsScene& scene )
 {
-	while ( m_stepTimer->CheckAndDecrement() )
+	PhysicsFrameStats frameStats;
+
+	// 0 hz pauses physics
+	if ( s_fixedDeltaSeconds <= 0.f )
+	{
+		m_accumulatedSeconds = 0.0;
+		frameStats.interpolationFraction = 1.f;
+		m_lastFrameStats = frameStats;
+		return;
+	}
+
+	m_accumulatedSeconds += m_physicsClock->GetLastDeltaSeconds();
+
+	float stepSeconds = s_fixedDeltaSeconds;
+	int numStepsOwed = (int)( m_accumulatedSeconds / (double)stepSeconds );
+	if ( s_isAdaptiveStepEnabled
+		 && numStepsOwed > s_maxSubstepsPerFrame )
 	{
-		AdvanceSimulation( scene, s_fixedDeltaSeconds );
+		stepSeconds = Min( (float)( m_accumulatedSeconds / (double)s_maxSubstepsPerFrame ), s_fixedDeltaSeconds * s_maxAdaptiveStepScale );
 	}
 
-	//AdvanceSimulation( scene, (float)m_physicsClock->GetLastDeltaSeconds() );
+	while ( frameStats.numSubsteps < s_maxSubstepsPerFrame
+			&& m_accumulatedSeconds >= (double)stepSeconds )
+	{
+		scene.rigidbodyStore.SavePreviousTransforms();
+		AdvanceSimulation( scene, stepSeconds );
+
+		m_accumulatedSeconds -= (double)stepSeconds;
+		++frameStats.numSubsteps;
+	}
 
-	// Update TransformComponents
+	// Drop whatever the budget couldn't cover instead of carrying it into the next frame's budget,
+	// the partial step is kept for interpolation
+	if ( m_accumulatedSeconds >= (double)stepSeconds )
+	{
+		double leftoverSeconds = fmod( m_accumulatedSeconds, (double)stepSeconds );
+		frameStats.droppedSeconds = (float)( m_accumulatedSeconds - leftoverSeconds );
+		m_accumulatedSeconds = leftoverSeconds;
+	}
+
+	frameStats.stepDeltaSeconds = stepSeconds;
+	frameStats.interpolationFraction = ClampZeroToOne( (float)( m_accumulatedSeconds / (double)stepSeconds ) );
+	m_lastFrameStats = frameStats;
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void PhysicsSystemBase::ApplyAffectors( RigidbodyVector& rigidbodies, const AffectorMap& affectors )
+void PhysicsSystemBase::ApplyAffectors( RigidbodyStore& rigidbodyStore, const AffectorVector& affectors )
 {
-	for ( auto& rigidbody : rigidbodies )
+	for ( int affectorIdx = 0; affectorIdx < (int)affectors.size(); ++affectorIdx )
 	{
-		if ( rigidbody->GetSimulationMode() == SIMULATION_MODE_DYNAMIC )
+		const PhysicsAffector& affector = affectors[affectorIdx];
+		switch ( affector.type )
 		{
-			for ( const auto& affector : affectors )
+			case eAffectorType::UNIFORM_FORCE:	rigidbodyStore.ApplyUniformForce( affector.force ); break;
+			case eAffectorType::DRAG:			rigidbodyStore.ApplyDragForces(); break;
+
+			case eAffectorType::PER_BODY:
 			{
-				affector.second( rigidbody );
+				for ( int bodyIdx = 0; bodyIdx < rigidbodyStore.GetNumBodies(); ++bodyIdx )
+				{
+					if ( rigidbodyStore.IsAffectable( bodyIdx ) )
+					{
+						affector.perBodyFn( rigidbodyStore.GetOwner( bodyIdx ) );
+					}
+				}
 			}
+			break;
 		}
 	}
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void PhysicsSystemBase::MoveRigidbodies( RigidbodyVector& rigidbodies, float deltaSeconds )
+void PhysicsSystemBase::MoveRigidbodies( RigidbodyStore& rigidbodyStore, float deltaSeconds )
 {
-	for ( int rigidbodyIdx = 0; rigidbodyIdx < (int)rigidbodies.size(); ++rigidbodyIdx )
+	rigidbodyStore.Integrate( deltaSeconds );
+
+	for ( int bodyIdx = 0; bodyIdx < rigidbodyStore.GetNumBodies(); ++bodyIdx )
 	{
-		Rigidbody*& rigidbody = rigidbodies[rigidbodyIdx];
-		if ( rigidbody == nullptr )
+		if ( !rigidbodyStore.IsMovable( bodyIdx ) )
 		{
 			continue;
 		}
 
-		switch ( rigidbody->GetSimulationMode() )
+		Rigidbody* rigidbody = rigidbodyStore.GetOwner( bodyIdx );
+		if ( rigidbody != nullptr
+			 && rigidbody->GetCollider() != nullptr )
 		{
-			case SIMULATION_MODE_DYNAMIC:
-			case SIMULATION_MODE_KINEMATIC:
+			rigidbody->GetCollider()->UpdateWorldShape();
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static float GetDistanceSquaredToSweep( const Vec3& point, const Vec3& sweepStart, const Vec3& displacement )
+{
+	float fractionAlongSweep = ClampZeroToOne( DotProduct3D( point - sweepStart, displacement ) / DotProduct3D( displacement, displacement ) );
+	return GetDistanceSquared3D( point, sweepStart + displacement * fractionAlongSweep );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Bodies flagged for continuous collision are swept from where the step started to where the
+// integrator put them and pulled back to just inside the first collider in the way, the discrete
+// pass then resolves that contact. Whatever time is left in the step after the impact is dropped
+//-----------------------------------------------------------------------------------------------
+void PhysicsSystemBase::SweepContinuousRigidbodies( PhysicsScene& scene )
+{
+	RigidbodyStore& store = scene.rigidbodyStore;
+	m_stepStats.numSweptBodies = 0;
+	m_stepStats.numTimeOfImpactHits = 0;
+
+	for ( int bodyIdx = 0; bodyIdx < store.GetNumBodies(); ++bodyIdx )
+	{
+		Rigidbody* rigidbody = store.GetOwner( bodyIdx );
+		if ( !store.IsMovable( bodyIdx )
+			 || rigidbody == nullptr
+			 || !rigidbody->IsContinuousCollisionEnabled() )
+		{
+			continue;
+		}
+
+		Collider* collider = rigidbody->GetCollider();
+		if ( collider == nullptr
+			 || !collider->IsEnabled()
+			 || collider->IsTrigger()
+			 || collider->GetSweepRadius() <= 0.f )
+		{
+			continue;
+		}
+
+		// A body that moved less than its radius can't have crossed anything the discrete test would miss
+		float sweepRadius = collider->GetSweepRadius();
+		Vec3 displacement = store.GetPosition( bodyIdx ) - store.GetPreviousPosition( bodyIdx );
+		float sweepLength = displacement.GetLength();
+		if ( sweepLength < sweepRadius )
+		{
+			continue;
+		}
+
+		++m_stepStats.numSweptBodies;
+
+		Vec3 sweepStart = collider->GetWorldPosition() - displacement;
+		float timeOfImpact = 1.f;
+		for ( int otherColliderIdx = 0; otherColliderIdx < (int)scene.colliders.size(); ++otherColliderIdx )
+		{
+			Collider* otherCollider = scene.colliders[otherColliderIdx];
+			if ( otherCollider == nullptr
+				 || !otherCollider->IsEnabled()
+				 || otherCollider->IsTrigger()
+				 || otherCollider->GetRigidbody() == nullptr
+				 || otherCollider->GetRigidbody() == rigidbody
+				 || !DoPhysicsLayersInteract( rigidbody->GetLayer(), otherCollider->GetRigidbody()->GetLayer() ) )
 			{
-				rigidbody->Update( deltaSeconds );
+				continue;
 			}
+
+			// Swept bounds, only colliders near the part of the path not already cut off are tested
+			float maxDistance = sweepRadius + otherCollider->GetBoundingRadius();
+			if ( GetDistanceSquaredToSweep( otherCollider->GetWorldPosition(), sweepStart, displacement * timeOfImpact ) > maxDistance * maxDistance )
+			{
+				continue;
+			}
+
+			float otherTimeOfImpact = 1.f;
+			if ( otherCollider->SweepSphere( sweepStart, displacement * timeOfImpact, sweepRadius, otherTimeOfImpact ) )
+			{
+				timeOfImpact *= otherTimeOfImpact;
+			}
+		}
+
+		if ( timeOfImpact < 1.f )
+		{
+			++m_stepStats.numTimeOfImpactHits;
+
+			Vec3 skinOffset = displacement * ( s_continuousContactSkin / sweepLength );
+			store.SetPosition( bodyIdx, store.GetPreviousPosition( bodyIdx ) + displacement * timeOfImpact + skinOffset );
+			collider->UpdateWorldShape();
 		}
 	}
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Builds islands from the contact graph with union find. Static bodies don't join islands so
+// everything resting on the same floor doesn't become one island
+//-----------------------------------------------------------------------------------------------
+void PhysicsSystemBase::UpdateSleepingIslands( PhysicsScene& scene, float deltaSeconds )
+{
+	RigidbodyStore& store = scene.rigidbodyStore;
+	const PhysicsSleepSettings& sleepSettings = scene.sleepSettings;
+	int numBodies = store.GetNumBodies();
+
+	store.UpdateSecondsAtRest( deltaSeconds, sleepSettings.linearSleepSpeed, sleepSettings.angularSleepSpeed );
+
+	m_islandParents.resize( numBodies );
+	for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+	{
+		m_islandParents[bodyIdx] = bodyIdx;
+	}
+
+	for ( int collisionIdx = 0; collisionIdx < (int)scene.collisions.size(); ++collisionIdx )
+	{
+		const Collision& collision = scene.collisions[collisionIdx];
+		if ( collision.myCollider == nullptr
+			 || collision.theirCollider == nullptr
+			 || collision.myCollider->IsTrigger()
+			 || collision.theirCollider->IsTrigger() )
+		{
+			continue;
+		}
+
+		int bodyIdx = store.GetBodyIndex( collision.myCollider->GetRigidbody()->GetHandle() );
+		int otherBodyIdx = store.GetBodyIndex( collision.theirCollider->GetRigidbody()->GetHandle() );
+		if ( bodyIdx >= 0
+			 && otherBodyIdx >= 0
+			 && store.IsSimulated( bodyIdx )
+			 && store.IsSimulated( otherBodyIdx ) )
+		{
+			MergeIslands( bodyIdx, otherBodyIdx );
+		}
+	}
+
+	// An island's time at rest is the shortest time any of its bodies has been at rest, woken bodies restart at 0
+	m_islandSecondsAtRest.assign( numBodies, FLT_MAX );
+	m_islandHasSleepingBody.assign( numBodies, 0 );
+	for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+	{
+		if ( !store.IsSimulated( bodyIdx ) )
+		{
+			continue;
+		}
+
+		int rootIdx = FindIslandRoot( bodyIdx );
+		if ( store.IsAwake( bodyIdx ) )
+		{
+			m_islandSecondsAtRest[rootIdx] = Min( m_islandSecondsAtRest[rootIdx], store.GetSecondsAtRest( bodyIdx ) );
+		}
+		else
+		{
+			m_islandHasSleepingBody[rootIdx] = 1;
+		}
+	}
+
+	m_stepStats.numAwakeBodies = 0;
+	m_stepStats.numSleepingBodies = 0;
+	m_stepStats.numIslands = 0;
+	m_stepStats.numSleepingIslands = 0;
+
+	for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+	{
+		if ( !store.IsSimulated( bodyIdx ) )
+		{
+			continue;
+		}
+
+		int rootIdx = FindIslandRoot( bodyIdx );
+		float islandSecondsAtRest = m_islandSecondsAtRest[rootIdx];
+		bool isIslandAwake = islandSecondsAtRest != FLT_MAX;		// At least one awake body
+
+		if ( isIslandAwake )
+		{
+			if ( sleepSettings.isSleepEnabled
+				 && islandSecondsAtRest >= sleepSettings.secondsBeforeSleep )
+			{
+				store.PutBodyToSleep( bodyIdx );
+			}
+			else if ( m_islandHasSleepingBody[rootIdx] != 0 )
+			{
+				// Wake on contact with an awake body
+				store.WakeBody( bodyIdx );
+			}
+		}
+
+		if ( store.IsAwake( bodyIdx ) )
+		{
+			++m_stepStats.numAwakeBodies;
+		}
+		else
+		{
+			++m_stepStats.numSleepingBodies;
+		}
+
+		if ( rootIdx == bodyIdx )
+		{
+			++m_stepStats.numIslands;
+			if ( !store.IsAwake( bodyIdx ) )
+			{
+				++m_stepStats.numSleepingIslands;
+			}
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int PhysicsSystemBase::FindIslandRoot( int bodyIdx )
+{
+	while ( m_islandParents[bodyIdx] != bodyIdx )
+	{
+		// Path halving
+		m_islandParents[bodyIdx] = m_islandParents[m_islandParents[bodyIdx]];
+		bodyIdx = m_islandParents[bodyIdx];
+	}
+
+	return bodyIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void PhysicsSystemBase::MergeIslands( int bodyIdx, int otherBodyIdx )
+{
+	int rootIdx = FindIslandRoot( bodyIdx );
+	int otherRootIdx = FindIslandRoot( otherBodyIdx );
+	if ( rootIdx == otherRootIdx )
+	{
+		return;
+	}
+
+	// Lower index is the root so results don't depend on contact order
+	if ( rootIdx < otherRootIdx )
+	{
+		m_islandParents[otherRootIdx] = rootIdx;
+	}
+	else
+	{
+		m_islandParents[rootIdx] = otherRootIdx;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void PhysicsSystemBase::PrintPhysicsStats( EventArgs* args )
+{
+	UNUSED( args );
+
+	g_devConsole->PrintString( Stringf( "Substeps: %i of %.2f ms, dropped %.2f ms, interpolation %.2f", 
+										m_lastFrameStats.numSubsteps, m_lastFrameStats.stepDeltaSeconds * 1000.f, m_lastFrameStats.droppedSeconds * 1000.f, m_lastFrameStats.interpolationFraction ) );
+	g_devConsole->PrintString( Stringf( "Bodies: %i awake, %i sleeping", m_lastStepStats.numAwakeBodies, m_lastStepStats.numSleepingBodies ) );
+	g_devConsole->PrintString( Stringf( "Islands: %i, %i sleeping", m_lastStepStats.numIslands, m_lastStepStats.numSleepingIslands ) );
+	g_devConsole->PrintString( Stringf( "Pairs tested: %i, contacts: %i", m_lastStepStats.numPairsTested, m_lastStepStats.numContacts ) );
+	g_devConsole->PrintString( Stringf( "Narrowphase jobs: %i, contact colors: %i", m_lastStepStats.numNarrowphaseJobs, m_lastStepStats.numContactColors ) );
+	g_devConsole->PrintString( Stringf( "Swept bodies: %i, time of impact hits: %i", m_lastStepStats.numSweptBodies, m_lastStepStats.numTimeOfImpactHits ) );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void PhysicsSystemBase::Shutdown()
 {
-	PTR_SAFE_DELETE( m_stepTimer );
+	g_eventSystem->DeRegisterObject( this );
+
 	PTR_SAFE_DELETE( m_physicsClock );
 }
 
@@ -111,6 +424,28 @@ void PhysicsSystemBase::ResetFixedDeltaSecondsToDefault()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void PhysicsSystemBase::SetStepBudget( int maxSubstepsPerFrame, bool isAdaptiveStepEnabled, float maxAdaptiveStepScale )
+{
+	s_maxSubstepsPerFrame = Max( maxSubstepsPerFrame, 1 );
+	s_isAdaptiveStepEnabled = isAdaptiveStepEnabled;
+	s_maxAdaptiveStepScale = ClampMin( maxAdaptiveStepScale, 1.f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool PhysicsSystemBase::SetPhysicsStepBudget( EventArgs* args )
+{
+	s_maxSubstepsPerFrame = Max( args->GetValue( "maxSubsteps", s_maxSubstepsPerFrame ), 1 );
+	s_isAdaptiveStepEnabled = args->GetValue( "adaptive", s_isAdaptiveStepEnabled );
+	s_maxAdaptiveStepScale = ClampMin( args->GetValue( "maxStepScale", s_maxAdaptiveStepScale ), 1.f );
+
+	g_devConsole->PrintString( Stringf( "Physics step budget: %i substeps, adaptive %s up to %.1fx", 
+										s_maxSubstepsPerFrame, s_isAdaptiveStepEnabled ? "on" : "off", s_maxAdaptiveStepScale ) );
+	return false;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 bool PhysicsSystemBase::SetPhysicsUpdateRate( EventArgs* args )
 {
@@ -127,3 +462,163 @@ bool PhysicsSystemBase::SetPhysicsUpdateRate( EventArgs* args )
 
 	return false;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+// Mirrors the layout rigidbodies had before the pooled store, one heap object per body with its
+// user properties inline and affectors looked up by name for every body
+//-----------------------------------------------------------------------------------------------
+struct BenchmarkHeapRigidbody
+{
+public:
+	NamedProperties userProperties;
+	EntityId parentEntityId = INVALID_ENTITY_ID;
+	Collider* collider = nullptr;
+	Vec3 worldPosition = Vec3::ZERO;
+	Vec3 sumOfForces = Vec3::ZERO;
+	Vec3 velocity = Vec3::ZERO;
+	float inverseMass = 1.f;
+	float drag = 0.f;
+	float orientationRadians = 0.f;
+	float angularVelocity = 0.f;
+	bool isEnabled = true;
+	eSimulationMode simulationMode = SIMULATION_MODE_DYNAMIC;
+
+public:
+	void Update( float deltaSeconds )
+	{
+		if ( !isEnabled )
+		{
+			return;
+		}
+
+		velocity += sumOfForces * deltaSeconds;
+		worldPosition += velocity * deltaSeconds;
+		orientationRadians += angularVelocity * deltaSeconds;
+
+		const float twoPI = fPI * 2.f;
+		while ( orientationRadians > twoPI )
+		{
+			orientationRadians -= twoPI;
+		}
+		while ( orientationRadians < 0.f )
+		{
+			orientationRadians += twoPI;
+		}
+
+		sumOfForces = Vec3::ZERO;
+	}
+};
+
+
+//-----------------------------------------------------------------------------------------------
+typedef void ( *BenchmarkAffectorFn )( BenchmarkHeapRigidbody* rigidbody );
+
+
+//-----------------------------------------------------------------------------------------------
+static void ApplyBenchmarkGravity( BenchmarkHeapRigidbody* rigidbody )
+{
+	rigidbody->sumOfForces += Vec3( 0.f, 0.f, -9.8f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static void ApplyBenchmarkDrag( BenchmarkHeapRigidbody* rigidbody )
+{
+	rigidbody->sumOfForces += -rigidbody->velocity * rigidbody->drag;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool PhysicsSystemBase::BenchmarkRigidbodyIntegration( EventArgs* args )
+{
+	int numBodies = args->GetValue( "bodies", 10000 );
+	int numSteps = args->GetValue( "steps", 120 );
+	if ( numBodies <= 0
+		 || numSteps <= 0 )
+	{
+		g_devConsole->PrintError( "bodies and steps must be positive" );
+		return false;
+	}
+
+	const float deltaSeconds = 1.f / 120.f;
+	RandomNumberGenerator rng;
+
+	// Per object layout, bodies are allocated between other allocations like they are in game
+	std::vector<BenchmarkHeapRigidbody*> heapRigidbodies;
+	std::vector<std::string*> interleavedAllocations;
+	heapRigidbodies.reserve( numBodies );
+	interleavedAllocations.reserve( numBodies );
+	for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+	{
+		BenchmarkHeapRigidbody* rigidbody = new BenchmarkHeapRigidbody();
+		rigidbody->worldPosition = Vec3( rng.RollRandomFloatInRange( -100.f, 100.f ), rng.RollRandomFloatInRange( -100.f, 100.f ), 0.f );
+		rigidbody->drag = rng.RollRandomFloatZeroToOneInclusive();
+		rigidbody->simulationMode = bodyIdx % 4 == 0 ? SIMULATION_MODE_STATIC : SIMULATION_MODE_DYNAMIC;
+		heapRigidbodies.push_back( rigidbody );
+
+		interleavedAllocations.push_back( new std::string( 64, 'x' ) );
+	}
+
+	std::map<std::string, BenchmarkAffectorFn> affectorMap;
+	affectorMap["gravity"] = ApplyBenchmarkGravity;
+	affectorMap["drag"] = ApplyBenchmarkDrag;
+
+	double heapStartTime = GetCurrentTimeSeconds();
+	for ( int stepIdx = 0; stepIdx < numSteps; ++stepIdx )
+	{
+		for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+		{
+			BenchmarkHeapRigidbody* rigidbody = heapRigidbodies[bodyIdx];
+			if ( rigidbody->simulationMode == SIMULATION_MODE_DYNAMIC )
+			{
+				for ( const auto& affector : affectorMap )
+				{
+					affector.second( rigidbody );
+				}
+			}
+		}
+
+		for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+		{
+			BenchmarkHeapRigidbody* rigidbody = heapRigidbodies[bodyIdx];
+			if ( rigidbody->simulationMode == SIMULATION_MODE_DYNAMIC
+				 || rigidbody->simulationMode == SIMULATION_MODE_KINEMATIC )
+			{
+				rigidbody->Update( deltaSeconds );
+			}
+		}
+	}
+	double heapSeconds = GetCurrentTimeSeconds() - heapStartTime;
+
+	PTR_VECTOR_SAFE_DELETE( heapRigidbodies );
+	PTR_VECTOR_SAFE_DELETE( interleavedAllocations );
+
+	// Pooled store, same bodies and affectors
+	rng.Reset( 0 );
+
+	RigidbodyStore store;
+	store.Reserve( numBodies );
+	for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+	{
+		int storeIdx = store.GetBodyIndex( store.AddBody( nullptr ) );
+		store.SetPosition( storeIdx, Vec3( rng.RollRandomFloatInRange( -100.f, 100.f ), rng.RollRandomFloatInRange( -100.f, 100.f ), 0.f ) );
+		store.SetDrag( storeIdx, rng.RollRandomFloatZeroToOneInclusive() );
+		store.SetSimulationMode( storeIdx, bodyIdx % 4 == 0 ? SIMULATION_MODE_STATIC : SIMULATION_MODE_DYNAMIC );
+	}
+
+	double storeStartTime = GetCurrentTimeSeconds();
+	for ( int stepIdx = 0; stepIdx < numSteps; ++stepIdx )
+	{
+		store.ApplyDragForces();
+		store.ApplyUniformForce( Vec3( 0.f, 0.f, -9.8f ) );
+		store.Integrate( deltaSeconds );
+	}
+	double storeSeconds = GetCurrentTimeSeconds() - storeStartTime;
+
+	g_devConsole->PrintString( Stringf( "Per object rigidbodies: %i bodies x %i steps in %.2f ms", numBodies, numSteps, heapSeconds * 1000.0 ) );
+	g_devConsole->PrintString( Stringf( "Pooled rigidbody store: %i bodies x %i steps in %.2f ms (%.1fx)", 
+										numBodies, numSteps, storeSeconds * 1000.0, storeSeconds > 0.0 ? heapSeconds / storeSeconds : 0.0 ) );
+
+	return false;
+}
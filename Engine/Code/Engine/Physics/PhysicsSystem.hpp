@@ -7,7 +7,6 @@
 
 //-----------------------------------------------------------------------------------------------
 class Clock;
-class Timer;
 
 
 //-----------------------------------------------------------------------------------------------
@@ -22,18 +21,46 @@ public:
 	void SetFixedDeltaSeconds( float newDeltaSeconds );
 	void ResetFixedDeltaSecondsToDefault();
 
+	// Caps the catch up steps taken in one frame after a hitch. With adaptive steps the backlog is
+	// covered by fewer, larger steps (up to maxStepScale times the fixed step) before time is dropped
+	void SetStepBudget( int maxSubstepsPerFrame, bool isAdaptiveStepEnabled, float maxAdaptiveStepScale );
+
+	// How far rendering is between the last two steps, blend rigidbody transforms by this
+	float GetInterpolationFraction() const											{ return m_lastFrameStats.interpolationFraction; }
+
+	const PhysicsStepStats& GetLastStepStats() const								{ return m_lastStepStats; }
+	const PhysicsFrameStats& GetLastFrameStats() const								{ return m_lastFrameStats; }
+
 	static bool SetPhysicsUpdateRate( EventArgs* args );
+	static bool SetPhysicsStepBudget( EventArgs* args );
+	static bool BenchmarkRigidbodyIntegration( EventArgs* args );
 
 protected:
 	virtual void AdvanceSimulation( PhysicsScene& scene, float deltaSeconds ) = 0;
-	void ApplyAffectors( RigidbodyVector& rigidbodies, const AffectorMap& affectors );
-	void MoveRigidbodies( RigidbodyVector& rigidbodies, float deltaSeconds );
+	void ApplyAffectors( RigidbodyStore& rigidbodyStore, const AffectorVector& affectors );
+	void MoveRigidbodies( RigidbodyStore& rigidbodyStore, float deltaSeconds );
+	void SweepContinuousRigidbodies( PhysicsScene& scene );
+	void UpdateSleepingIslands( PhysicsScene& scene, float deltaSeconds );
+
+	int FindIslandRoot( int bodyIdx );
+	void MergeIslands( int bodyIdx, int otherBodyIdx );
+
+	void PrintPhysicsStats( EventArgs* args );
 
 protected:
 	Clock* m_gameClock = nullptr;
 	Clock* m_physicsClock = nullptr;
-	Timer* m_stepTimer = nullptr;
+	double m_accumulatedSeconds = 0.0;
 	uint m_frameNum = 0;
+
+	PhysicsStepStats m_stepStats;
+	PhysicsStepStats m_lastStepStats;
+	PhysicsFrameStats m_lastFrameStats;
+
+	// Scratch space for island building, indexed by store body index
+	std::vector<int> m_islandParents;
+	std::vector<float> m_islandSecondsAtRest;
+	std::vector<byte> m_islandHasSleepingBody;
 };
 
 
@@ -44,11 +71,15 @@ class PhysicsSystem : public PhysicsSystemBase
 protected:
 	virtual void AdvanceSimulation( PhysicsScene& scene, float deltaSeconds ) override
 	{
-		ApplyAffectors( scene.rigidbodies, scene.affectors ); 									// apply gravity (or other scene wide effects) to all dynamic objects
-		MoveRigidbodies( scene.rigidbodies, deltaSeconds ); 									// apply an euler step to all rigidbodies, and reset per-frame data
-		CollisionPolicy::ResolveCollisions( scene.colliders, scene.collisions, m_frameNum );	// resolve all collisions, firing appropriate events
+		ApplyAffectors( scene.rigidbodyStore, scene.affectors ); 								// apply gravity (or other scene wide effects) to all dynamic objects
+		MoveRigidbodies( scene.rigidbodyStore, deltaSeconds ); 									// apply an euler step to all rigidbodies, and reset per-frame data
+		SweepContinuousRigidbodies( scene );													// pull fast bodies back to their time of impact so they can't tunnel
+		CollisionPolicy::ResolveCollisions( scene.colliders, scene.collisions, m_frameNum, m_stepStats );	// resolve all collisions, firing appropriate events
+		UpdateSleepingIslands( scene, deltaSeconds );											// put islands that came to rest to sleep, wake islands touched by awake bodies
 		scene.CleanupDestroyedObjects();  														// destroy objects 
 
+		m_lastStepStats = m_stepStats;
+
 		++m_frameNum;
 	}
 };
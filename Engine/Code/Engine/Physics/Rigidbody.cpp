@@ -1,6 +1,7 @@
 #include "Engine/Physics/Rigidbody.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Physics/Collider.hpp"
@@ -15,44 +16,7 @@ Rigidbody::Rigidbody( PhysicsScene* owningScene, const EntityId& parentEntityId
 	: m_physicsScene( owningScene )
 	, m_parentEntityId( parentEntityId )
 {
-}
-
-
-//-----------------------------------------------------------------------------------------------
-void Rigidbody::Update( float deltaSeconds )
-{
-	if ( !m_isEnabled )
-	{
-		return;
-	}
-
-	Vec3 oldPosition = m_worldPosition;
-
-	Vec3 acceleration = m_sumOfForces;
-	m_velocity += acceleration * deltaSeconds;
-	m_worldPosition += m_velocity * deltaSeconds;
-
-	float angularAcceleration = m_frameTorque;
-	m_angularVelocity += angularAcceleration * deltaSeconds;
-	m_orientationRadians += m_angularVelocity * deltaSeconds;
-	
-	const float twoPI = fPI * 2.f;
-	while ( m_orientationRadians > twoPI )
-	{
-		m_orientationRadians -= twoPI;
-	}
-	while ( m_orientationRadians < 0.f )
-	{
-		m_orientationRadians += twoPI;
-	}
-
-	if ( m_collider != nullptr )
-	{
-		m_collider->UpdateWorldShape();
-	}
-
-	m_sumOfForces = Vec3::ZERO;
-	m_frameTorque = 0.f;
+	m_handle = m_physicsScene->rigidbodyStore.AddBody( this );
 }
 
 
@@ -85,6 +49,18 @@ void Rigidbody::TakeCollider( Collider* collider )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+NamedProperties& Rigidbody::GetUserProperties()
+{
+	if ( m_userProperties == nullptr )
+	{
+		m_userProperties = new NamedProperties();
+	}
+
+	return *m_userProperties;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::SetLayer( const std::string& layerStr )
 {
@@ -98,10 +74,23 @@ void Rigidbody::SetLayer( const std::string& layerStr )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+Vec3 Rigidbody::GetVelocity() const
+{
+	return GetStore().GetVelocity( GetBodyIndex() );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::SetVelocity( const Vec3& velocity )
 {
-	m_velocity = velocity;
+	int bodyIdx = GetBodyIndex();
+	if ( velocity != GetStore().GetVelocity( bodyIdx ) )
+	{
+		GetStore().WakeBody( bodyIdx );
+	}
+
+	GetStore().SetVelocity( bodyIdx, velocity );
 }
 
 
@@ -115,6 +104,13 @@ void Rigidbody::SetVelocity( const Vec3& velocity )
 //}
 
 
+//-----------------------------------------------------------------------------------------------
+Vec3 Rigidbody::GetWorldPosition() const
+{
+	return GetStore().GetPosition( GetBodyIndex() );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Vec3 Rigidbody::GetCenterOfMass() const
 {
@@ -123,14 +119,22 @@ Vec3 Rigidbody::GetCenterOfMass() const
 		return m_collider->m_worldPosition;
 	}
 
-	return m_worldPosition;
+	return GetWorldPosition();
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::SetPosition( const Vec3& position )
 {
-	m_worldPosition = position;
+	// Entities copy their transform in every frame, only an actual move wakes the body and it
+	// teleports rather than being blended from the old position
+	int bodyIdx = GetBodyIndex();
+	if ( position != GetStore().GetPosition( bodyIdx ) )
+	{
+		GetStore().WakeBody( bodyIdx );
+		GetStore().SetPosition( bodyIdx, position );
+		GetStore().SnapPreviousTransform( bodyIdx );
+	}
 
 	if ( m_collider != nullptr )
 	{
@@ -142,7 +146,13 @@ void Rigidbody::SetPosition( const Vec3& position )
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::Translate( const Vec3& translation )
 {
-	m_worldPosition += translation;
+	int bodyIdx = GetBodyIndex();
+	if ( translation != Vec3::ZERO )
+	{
+		GetStore().WakeBody( bodyIdx );
+	}
+
+	GetStore().SetPosition( bodyIdx, GetStore().GetPosition( bodyIdx ) + translation );
 
 	if ( m_collider != nullptr )
 	{
@@ -154,31 +164,44 @@ void Rigidbody::Translate( const Vec3& translation )
 //-----------------------------------------------------------------------------------------------
 Vec3 Rigidbody::GetImpactVelocityAtPoint( const Vec3& point )
 {
-	Vec3 contactPoint = point - m_worldPosition;
+	Vec3 contactPoint = point - GetWorldPosition();
 	Vec3 tangent = Vec3( contactPoint.XY().GetRotated90Degrees(), 0.f );
 
-	return GetVelocity() + m_angularVelocity * tangent;
+	return GetVelocity() + GetAngularVelocity() * tangent;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::RotateDegrees( float deltaDegrees )
 {
-	m_orientationRadians += ConvertDegreesToRadians( deltaDegrees );
+	int bodyIdx = GetBodyIndex();
+	GetStore().SetOrientationRadians( bodyIdx, GetStore().GetOrientationRadians( bodyIdx ) + ConvertDegreesToRadians( deltaDegrees ) );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::ChangeAngularVelocity( float deltaRadians )
 {
-	m_angularVelocity += deltaRadians;
+	int bodyIdx = GetBodyIndex();
+	if ( deltaRadians != 0.f )
+	{
+		GetStore().WakeBody( bodyIdx );
+	}
+
+	GetStore().SetAngularVelocity( bodyIdx, GetStore().GetAngularVelocity( bodyIdx ) + deltaRadians );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::SetAngularVelocity( float newAngularVelocity )
 {
-	m_angularVelocity = newAngularVelocity;
+	int bodyIdx = GetBodyIndex();
+	if ( newAngularVelocity != GetStore().GetAngularVelocity( bodyIdx ) )
+	{
+		GetStore().WakeBody( bodyIdx );
+	}
+
+	GetStore().SetAngularVelocity( bodyIdx, newAngularVelocity );
 }
 
 
@@ -192,7 +215,7 @@ void Rigidbody::SetMass( float mass )
 	}
 
 	m_mass = mass;
-	m_inverseMass = 1.f / m_mass;
+	GetStore().SetInverseMass( GetBodyIndex(), 1.f / m_mass );
 }
 
 
@@ -204,7 +227,7 @@ void Rigidbody::ChangeMass( float deltaMass )
 	m_mass += deltaMass;
 	m_mass = ClampMin( m_mass, .001f );
 
-	m_inverseMass = 1.f / m_mass;
+	GetStore().SetInverseMass( GetBodyIndex(), 1.f / m_mass );
 
 	float massRatio = m_mass / oldMass;
 	m_moment *= massRatio;
@@ -216,10 +239,31 @@ void Rigidbody::ChangeMass( float deltaMass )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+float Rigidbody::GetInverseMass() const
+{
+	return GetStore().GetInverseMass( GetBodyIndex() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float Rigidbody::GetDrag() const
+{
+	return GetStore().GetDrag( GetBodyIndex() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Rigidbody::SetDrag( float drag )
+{
+	GetStore().SetDrag( GetBodyIndex(), drag );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::ChangeDrag( float deltaDrag )
 {
-	m_drag += deltaDrag;
+	SetDrag( GetDrag() + deltaDrag );
 
 	//m_drag = ClampZeroToOne( m_drag );
 }
@@ -228,48 +272,67 @@ void Rigidbody::ChangeDrag( float deltaDrag )
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::AddForce( const Vec3& force )
 {
-	if ( !m_isEnabled )
+	int bodyIdx = GetBodyIndex();
+	if ( !GetStore().IsEnabled( bodyIdx ) )
 	{
 		return;
 	}
 
-	m_sumOfForces += force;
+	if ( force != Vec3::ZERO )
+	{
+		GetStore().WakeBody( bodyIdx );
+	}
+
+	GetStore().AddForce( bodyIdx, force );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::AddImpulse( const Vec3& impulse )
 {
-	if ( !m_isEnabled )
+	int bodyIdx = GetBodyIndex();
+	if ( !GetStore().IsEnabled( bodyIdx ) )
 	{
 		return;
 	}
 
-	m_velocity += impulse;
+	if ( impulse != Vec3::ZERO )
+	{
+		GetStore().WakeBody( bodyIdx );
+	}
+
+	GetStore().SetVelocity( bodyIdx, GetStore().GetVelocity( bodyIdx ) + impulse );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::ApplyImpulseAt( const Vec3& impulse, const Vec3& point )
 {
-	if ( !m_isEnabled )
+	RigidbodyStore& store = GetStore();
+	int bodyIdx = GetBodyIndex();
+	if ( !store.IsEnabled( bodyIdx ) )
 	{
 		return;
 	}
 
-	m_velocity += ( impulse * m_inverseMass );
+	if ( impulse != Vec3::ZERO )
+	{
+		store.WakeBody( bodyIdx );
+	}
 
-	Vec3 contactPoint = point - m_worldPosition;
+	store.SetVelocity( bodyIdx, store.GetVelocity( bodyIdx ) + ( impulse * store.GetInverseMass( bodyIdx ) ) );
+
+	Vec3 contactPoint = point - store.GetPosition( bodyIdx );
 	contactPoint = Vec3( contactPoint.XY().GetRotated90Degrees(), 0.f );
 
-	m_angularVelocity += DotProduct3D( impulse, contactPoint ) * m_inverseMoment;
+	store.SetAngularVelocity( bodyIdx, store.GetAngularVelocity( bodyIdx ) + DotProduct3D( impulse, contactPoint ) * m_inverseMoment );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::ApplyDragForce()
 {
-	Vec3 dragForce = -GetVelocity() * m_drag;
+	Vec3 dragForce = -GetVelocity() * GetDrag();
 	AddForce( dragForce );
 }
 
@@ -286,6 +349,13 @@ void Rigidbody::DebugRender( const Rgba8& borderColor, const Rgba8& fillColor )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+bool Rigidbody::IsEnabled() const
+{
+	return GetStore().IsEnabled( GetBodyIndex() );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::Enable()
 {
@@ -306,22 +376,101 @@ void Rigidbody::Disable()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+bool Rigidbody::IsAwake() const
+{
+	return GetStore().IsAwake( GetBodyIndex() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool Rigidbody::IsAtRest() const
+{
+	return !GetStore().IsMovable( GetBodyIndex() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Rigidbody::WakeUp()
+{
+	GetStore().WakeBody( GetBodyIndex() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Rigidbody::PutToSleep()
+{
+	GetStore().PutBodyToSleep( GetBodyIndex() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+eSimulationMode Rigidbody::GetSimulationMode() const
+{
+	return GetStore().GetSimulationMode( GetBodyIndex() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Rigidbody::SetSimulationMode( eSimulationMode mode )
+{
+	int bodyIdx = GetBodyIndex();
+	GetStore().SetSimulationMode( bodyIdx, mode );
+	GetStore().WakeBody( bodyIdx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float Rigidbody::GetAngularVelocity() const
+{
+	return GetStore().GetAngularVelocity( GetBodyIndex() );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 float Rigidbody::GetOrientationDegrees() const
 {
-	return ConvertRadiansToDegrees( m_orientationRadians );
+	return ConvertRadiansToDegrees( GetOrientationRadians() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float Rigidbody::GetOrientationRadians() const
+{
+	return GetStore().GetOrientationRadians( GetBodyIndex() );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Rigidbody::SetRotationDegrees( float newRotationDegrees )
 {
-	m_orientationRadians = ConvertDegreesToRadians( newRotationDegrees );
+	int bodyIdx = GetBodyIndex();
+	GetStore().SetOrientationRadians( bodyIdx, ConvertDegreesToRadians( newRotationDegrees ) );
+	GetStore().SnapPreviousTransform( bodyIdx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int Rigidbody::GetBodyIndex() const
+{
+	int bodyIdx = m_physicsScene->rigidbodyStore.GetBodyIndex( m_handle );
+	ASSERT_OR_DIE( bodyIdx >= 0, "Rigidbody's store handle is stale" );
+
+	return bodyIdx;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+RigidbodyStore& Rigidbody::GetStore() const
+{
+	return m_physicsScene->rigidbodyStore;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 Rigidbody::~Rigidbody()
 {
-	//Destroy();
+	m_physicsScene->rigidbodyStore.RemoveBody( m_handle );
+
+	PTR_SAFE_DELETE( m_userProperties );
 }
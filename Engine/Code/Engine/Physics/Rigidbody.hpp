@@ -1,25 +1,20 @@
 #pragma once
-#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include "Engine/Physics/RigidbodyStore.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
 struct Rgba8;
 struct PhysicsScene;
 class Collider;
+class NamedProperties;
 class RenderContext;
 
 
 //-----------------------------------------------------------------------------------------------
-enum eSimulationMode : unsigned int
-{
-	SIMULATION_MODE_NONE,
-	SIMULATION_MODE_STATIC,
-	SIMULATION_MODE_KINEMATIC,
-	SIMULATION_MODE_DYNAMIC
-};
-
-
+// Gameplay facing view of a body, the per step simulation data lives in the owning scene's
+// RigidbodyStore and only rarely touched data is kept on the object itself
 //-----------------------------------------------------------------------------------------------
 class Rigidbody
 {
@@ -28,23 +23,24 @@ class Rigidbody
 public:
 	Rigidbody( PhysicsScene* owningScene, const EntityId& parentEntityId );
 
-	void Update( float deltaSeconds );
-
 	void Destroy(); // helper for destroying myself (uses owner to destroy self)
 
 	Collider* GetCollider()															{ return m_collider; }
 	void TakeCollider( Collider* collider ); // takes ownership of a collider (destroying my current one if present)
 
 	EntityId GetParentEntityId() const												{ return m_parentEntityId; }
+	RigidbodyHandle GetHandle() const												{ return m_handle; }
+
+	NamedProperties& GetUserProperties();		// Allocated on first use
 
 	uint GetLayer() const															{ return m_layer; }
 	void SetLayer( uint layer )														{ m_layer = layer; }
 	void SetLayer( const std::string& collisionLayerStr );
 
-	Vec3 GetVelocity()																{ return m_velocity; }
+	Vec3 GetVelocity() const;
 	void SetVelocity( const Vec3& velocity );
 	
-	Vec3 GetWorldPosition()															{ return m_worldPosition; }
+	Vec3 GetWorldPosition() const;
 	Vec3 GetCenterOfMass() const;
 	void SetPosition( const Vec3& position );
 	void Translate( const Vec3& translation );
@@ -60,10 +56,10 @@ public:
 	float GetMass() const															{ return m_mass; }
 	void SetMass( float mass );
 	void ChangeMass( float deltaMass );
-	float GetInverseMass() const													{ return m_inverseMass; }
+	float GetInverseMass() const;
 
-	float GetDrag() const															{ return m_drag; }
-	void SetDrag( float drag )														{ m_drag = drag; }
+	float GetDrag() const;
+	void SetDrag( float drag );
 	void ChangeDrag( float deltaDrag );
 
 	void AddForce( const Vec3& force );
@@ -73,46 +69,49 @@ public:
 
 	void DebugRender( const Rgba8& borderColor, const Rgba8& fillColor ) const;
 
-	bool IsEnabled() const															{ return m_isEnabled; }
+	bool IsEnabled() const;
 	void Enable();
 	void Disable();
 
-	eSimulationMode GetSimulationMode()	const										{ return m_simulationMode; }
-	void SetSimulationMode( eSimulationMode mode )									{ m_simulationMode = mode; }
+	// Bodies fall asleep when their island comes to rest and wake on contact, impulses, forces
+	// or being moved by gameplay code
+	bool IsAwake() const;
+	bool IsAtRest() const;		// Can't move this step: static, disabled or asleep
+	void WakeUp();
+	void PutToSleep();
 
-	float GetAngularVelocity() const												{ return m_angularVelocity; }
+	eSimulationMode GetSimulationMode()	const;
+	void SetSimulationMode( eSimulationMode mode );
+
+	// Sweeps the collider along each step's motion so fast bodies can't tunnel through thin
+	// colliders, only sphere and disc colliders can be swept
+	bool IsContinuousCollisionEnabled() const										{ return m_isContinuousCollisionEnabled; }
+	void SetContinuousCollisionEnabled( bool isEnabled )							{ m_isContinuousCollisionEnabled = isEnabled; }
+
+	float GetAngularVelocity() const;
 	float GetOrientationDegrees() const;
-	float GetOrientationRadians() const												{ return m_orientationRadians; }
+	float GetOrientationRadians() const;
 	float GetMomentOfInertia() const												{ return m_moment; }
 
-public:
-	NamedProperties m_userProperties;
+private:
+	int GetBodyIndex() const;
+	RigidbodyStore& GetStore() const;
 
 private:
 	EntityId m_parentEntityId = INVALID_ENTITY_ID;
 
 	PhysicsScene* m_physicsScene = nullptr;						// which scene created/owns this object
-	Vec3 m_worldPosition = Vec3::ZERO;							// where in the world is this rigidbody
+	RigidbodyHandle m_handle;									// position, velocity, forces, etc. in the scene's store
 	Collider* m_collider = nullptr;
 
-	Vec3 m_sumOfForces = Vec3::ZERO;
-	Vec3 m_velocity = Vec3::ZERO;
-	//Vec2 m_verletVelocity = Vec2::ZERO;
+	NamedProperties* m_userProperties = nullptr;
 
 	float m_mass = 1.f;
-	float m_inverseMass = 1.f;
-	float m_drag = 0.f;
-
-	float m_orientationRadians = 0.f;
-	float m_angularVelocity = 0.f;
-	float m_frameTorque = 0.f;
 	float m_moment = 0.f;
 	float m_inverseMoment = 1.f;
 
-	bool m_isEnabled = true;
-	eSimulationMode m_simulationMode = SIMULATION_MODE_DYNAMIC;
-
 	uint m_layer = 0;
+	bool m_isContinuousCollisionEnabled = false;
 
 private:
 	~Rigidbody(); // destroys the collider
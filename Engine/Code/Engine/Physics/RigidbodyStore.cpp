@@ -0,0 +1,537 @@
+#include "Engine/Physics/RigidbodyStore.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <xmmintrin.h>
+
+
+//-----------------------------------------------------------------------------------------------
+const RigidbodyHandle RigidbodyHandle::INVALID = RigidbodyHandle();
+
+
+//-----------------------------------------------------------------------------------------------
+// out += scaledBy * mask * factor for every body, 4 bodies at a time
+//-----------------------------------------------------------------------------------------------
+static void MultiplyAddMasked( float* out, const float* scaledBy, const float* mask, float factor, int count )
+{
+	__m128 factor4 = _mm_set1_ps( factor );
+
+	int bodyIdx = 0;
+	for ( ; bodyIdx + 4 <= count; bodyIdx += 4 )
+	{
+		__m128 out4 = _mm_loadu_ps( out + bodyIdx );
+		__m128 scaled4 = _mm_mul_ps( _mm_loadu_ps( scaledBy + bodyIdx ), _mm_loadu_ps( mask + bodyIdx ) );
+		_mm_storeu_ps( out + bodyIdx, _mm_add_ps( out4, _mm_mul_ps( scaled4, factor4 ) ) );
+	}
+
+	for ( ; bodyIdx < count; ++bodyIdx )
+	{
+		out[bodyIdx] += scaledBy[bodyIdx] * mask[bodyIdx] * factor;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// out += mask * value for every body, 4 bodies at a time
+//-----------------------------------------------------------------------------------------------
+static void AddMasked( float* out, const float* mask, float value, int count )
+{
+	if ( value == 0.f )
+	{
+		return;
+	}
+
+	__m128 value4 = _mm_set1_ps( value );
+
+	int bodyIdx = 0;
+	for ( ; bodyIdx + 4 <= count; bodyIdx += 4 )
+	{
+		__m128 out4 = _mm_loadu_ps( out + bodyIdx );
+		_mm_storeu_ps( out + bodyIdx, _mm_add_ps( out4, _mm_mul_ps( _mm_loadu_ps( mask + bodyIdx ), value4 ) ) );
+	}
+
+	for ( ; bodyIdx < count; ++bodyIdx )
+	{
+		out[bodyIdx] += mask[bodyIdx] * value;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// out -= velocity * drag * mask for every body, 4 bodies at a time
+//-----------------------------------------------------------------------------------------------
+static void SubtractDragMasked( float* out, const float* velocities, const float* drags, const float* mask, int count )
+{
+	int bodyIdx = 0;
+	for ( ; bodyIdx + 4 <= count; bodyIdx += 4 )
+	{
+		__m128 drag4 = _mm_mul_ps( _mm_loadu_ps( drags + bodyIdx ), _mm_loadu_ps( mask + bodyIdx ) );
+		__m128 dragForce4 = _mm_mul_ps( _mm_loadu_ps( velocities + bodyIdx ), drag4 );
+		_mm_storeu_ps( out + bodyIdx, _mm_sub_ps( _mm_loadu_ps( out + bodyIdx ), dragForce4 ) );
+	}
+
+	for ( ; bodyIdx < count; ++bodyIdx )
+	{
+		out[bodyIdx] -= velocities[bodyIdx] * drags[bodyIdx] * mask[bodyIdx];
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+RigidbodyHandle RigidbodyStore::AddBody( Rigidbody* owner )
+{
+	RigidbodyHandle handle;
+	if ( !m_freeSlots.empty() )
+	{
+		handle.slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		handle.slot = (uint32_t)m_slotBodyIndexes.size();
+		m_slotBodyIndexes.push_back( -1 );
+		m_slotGenerations.push_back( 0 );
+	}
+
+	handle.generation = m_slotGenerations[handle.slot];
+
+	int bodyIdx = GetNumBodies();
+	m_slotBodyIndexes[handle.slot] = bodyIdx;
+
+	m_owners.push_back( owner );
+	m_bodySlots.push_back( handle.slot );
+
+	m_positionsX.push_back( 0.f );
+	m_positionsY.push_back( 0.f );
+	m_positionsZ.push_back( 0.f );
+	m_velocitiesX.push_back( 0.f );
+	m_velocitiesY.push_back( 0.f );
+	m_velocitiesZ.push_back( 0.f );
+	m_forcesX.push_back( 0.f );
+	m_forcesY.push_back( 0.f );
+	m_forcesZ.push_back( 0.f );
+
+	m_inverseMasses.push_back( 1.f );
+	m_drags.push_back( 0.f );
+
+	m_orientationsRadians.push_back( 0.f );
+	m_angularVelocities.push_back( 0.f );
+
+	m_previousPositionsX.push_back( 0.f );
+	m_previousPositionsY.push_back( 0.f );
+	m_previousPositionsZ.push_back( 0.f );
+	m_previousOrientationsRadians.push_back( 0.f );
+
+	m_simulationModes.push_back( SIMULATION_MODE_DYNAMIC );
+	m_isEnabled.push_back( 1 );
+	m_isAwake.push_back( 1 );
+	m_secondsAtRest.push_back( 0.f );
+	m_moveScales.push_back( 0.f );
+	m_affectorScales.push_back( 0.f );
+
+	UpdateScales( bodyIdx );
+
+	return handle;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::RemoveBody( const RigidbodyHandle& handle )
+{
+	int bodyIdx = GetBodyIndex( handle );
+	if ( bodyIdx < 0 )
+	{
+		return;
+	}
+
+	int lastBodyIdx = GetNumBodies() - 1;
+	if ( bodyIdx != lastBodyIdx )
+	{
+		MoveBody( lastBodyIdx, bodyIdx );
+	}
+
+	PopBackBody();
+
+	m_slotBodyIndexes[handle.slot] = -1;
+	++m_slotGenerations[handle.slot];
+	m_freeSlots.push_back( handle.slot );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::Clear()
+{
+	while ( GetNumBodies() > 0 )
+	{
+		RigidbodyHandle handle;
+		handle.slot = m_bodySlots.back();
+		handle.generation = m_slotGenerations[handle.slot];
+
+		RemoveBody( handle );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::Reserve( int numBodies )
+{
+	m_slotBodyIndexes.reserve( numBodies );
+	m_slotGenerations.reserve( numBodies );
+	m_owners.reserve( numBodies );
+	m_bodySlots.reserve( numBodies );
+
+	m_positionsX.reserve( numBodies );
+	m_positionsY.reserve( numBodies );
+	m_positionsZ.reserve( numBodies );
+	m_velocitiesX.reserve( numBodies );
+	m_velocitiesY.reserve( numBodies );
+	m_velocitiesZ.reserve( numBodies );
+	m_forcesX.reserve( numBodies );
+	m_forcesY.reserve( numBodies );
+	m_forcesZ.reserve( numBodies );
+
+	m_inverseMasses.reserve( numBodies );
+	m_drags.reserve( numBodies );
+
+	m_orientationsRadians.reserve( numBodies );
+	m_angularVelocities.reserve( numBodies );
+
+	m_previousPositionsX.reserve( numBodies );
+	m_previousPositionsY.reserve( numBodies );
+	m_previousPositionsZ.reserve( numBodies );
+	m_previousOrientationsRadians.reserve( numBodies );
+
+	m_simulationModes.reserve( numBodies );
+	m_isEnabled.reserve( numBodies );
+	m_isAwake.reserve( numBodies );
+	m_secondsAtRest.reserve( numBodies );
+	m_moveScales.reserve( numBodies );
+	m_affectorScales.reserve( numBodies );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool RigidbodyStore::IsValid( const RigidbodyHandle& handle ) const
+{
+	return GetBodyIndex( handle ) >= 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int RigidbodyStore::GetBodyIndex( const RigidbodyHandle& handle ) const
+{
+	if ( handle.slot >= (uint32_t)m_slotBodyIndexes.size()
+		 || m_slotGenerations[handle.slot] != handle.generation )
+	{
+		return -1;
+	}
+
+	return m_slotBodyIndexes[handle.slot];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::SetPosition( int bodyIdx, const Vec3& position )
+{
+	m_positionsX[bodyIdx] = position.x;
+	m_positionsY[bodyIdx] = position.y;
+	m_positionsZ[bodyIdx] = position.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec3 RigidbodyStore::GetInterpolatedPosition( int bodyIdx, float fractionOfStep ) const
+{
+	return Vec3( Interpolate( m_previousPositionsX[bodyIdx], m_positionsX[bodyIdx], fractionOfStep ),
+				 Interpolate( m_previousPositionsY[bodyIdx], m_positionsY[bodyIdx], fractionOfStep ),
+				 Interpolate( m_previousPositionsZ[bodyIdx], m_positionsZ[bodyIdx], fractionOfStep ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+float RigidbodyStore::GetInterpolatedOrientationRadians( int bodyIdx, float fractionOfStep ) const
+{
+	// Orientations wrap at 2pi, blend across the shortest way around
+	float previousDegrees = ConvertRadiansToDegrees( m_previousOrientationsRadians[bodyIdx] );
+	float displacementDegrees = GetShortestAngularDisplacementDegrees( previousDegrees, ConvertRadiansToDegrees( m_orientationsRadians[bodyIdx] ) );
+
+	return ConvertDegreesToRadians( previousDegrees + displacementDegrees * fractionOfStep );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::SetVelocity( int bodyIdx, const Vec3& velocity )
+{
+	m_velocitiesX[bodyIdx] = velocity.x;
+	m_velocitiesY[bodyIdx] = velocity.y;
+	m_velocitiesZ[bodyIdx] = velocity.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::AddForce( int bodyIdx, const Vec3& force )
+{
+	m_forcesX[bodyIdx] += force.x;
+	m_forcesY[bodyIdx] += force.y;
+	m_forcesZ[bodyIdx] += force.z;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::SetSimulationMode( int bodyIdx, eSimulationMode mode )
+{
+	m_simulationModes[bodyIdx] = mode;
+	UpdateScales( bodyIdx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::SetEnabled( int bodyIdx, bool isEnabled )
+{
+	m_isEnabled[bodyIdx] = isEnabled ? 1 : 0;
+	UpdateScales( bodyIdx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool RigidbodyStore::IsSimulated( int bodyIdx ) const
+{
+	eSimulationMode mode = m_simulationModes[bodyIdx];
+	return m_isEnabled[bodyIdx] != 0
+		&& ( mode == SIMULATION_MODE_DYNAMIC || mode == SIMULATION_MODE_KINEMATIC );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::WakeBody( int bodyIdx )
+{
+	if ( m_isAwake[bodyIdx] != 0 )
+	{
+		return;
+	}
+
+	m_isAwake[bodyIdx] = 1;
+	m_secondsAtRest[bodyIdx] = 0.f;
+	UpdateScales( bodyIdx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::PutBodyToSleep( int bodyIdx )
+{
+	m_isAwake[bodyIdx] = 0;
+
+	SetVelocity( bodyIdx, Vec3::ZERO );
+	m_angularVelocities[bodyIdx] = 0.f;
+	m_forcesX[bodyIdx] = 0.f;
+	m_forcesY[bodyIdx] = 0.f;
+	m_forcesZ[bodyIdx] = 0.f;
+
+	UpdateScales( bodyIdx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::SavePreviousTransforms()
+{
+	m_previousPositionsX = m_positionsX;
+	m_previousPositionsY = m_positionsY;
+	m_previousPositionsZ = m_positionsZ;
+	m_previousOrientationsRadians = m_orientationsRadians;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::SnapPreviousTransform( int bodyIdx )
+{
+	m_previousPositionsX[bodyIdx] = m_positionsX[bodyIdx];
+	m_previousPositionsY[bodyIdx] = m_positionsY[bodyIdx];
+	m_previousPositionsZ[bodyIdx] = m_positionsZ[bodyIdx];
+	m_previousOrientationsRadians[bodyIdx] = m_orientationsRadians[bodyIdx];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::ApplyUniformForce( const Vec3& force )
+{
+	int numBodies = GetNumBodies();
+	if ( numBodies == 0 )
+	{
+		return;
+	}
+
+	const float* mask = &m_affectorScales[0];
+	AddMasked( &m_forcesX[0], mask, force.x, numBodies );
+	AddMasked( &m_forcesY[0], mask, force.y, numBodies );
+	AddMasked( &m_forcesZ[0], mask, force.z, numBodies );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::ApplyDragForces()
+{
+	int numBodies = GetNumBodies();
+	if ( numBodies == 0 )
+	{
+		return;
+	}
+
+	const float* mask = &m_affectorScales[0];
+	const float* drags = &m_drags[0];
+	SubtractDragMasked( &m_forcesX[0], &m_velocitiesX[0], drags, mask, numBodies );
+	SubtractDragMasked( &m_forcesY[0], &m_velocitiesY[0], drags, mask, numBodies );
+	SubtractDragMasked( &m_forcesZ[0], &m_velocitiesZ[0], drags, mask, numBodies );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::Integrate( float deltaSeconds )
+{
+	int numBodies = GetNumBodies();
+	if ( numBodies == 0 )
+	{
+		return;
+	}
+
+	const float* mask = &m_moveScales[0];
+
+	// Semi-implicit euler, forces are treated as accelerations the same as Rigidbody always has
+	MultiplyAddMasked( &m_velocitiesX[0], &m_forcesX[0], mask, deltaSeconds, numBodies );
+	MultiplyAddMasked( &m_velocitiesY[0], &m_forcesY[0], mask, deltaSeconds, numBodies );
+	MultiplyAddMasked( &m_velocitiesZ[0], &m_forcesZ[0], mask, deltaSeconds, numBodies );
+
+	MultiplyAddMasked( &m_positionsX[0], &m_velocitiesX[0], mask, deltaSeconds, numBodies );
+	MultiplyAddMasked( &m_positionsY[0], &m_velocitiesY[0], mask, deltaSeconds, numBodies );
+	MultiplyAddMasked( &m_positionsZ[0], &m_velocitiesZ[0], mask, deltaSeconds, numBodies );
+
+	MultiplyAddMasked( &m_orientationsRadians[0], &m_angularVelocities[0], mask, deltaSeconds, numBodies );
+
+	const float twoPI = fPI * 2.f;
+	for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+	{
+		float& orientationRadians = m_orientationsRadians[bodyIdx];
+		if ( orientationRadians > twoPI
+			 || orientationRadians < 0.f )
+		{
+			orientationRadians -= twoPI * floorf( orientationRadians / twoPI );
+		}
+	}
+
+	std::fill( m_forcesX.begin(), m_forcesX.end(), 0.f );
+	std::fill( m_forcesY.begin(), m_forcesY.end(), 0.f );
+	std::fill( m_forcesZ.begin(), m_forcesZ.end(), 0.f );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::UpdateSecondsAtRest( float deltaSeconds, float linearSleepSpeed, float angularSleepSpeed )
+{
+	float linearSleepSpeedSquared = linearSleepSpeed * linearSleepSpeed;
+
+	int numBodies = GetNumBodies();
+	for ( int bodyIdx = 0; bodyIdx < numBodies; ++bodyIdx )
+	{
+		if ( m_moveScales[bodyIdx] == 0.f )
+		{
+			continue;
+		}
+
+		float speedSquared = m_velocitiesX[bodyIdx] * m_velocitiesX[bodyIdx]
+							+ m_velocitiesY[bodyIdx] * m_velocitiesY[bodyIdx]
+							+ m_velocitiesZ[bodyIdx] * m_velocitiesZ[bodyIdx];
+
+		if ( speedSquared <= linearSleepSpeedSquared
+			 && fabsf( m_angularVelocities[bodyIdx] ) <= angularSleepSpeed )
+		{
+			m_secondsAtRest[bodyIdx] += deltaSeconds;
+		}
+		else
+		{
+			m_secondsAtRest[bodyIdx] = 0.f;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::UpdateScales( int bodyIdx )
+{
+	bool isActive = m_isEnabled[bodyIdx] != 0 && m_isAwake[bodyIdx] != 0;
+	eSimulationMode mode = m_simulationModes[bodyIdx];
+
+	m_moveScales[bodyIdx] = ( isActive && ( mode == SIMULATION_MODE_DYNAMIC || mode == SIMULATION_MODE_KINEMATIC ) ) ? 1.f : 0.f;
+	m_affectorScales[bodyIdx] = ( isActive && mode == SIMULATION_MODE_DYNAMIC ) ? 1.f : 0.f;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::MoveBody( int fromIdx, int toIdx )
+{
+	m_owners[toIdx] = m_owners[fromIdx];
+	m_bodySlots[toIdx] = m_bodySlots[fromIdx];
+	m_slotBodyIndexes[m_bodySlots[toIdx]] = toIdx;
+
+	m_positionsX[toIdx] = m_positionsX[fromIdx];
+	m_positionsY[toIdx] = m_positionsY[fromIdx];
+	m_positionsZ[toIdx] = m_positionsZ[fromIdx];
+	m_velocitiesX[toIdx] = m_velocitiesX[fromIdx];
+	m_velocitiesY[toIdx] = m_velocitiesY[fromIdx];
+	m_velocitiesZ[toIdx] = m_velocitiesZ[fromIdx];
+	m_forcesX[toIdx] = m_forcesX[fromIdx];
+	m_forcesY[toIdx] = m_forcesY[fromIdx];
+	m_forcesZ[toIdx] = m_forcesZ[fromIdx];
+
+	m_inverseMasses[toIdx] = m_inverseMasses[fromIdx];
+	m_drags[toIdx] = m_drags[fromIdx];
+
+	m_orientationsRadians[toIdx] = m_orientationsRadians[fromIdx];
+	m_angularVelocities[toIdx] = m_angularVelocities[fromIdx];
+
+	m_previousPositionsX[toIdx] = m_previousPositionsX[fromIdx];
+	m_previousPositionsY[toIdx] = m_previousPositionsY[fromIdx];
+	m_previousPositionsZ[toIdx] = m_previousPositionsZ[fromIdx];
+	m_previousOrientationsRadians[toIdx] = m_previousOrientationsRadians[fromIdx];
+
+	m_simulationModes[toIdx] = m_simulationModes[fromIdx];
+	m_isEnabled[toIdx] = m_isEnabled[fromIdx];
+	m_isAwake[toIdx] = m_isAwake[fromIdx];
+	m_secondsAtRest[toIdx] = m_secondsAtRest[fromIdx];
+	m_moveScales[toIdx] = m_moveScales[fromIdx];
+	m_affectorScales[toIdx] = m_affectorScales[fromIdx];
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void RigidbodyStore::PopBackBody()
+{
+	m_owners.pop_back();
+	m_bodySlots.pop_back();
+
+	m_positionsX.pop_back();
+	m_positionsY.pop_back();
+	m_positionsZ.pop_back();
+	m_velocitiesX.pop_back();
+	m_velocitiesY.pop_back();
+	m_velocitiesZ.pop_back();
+	m_forcesX.pop_back();
+	m_forcesY.pop_back();
+	m_forcesZ.pop_back();
+
+	m_inverseMasses.pop_back();
+	m_drags.pop_back();
+
+	m_orientationsRadians.pop_back();
+	m_angularVelocities.pop_back();
+
+	m_previousPositionsX.pop_back();
+	m_previousPositionsY.pop_back();
+	m_previousPositionsZ.pop_back();
+	m_previousOrientationsRadians.pop_back();
+
+	m_simulationModes.pop_back();
+	m_isEnabled.pop_back();
+	m_isAwake.pop_back();
+	m_secondsAtRest.pop_back();
+	m_moveScales.pop_back();
+	m_affectorScales.pop_back();
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+class Rigidbody;
+
+
+//-----------------------------------------------------------------------------------------------
+enum eSimulationMode : unsigned int
+{
+	SIMULATION_MODE_NONE,
+	SIMULATION_MODE_STATIC,
+	SIMULATION_MODE_KINEMATIC,
+	SIMULATION_MODE_DYNAMIC
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Stays valid for gameplay code while bodies are added and removed around it, a handle to a
+// removed body is detected by its generation instead of dangling
+//-----------------------------------------------------------------------------------------------
+struct RigidbodyHandle
+{
+public:
+	uint32_t slot = 0xFFFFFFFF;
+	uint32_t generation = 0;
+
+public:
+	bool IsValid() const															{ return slot != 0xFFFFFFFF; }
+
+	bool operator==( const RigidbodyHandle& other ) const							{ return slot == other.slot && generation == other.generation; }
+	bool operator!=( const RigidbodyHandle& other ) const							{ return !( *this == other ); }
+
+	static const RigidbodyHandle INVALID;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Pooled structure of arrays holding the per step simulation data of every rigidbody in a scene.
+// Bodies are densely packed so the integration and affector kernels stream through contiguous
+// floats, removing a body swaps the last body into its place and fixes up the handle table.
+// Rigidbody objects stay as the gameplay facing api and read/write their data in here
+//-----------------------------------------------------------------------------------------------
+class RigidbodyStore
+{
+public:
+	RigidbodyHandle AddBody( Rigidbody* owner );
+	void RemoveBody( const RigidbodyHandle& handle );
+	void Clear();
+	void Reserve( int numBodies );
+
+	bool IsValid( const RigidbodyHandle& handle ) const;
+	int GetBodyIndex( const RigidbodyHandle& handle ) const;		// Dense index, -1 for stale handles
+	int GetNumBodies() const														{ return (int)m_owners.size(); }
+	Rigidbody* GetOwner( int bodyIdx ) const										{ return m_owners[bodyIdx]; }
+
+	Vec3 GetPosition( int bodyIdx ) const											{ return Vec3( m_positionsX[bodyIdx], m_positionsY[bodyIdx], m_positionsZ[bodyIdx] ); }
+	void SetPosition( int bodyIdx, const Vec3& position );
+	Vec3 GetPreviousPosition( int bodyIdx ) const									{ return Vec3( m_previousPositionsX[bodyIdx], m_previousPositionsY[bodyIdx], m_previousPositionsZ[bodyIdx] ); }
+	Vec3 GetInterpolatedPosition( int bodyIdx, float fractionOfStep ) const;
+	Vec3 GetVelocity( int bodyIdx ) const											{ return Vec3( m_velocitiesX[bodyIdx], m_velocitiesY[bodyIdx], m_velocitiesZ[bodyIdx] ); }
+	void SetVelocity( int bodyIdx, const Vec3& velocity );
+	Vec3 GetForce( int bodyIdx ) const												{ return Vec3( m_forcesX[bodyIdx], m_forcesY[bodyIdx], m_forcesZ[bodyIdx] ); }
+	void AddForce( int bodyIdx, const Vec3& force );
+
+	float GetInverseMass( int bodyIdx ) const										{ return m_inverseMasses[bodyIdx]; }
+	void SetInverseMass( int bodyIdx, float inverseMass )							{ m_inverseMasses[bodyIdx] = inverseMass; }
+	float GetDrag( int bodyIdx ) const												{ return m_drags[bodyIdx]; }
+	void SetDrag( int bodyIdx, float drag )											{ m_drags[bodyIdx] = drag; }
+
+	float GetOrientationRadians( int bodyIdx ) const								{ return m_orientationsRadians[bodyIdx]; }
+	void SetOrientationRadians( int bodyIdx, float orientationRadians )				{ m_orientationsRadians[bodyIdx] = orientationRadians; }
+	float GetInterpolatedOrientationRadians( int bodyIdx, float fractionOfStep ) const;
+	float GetAngularVelocity( int bodyIdx ) const									{ return m_angularVelocities[bodyIdx]; }
+	void SetAngularVelocity( int bodyIdx, float angularVelocity )					{ m_angularVelocities[bodyIdx] = angularVelocity; }
+
+	eSimulationMode GetSimulationMode( int bodyIdx ) const							{ return m_simulationModes[bodyIdx]; }
+	void SetSimulationMode( int bodyIdx, eSimulationMode mode );
+	bool IsEnabled( int bodyIdx ) const												{ return m_isEnabled[bodyIdx] != 0; }
+	void SetEnabled( int bodyIdx, bool isEnabled );
+	bool IsSimulated( int bodyIdx ) const;										// Enabled dynamic or kinematic, awake or not
+	bool IsMovable( int bodyIdx ) const												{ return m_moveScales[bodyIdx] != 0.f; }
+	bool IsAffectable( int bodyIdx ) const											{ return m_affectorScales[bodyIdx] != 0.f; }
+
+	// Sleeping bodies are skipped by the affector and integration kernels until something wakes them
+	bool IsAwake( int bodyIdx ) const												{ return m_isAwake[bodyIdx] != 0; }
+	void WakeBody( int bodyIdx );
+	void PutBodyToSleep( int bodyIdx );
+	float GetSecondsAtRest( int bodyIdx ) const										{ return m_secondsAtRest[bodyIdx]; }
+
+	// Kernels over every body, affectors only touch enabled dynamic bodies and integration
+	// moves enabled dynamic and kinematic bodies then zeroes all accumulated forces
+	void SavePreviousTransforms();							// Start of a step, interpolation blends from these
+	void SnapPreviousTransform( int bodyIdx );				// Teleports aren't blended
+	void ApplyUniformForce( const Vec3& force );
+	void ApplyDragForces();
+	void Integrate( float deltaSeconds );
+	void UpdateSecondsAtRest( float deltaSeconds, float linearSleepSpeed, float angularSleepSpeed );
+
+private:
+	void UpdateScales( int bodyIdx );
+	void MoveBody( int fromIdx, int toIdx );
+	void PopBackBody();
+
+private:
+	// Handle table, indexed by slot
+	std::vector<int> m_slotBodyIndexes;
+	std::vector<uint32_t> m_slotGenerations;
+	std::vector<uint32_t> m_freeSlots;
+
+	// Body data, indexed by dense body index
+	std::vector<Rigidbody*> m_owners;
+	std::vector<uint32_t> m_bodySlots;
+
+	std::vector<float> m_positionsX;
+	std::vector<float> m_positionsY;
+	std::vector<float> m_positionsZ;
+	std::vector<float> m_velocitiesX;
+	std::vector<float> m_velocitiesY;
+	std::vector<float> m_velocitiesZ;
+	std::vector<float> m_forcesX;
+	std::vector<float> m_forcesY;
+	std::vector<float> m_forcesZ;
+
+	std::vector<float> m_inverseMasses;
+	std::vector<float> m_drags;
+
+	std::vector<float> m_orientationsRadians;
+	std::vector<float> m_angularVelocities;
+
+	std::vector<float> m_previousPositionsX;
+	std::vector<float> m_previousPositionsY;
+	std::vector<float> m_previousPositionsZ;
+	std::vector<float> m_previousOrientationsRadians;
+
+	std::vector<eSimulationMode> m_simulationModes;
+	std::vector<byte> m_isEnabled;
+	std::vector<byte> m_isAwake;
+	std::vector<float> m_secondsAtRest;		// How long the body has been below the sleep speeds
+	std::vector<float> m_moveScales;			// 1 for bodies the integrator moves, 0 otherwise so kernels don't branch
+	std::vector<float> m_affectorScales;		// 1 for bodies affectors act on, 0 otherwise
+};
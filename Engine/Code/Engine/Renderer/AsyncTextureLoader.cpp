@@ -0,0 +1,291 @@
+#include "Engine/Renderer/AsyncTextureLoader.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Time/Time.hpp"
+
+#include "ThirdParty/stb/stb_image.h"
+
+#include <climits>
+
+
+//-----------------------------------------------------------------------------------------------
+// ImageDecodeJob
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+ImageDecodeJob::ImageDecodeJob( AsyncTextureLoader* loader, Texture* texture, const std::string& filePath )
+	: m_loader( loader )
+	, m_filePath( filePath )
+{
+	m_decodedImage.texture = texture;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ImageDecodeJob::~ImageDecodeJob()
+{
+	if ( m_decodedImage.rgbaTexels != nullptr )
+	{
+		stbi_image_free( m_decodedImage.rgbaTexels );
+		m_decodedImage.rgbaTexels = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ImageDecodeJob::Execute()
+{
+	std::vector<byte>* fileBuffer = m_loader->AcquireFileBuffer();
+
+	if ( FileReadBinaryToBuffer( m_filePath, *fileBuffer ) )
+	{
+		m_decodedImage.rgbaTexels = AsyncTextureLoader::DecodeImageFromBuffer( *fileBuffer, m_decodedImage.dimensions );
+	}
+
+	m_loader->ReleaseFileBuffer( fileBuffer );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ImageDecodeJob::ClaimJobCallback()
+{
+	if ( m_decodedImage.rgbaTexels == nullptr )
+	{
+		g_devConsole->PrintError( Stringf( "Failed to load image \"%s\"", m_filePath.c_str() ) );
+	}
+
+	// Loader takes ownership of the texels
+	m_loader->AddDecodedImage( m_decodedImage );
+	m_decodedImage.rgbaTexels = nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// AsyncTextureLoader
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+AsyncTextureLoader::AsyncTextureLoader( RenderContext* context )
+	: m_context( context )
+	, m_numPendingLoads( 0 )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+	PTR_VECTOR_SAFE_DELETE( m_fileBufferPool );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::Startup()
+{
+	// stb_image's flip flag is global, every image in the engine is loaded flipped so set it once up front
+	stbi_set_flip_vertically_on_load( 1 ); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
+
+	g_eventSystem->RegisterMethodEvent( "benchmark_image_decode", "Decode every image in a folder serially and on the job system, folder=Data/Images", eUsageLocation::DEV_CONSOLE, this, &AsyncTextureLoader::BenchmarkImageDecode );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::Shutdown()
+{
+	FinishAllPendingLoads();
+
+	g_eventSystem->DeRegisterObject( this );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool AsyncTextureLoader::CanLoadAsync() const
+{
+	return g_jobSystem != nullptr
+		&& g_jobSystem->GetNumWorkerThreads() > 0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::QueueTextureLoad( Texture* pendingTexture )
+{
+	++m_numPendingLoads;
+
+	g_jobSystem->QueueJob( new ImageDecodeJob( this, pendingTexture, pendingTexture->GetFilePath() ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::UploadDecodedTextures( int maxUploads )
+{
+	int numUploads = 0;
+	int numDecodedImages = (int)m_decodedImages.size();
+	for ( ; numUploads < numDecodedImages && numUploads < maxUploads; ++numUploads )
+	{
+		DecodedImage& decodedImage = m_decodedImages[numUploads];
+		if ( decodedImage.rgbaTexels != nullptr )
+		{
+			// Images decoded without a texture are benchmark runs and are just discarded
+			if ( decodedImage.texture != nullptr )
+			{
+				decodedImage.texture->SetLoadedHandle( m_context->CreateTexture2DFromTexels( decodedImage.rgbaTexels, decodedImage.dimensions ) );
+			}
+
+			stbi_image_free( decodedImage.rgbaTexels );
+			decodedImage.rgbaTexels = nullptr;
+		}
+
+		--m_numPendingLoads;
+	}
+
+	m_decodedImages.erase( m_decodedImages.begin(), m_decodedImages.begin() + numUploads );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::FinishAllPendingLoads()
+{
+	while ( m_numPendingLoads > 0 )
+	{
+		g_jobSystem->ClaimAndDeleteAllCompletedJobs();
+		UploadDecodedTextures( INT_MAX );
+
+		if ( m_numPendingLoads > 0 )
+		{
+			std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+unsigned char* AsyncTextureLoader::DecodeImageFromBuffer( const std::vector<byte>& fileBuffer, IntVec2& out_dimensions )
+{
+	if ( fileBuffer.empty() )
+	{
+		return nullptr;
+	}
+
+	int imageTexelSizeX = 0;
+	int imageTexelSizeY = 0;
+	int numComponents = 0;
+	int numComponentsRequested = 4; // we support 4 (32-bit RGBA)
+
+	unsigned char* imageData = stbi_load_from_memory( &fileBuffer[0], (int)fileBuffer.size(), &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested );
+	if ( imageData == nullptr
+		 || imageTexelSizeX <= 0
+		 || imageTexelSizeY <= 0 )
+	{
+		stbi_image_free( imageData );
+		return nullptr;
+	}
+
+	out_dimensions = IntVec2( imageTexelSizeX, imageTexelSizeY );
+	return imageData;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::AddDecodedImage( const DecodedImage& decodedImage )
+{
+	m_decodedImages.push_back( decodedImage );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+std::vector<byte>* AsyncTextureLoader::AcquireFileBuffer()
+{
+	std::vector<byte>* fileBuffer = nullptr;
+
+	m_fileBufferPoolMutex.lock();
+	if ( !m_fileBufferPool.empty() )
+	{
+		fileBuffer = m_fileBufferPool.back();
+		m_fileBufferPool.pop_back();
+	}
+	m_fileBufferPoolMutex.unlock();
+
+	if ( fileBuffer == nullptr )
+	{
+		fileBuffer = new std::vector<byte>();
+	}
+
+	return fileBuffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::ReleaseFileBuffer( std::vector<byte>* fileBuffer )
+{
+	m_fileBufferPoolMutex.lock();
+	m_fileBufferPool.push_back( fileBuffer );
+	m_fileBufferPoolMutex.unlock();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AsyncTextureLoader::BenchmarkImageDecode( EventArgs* args )
+{
+	std::string folder = args->GetValue( "folder", "Data/Images" );
+
+	Strings fileNames = GetFileNamesInFolder( folder, "*.png" );
+	if ( fileNames.empty() )
+	{
+		g_devConsole->PrintError( Stringf( "No images found in '%s'", folder.c_str() ) );
+		return;
+	}
+
+	// Serial decode on this thread
+	std::vector<byte> fileBuffer;
+	size_t totalTexelBytes = 0;
+	double serialStartTime = GetCurrentTimeSeconds();
+	for ( int fileIdx = 0; fileIdx < (int)fileNames.size(); ++fileIdx )
+	{
+		if ( !FileReadBinaryToBuffer( folder + "/" + fileNames[fileIdx], fileBuffer ) )
+		{
+			continue;
+		}
+
+		IntVec2 dimensions;
+		unsigned char* texels = DecodeImageFromBuffer( fileBuffer, dimensions );
+		if ( texels != nullptr )
+		{
+			totalTexelBytes += (size_t)dimensions.x * (size_t)dimensions.y * 4;
+			stbi_image_free( texels );
+		}
+	}
+	double serialSeconds = GetCurrentTimeSeconds() - serialStartTime;
+
+	float texelMegabytes = (float)totalTexelBytes / ( 1024.f * 1024.f );
+	g_devConsole->PrintString( Stringf( "Serial decode: %i images, %.2f MB in %.2f ms (%.2f MB/s)",
+										(int)fileNames.size(), texelMegabytes, serialSeconds * 1000.0, texelMegabytes / (float)serialSeconds ) );
+
+	if ( !CanLoadAsync() )
+	{
+		g_devConsole->PrintString( "No job system worker threads, skipping parallel decode" );
+		return;
+	}
+
+	// Parallel decode on the job system, jobs without a texture are discarded when claimed
+	FinishAllPendingLoads();
+
+	double parallelStartTime = GetCurrentTimeSeconds();
+	for ( int fileIdx = 0; fileIdx < (int)fileNames.size(); ++fileIdx )
+	{
+		++m_numPendingLoads;
+		g_jobSystem->QueueJob( new ImageDecodeJob( this, nullptr, folder + "/" + fileNames[fileIdx] ) );
+	}
+
+	FinishAllPendingLoads();
+	double parallelSeconds = GetCurrentTimeSeconds() - parallelStartTime;
+
+	g_devConsole->PrintString( Stringf( "Job system decode: %i images on %i workers in %.2f ms (%.2f MB/s)",
+										(int)fileNames.size(), g_jobSystem->GetNumWorkerThreads(), parallelSeconds * 1000.0, texelMegabytes / (float)parallelSeconds ) );
+}
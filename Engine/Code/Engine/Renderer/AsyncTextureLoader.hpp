@@ -0,0 +1,87 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+class AsyncTextureLoader;
+class RenderContext;
+class Texture;
+
+
+//-----------------------------------------------------------------------------------------------
+struct DecodedImage
+{
+public:
+	Texture* texture = nullptr;
+	unsigned char* rgbaTexels = nullptr;		// Allocated by stb_image, freed once uploaded
+	IntVec2 dimensions = IntVec2::ZERO;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Reads and decodes an image file on a worker thread, the decoded texels are handed back
+// to the loader on the main thread when the job is claimed
+//-----------------------------------------------------------------------------------------------
+class ImageDecodeJob : public Job
+{
+public:
+	ImageDecodeJob( AsyncTextureLoader* loader, Texture* texture, const std::string& filePath );
+	virtual ~ImageDecodeJob();
+
+	virtual void Execute() override;				// Called by worker thread
+	virtual void ClaimJobCallback() override;		// Called by client on its thread
+
+private:
+	AsyncTextureLoader* m_loader = nullptr;
+	std::string m_filePath;
+	DecodedImage m_decodedImage;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+class AsyncTextureLoader
+{
+	friend class ImageDecodeJob;
+
+public:
+	AsyncTextureLoader( RenderContext* context );
+	~AsyncTextureLoader();
+
+	void Startup();
+	void Shutdown();
+
+	bool CanLoadAsync() const;
+	int GetNumPendingLoads() const												{ return m_numPendingLoads; }
+
+	void QueueTextureLoad( Texture* pendingTexture );
+	void UploadDecodedTextures( int maxUploads );
+	void FinishAllPendingLoads();
+
+	static unsigned char* DecodeImageFromBuffer( const std::vector<byte>& fileBuffer, IntVec2& out_dimensions );
+
+private:
+	void AddDecodedImage( const DecodedImage& decodedImage );
+
+	// File buffers are pooled since they're only needed until stb_image has decoded the texels
+	std::vector<byte>* AcquireFileBuffer();
+	void ReleaseFileBuffer( std::vector<byte>* fileBuffer );
+
+	// Console commands
+	void BenchmarkImageDecode( EventArgs* args );
+
+private:
+	RenderContext* m_context = nullptr;
+
+	std::atomic<int> m_numPendingLoads;
+	std::vector<DecodedImage> m_decodedImages;
+
+	std::mutex m_fileBufferPoolMutex;
+	std::vector<std::vector<byte>*> m_fileBufferPool;
+};
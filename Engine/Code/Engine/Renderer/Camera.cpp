@@ -228,6 +228,19 @@ float Camera::GetAspectRatio() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+Frustum Camera::GetWorldFrustum() const
+{
+	Mat44 viewMatrix = m_transform.GetAsMatrix();
+	InvertMatrix( viewMatrix );
+
+	Mat44 worldToClip = GetProjectionMatrix();
+	worldToClip.PushTransform( viewMatrix );
+
+	return Frustum::CreateFromWorldToClipMatrix( worldToClip );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Camera::UpdateCameraUBO()
 {
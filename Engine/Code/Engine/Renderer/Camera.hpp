@@ -5,6 +5,7 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Math/Transform.hpp"
 
 
@@ -95,6 +96,7 @@ public:
 
 	const Mat44 GetViewMatrix()				const	{ return m_viewMatrix; }
 	const Mat44 GetProjectionMatrix()		const	{ return m_projectionMatrix; }
+	Frustum GetWorldFrustum() const;		// from the current transform, doesn't wait for the view matrix to update
 
 	// Helpers
 	// can use this to determine aspect ratio
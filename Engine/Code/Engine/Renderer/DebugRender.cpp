@@ -943,10 +943,7 @@ void DebugAddWorldText( const Mat44& basis, const Vec2& pivot, const Rgba8& star
 	
 	font->AppendVertsAndIndicesForText2D( vertices, indices, textMins, textHeight, text, Rgba8::WHITE );
 
-	for ( int vertIdx = 0; vertIdx < (int)vertices.size(); ++vertIdx )
-	{
-		vertices[vertIdx].m_position = basis.TransformPosition3D( vertices[vertIdx].m_position );
-	}
+	TransformVertexArray( vertices, basis );
 
 	DebugRenderObject* obj = new DebugRenderObject( vertices, indices, start_color, end_color, duration );
 
@@ -5,6 +5,7 @@
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/ObjLoader.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/BatchTransform.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/MatrixUtils.hpp"
 #include "Engine/Math/AABB2.hpp"
@@ -258,6 +259,49 @@ void DrawPolygon2Outline( RenderContext* renderer,
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void TransformVertexArray( std::vector<Vertex_PCU>& vertexArray, const Mat44& transform )
+{
+	if ( vertexArray.empty() )
+	{
+		return;
+	}
+
+	TransformPositions3DBatch( transform, (byte*)&vertexArray[0].m_position, (int)vertexArray.size(), sizeof( Vertex_PCU ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TransformVertexArray( std::vector<Vertex_PCUTBN>& vertexArray, const Mat44& transform )
+{
+	ObjLoader::TransformVerts( vertexArray, transform );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AABB3 GetBoundsForVertexArray( const std::vector<Vertex_PCU>& vertexArray )
+{
+	if ( vertexArray.empty() )
+	{
+		return AABB3();
+	}
+
+	return GetBoundsOfPositions3DBatch( (const byte*)&vertexArray[0].m_position, (int)vertexArray.size(), sizeof( Vertex_PCU ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+AABB3 GetBoundsForVertexArray( const std::vector<Vertex_PCUTBN>& vertexArray )
+{
+	if ( vertexArray.empty() )
+	{
+		return AABB3();
+	}
+
+	return GetBoundsOfPositions3DBatch( (const byte*)&vertexArray[0].position, (int)vertexArray.size(), sizeof( Vertex_PCUTBN ) );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void AppendVertsForArc( std::vector<Vertex_PCU>& vertexArray, 
 						const Vec2& center, float radius, 
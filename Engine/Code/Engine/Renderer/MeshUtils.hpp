@@ -38,6 +38,15 @@ void DrawPolygon2Outline( RenderContext* renderer, const std::vector<Vec2>& vert
 void DrawAABB2WithDepth( RenderContext* renderer, const AABB2& box, float zDepth, const Rgba8& tint );
 
 
+//-----------------------------------------------------------------------------------------------
+// Vertex array operations, these run on the whole array at once with simd where available
+//-----------------------------------------------------------------------------------------------
+void  TransformVertexArray( std::vector<Vertex_PCU>& vertexArray, const Mat44& transform );
+void  TransformVertexArray( std::vector<Vertex_PCUTBN>& vertexArray, const Mat44& transform );		// Normals, tangents, and bitangents are rotated but not scaled
+AABB3 GetBoundsForVertexArray( const std::vector<Vertex_PCU>& vertexArray );
+AABB3 GetBoundsForVertexArray( const std::vector<Vertex_PCUTBN>& vertexArray );
+
+
 //-----------------------------------------------------------------------------------------------
 // Vertex_PCU append methods
 //-----------------------------------------------------------------------------------------------
@@ -9,7 +9,10 @@
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Core/XMLUtils.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Math/BatchTransform.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/AsyncTextureLoader.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/BuiltInShaders.hpp"
 #include "Engine/Renderer/Camera.hpp"
@@ -22,6 +25,7 @@
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/ShaderProgram.hpp"
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/TextureAtlas.hpp"
 #include "Engine/Renderer/TextureView.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
@@ -46,6 +50,11 @@ void RenderContext::Startup( Window* window )
 	InitializeSwapChain( window );
 	InitializeDefaultRenderObjects();
 
+	m_asyncTextureLoader = new AsyncTextureLoader( this );
+	m_asyncTextureLoader->Startup();
+
+	g_eventSystem->RegisterEvent( "benchmark_batch_transform", "Time batched vertex transforms at each simd level, vertices=1000000 iterations=10", eUsageLocation::DEV_CONSOLE, BenchmarkBatchTransformEvent );
+
 	m_systemFont = CreateOrGetBitmapFontFromFile( "Data/Fonts/SquirrelFixedFont" );
 
 	m_effectCamera = new Camera();
@@ -133,6 +142,7 @@ void RenderContext::InitializeDefaultRenderObjects()
 	m_defaultWhiteTexture = CreateTextureFromColor( Rgba8::WHITE );
 	m_flatNormalMap = CreateTextureFromColor( Rgba8( 127, 127, 255, 255 ) );
 	m_defaultSpecGlossEmissiveTexture = CreateTextureFromColor( Rgba8( 127, 127, 0, 255 ) );
+	m_loadingPlaceholderTexture = CreateTextureFromColor( Rgba8( 127, 127, 127, 255 ) );
 
 	// Create a depth buffer and initialize it to draw pixels using painter's algorithm
 	m_defaultDepthBuffer = GetOrCreateDepthStencil( m_swapchain->GetBackBuffer()->GetTexelSize() );
@@ -159,6 +169,8 @@ void RenderContext::Setup( Clock* gameClock )
 //-----------------------------------------------------------------------------------------------
 void RenderContext::BeginFrame()
 {
+	m_asyncTextureLoader->UploadDecodedTextures( MAX_TEXTURE_UPLOADS_PER_FRAME );
+
 	UpdateFrameData();
 }
 
@@ -173,6 +185,10 @@ void RenderContext::EndFrame()
 //-----------------------------------------------------------------------------------------------
 void RenderContext::Shutdown()
 {
+	// Decode jobs hold onto textures, let them land before the textures are deleted
+	m_asyncTextureLoader->Shutdown();
+	PTR_SAFE_DELETE( m_asyncTextureLoader );
+
 	PTR_SAFE_DELETE( m_effectCamera );
 
 	PTR_SAFE_DELETE( m_immediateVBOPCU );
@@ -191,6 +207,7 @@ void RenderContext::Shutdown()
 		
 	PTR_MAP_SAFE_DELETE( m_loadedBitmapFonts );
 	PTR_VECTOR_SAFE_DELETE( m_loadedTextures );
+	PTR_VECTOR_SAFE_DELETE( m_textureAtlases );
 	PTR_VECTOR_SAFE_DELETE( m_loadedShaders );
 	PTR_VECTOR_SAFE_DELETE( m_loadedShaderPrograms );
 	PTR_VECTOR_SAFE_DELETE( m_loadedSamplers );
@@ -913,6 +930,50 @@ Texture* RenderContext::CreateOrGetTextureFromFile( const char* filePath )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void RenderContext::FinishPendingTextureLoads()
+{
+	m_asyncTextureLoader->FinishAllPendingLoads();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+TextureAtlas* RenderContext::CreateOrLoadTextureAtlas( const std::string& cacheFilePath, const Strings& sourceImagePaths )
+{
+	TextureAtlas* atlas = new TextureAtlas( this, cacheFilePath );
+	if ( !atlas->LoadFromCache( sourceImagePaths ) )
+	{
+		g_devConsole->PrintString( Stringf( "Building texture atlas '%s'", cacheFilePath.c_str() ) );
+
+		if ( !atlas->Build( sourceImagePaths ) )
+		{
+			PTR_SAFE_DELETE( atlas );
+			return nullptr;
+		}
+	}
+
+	m_textureAtlases.push_back( atlas );
+
+	// Source textures bind the atlas from now on, ones that haven't been requested yet never load their own image
+	const std::vector<TextureAtlasEntry>& entries = atlas->GetEntries();
+	for ( int entryIdx = 0; entryIdx < (int)entries.size(); ++entryIdx )
+	{
+		const TextureAtlasEntry& entry = entries[entryIdx];
+
+		Texture* sourceTexture = RetrieveTextureFromCache( entry.sourcePath.c_str() );
+		if ( sourceTexture == nullptr )
+		{
+			sourceTexture = new Texture( entry.sourcePath.c_str(), this, entry.sourceDimensions );
+			m_loadedTextures.push_back( sourceTexture );
+		}
+
+		sourceTexture->SetAtlasRegion( atlas->GetTexture(), entry.uvBounds );
+	}
+
+	return atlas;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Texture* RenderContext::CreateTextureFromFile( const char* imageFilePath )
 {
@@ -921,6 +982,22 @@ Texture* RenderContext::CreateTextureFromFile( const char* imageFilePath )
 	int numComponents = 0; // This will be filled in for us to indicate how many color components the image had (e.g. 3=RGB=24bit, 4=RGBA=32bit)
 	int numComponentsRequested = 4; // we support 4 (32-bit RGBA)
 
+	if ( m_asyncTextureLoader->CanLoadAsync() )
+	{
+		// Only the header is read here so the texture knows its size while the texels decode on a worker
+		if ( !stbi_info( imageFilePath, &imageTexelSizeX, &imageTexelSizeY, &numComponents ) )
+		{
+			g_devConsole->PrintString( Stringf( "Failed to load image \"%s\"", imageFilePath ), Rgba8::RED );
+			return nullptr;
+		}
+
+		Texture* pendingTexture = new Texture( imageFilePath, this, IntVec2( imageTexelSizeX, imageTexelSizeY ) );
+		m_loadedTextures.push_back( pendingTexture );
+
+		m_asyncTextureLoader->QueueTextureLoad( pendingTexture );
+		return pendingTexture;
+	}
+
 	// Load (and decompress) the image RGB(A) bytes from a file on disk into a memory buffer (array of bytes)
 	stbi_set_flip_vertically_on_load( 1 ); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
 	unsigned char* imageData = stbi_load( imageFilePath, &imageTexelSizeX, &imageTexelSizeY, &numComponents, numComponentsRequested );
@@ -938,39 +1015,82 @@ Texture* RenderContext::CreateTextureFromFile( const char* imageFilePath )
 			&& imageTexelSizeX > 0 && imageTexelSizeY > 0 ) )
 	{
 		g_devConsole->PrintString( Stringf( "ERROR loading image \"%s\" (Bpp=%i, size=%i,%i)", imageFilePath, numComponents, imageTexelSizeX, imageTexelSizeY ) ,Rgba8::RED );
+		stbi_image_free( imageData );
 		return nullptr;
 	}
 
+	ID3D11Texture2D* texHandle = CreateTexture2DFromTexels( imageData, IntVec2( imageTexelSizeX, imageTexelSizeY ) );
+
+	// Free the raw image texel data now that we've sent a copy of it down to the GPU to be stored in video memory
+	stbi_image_free( imageData );
+
+	Texture* newTexture = new Texture( imageFilePath, this, texHandle );
+	m_loadedTextures.push_back( newTexture );
+
+	return newTexture;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ID3D11Texture2D* RenderContext::CreateTexture2DFromTexels( const unsigned char* rgbaTexels, const IntVec2& dimensions, int numMipLevels )
+{
+	GUARANTEE_OR_DIE( numMipLevels > 0 && numMipLevels <= D3D11_REQ_MIP_LEVELS, Stringf( "Invalid number of mip levels '%i'", numMipLevels ) );
+
 	// Describe the texture
 	D3D11_TEXTURE2D_DESC desc;
-	desc.Width = imageTexelSizeX;
-	desc.Height = imageTexelSizeY;
-	desc.MipLevels = 1;
+	desc.Width = dimensions.x;
+	desc.Height = dimensions.y;
+	desc.MipLevels = numMipLevels;
 	desc.ArraySize = 1;
 	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 	desc.SampleDesc.Count = 1;						// MSAA
 	desc.SampleDesc.Quality = 0;
-	desc.Usage = D3D11_USAGE_IMMUTABLE;				// if we do mip chains this needs to be GPU/DEFAULT; as of now the texture will never change
+	desc.Usage = D3D11_USAGE_IMMUTABLE;				// mip chains are precomputed, as of now the texture will never change
 	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;	// | RENDER_TAGET later
 	desc.CPUAccessFlags = 0;
 	desc.MiscFlags = 0;
 
-	D3D11_SUBRESOURCE_DATA initialData;
-	initialData.pSysMem = imageData;
-	initialData.SysMemPitch = imageTexelSizeX * numComponents;
-	initialData.SysMemSlicePitch = 0;
+	// Texels are always 4 components, each mip level follows the previous one in memory
+	D3D11_SUBRESOURCE_DATA initialData[D3D11_REQ_MIP_LEVELS];
+	const unsigned char* mipTexels = rgbaTexels;
+	IntVec2 mipDimensions = dimensions;
+	for ( int mipIdx = 0; mipIdx < numMipLevels; ++mipIdx )
+	{
+		initialData[mipIdx].pSysMem = mipTexels;
+		initialData[mipIdx].SysMemPitch = mipDimensions.x * 4;
+		initialData[mipIdx].SysMemSlicePitch = 0;
+
+		mipTexels += mipDimensions.x * mipDimensions.y * 4;
+		mipDimensions = IntVec2( Max( mipDimensions.x / 2, 1 ), Max( mipDimensions.y / 2, 1 ) );
+	}
 
 	// DirectX creation
 	ID3D11Texture2D* texHandle = nullptr;
-	m_device->CreateTexture2D( &desc, &initialData, &texHandle );
+	m_device->CreateTexture2D( &desc, initialData, &texHandle );
 
-	// Free the raw image texel data now that we've sent a copy of it down to the GPU to be stored in video memory
-	stbi_image_free( imageData );
+	return texHandle;
+}
 
-	Texture* newTexture = new Texture( imageFilePath, this, texHandle );
-	m_loadedTextures.push_back( newTexture );
 
-	return newTexture;
+//-----------------------------------------------------------------------------------------------
+Texture* RenderContext::GetBindableTexture( Texture* texture, Texture* defaultTexture )
+{
+	if ( texture == nullptr )
+	{
+		return defaultTexture;
+	}
+
+	if ( texture->IsAtlased() )
+	{
+		texture = texture->GetAtlasTexture();
+	}
+
+	if ( !texture->IsLoaded() )
+	{
+		return m_loadingPlaceholderTexture;
+	}
+
+	return texture;
 }
 
 
@@ -1091,11 +1211,7 @@ void RenderContext::CreateDefaultRasterState()
 //-----------------------------------------------------------------------------------------------
 void RenderContext::BindDiffuseTexture( const Texture* constTexture )
 {
-	Texture* texture = const_cast<Texture*>( constTexture );
-	if ( texture == nullptr )
-	{
-		texture = m_defaultWhiteTexture;
-	}
+	Texture* texture = GetBindableTexture( const_cast<Texture*>( constTexture ), m_defaultWhiteTexture );
 
 	TextureView* shaderResourceView = texture->GetOrCreateShaderResourceView();
 	ID3D11ShaderResourceView* srvHandle = shaderResourceView->m_shaderResourceView;
@@ -1106,11 +1222,7 @@ void RenderContext::BindDiffuseTexture( const Texture* constTexture )
 //-----------------------------------------------------------------------------------------------
 void RenderContext::BindNormalTexture( const Texture* constTexture )
 {
-	Texture* texture = const_cast<Texture*>( constTexture );
-	if ( texture == nullptr )
-	{
-		texture = m_flatNormalMap;
-	}
+	Texture* texture = GetBindableTexture( const_cast<Texture*>( constTexture ), m_flatNormalMap );
 
 	TextureView* shaderResourceView = texture->GetOrCreateShaderResourceView();
 	ID3D11ShaderResourceView* srvHandle = shaderResourceView->m_shaderResourceView;
@@ -1121,11 +1233,7 @@ void RenderContext::BindNormalTexture( const Texture* constTexture )
 //-----------------------------------------------------------------------------------------------
 void RenderContext::BindSpecGlossEmissiveTexture( const Texture* constTexture )
 {
-	Texture* texture = const_cast<Texture*>( constTexture );
-	if ( texture == nullptr )
-	{
-		texture = m_defaultSpecGlossEmissiveTexture;
-	}
+	Texture* texture = GetBindableTexture( const_cast<Texture*>( constTexture ), m_defaultSpecGlossEmissiveTexture );
 
 	TextureView* shaderResourceView = texture->GetOrCreateShaderResourceView();
 	ID3D11ShaderResourceView* srvHandle = shaderResourceView->m_shaderResourceView;
@@ -1136,12 +1244,8 @@ void RenderContext::BindSpecGlossEmissiveTexture( const Texture* constTexture )
 //-----------------------------------------------------------------------------------------------
 void RenderContext::BindTexture( uint slot, const Texture* constTexture )
 {
-	Texture* texture = const_cast<Texture*>( constTexture );
-	if ( texture == nullptr )
-	{
-		// TODO: Make error texture
-		texture = m_defaultWhiteTexture;
-	}
+	// TODO: Make error texture
+	Texture* texture = GetBindableTexture( const_cast<Texture*>( constTexture ), m_defaultWhiteTexture );
 
 	TextureView* shaderResourceView = texture->GetOrCreateShaderResourceView();
 	ID3D11ShaderResourceView* srvHandle = shaderResourceView->m_shaderResourceView;
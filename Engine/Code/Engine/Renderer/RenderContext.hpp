@@ -16,6 +16,7 @@
 //-----------------------------------------------------------------------------------------------
 constexpr int USER_TEXTURE_SLOT_START = 8;
 constexpr int MAX_USER_TEXTURES = 8;
+constexpr int MAX_TEXTURE_UPLOADS_PER_FRAME = 8;
 
 
 //-----------------------------------------------------------------------------------------------
@@ -32,6 +33,9 @@ struct ID3D11RasterizerState;
 struct ID3D11DepthStencilView;
 struct Vertex_PCU;
 struct Vertex_PCUTBN;
+struct ID3D11Texture2D;
+class AsyncTextureLoader;
+class TextureAtlas;
 class BitmapFont;
 class Camera;
 class Clock;
@@ -164,6 +168,9 @@ struct Fog
 //-----------------------------------------------------------------------------------------------
 class RenderContext
 {
+	friend class AsyncTextureLoader;
+	friend class TextureAtlas;
+
 public:
 	void Startup( Window* window );
 	void Setup( Clock* gameClock );
@@ -172,6 +179,7 @@ public:
 	void Shutdown();
 
 	void SetBlendMode( eBlendMode blendMode );
+	eBlendMode GetBlendMode() const							{ return m_currentBlendMode; }
 	void SetDepthTest( eCompareFunc compare, bool writeDepthOnPass );
 
 	void ClearScreen( ID3D11RenderTargetView* renderTargetView, const Rgba8& clearColor );
@@ -208,6 +216,7 @@ public:
 	void BindShaderByPath( const char* filePath );
 	void BindShaderProgram( ShaderProgram* shader );
 	void BindShaderProgram( const char* fileName );
+	ShaderProgram* GetCurrentShaderProgram() const			{ return m_currentShaderProgram; }
 	void BindDiffuseTexture( const Texture* constTexture );
 	void BindNormalTexture( const Texture* constTexture );
 	void BindSpecGlossEmissiveTexture( const Texture* constTexture );
@@ -218,7 +227,9 @@ public:
 	Shader* GetOrCreateShader( const char* filename );
 	ShaderProgram* GetOrCreateShaderProgram( const char* filename );
 	ShaderProgram* GetOrCreateShaderProgramFromSourceString( const char* shaderName, const char* source );
-	Texture* CreateOrGetTextureFromFile( const char* filePath );
+	Texture* CreateOrGetTextureFromFile( const char* filePath );		// Decoded on the job system when workers are available
+	void FinishPendingTextureLoads();
+	TextureAtlas* CreateOrLoadTextureAtlas( const std::string& cacheFilePath, const Strings& sourceImagePaths );
 	Texture* CreateTextureFromColor( const Rgba8& color );
 	Texture* GetOrCreateDepthStencil( const IntVec2& outputDimensions );
 	Texture* CreateRenderTarget( const IntVec2& outputDimensions );
@@ -266,6 +277,7 @@ public:
 	Texture* GetDefaultWhiteTexture()					{ return m_defaultWhiteTexture; }
 	Texture* GetDefaultFlatTexture()					{ return m_flatNormalMap; }
 	Texture* GetDefaultSpecGlossEmissiveTexture()		{ return m_defaultSpecGlossEmissiveTexture; }
+	Texture* GetLoadingPlaceholderTexture()				{ return m_loadingPlaceholderTexture; }
 
 	// Debug methods
 	void CycleBlendMode();
@@ -311,6 +323,8 @@ private:
 
 	Texture* CreateTextureFromFile( const char* filePath );
 	Texture* RetrieveTextureFromCache( const char* filePath );
+	ID3D11Texture2D* CreateTexture2DFromTexels( const unsigned char* rgbaTexels, const IntVec2& dimensions, int numMipLevels = 1 );
+	Texture* GetBindableTexture( Texture* texture, Texture* defaultTexture );
 	
 	void CreateBlendStates();
 
@@ -349,6 +363,8 @@ private:
 
 	// Textures
 	std::vector<Texture*> m_loadedTextures;
+	AsyncTextureLoader* m_asyncTextureLoader		= nullptr;
+	std::vector<TextureAtlas*> m_textureAtlases;
 	std::map<std::string, BitmapFont*> m_loadedBitmapFonts;
 	BitmapFont* m_systemFont						= nullptr;
 	
@@ -377,6 +393,7 @@ private:
 	Texture* m_flatNormalMap						= nullptr;
 	Texture* m_defaultSpecGlossEmissiveTexture		= nullptr;
 	Texture* m_defaultDepthBuffer					= nullptr;
+	Texture* m_loadingPlaceholderTexture			= nullptr;		// Bound in place of textures still being decoded
 
 	// Lighting
 	Vec3 m_ambientLightColor						= Vec3::ONE;
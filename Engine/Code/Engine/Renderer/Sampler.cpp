@@ -42,7 +42,7 @@ Sampler::Sampler( RenderContext* context, eSamplerType type, eSamplerUVMode mode
 	desc.BorderColor[2] = 0.f;
 	desc.BorderColor[3] = 0.f;
 	desc.MinLOD = 0.f;
-	desc.MaxLOD = 0.f;
+	desc.MaxLOD = D3D11_FLOAT32_MAX;		// Only textures with precomputed mip chains have more than one level
 
 	device->CreateSamplerState( &desc, &m_handle );
 }
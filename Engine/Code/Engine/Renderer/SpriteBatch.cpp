@@ -0,0 +1,298 @@
+#include "Engine/Renderer/SpriteBatch.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+#include <algorithm>
+
+
+//-----------------------------------------------------------------------------------------------
+static const int VERTICES_PER_SPRITE = 6;
+static const int MIN_SPRITES_PER_VERTEX_JOB = 256;
+
+// Every live batch, the stats command is registered while there's at least one
+static std::vector<SpriteBatch*> s_spriteBatches;
+
+
+//-----------------------------------------------------------------------------------------------
+SpriteBatch::SpriteBatch( RenderContext* renderer )
+	: m_renderer( renderer )
+{
+	GUARANTEE_OR_DIE( m_renderer != nullptr, "SpriteBatch needs a render context" );
+
+	m_vbo = new VertexBuffer( m_renderer, MEMORY_HINT_DYNAMIC, sizeof( Vertex_PCUTBN ), Vertex_PCUTBN::LAYOUT );
+
+	if ( s_spriteBatches.empty() )
+	{
+		g_eventSystem->RegisterEvent( "sprite_batch_stats", "Print sprite, draw call, and vertex job counts for the last frame of each sprite batch", eUsageLocation::DEV_CONSOLE, PrintSpriteBatchStatsEvent );
+	}
+
+	s_spriteBatches.push_back( this );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+SpriteBatch::~SpriteBatch()
+{
+	s_spriteBatches.erase( std::find( s_spriteBatches.begin(), s_spriteBatches.end(), this ) );
+	if ( s_spriteBatches.empty() )
+	{
+		g_eventSystem->DeRegisterEvent( "sprite_batch_stats", PrintSpriteBatchStatsEvent );
+	}
+
+	PTR_SAFE_DELETE( m_vbo );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::Begin()
+{
+	m_sprites.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::AddSprite( const SpriteBatchSprite& sprite )
+{
+	m_sprites.push_back( sprite );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::AddSprite( const Vec3* corners, const Vec2& uvMins, const Vec2& uvMaxs, const Texture* texture, Material* material, float depth, const Rgba8& tint )
+{
+	m_sprites.emplace_back();
+	SpriteBatchSprite& sprite = m_sprites.back();
+
+	for ( int cornerIdx = 0; cornerIdx < 4; ++cornerIdx )
+	{
+		sprite.corners[cornerIdx] = corners[cornerIdx];
+	}
+
+	sprite.uvMins = uvMins;
+	sprite.uvMaxs = uvMaxs;
+	sprite.tint = tint;
+	sprite.texture = texture;
+	sprite.material = material;
+	sprite.depth = depth;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::End()
+{
+	m_stats.numSprites = (int)m_sprites.size();
+	m_stats.numDrawCalls = 0;
+	m_stats.numVertexJobs = 0;
+	m_stats.maxSprites = Max( m_stats.maxSprites, m_stats.numSprites );
+
+	if ( m_sprites.empty() )
+	{
+		return;
+	}
+
+	SortSprites();
+	BuildRuns();
+	BuildVertices();
+
+	m_vbo->Update( &m_vertices[0], m_vertices.size() * sizeof( Vertex_PCUTBN ), sizeof( Vertex_PCUTBN ) );
+
+	DrawRuns();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Stable so sprites with equal keys keep their submission order and don't flicker between frames.
+// Depth comes first unless state sorting is on, blended sprites have to draw back to front
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::SortSprites()
+{
+	int numSprites = (int)m_sprites.size();
+	m_sortedSpriteIndexes.resize( numSprites );
+	for ( int spriteIdx = 0; spriteIdx < numSprites; ++spriteIdx )
+	{
+		m_sortedSpriteIndexes[spriteIdx] = spriteIdx;
+	}
+
+	const std::vector<SpriteBatchSprite>& sprites = m_sprites;
+	if ( !m_isSortedByState )
+	{
+		std::stable_sort( m_sortedSpriteIndexes.begin(), m_sortedSpriteIndexes.end(), [&sprites]( int spriteIdx, int otherSpriteIdx )
+		{
+			return sprites[spriteIdx].depth > sprites[otherSpriteIdx].depth;
+		} );
+
+		return;
+	}
+
+	std::stable_sort( m_sortedSpriteIndexes.begin(), m_sortedSpriteIndexes.end(), [&sprites]( int spriteIdx, int otherSpriteIdx )
+	{
+		const SpriteBatchSprite& sprite = sprites[spriteIdx];
+		const SpriteBatchSprite& otherSprite = sprites[otherSpriteIdx];
+
+		if ( sprite.material != otherSprite.material )
+		{
+			return sprite.material < otherSprite.material;
+		}
+
+		if ( sprite.texture != otherSprite.texture )
+		{
+			return sprite.texture < otherSprite.texture;
+		}
+
+		return sprite.depth > otherSprite.depth;
+	} );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Only neighbors in sorted order share a run, merging any further would change the draw order
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::BuildRuns()
+{
+	m_runs.clear();
+
+	for ( int sortedIdx = 0; sortedIdx < (int)m_sortedSpriteIndexes.size(); ++sortedIdx )
+	{
+		const SpriteBatchSprite& sprite = m_sprites[m_sortedSpriteIndexes[sortedIdx]];
+
+		if ( m_runs.empty()
+			 || m_runs.back().material != sprite.material
+			 || m_runs.back().texture != sprite.texture )
+		{
+			SpriteBatchRun run;
+			run.material = sprite.material;
+			run.texture = sprite.texture;
+			run.vertexOffset = sortedIdx * VERTICES_PER_SPRITE;
+			m_runs.push_back( run );
+		}
+
+		m_runs.back().numVertices += VERTICES_PER_SPRITE;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::BuildVertices()
+{
+	int numSprites = (int)m_sortedSpriteIndexes.size();
+	m_vertices.resize( numSprites * VERTICES_PER_SPRITE );
+
+	if ( g_jobSystem == nullptr )
+	{
+		m_stats.numVertexJobs = 1;
+		BuildVerticesForRange( 0, numSprites );
+		return;
+	}
+
+	int numChunks = g_jobSystem->GetNumParallelForRanges( numSprites, MIN_SPRITES_PER_VERTEX_JOB );
+	m_stats.numVertexJobs = numChunks;
+
+	g_jobSystem->ParallelFor( numSprites, numChunks, [this]( int chunkIdx, int firstSortedIdx, int endSortedIdx )
+	{
+		UNUSED( chunkIdx );
+		BuildVerticesForRange( firstSortedIdx, endSortedIdx );
+	} );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Same quad layout as AppendVertsForQuad, written into the sprite's slot instead of appended
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::BuildVerticesForRange( int firstSortedIdx, int endSortedIdx )
+{
+	for ( int sortedIdx = firstSortedIdx; sortedIdx < endSortedIdx; ++sortedIdx )
+	{
+		const SpriteBatchSprite& sprite = m_sprites[m_sortedSpriteIndexes[sortedIdx]];
+
+		const Vec3& bottomLeft = sprite.corners[0];
+		const Vec3& bottomRight = sprite.corners[1];
+		const Vec3& topLeft = sprite.corners[2];
+		const Vec3& topRight = sprite.corners[3];
+
+		Vec3 right = bottomRight - bottomLeft;
+		Vec3 up = topLeft - bottomLeft;
+
+		Vec3 normal = CrossProduct3D( right, up ).GetNormalized();
+		Vec3 tangent = right.GetNormalized();
+
+		Vec2 uvBottomRight( sprite.uvMaxs.x, sprite.uvMins.y );
+		Vec2 uvTopLeft( sprite.uvMins.x, sprite.uvMaxs.y );
+
+		Vertex_PCUTBN* vertices = &m_vertices[sortedIdx * VERTICES_PER_SPRITE];
+		vertices[0] = Vertex_PCUTBN( bottomLeft,	sprite.tint, sprite.uvMins,	normal, tangent );
+		vertices[1] = Vertex_PCUTBN( bottomRight,	sprite.tint, uvBottomRight,	normal, tangent );
+		vertices[2] = Vertex_PCUTBN( topRight,		sprite.tint, sprite.uvMaxs,	normal, tangent );
+
+		vertices[3] = Vertex_PCUTBN( bottomLeft,	sprite.tint, sprite.uvMins,	normal, tangent );
+		vertices[4] = Vertex_PCUTBN( topRight,		sprite.tint, sprite.uvMaxs,	normal, tangent );
+		vertices[5] = Vertex_PCUTBN( topLeft,		sprite.tint, uvTopLeft,		normal, tangent );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs without a material draw with the caller's shader and blend mode, which are put back after
+// any run whose material replaced them
+//-----------------------------------------------------------------------------------------------
+void SpriteBatch::DrawRuns()
+{
+	ShaderProgram* callerShaderProgram = m_renderer->GetCurrentShaderProgram();
+	eBlendMode callerBlendMode = m_renderer->GetBlendMode();
+	bool isMaterialBound = false;
+
+	m_renderer->BindVertexBuffer( m_vbo );
+
+	for ( int runIdx = 0; runIdx < (int)m_runs.size(); ++runIdx )
+	{
+		const SpriteBatchRun& run = m_runs[runIdx];
+		if ( run.material != nullptr )
+		{
+			m_renderer->BindMaterial( run.material );
+			isMaterialBound = true;
+		}
+		else
+		{
+			if ( isMaterialBound )
+			{
+				m_renderer->BindShaderProgram( callerShaderProgram );
+				m_renderer->SetBlendMode( callerBlendMode );
+				isMaterialBound = false;
+			}
+
+			// No material for this sprite, just use the diffuse texture
+			m_renderer->BindDiffuseTexture( run.texture );
+			m_renderer->BindNormalTexture( nullptr );
+		}
+
+		m_renderer->Draw( run.numVertices, run.vertexOffset );
+		++m_stats.numDrawCalls;
+	}
+
+	if ( isMaterialBound )
+	{
+		m_renderer->BindShaderProgram( callerShaderProgram );
+		m_renderer->SetBlendMode( callerBlendMode );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool PrintSpriteBatchStatsEvent( EventArgs* args )
+{
+	UNUSED( args );
+
+	for ( int batchIdx = 0; batchIdx < (int)s_spriteBatches.size(); ++batchIdx )
+	{
+		const SpriteBatchStats& stats = s_spriteBatches[batchIdx]->GetStats();
+		g_devConsole->PrintString( Stringf( "Sprite batch %i sprites: %i  draw calls: %i  vertex jobs: %i  max sprites: %i",
+											batchIdx, stats.numSprites, stats.numDrawCalls, stats.numVertexJobs, stats.maxSprites ) );
+	}
+
+	return false;
+}
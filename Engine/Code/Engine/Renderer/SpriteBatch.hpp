@@ -0,0 +1,101 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+class Material;
+class RenderContext;
+class Texture;
+class VertexBuffer;
+
+
+//-----------------------------------------------------------------------------------------------
+struct SpriteBatchSprite
+{
+public:
+	Vec3 corners[4];						// Bottom left, bottom right, top left, top right like AppendVertsForQuad
+	Vec2 uvMins = Vec2::ZERO;
+	Vec2 uvMaxs = Vec2::ONE;
+	Rgba8 tint = Rgba8::WHITE;
+	const Texture* texture = nullptr;
+	Material* material = nullptr;
+	float depth = 0.f;						// Larger depths draw first, equal depths in submission order
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct SpriteBatchRun
+{
+public:
+	const Texture* texture = nullptr;
+	Material* material = nullptr;
+	int vertexOffset = 0;
+	int numVertices = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct SpriteBatchStats
+{
+public:
+	int numSprites = 0;						// Last frame
+	int numDrawCalls = 0;
+	int numVertexJobs = 0;
+	int maxSprites = 0;						// Since startup
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Collects every sprite submitted between Begin and End into one retained vertex buffer.
+// Sprites are drawn back to front, and each sorted sprite owns a fixed slot of 6 vertices so the
+// quads can be built on any number of threads. End issues one draw per run of neighboring
+// sprites with the same material and texture
+//-----------------------------------------------------------------------------------------------
+class SpriteBatch
+{
+public:
+	SpriteBatch( RenderContext* renderer );
+	~SpriteBatch();
+
+	void Begin();
+	void AddSprite( const SpriteBatchSprite& sprite );
+	void AddSprite( const Vec3* corners, const Vec2& uvMins, const Vec2& uvMaxs, const Texture* texture, Material* material, float depth, const Rgba8& tint = Rgba8::WHITE );
+	void End();
+
+	// Sorts by material and texture before depth for fewer draws. Only for sprites that don't
+	// blend, since sprites with different textures no longer draw back to front
+	void SetSortByState( bool isSortedByState )									{ m_isSortedByState = isSortedByState; }
+
+	int GetNumSprites() const													{ return (int)m_sprites.size(); }
+	const SpriteBatchStats& GetStats() const									{ return m_stats; }
+
+private:
+	void SortSprites();
+	void BuildRuns();
+	void BuildVertices();
+	void BuildVerticesForRange( int firstSortedIdx, int endSortedIdx );
+	void DrawRuns();
+
+private:
+	RenderContext* m_renderer = nullptr;
+	VertexBuffer* m_vbo = nullptr;
+
+	std::vector<SpriteBatchSprite> m_sprites;
+	std::vector<int> m_sortedSpriteIndexes;
+	std::vector<Vertex_PCUTBN> m_vertices;
+	std::vector<SpriteBatchRun> m_runs;
+	bool m_isSortedByState = false;
+
+	SpriteBatchStats m_stats;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+bool PrintSpriteBatchStatsEvent( EventArgs* args );
@@ -18,6 +18,9 @@ void SpriteDefinition::GetUVs( Vec2& out_uvAtMins, Vec2& out_uvAtMaxs ) const
 {
 	out_uvAtMins = m_uvAtMins;
 	out_uvAtMaxs = m_uvAtMaxs;
+
+	// Sprite uvs are stored relative to the source image, move them into its region of the atlas
+	GetTexture().RemapUVsToAtlas( out_uvAtMins, out_uvAtMaxs );
 }
 
 
@@ -1,4 +1,5 @@
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Core/StringUtils.hpp"
 #include "Engine/Renderer/D3D11Common.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/TextureView.hpp"
@@ -24,6 +25,15 @@ Texture::Texture( const char* filePath, RenderContext* owner, ID3D11Texture2D* h
 }
 
 
+//-----------------------------------------------------------------------------------------------
+Texture::Texture( const char* filePath, RenderContext* owner, const IntVec2& texelSize )
+	: m_owner( owner )
+	, m_filePath( filePath )
+	, m_texelSize( texelSize )
+{
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Texture::~Texture()
 {
@@ -36,6 +46,58 @@ Texture::~Texture()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+bool Texture::IsLoaded() const
+{
+	if ( m_atlasTexture != nullptr )
+	{
+		return m_atlasTexture->IsLoaded();
+	}
+
+	return m_handle != nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Texture::SetLoadedHandle( ID3D11Texture2D* handle )
+{
+	GUARANTEE_OR_DIE( m_handle == nullptr, Stringf( "Texture '%s' was already loaded", m_filePath.c_str() ) );
+
+	if ( handle == nullptr )
+	{
+		return;
+	}
+
+	m_tex2D = handle;
+
+	D3D11_TEXTURE2D_DESC desc;
+	handle->GetDesc( &desc );
+
+	m_texelSize = IntVec2( desc.Width, desc.Height );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Texture::SetAtlasRegion( Texture* atlasTexture, const AABB2& atlasUVBounds )
+{
+	m_atlasTexture = atlasTexture;
+	m_atlasUVBounds = atlasUVBounds;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Texture::RemapUVsToAtlas( Vec2& inout_uvAtMins, Vec2& inout_uvAtMaxs ) const
+{
+	if ( m_atlasTexture == nullptr )
+	{
+		return;
+	}
+
+	inout_uvAtMins = m_atlasUVBounds.GetPointAtUV( inout_uvAtMins );
+	inout_uvAtMaxs = m_atlasUVBounds.GetPointAtUV( inout_uvAtMaxs );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 TextureView* Texture::GetOrCreateRenderTargetView()
 { 
@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/IntVec2.hpp"
 
 #include <string>
@@ -17,7 +18,18 @@ class Texture
 public:
 	Texture( RenderContext* owner, ID3D11Texture2D* handle ); // constructor we need for swapchain
 	Texture( const char* filePath, RenderContext* owner, ID3D11Texture2D* handle ); 
+	Texture( const char* filePath, RenderContext* owner, const IntVec2& texelSize ); // pending until the async loader uploads it
 	~Texture();
+
+	bool IsLoaded() const;
+	void SetLoadedHandle( ID3D11Texture2D* handle );
+
+	// Textures packed into an atlas bind the atlas in their place, uvs must be remapped into the atlas region
+	bool		IsAtlased() const										{ return m_atlasTexture != nullptr; }
+	Texture*	GetAtlasTexture() const									{ return m_atlasTexture; }
+	AABB2		GetAtlasUVBounds() const								{ return m_atlasUVBounds; }
+	void		SetAtlasRegion( Texture* atlasTexture, const AABB2& atlasUVBounds );
+	void		RemapUVsToAtlas( Vec2& inout_uvAtMins, Vec2& inout_uvAtMaxs ) const;
 	
 	TextureView* GetOrCreateRenderTargetView();
 	TextureView* GetOrCreateShaderResourceView();
@@ -51,4 +63,7 @@ public:
 private:
 	std::string		m_filePath;
 	IntVec2			m_texelSize = IntVec2::ZERO;
+
+	Texture*		m_atlasTexture = nullptr;
+	AABB2			m_atlasUVBounds = AABB2::ONE_BY_ONE;
 };
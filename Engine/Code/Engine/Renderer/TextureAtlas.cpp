@@ -0,0 +1,483 @@
+#include "Engine/Renderer/TextureAtlas.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/AsyncTextureLoader.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/Texture.hpp"
+
+#include "ThirdParty/stb/stb_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+//-----------------------------------------------------------------------------------------------
+// Cache file layout: header, one fixed size entry per source image, then the texel data of every
+// mip level back to back starting at texelDataOffset
+//-----------------------------------------------------------------------------------------------
+static const char TEXTURE_ATLAS_FOURCC[4] = { 'E', 'A', 'T', 'L' };
+static constexpr uint32_t TEXTURE_ATLAS_TEXEL_DATA_ALIGNMENT = 16;
+
+
+//-----------------------------------------------------------------------------------------------
+struct TextureAtlasFileHeader
+{
+	char fourCC[4];
+	uint32_t version = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t numMipLevels = 0;
+	uint32_t numEntries = 0;
+	uint32_t texelDataOffset = 0;
+	uint32_t texelDataSize = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct TextureAtlasFileEntry
+{
+	char sourcePath[TEXTURE_ATLAS_MAX_PATH_LENGTH];
+	int64_t sourceLastWriteTime = 0;
+	int32_t sourceWidth = 0;
+	int32_t sourceHeight = 0;
+	int32_t atlasTexelMinX = 0;
+	int32_t atlasTexelMinY = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static int RoundUpToMultiple( int value, int multiple )
+{
+	return ( ( value + multiple - 1 ) / multiple ) * multiple;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static int RoundUpToPowerOfTwo( int value )
+{
+	int powerOfTwo = 1;
+	while ( powerOfTwo < value )
+	{
+		powerOfTwo <<= 1;
+	}
+
+	return powerOfTwo;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static uint32_t GetTexelDataOffset( uint32_t numEntries )
+{
+	uint32_t tableEnd = (uint32_t)( sizeof( TextureAtlasFileHeader ) + numEntries * sizeof( TextureAtlasFileEntry ) );
+	return (uint32_t)RoundUpToMultiple( (int)tableEnd, (int)TEXTURE_ATLAS_TEXEL_DATA_ALIGNMENT );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static IntVec2 GetSlotDimensions( const IntVec2& sourceDimensions )
+{
+	// Each region sits in a slot aligned to the padding so mip texels only ever blend a region with its own border
+	return IntVec2( RoundUpToMultiple( sourceDimensions.x + 2 * TEXTURE_ATLAS_REGION_PADDING, TEXTURE_ATLAS_REGION_PADDING ),
+					RoundUpToMultiple( sourceDimensions.y + 2 * TEXTURE_ATLAS_REGION_PADDING, TEXTURE_ATLAS_REGION_PADDING ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+TextureAtlas::TextureAtlas( RenderContext* context, const std::string& cacheFilePath )
+	: m_context( context )
+	, m_cacheFilePath( cacheFilePath )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+TextureAtlas::~TextureAtlas()
+{
+	PTR_SAFE_DELETE( m_texture );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TextureAtlas::LoadFromCache( const Strings& sourceImagePaths )
+{
+	MemoryMappedFile cacheFile;
+	if ( !cacheFile.Open( m_cacheFilePath )
+		 || cacheFile.GetSize() < sizeof( TextureAtlasFileHeader ) )
+	{
+		return false;
+	}
+
+	const byte* fileData = cacheFile.GetData();
+	const TextureAtlasFileHeader* header = reinterpret_cast<const TextureAtlasFileHeader*>( fileData );
+	if ( memcmp( header->fourCC, TEXTURE_ATLAS_FOURCC, sizeof( TEXTURE_ATLAS_FOURCC ) ) != 0
+		 || header->version != TEXTURE_ATLAS_FILE_VERSION
+		 || header->numEntries != (uint32_t)sourceImagePaths.size()
+		 || header->texelDataOffset != GetTexelDataOffset( header->numEntries ) )
+	{
+		return false;
+	}
+
+	IntVec2 dimensions( (int)header->width, (int)header->height );
+	int numMipLevels = (int)header->numMipLevels;
+	if ( dimensions.x <= 0 || dimensions.x > TEXTURE_ATLAS_MAX_DIMENSION
+		 || dimensions.y <= 0 || dimensions.y > TEXTURE_ATLAS_MAX_DIMENSION
+		 || numMipLevels != CalculateNumMipLevels( dimensions )
+		 || header->texelDataSize != CalculateMipChainTexelCount( dimensions, numMipLevels ) * sizeof( Rgba8 )
+		 || (size_t)header->texelDataOffset + (size_t)header->texelDataSize > cacheFile.GetSize() )
+	{
+		return false;
+	}
+
+	// Any source that moved, changed or was edited since the build invalidates the whole atlas
+	const TextureAtlasFileEntry* fileEntries = reinterpret_cast<const TextureAtlasFileEntry*>( fileData + sizeof( TextureAtlasFileHeader ) );
+	std::vector<TextureAtlasEntry> entries( header->numEntries );
+	for ( int entryIdx = 0; entryIdx < (int)header->numEntries; ++entryIdx )
+	{
+		const TextureAtlasFileEntry& fileEntry = fileEntries[entryIdx];
+		TextureAtlasEntry& entry = entries[entryIdx];
+
+		entry.sourcePath = std::string( fileEntry.sourcePath, strnlen( fileEntry.sourcePath, TEXTURE_ATLAS_MAX_PATH_LENGTH ) );
+		if ( entry.sourcePath != sourceImagePaths[entryIdx]
+			 || !GetFileLastWriteTime( entry.sourcePath, entry.sourceLastWriteTime )
+			 || entry.sourceLastWriteTime != fileEntry.sourceLastWriteTime )
+		{
+			return false;
+		}
+
+		entry.sourceDimensions = IntVec2( fileEntry.sourceWidth, fileEntry.sourceHeight );
+		entry.atlasTexelMins = IntVec2( fileEntry.atlasTexelMinX, fileEntry.atlasTexelMinY );
+	}
+
+	m_dimensions = dimensions;
+	m_numMipLevels = numMipLevels;
+	m_entries.swap( entries );
+	ComputeEntryUVBounds();
+
+	// Texel data is already in upload order, the mapped pages go straight to the gpu
+	CreateTexture( fileData + header->texelDataOffset );
+
+	return m_texture != nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TextureAtlas::Build( const Strings& sourceImagePaths )
+{
+	m_entries.clear();
+	m_entries.resize( sourceImagePaths.size() );
+
+	std::vector<unsigned char*> sourceTexels( sourceImagePaths.size(), nullptr );
+	std::vector<byte> fileBuffer;
+	bool wasSuccessful = true;
+
+	for ( int entryIdx = 0; entryIdx < (int)sourceImagePaths.size(); ++entryIdx )
+	{
+		TextureAtlasEntry& entry = m_entries[entryIdx];
+		entry.sourcePath = sourceImagePaths[entryIdx];
+
+		if ( entry.sourcePath.size() >= TEXTURE_ATLAS_MAX_PATH_LENGTH )
+		{
+			g_devConsole->PrintError( Stringf( "TextureAtlas: Source path '%s' is too long", entry.sourcePath.c_str() ) );
+			wasSuccessful = false;
+			break;
+		}
+
+		if ( !GetFileLastWriteTime( entry.sourcePath, entry.sourceLastWriteTime )
+			 || !FileReadBinaryToBuffer( entry.sourcePath, fileBuffer ) )
+		{
+			g_devConsole->PrintError( Stringf( "TextureAtlas: Couldn't read source image '%s'", entry.sourcePath.c_str() ) );
+			wasSuccessful = false;
+			break;
+		}
+
+		sourceTexels[entryIdx] = AsyncTextureLoader::DecodeImageFromBuffer( fileBuffer, entry.sourceDimensions );
+		if ( sourceTexels[entryIdx] == nullptr )
+		{
+			g_devConsole->PrintError( Stringf( "TextureAtlas: Couldn't decode source image '%s'", entry.sourcePath.c_str() ) );
+			wasSuccessful = false;
+			break;
+		}
+	}
+
+	if ( wasSuccessful )
+	{
+		wasSuccessful = PackEntries();
+		if ( !wasSuccessful )
+		{
+			g_devConsole->PrintError( Stringf( "TextureAtlas: Sources for '%s' don't fit in a %ix%i atlas", m_cacheFilePath.c_str(), TEXTURE_ATLAS_MAX_DIMENSION, TEXTURE_ATLAS_MAX_DIMENSION ) );
+		}
+	}
+
+	if ( wasSuccessful )
+	{
+		m_numMipLevels = CalculateNumMipLevels( m_dimensions );
+
+		std::vector<Rgba8> atlasTexels;
+		atlasTexels.reserve( CalculateMipChainTexelCount( m_dimensions, m_numMipLevels ) );
+		atlasTexels.resize( (size_t)m_dimensions.x * (size_t)m_dimensions.y );
+
+		for ( int entryIdx = 0; entryIdx < (int)m_entries.size(); ++entryIdx )
+		{
+			CopySourceIntoAtlas( m_entries[entryIdx], reinterpret_cast<const Rgba8*>( sourceTexels[entryIdx] ), atlasTexels );
+		}
+
+		AppendMipChain( atlasTexels );
+		ComputeEntryUVBounds();
+
+		CreateTexture( reinterpret_cast<const byte*>( &atlasTexels[0] ) );
+		wasSuccessful = m_texture != nullptr;
+
+		// A failed write only costs a rebuild next run
+		if ( !WriteCacheFile( atlasTexels ) )
+		{
+			g_devConsole->PrintError( Stringf( "TextureAtlas: Couldn't write cache file '%s'", m_cacheFilePath.c_str() ) );
+		}
+	}
+
+	for ( int entryIdx = 0; entryIdx < (int)sourceTexels.size(); ++entryIdx )
+	{
+		stbi_image_free( sourceTexels[entryIdx] );
+	}
+
+	return wasSuccessful;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+const TextureAtlasEntry* TextureAtlas::GetEntryForSourcePath( const std::string& sourcePath ) const
+{
+	for ( int entryIdx = 0; entryIdx < (int)m_entries.size(); ++entryIdx )
+	{
+		if ( m_entries[entryIdx].sourcePath == sourcePath )
+		{
+			return &m_entries[entryIdx];
+		}
+	}
+
+	return nullptr;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int TextureAtlas::CalculateNumMipLevels( const IntVec2& dimensions )
+{
+	int numMipLevels = 1;
+	int smallestDimension = Min( dimensions.x, dimensions.y );
+	while ( smallestDimension > 1
+			&& numMipLevels < TEXTURE_ATLAS_MAX_MIP_LEVELS )
+	{
+		smallestDimension /= 2;
+		++numMipLevels;
+	}
+
+	return numMipLevels;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+size_t TextureAtlas::CalculateMipChainTexelCount( const IntVec2& dimensions, int numMipLevels )
+{
+	size_t numTexels = 0;
+	IntVec2 mipDimensions = dimensions;
+	for ( int mipIdx = 0; mipIdx < numMipLevels; ++mipIdx )
+	{
+		numTexels += (size_t)mipDimensions.x * (size_t)mipDimensions.y;
+		mipDimensions = IntVec2( Max( mipDimensions.x / 2, 1 ), Max( mipDimensions.y / 2, 1 ) );
+	}
+
+	return numTexels;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TextureAtlas::PackEntries()
+{
+	// Shelf pack tallest first, starting from the narrowest power of two width that could hold everything
+	std::vector<int> packOrder( m_entries.size() );
+	int maxSlotWidth = 0;
+	int64_t totalSlotArea = 0;
+	for ( int entryIdx = 0; entryIdx < (int)m_entries.size(); ++entryIdx )
+	{
+		packOrder[entryIdx] = entryIdx;
+
+		IntVec2 slotDimensions = GetSlotDimensions( m_entries[entryIdx].sourceDimensions );
+		maxSlotWidth = Max( maxSlotWidth, slotDimensions.x );
+		totalSlotArea += (int64_t)slotDimensions.x * (int64_t)slotDimensions.y;
+	}
+
+	std::sort( packOrder.begin(), packOrder.end(), [this]( int a, int b )
+			   {
+				   return m_entries[a].sourceDimensions.y > m_entries[b].sourceDimensions.y;
+			   } );
+
+	int atlasWidth = RoundUpToPowerOfTwo( Max( maxSlotWidth, (int)sqrt( (double)totalSlotArea ) ) );
+	for ( ; atlasWidth <= TEXTURE_ATLAS_MAX_DIMENSION; atlasWidth *= 2 )
+	{
+		int shelfX = 0;
+		int shelfY = 0;
+		int shelfHeight = 0;
+		for ( int orderIdx = 0; orderIdx < (int)packOrder.size(); ++orderIdx )
+		{
+			TextureAtlasEntry& entry = m_entries[packOrder[orderIdx]];
+			IntVec2 slotDimensions = GetSlotDimensions( entry.sourceDimensions );
+
+			if ( shelfX + slotDimensions.x > atlasWidth )
+			{
+				shelfX = 0;
+				shelfY += shelfHeight;
+				shelfHeight = 0;
+			}
+
+			entry.atlasTexelMins = IntVec2( shelfX + TEXTURE_ATLAS_REGION_PADDING, shelfY + TEXTURE_ATLAS_REGION_PADDING );
+
+			shelfX += slotDimensions.x;
+			shelfHeight = Max( shelfHeight, slotDimensions.y );
+		}
+
+		int atlasHeight = RoundUpToPowerOfTwo( shelfY + shelfHeight );
+		if ( atlasHeight <= TEXTURE_ATLAS_MAX_DIMENSION )
+		{
+			m_dimensions = IntVec2( atlasWidth, atlasHeight );
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TextureAtlas::CopySourceIntoAtlas( const TextureAtlasEntry& entry, const Rgba8* sourceTexels, std::vector<Rgba8>& atlasTexels ) const
+{
+	// Fill the whole slot, clamping into the source so edge texels extrude into the padding
+	IntVec2 slotDimensions = GetSlotDimensions( entry.sourceDimensions );
+	IntVec2 slotMins = entry.atlasTexelMins - IntVec2( TEXTURE_ATLAS_REGION_PADDING, TEXTURE_ATLAS_REGION_PADDING );
+
+	for ( int slotY = 0; slotY < slotDimensions.y; ++slotY )
+	{
+		int sourceY = ClampMinMaxInt( slotY - TEXTURE_ATLAS_REGION_PADDING, 0, entry.sourceDimensions.y - 1 );
+		const Rgba8* sourceRow = &sourceTexels[sourceY * entry.sourceDimensions.x];
+		Rgba8* atlasRow = &atlasTexels[( slotMins.y + slotY ) * m_dimensions.x + slotMins.x];
+
+		for ( int slotX = 0; slotX < slotDimensions.x; ++slotX )
+		{
+			int sourceX = ClampMinMaxInt( slotX - TEXTURE_ATLAS_REGION_PADDING, 0, entry.sourceDimensions.x - 1 );
+			atlasRow[slotX] = sourceRow[sourceX];
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TextureAtlas::AppendMipChain( std::vector<Rgba8>& texels ) const
+{
+	size_t sourceMipStart = 0;
+	IntVec2 sourceDimensions = m_dimensions;
+	for ( int mipIdx = 1; mipIdx < m_numMipLevels; ++mipIdx )
+	{
+		IntVec2 mipDimensions( Max( sourceDimensions.x / 2, 1 ), Max( sourceDimensions.y / 2, 1 ) );
+		size_t mipStart = texels.size();
+		texels.resize( mipStart + (size_t)mipDimensions.x * (size_t)mipDimensions.y );
+
+		// 2x2 box filter
+		for ( int mipY = 0; mipY < mipDimensions.y; ++mipY )
+		{
+			int sourceY0 = Min( mipY * 2, sourceDimensions.y - 1 );
+			int sourceY1 = Min( mipY * 2 + 1, sourceDimensions.y - 1 );
+
+			for ( int mipX = 0; mipX < mipDimensions.x; ++mipX )
+			{
+				int sourceX0 = Min( mipX * 2, sourceDimensions.x - 1 );
+				int sourceX1 = Min( mipX * 2 + 1, sourceDimensions.x - 1 );
+
+				const Rgba8& texel00 = texels[sourceMipStart + sourceY0 * sourceDimensions.x + sourceX0];
+				const Rgba8& texel10 = texels[sourceMipStart + sourceY0 * sourceDimensions.x + sourceX1];
+				const Rgba8& texel01 = texels[sourceMipStart + sourceY1 * sourceDimensions.x + sourceX0];
+				const Rgba8& texel11 = texels[sourceMipStart + sourceY1 * sourceDimensions.x + sourceX1];
+
+				Rgba8& mipTexel = texels[mipStart + mipY * mipDimensions.x + mipX];
+				mipTexel.r = (unsigned char)( ( texel00.r + texel10.r + texel01.r + texel11.r + 2 ) / 4 );
+				mipTexel.g = (unsigned char)( ( texel00.g + texel10.g + texel01.g + texel11.g + 2 ) / 4 );
+				mipTexel.b = (unsigned char)( ( texel00.b + texel10.b + texel01.b + texel11.b + 2 ) / 4 );
+				mipTexel.a = (unsigned char)( ( texel00.a + texel10.a + texel01.a + texel11.a + 2 ) / 4 );
+			}
+		}
+
+		sourceMipStart = mipStart;
+		sourceDimensions = mipDimensions;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TextureAtlas::ComputeEntryUVBounds()
+{
+	Vec2 atlasDimensions( (float)m_dimensions.x, (float)m_dimensions.y );
+
+	for ( int entryIdx = 0; entryIdx < (int)m_entries.size(); ++entryIdx )
+	{
+		TextureAtlasEntry& entry = m_entries[entryIdx];
+		IntVec2 atlasTexelMaxs = entry.atlasTexelMins + entry.sourceDimensions;
+
+		entry.uvBounds = AABB2( (float)entry.atlasTexelMins.x / atlasDimensions.x, (float)entry.atlasTexelMins.y / atlasDimensions.y,
+								(float)atlasTexelMaxs.x / atlasDimensions.x, (float)atlasTexelMaxs.y / atlasDimensions.y );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool TextureAtlas::WriteCacheFile( const std::vector<Rgba8>& texels ) const
+{
+	TextureAtlasFileHeader header;
+	memcpy( header.fourCC, TEXTURE_ATLAS_FOURCC, sizeof( TEXTURE_ATLAS_FOURCC ) );
+	header.version = TEXTURE_ATLAS_FILE_VERSION;
+	header.width = (uint32_t)m_dimensions.x;
+	header.height = (uint32_t)m_dimensions.y;
+	header.numMipLevels = (uint32_t)m_numMipLevels;
+	header.numEntries = (uint32_t)m_entries.size();
+	header.texelDataOffset = GetTexelDataOffset( header.numEntries );
+	header.texelDataSize = (uint32_t)( texels.size() * sizeof( Rgba8 ) );
+
+	std::vector<byte> fileBuffer( (size_t)header.texelDataOffset + (size_t)header.texelDataSize, 0 );
+	memcpy( &fileBuffer[0], &header, sizeof( header ) );
+
+	TextureAtlasFileEntry* fileEntries = reinterpret_cast<TextureAtlasFileEntry*>( &fileBuffer[sizeof( header )] );
+	for ( int entryIdx = 0; entryIdx < (int)m_entries.size(); ++entryIdx )
+	{
+		const TextureAtlasEntry& entry = m_entries[entryIdx];
+		TextureAtlasFileEntry fileEntry;
+		memset( fileEntry.sourcePath, 0, sizeof( fileEntry.sourcePath ) );
+		memcpy( fileEntry.sourcePath, entry.sourcePath.c_str(), entry.sourcePath.size() );
+		fileEntry.sourceLastWriteTime = entry.sourceLastWriteTime;
+		fileEntry.sourceWidth = entry.sourceDimensions.x;
+		fileEntry.sourceHeight = entry.sourceDimensions.y;
+		fileEntry.atlasTexelMinX = entry.atlasTexelMins.x;
+		fileEntry.atlasTexelMinY = entry.atlasTexelMins.y;
+
+		memcpy( &fileEntries[entryIdx], &fileEntry, sizeof( fileEntry ) );
+	}
+
+	memcpy( &fileBuffer[header.texelDataOffset], &texels[0], header.texelDataSize );
+
+	return WriteBufferToFile( m_cacheFilePath, &fileBuffer[0], (uint32_t)fileBuffer.size() );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TextureAtlas::CreateTexture( const byte* texelData )
+{
+	PTR_SAFE_DELETE( m_texture );
+
+	ID3D11Texture2D* texHandle = m_context->CreateTexture2DFromTexels( texelData, m_dimensions, m_numMipLevels );
+	if ( texHandle == nullptr )
+	{
+		g_devConsole->PrintError( Stringf( "TextureAtlas: Couldn't create texture for '%s'", m_cacheFilePath.c_str() ) );
+		return;
+	}
+
+	m_texture = new Texture( m_cacheFilePath.c_str(), m_context, texHandle );
+}
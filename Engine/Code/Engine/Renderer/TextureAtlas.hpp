@@ -0,0 +1,76 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+class RenderContext;
+class Texture;
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr uint32_t TEXTURE_ATLAS_FILE_VERSION = 1;
+constexpr int TEXTURE_ATLAS_MAX_DIMENSION = 4096;
+constexpr int TEXTURE_ATLAS_MAX_MIP_LEVELS = 5;
+constexpr int TEXTURE_ATLAS_REGION_PADDING = 1 << ( TEXTURE_ATLAS_MAX_MIP_LEVELS - 1 );	// Regions never share a texel at the smallest mip
+constexpr int TEXTURE_ATLAS_MAX_PATH_LENGTH = 256;
+
+
+//-----------------------------------------------------------------------------------------------
+struct TextureAtlasEntry
+{
+public:
+	std::string sourcePath;
+	int64_t sourceLastWriteTime = 0;
+	IntVec2 sourceDimensions = IntVec2::ZERO;
+	IntVec2 atlasTexelMins = IntVec2::ZERO;
+	AABB2 uvBounds = AABB2::ONE_BY_ONE;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Packs a set of source images into one texture with a precomputed mip chain. The result is
+// cached in a binary file with fixed size records and texel data stored exactly as it is
+// uploaded, so later runs memory map the file and hand it straight to the gpu
+//-----------------------------------------------------------------------------------------------
+class TextureAtlas
+{
+public:
+	TextureAtlas( RenderContext* context, const std::string& cacheFilePath );
+	~TextureAtlas();
+
+	bool LoadFromCache( const Strings& sourceImagePaths );			// Fails if the cache is missing or out of date with any source
+	bool Build( const Strings& sourceImagePaths );					// Packs the sources and rewrites the cache
+
+	Texture*								GetTexture() const						{ return m_texture; }
+	const std::string&						GetCacheFilePath() const				{ return m_cacheFilePath; }
+	IntVec2									GetDimensions() const					{ return m_dimensions; }
+	int										GetNumMipLevels() const					{ return m_numMipLevels; }
+	const std::vector<TextureAtlasEntry>&	GetEntries() const						{ return m_entries; }
+	const TextureAtlasEntry*				GetEntryForSourcePath( const std::string& sourcePath ) const;
+
+	static int CalculateNumMipLevels( const IntVec2& dimensions );
+	static size_t CalculateMipChainTexelCount( const IntVec2& dimensions, int numMipLevels );
+
+private:
+	bool PackEntries();
+	void CopySourceIntoAtlas( const TextureAtlasEntry& entry, const Rgba8* sourceTexels, std::vector<Rgba8>& atlasTexels ) const;
+	void AppendMipChain( std::vector<Rgba8>& texels ) const;
+	void ComputeEntryUVBounds();
+	bool WriteCacheFile( const std::vector<Rgba8>& texels ) const;
+	void CreateTexture( const byte* texelData );
+
+private:
+	RenderContext* m_context = nullptr;
+	std::string m_cacheFilePath;
+
+	Texture* m_texture = nullptr;
+	IntVec2 m_dimensions = IntVec2::ZERO;
+	int m_numMipLevels = 0;
+	std::vector<TextureAtlasEntry> m_entries;
+};
@@ -74,6 +74,15 @@ void Clock::Update( double deltaSeconds )
 		deltaSeconds += ( after - before );
 	}
 
+	AdvanceTime( deltaSeconds );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Clock::AdvanceTime( double deltaSeconds )
+{
+	m_unscaledDeltaTimeSeconds = deltaSeconds;
+
 	if ( m_isPaused )
 	{
 		deltaSeconds = 0.0;
@@ -158,6 +167,13 @@ void Clock::MasterBeginFrame()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void Clock::MasterBeginFrame( double deltaSeconds )
+{
+	s_masterClock->AdvanceTime( deltaSeconds );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 Clock* Clock::GetMaster()
 {
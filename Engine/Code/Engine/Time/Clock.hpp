@@ -22,6 +22,7 @@ public:
 	// Accessors
 	double GetTotalElapsedSeconds() const							{ return m_totalElapsedSeconds; }
 	double GetLastDeltaSeconds() const								{ return m_deltaTimeSeconds; }
+	double GetLastUnscaledDeltaSeconds() const						{ return m_unscaledDeltaTimeSeconds; }	// after frame limits, before pause and scale
 
 	double GetScale() const											{ return m_timeScale; }
 	bool IsPaused() const											{ return m_isPaused; }
@@ -30,6 +31,7 @@ public:
 	static void MasterStartup();  // create/reset master clock
 	static void MasterShutdown();
 	static void MasterBeginFrame();     // advance master clock (which immediately propagates to children)
+	static void MasterBeginFrame( double deltaSeconds );	// advance master clock by a set time without waiting on frame limits, for replays
 
 	static Clock* GetMaster();
 
@@ -39,11 +41,15 @@ public:
 	void AddChild( Clock* clock );
 	void RemoveChild( Clock* clock );
 
+private:
+	void AdvanceTime( double deltaSeconds );
+
 private:
 	//static Clock* s_masterClock;
 
 	double m_totalElapsedSeconds = 0.0;
 	double m_deltaTimeSeconds = 0.0;
+	double m_unscaledDeltaTimeSeconds = 0.0;
 	double m_minFrameTime = 0.0;
 	double m_maxFrameTime = 0.1;
 
@@ -130,25 +130,18 @@ void UIButton::Update()
 
 
 //-----------------------------------------------------------------------------------------------
-void UIButton::Render() const
+void UIButton::AddToRenderBatches() const
 {
 	if ( !m_isVisible )
 	{
 		return;
 	}
 
-	if ( m_backgroundTexture != nullptr )
-	{
-		std::vector<Vertex_PCU> vertices;
-		AppendVertsForAABB2D( vertices, m_boundingBox, m_curTint, m_uvsAtMins, m_uvsAtMaxs );
-
-		m_uiSystem.m_renderer->BindTexture( 0, m_backgroundTexture );
-		m_uiSystem.m_renderer->DrawVertexArray( vertices );
-	}
+	AddBackgroundToRenderBatches();
 
 	for ( int labelIdx = 0; labelIdx < (int)m_labels.size(); ++labelIdx )
 	{
-		m_labels[labelIdx]->Render();
+		m_labels[labelIdx]->AddToRenderBatches();
 	}
 }
 
@@ -25,7 +25,7 @@ public:
 	virtual ~UIButton();
 
 	virtual void Update() override;
-	virtual void Render() const override;
+	virtual void AddToRenderBatches() const override;
 	virtual void DebugRender() const override;
 
 	Vec2 GetPosition() const;
@@ -28,6 +28,8 @@ UIElement::UIElement( UISystem& uiSystem, const std::string& name )
 	{
 		uiSystem.RegisterUIElementName( name, m_id );
 	}
+
+	uiSystem.MarkRenderBatchesDirty();
 }
 
 
@@ -35,6 +37,30 @@ UIElement::UIElement( UISystem& uiSystem, const std::string& name )
 UIElement::~UIElement()
 {
 	PTR_SAFE_DELETE( m_userData );
+
+	m_uiSystem.MarkRenderBatchesDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UIElement::Hide()
+{
+	if ( m_isVisible )
+	{
+		m_isVisible = false;
+		m_uiSystem.MarkRenderBatchesDirty();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UIElement::Show()
+{
+	if ( !m_isVisible )
+	{
+		m_isVisible = true;
+		m_uiSystem.MarkRenderBatchesDirty();
+	}
 }
 
 
@@ -51,10 +77,28 @@ void UIElement::DebugRender() const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void UIElement::SetBackgroundTexture( Texture* backgroundTexture )
+{
+	m_backgroundTexture = backgroundTexture;
+
+	MarkVertexDataDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UIElement::SetInitialTint( const Rgba8& tint )
+{
+	m_initialTint = tint;
+
+	SetCurrentTint( tint );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void UIElement::SetButtonAndLabelTint( const Rgba8& tint )
 {
-	m_curTint = tint;
+	SetCurrentTint( tint );
 
 	for ( int labelIdx = 0; labelIdx < (int)m_labels.size(); ++labelIdx )
 	{
@@ -75,6 +119,53 @@ void UIElement::SetBoundingBoxPercent( const Vec2& percentOfDimensions )
 {
 	m_boundingBox.maxs.x = m_boundingBox.mins.x + m_initialBoundingBox.GetWidth() * percentOfDimensions.x;
 	m_boundingBox.maxs.y = m_boundingBox.mins.y + m_initialBoundingBox.GetHeight() * percentOfDimensions.y;
+
+	MarkVertexDataDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UIElement::MarkVertexDataDirty()
+{
+	m_isVertexDataDirty = true;
+
+	m_uiSystem.MarkRenderBatchesDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UIElement::SetCurrentTint( const Rgba8& tint )
+{
+	// Hover tints are reapplied every frame, don't rebuild unless the color actually changes
+	if ( m_curTint == tint )
+	{
+		return;
+	}
+
+	m_curTint = tint;
+
+	MarkVertexDataDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UIElement::AddBackgroundToRenderBatches() const
+{
+	if ( m_backgroundTexture == nullptr )
+	{
+		return;
+	}
+
+	if ( m_isVertexDataDirty )
+	{
+		m_vertices.clear();
+		AppendVertsForAABB2D( m_vertices, m_boundingBox, m_curTint, m_uvsAtMins, m_uvsAtMaxs );
+
+		m_isVertexDataDirty = false;
+		++m_uiSystem.m_renderStats.numVertexRebuilds;
+	}
+
+	m_uiSystem.AddToRenderBatch( m_vertices, m_boundingBox, m_backgroundTexture );
 }
 
 
@@ -1,8 +1,11 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Math/AABB2.hpp"
 
+#include <vector>
+
 
 //-----------------------------------------------------------------------------------------------
 struct UIAlignedPositionData;
@@ -25,23 +28,23 @@ public:
 	virtual ~UIElement();
 
 	virtual void Update() = 0;
-	virtual void Render() const = 0;
+	virtual void AddToRenderBatches() const = 0;
 	virtual void DebugRender() const = 0;
 
 	virtual void Activate()										{ m_isActive = true; }
 	virtual void Deactivate()									{ m_isActive = false; }
-	virtual void Hide()											{ m_isVisible = false; }
-	virtual void Show()											{ m_isVisible = true; }
+	virtual void Hide();
+	virtual void Show();
 	bool		 IsVisible() const								{ return m_isVisible; }
 	bool		 IsActive() const								{ return m_isActive; }
 
 	int GetId() const											{ return m_id; }
 	std::string GetName() const									{ return m_name; }
-	void SetBackgroundTexture( Texture* backgroundTexture )		{ m_backgroundTexture = backgroundTexture; }
-	void SetInitialTint( const Rgba8& tint )					{ m_initialTint = m_curTint = tint; }
+	void SetBackgroundTexture( Texture* backgroundTexture );
+	void SetInitialTint( const Rgba8& tint );
 	void SetHoverTint( const Rgba8& tint )						{ m_hoverTint = tint; }
-	void ResetTint()											{ m_curTint = m_initialTint; }
-	void ActivateHoverTint()									{ m_curTint = m_hoverTint; }
+	void ResetTint()											{ SetCurrentTint( m_initialTint ); }
+	void ActivateHoverTint()									{ SetCurrentTint( m_hoverTint ); }
 	void SetButtonAndLabelTint( const Rgba8& tint );
 	AABB2 GetBoundingBox() const								{ return m_boundingBox; }
 	Vec2 GetBoundingBoxCenter() const;
@@ -104,6 +107,10 @@ public:
 protected:
 	UIElement( UISystem& uiSystem, const std::string& name = "" );
 
+	void MarkVertexDataDirty();
+	void SetCurrentTint( const Rgba8& tint );
+	void AddBackgroundToRenderBatches() const;
+
 protected:
 	UISystem& m_uiSystem;
 
@@ -125,6 +132,10 @@ protected:
 
 	std::vector<UILabel*> m_labels;
 
+	// Vertices are kept between frames and only rebuilt when something that affects them changes
+	mutable std::vector<Vertex_PCU> m_vertices;
+	mutable bool m_isVertexDataDirty = true;
+
 private:
 	static int s_nextId;
 };
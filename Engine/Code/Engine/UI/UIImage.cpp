@@ -51,14 +51,21 @@ UIImage::UIImage( UISystem& uiSystem, const UIElement& parentElement, const UIRe
 
 
 //-----------------------------------------------------------------------------------------------
-void UIImage::Render() const
+void UIImage::AddToRenderBatches() const
 {
-	if ( m_image != nullptr )
+	if ( m_image == nullptr )
 	{
-		std::vector<Vertex_PCU> vertices;
-		AppendVertsForAABB2D( vertices, m_boundingBox, m_initialTint, m_uvAtMins, m_uvAtMaxs );
+		return;
+	}
 
-		m_uiSystem.m_renderer->BindTexture( 0, m_image );
-		m_uiSystem.m_renderer->DrawVertexArray( vertices );
+	if ( m_isVertexDataDirty )
+	{
+		m_vertices.clear();
+		AppendVertsForAABB2D( m_vertices, m_boundingBox, m_initialTint, m_uvAtMins, m_uvAtMaxs );
+
+		m_isVertexDataDirty = false;
+		++m_uiSystem.m_renderStats.numVertexRebuilds;
 	}
+
+	m_uiSystem.AddToRenderBatch( m_vertices, m_boundingBox, m_image );
 }
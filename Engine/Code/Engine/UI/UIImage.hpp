@@ -14,7 +14,7 @@ class UIImage : public UILabel
 	friend class UIElement;
 
 public:	
-	virtual void Render() const override;
+	virtual void AddToRenderBatches() const override;
 
 private:
 	UIImage( UISystem& uiSystem, const UIElement& parentElement, const UIAlignedPositionData& positionData, Texture* image = nullptr, const std::string& name = "" );
@@ -27,3 +27,17 @@ void UILabel::DebugRender() const
 	m_uiSystem.m_renderer->BindTexture( 0, nullptr );
 	DrawAABB2Outline( m_uiSystem.m_renderer, m_boundingBox, Rgba8::GREEN, UI_DEBUG_LINE_THICKNESS );
 }
+
+
+//-----------------------------------------------------------------------------------------------
+void UILabel::SetTint( const Rgba8& tint )
+{
+	if ( m_initialTint == tint )
+	{
+		return;
+	}
+
+	m_initialTint = tint;
+
+	MarkVertexDataDirty();
+}
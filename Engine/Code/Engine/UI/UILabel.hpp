@@ -18,11 +18,11 @@ public:
 	virtual ~UILabel() {}
 
 	virtual void Update(){}
-	virtual void Render() const = 0;
+	virtual void AddToRenderBatches() const = 0;
 	virtual void DebugRender() const;
 
 	virtual AABB2 GetBounds() const											{ return m_boundingBox; }
-	virtual void SetTint( const Rgba8& tint )								{ m_initialTint = tint; }
+	virtual void SetTint( const Rgba8& tint );
 
 protected:
 	UILabel( const std::string& name, UISystem& uiSystem, const UIElement& parentElement, const UIAlignedPositionData& positionData );
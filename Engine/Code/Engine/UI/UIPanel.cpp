@@ -108,35 +108,28 @@ void UIPanel::Update()
 
 
 //-----------------------------------------------------------------------------------------------
-void UIPanel::Render() const
+void UIPanel::AddToRenderBatches() const
 {
 	if ( !m_isVisible )
 	{
 		return;
 	}
 
-	if ( m_backgroundTexture != nullptr )
-	{
-		std::vector<Vertex_PCU> vertices;
-		AppendVertsForAABB2D( vertices, m_boundingBox, m_curTint, m_uvsAtMins, m_uvsAtMaxs );
-
-		m_uiSystem.m_renderer->BindTexture( 0, m_backgroundTexture );
-		m_uiSystem.m_renderer->DrawVertexArray( vertices );
-	}
+	AddBackgroundToRenderBatches();
 
 	for ( int labelIdx = 0; labelIdx < (int)m_labels.size(); ++labelIdx )
 	{
-		m_labels[labelIdx]->Render();
+		m_labels[labelIdx]->AddToRenderBatches();
 	}
 
 	for ( int buttonIdx = 0; buttonIdx < (int)m_buttons.size(); ++buttonIdx )
 	{
-		m_buttons[buttonIdx]->Render();
+		m_buttons[buttonIdx]->AddToRenderBatches();
 	}
 
 	for ( int panelIdx = 0; panelIdx < (int)m_childPanels.size(); ++panelIdx )
 	{
-		m_childPanels[panelIdx]->Render();
+		m_childPanels[panelIdx]->AddToRenderBatches();
 	}
 }
 
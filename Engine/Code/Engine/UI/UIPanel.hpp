@@ -25,7 +25,7 @@ public:
 	virtual ~UIPanel();
 
 	virtual void Update() override;
-	virtual void Render() const override;
+	virtual void AddToRenderBatches() const override;
 	virtual void DebugRender() const override;
 
 	virtual UIPanel* AddChildPanel( const UIAlignedPositionData& positionData,
@@ -1,10 +1,15 @@
 #include "Engine/UI/UISystem.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/OS/Window.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/UI/UIPanel.hpp"
 #include "Engine/UI/UIButton.hpp"
 #include "Engine/UI/UIUniformGrid.hpp"
@@ -30,6 +35,9 @@ void UISystem::Startup( Window* window, RenderContext* renderer, BitmapFont* fon
 	}
 		
 	m_rootPanel = new UIPanel( *this, AABB2( Vec2::ZERO, m_windowDimensions ) );
+	m_batchedVBO = new VertexBuffer( m_renderer, MEMORY_HINT_DYNAMIC, sizeof( Vertex_PCU ), Vertex_PCU::LAYOUT );
+
+	g_eventSystem->RegisterMethodEvent( "ui_render_stats", "Print draw call, batch, and vertex rebuild counts for the ui", eUsageLocation::DEV_CONSOLE, this, &UISystem::PrintRenderStats );
 }
 
 
@@ -41,6 +49,7 @@ void UISystem::Startup( const Vec2& windowDimensions, RenderContext* renderer )
 	m_uiFont = m_renderer->GetSystemFont();
 
 	m_rootPanel = new UIPanel( *this, AABB2( Vec2::ZERO, m_windowDimensions ) );
+	m_batchedVBO = new VertexBuffer( m_renderer, MEMORY_HINT_DYNAMIC, sizeof( Vertex_PCU ), Vertex_PCU::LAYOUT );
 }
 
 
@@ -54,7 +63,46 @@ void UISystem::Update()
 //-----------------------------------------------------------------------------------------------
 void UISystem::Render()
 {
-	m_rootPanel->Render();
+	if ( m_areRenderBatchesDirty )
+	{
+		RebuildRenderBatches();
+	}
+
+	m_renderStats.numDrawCalls = 0;
+	if ( m_batchedVertices.empty() )
+	{
+		return;
+	}
+
+	m_renderer->BindVertexBuffer( m_batchedVBO );
+
+	Material* boundMaterial = nullptr;
+	for ( int batchIdx = 0; batchIdx < (int)m_renderBatches.size(); ++batchIdx )
+	{
+		const UIRenderBatch& batch = m_renderBatches[batchIdx];
+		if ( batch.material != boundMaterial )
+		{
+			if ( batch.material != nullptr )
+			{
+				m_renderer->BindMaterial( batch.material );
+			}
+			else
+			{
+				m_renderer->BindShader( nullptr );
+			}
+
+			boundMaterial = batch.material;
+		}
+
+		m_renderer->BindTexture( 0, batch.texture );
+		m_renderer->Draw( (int)batch.vertices.size(), batch.vertexOffset );
+		++m_renderStats.numDrawCalls;
+	}
+
+	if ( boundMaterial != nullptr )
+	{
+		m_renderer->BindShader( nullptr );
+	}
 }
 
 
@@ -68,7 +116,10 @@ void UISystem::DebugRender()
 //-----------------------------------------------------------------------------------------------
 void UISystem::Shutdown()
 {
+	g_eventSystem->DeRegisterObject( this );
+
 	PTR_SAFE_DELETE( m_rootPanel );
+	PTR_SAFE_DELETE( m_batchedVBO );
 }
 
 
@@ -228,8 +279,112 @@ void UISystem::SetFont( BitmapFont* font, Material* material )
 
 	m_uiFont = font;
 	m_uiFontMaterial = material;
+
+	MarkAllVertexDataDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UISystem::MarkAllVertexDataDirty()
+{
+	for ( auto elemIter = m_elementsById.begin(); elemIter != m_elementsById.end(); ++elemIter )
+	{
+		elemIter->second->m_isVertexDataDirty = true;
+	}
+
+	MarkRenderBatchesDirty();
 }
 
+
+//-----------------------------------------------------------------------------------------------
+void UISystem::AddToRenderBatch( const std::vector<Vertex_PCU>& vertices, const AABB2& bounds, const Texture* texture, Material* material )
+{
+	if ( vertices.empty() )
+	{
+		return;
+	}
+
+	++m_renderStats.numElementsBatched;
+
+	// Sprites packed into an atlas can share a batch with anything else drawn from that atlas
+	if ( texture != nullptr
+		 && texture->IsAtlased() )
+	{
+		texture = texture->GetAtlasTexture();
+	}
+
+	// Elements are added in draw order, so walk back through the batches and join the latest one with
+	// the same state, stopping at the first batch that overlaps since anything drawn under it must stay there
+	for ( int batchIdx = (int)m_renderBatches.size() - 1; batchIdx >= 0; --batchIdx )
+	{
+		UIRenderBatch& batch = m_renderBatches[batchIdx];
+		if ( batch.texture == texture
+			 && batch.material == material )
+		{
+			batch.vertices.insert( batch.vertices.end(), vertices.begin(), vertices.end() );
+			batch.bounds.StretchToIncludePoint( bounds.mins );
+			batch.bounds.StretchToIncludePoint( bounds.maxs );
+			return;
+		}
+
+		if ( DoAABBsOverlap2D( batch.bounds, bounds ) )
+		{
+			break;
+		}
+	}
+
+	UIRenderBatch newBatch;
+	newBatch.texture = texture;
+	newBatch.material = material;
+	newBatch.bounds = bounds;
+	newBatch.vertices = vertices;
+	m_renderBatches.push_back( newBatch );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UISystem::RebuildRenderBatches()
+{
+	m_renderBatches.clear();
+	m_renderStats.numElementsBatched = 0;
+	m_renderStats.numVertexRebuilds = 0;
+
+	m_rootPanel->AddToRenderBatches();
+
+	// Flatten all batches into one buffer that stays on the gpu until something changes
+	m_batchedVertices.clear();
+	for ( int batchIdx = 0; batchIdx < (int)m_renderBatches.size(); ++batchIdx )
+	{
+		UIRenderBatch& batch = m_renderBatches[batchIdx];
+		batch.vertexOffset = (int)m_batchedVertices.size();
+		m_batchedVertices.insert( m_batchedVertices.end(), batch.vertices.begin(), batch.vertices.end() );
+	}
+
+	if ( !m_batchedVertices.empty() )
+	{
+		m_batchedVBO->Update( &m_batchedVertices[0], m_batchedVertices.size() * sizeof( Vertex_PCU ), sizeof( Vertex_PCU ) );
+	}
+
+	m_renderStats.numBatches = (int)m_renderBatches.size();
+	m_renderStats.numVertices = (int)m_batchedVertices.size();
+	++m_renderStats.numBatchRebuilds;
+
+	m_areRenderBatchesDirty = false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UISystem::PrintRenderStats( EventArgs* args )
+{
+	UNUSED( args );
+
+	g_devConsole->PrintString( Stringf( "UI draw calls: %i  batches: %i  elements: %i  vertices: %i",
+										m_renderStats.numDrawCalls, m_renderStats.numBatches, m_renderStats.numElementsBatched, m_renderStats.numVertices ) );
+	g_devConsole->PrintString( Stringf( "UI vertex rebuilds on last batch rebuild: %i  batch rebuilds since startup: %i",
+										m_renderStats.numVertexRebuilds, m_renderStats.numBatchRebuilds ) );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void UISystem::ParseUIElementXml( const XmlElement& uiElementElem, UIElement* parentElem )
 {
@@ -1,17 +1,22 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/XMLUtils.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Vec2.hpp"
 
+#include <vector>
+
 
 //-----------------------------------------------------------------------------------------------
 class BitmapFont;
 class Material;
 class InputSystem;
 class RenderContext;
+class Texture;
 class UIPanel;
 class UIElement;
+class VertexBuffer;
 class Window;
 
 
@@ -45,6 +50,33 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------------------------
+struct UIRenderStats
+{
+public:
+	int numDrawCalls = 0;				// Last frame
+	int numBatches = 0;					// Since the batches were last rebuilt
+	int numElementsBatched = 0;
+	int numVertices = 0;
+	int numVertexRebuilds = 0;
+	int numBatchRebuilds = 0;			// Since startup
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// A run of ui vertices that share a texture and material and can be drawn with one call
+//-----------------------------------------------------------------------------------------------
+struct UIRenderBatch
+{
+public:
+	const Texture* texture = nullptr;
+	Material* material = nullptr;
+	AABB2 bounds;
+	std::vector<Vertex_PCU> vertices;
+	int vertexOffset = 0;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class UISystem
 {
@@ -76,6 +108,8 @@ public:
 
 	void SetFont( BitmapFont* font, Material* material = nullptr );
 
+	const UIRenderStats& GetRenderStats() const								{ return m_renderStats; }
+
 private:
 	AABB2 GetBoundingBoxFromParentAndPositionData( const AABB2& parentBoundingBox, const UIAlignedPositionData& positionData ) const;
 	AABB2 GetBoundingBoxFromParentAndPositionData( const AABB2& parentBoundingBox, const UIRelativePositionData& positionData ) const;
@@ -89,6 +123,15 @@ private:
 	BitmapFont* GetFont() const												{ return m_uiFont; }
 	Material* GetFontMaterial() const										{ return m_uiFontMaterial; }
 
+	// Retained rendering
+	void MarkRenderBatchesDirty()											{ m_areRenderBatchesDirty = true; }
+	void MarkAllVertexDataDirty();
+	void AddToRenderBatch( const std::vector<Vertex_PCU>& vertices, const AABB2& bounds, const Texture* texture, Material* material = nullptr );
+	void RebuildRenderBatches();
+
+	// Console commands
+	void PrintRenderStats( EventArgs* args );
+
 	// XML helpers
 	void ParseUIElementXml( const XmlElement& uiElementElem, UIElement* parentElem );
 	UIAlignedPositionData ParseAlignedPositionData( const XmlElement& positionDataElem );
@@ -106,4 +149,10 @@ private:
 
 	std::map<std::string, uint> m_elementNameToId;
 	std::map<uint, UIElement*> m_elementsById;
+
+	bool						m_areRenderBatchesDirty = true;
+	std::vector<UIRenderBatch>	m_renderBatches;
+	std::vector<Vertex_PCU>		m_batchedVertices;
+	VertexBuffer*				m_batchedVBO = nullptr;
+	UIRenderStats				m_renderStats;
 };
@@ -30,22 +30,36 @@ UIText::UIText( UISystem& uiSystem, const UIElement& parentElement, const UIRela
 
 
 //-----------------------------------------------------------------------------------------------
-void UIText::Render() const
+void UIText::SetText( const std::string& text )
 {
-	if ( !m_text.empty() )
+	if ( m_text == text )
 	{
-		std::vector<Vertex_PCU> vertices;
-		BitmapFont* font = m_uiSystem.GetFont();
-		Material* fontMaterial = m_uiSystem.GetFontMaterial();
-		font->AppendVertsForTextInBox2D( vertices, m_boundingBox, m_fontSize, m_text, m_initialTint, 1.f, m_textAlignment );
-
-		if ( fontMaterial != nullptr )
-		{
-			m_uiSystem.m_renderer->BindMaterial( fontMaterial );
-		}
-		m_uiSystem.m_renderer->BindTexture( 0, font->GetTexture() );
-		m_uiSystem.m_renderer->DrawVertexArray( vertices );
+		return;
 	}
 
-	m_uiSystem.m_renderer->BindShader( nullptr );
+	m_text = text;
+
+	MarkVertexDataDirty();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void UIText::AddToRenderBatches() const
+{
+	if ( m_text.empty() )
+	{
+		return;
+	}
+
+	BitmapFont* font = m_uiSystem.GetFont();
+	if ( m_isVertexDataDirty )
+	{
+		m_vertices.clear();
+		font->AppendVertsForTextInBox2D( m_vertices, m_boundingBox, m_fontSize, m_text, m_initialTint, 1.f, m_textAlignment );
+
+		m_isVertexDataDirty = false;
+		++m_uiSystem.m_renderStats.numVertexRebuilds;
+	}
+
+	m_uiSystem.AddToRenderBatch( m_vertices, m_boundingBox, font->GetTexture(), m_uiSystem.GetFontMaterial() );
 }
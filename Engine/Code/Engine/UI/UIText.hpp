@@ -13,9 +13,9 @@ class UIText : public UILabel
 	friend class UIElement;
 
 public:
-	virtual void Render() const override;
+	virtual void AddToRenderBatches() const override;
 
-	void SetText( const std::string& text )									{ m_text = text; }
+	void SetText( const std::string& text );
 
 private:
 	UIText( UISystem& uiSystem, const UIElement& parentElement, const UIAlignedPositionData& positionData, const std::string& text, float fontSize = 24.f, const Vec2& textAlignment = ALIGN_CENTERED, const std::string& name = "" );
@@ -69,7 +69,7 @@ void UIUniformGrid::Update()
 
 
 //-----------------------------------------------------------------------------------------------
-void UIUniformGrid::Render() const
+void UIUniformGrid::AddToRenderBatches() const
 {
 	if ( !IsVisible() )
 	{
@@ -78,7 +78,7 @@ void UIUniformGrid::Render() const
 
 	for ( int elemIdx = 0; elemIdx < (int)m_gridElements.size(); ++elemIdx )
 	{
-		m_gridElements[elemIdx]->Render();
+		m_gridElements[elemIdx]->AddToRenderBatches();
 	}
 }
 
@@ -22,7 +22,7 @@ public:
 	virtual ~UIUniformGrid();
 
 	virtual void Update() override;
-	virtual void Render() const override;
+	virtual void AddToRenderBatches() const override;
 	virtual void DebugRender() const override;
 
 	std::vector<UIElement*> GetGridElements() const											{ return m_gridElements; }
@@ -170,6 +170,7 @@ std::string ToString( eOpCode opCode )
 		case eOpCode::LESS:						return "LESS";
 		case eOpCode::LESS_EQUAL:				return "LESS_EQUAL";
 		case eOpCode::FUNCTION_CALL:			return "FUNCTION_CALL";
+		case eOpCode::NATIVE_FUNCTION_CALL:		return "NATIVE_FUNCTION_CALL";
 		case eOpCode::CHANGE_STATE:				return "CHANGE_STATE";
 		case eOpCode::RETURN:					return "RETURN";
 		case eOpCode::IF:						return "IF";
@@ -138,6 +138,7 @@ enum class eOpCode : byte
 	LESS_EQUAL,
 
 	FUNCTION_CALL,
+	NATIVE_FUNCTION_CALL,
 	CHANGE_STATE,
 
 	RETURN,
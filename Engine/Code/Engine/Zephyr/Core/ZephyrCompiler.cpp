@@ -17,6 +17,13 @@ ZephyrScriptDefinition* ZephyrCompiler::CompileScriptFile( const std::string& fi
 {
 	std::string scriptSource( (char*)FileReadToNewBuffer( filePath ) );
 
+	return CompileScriptSource( scriptSource, GetFileName( filePath ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+ZephyrScriptDefinition* ZephyrCompiler::CompileScriptSource( const std::string& scriptSource, const std::string& scriptName )
+{
 	ZephyrScanner scanner( scriptSource );
 	std::vector<ZephyrToken> tokens = scanner.ScanSourceIntoTokens();
 
@@ -25,7 +32,7 @@ ZephyrScriptDefinition* ZephyrCompiler::CompileScriptFile( const std::string& fi
 	//	g_devConsole->PrintString( Stringf( "%s line: %i - %s", tokens[tokenIdx].GetDebugName().c_str(), tokens[tokenIdx].GetLineNum(), tokens[tokenIdx].GetData().c_str() ) );
 	//}
 
-	ZephyrParser parser( GetFileName( filePath ), tokens );
+	ZephyrParser parser( scriptName, tokens );
 	return parser.ParseTokensIntoScriptDefinition();
 }
 
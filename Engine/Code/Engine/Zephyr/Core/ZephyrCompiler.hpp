@@ -11,4 +11,5 @@ class ZephyrCompiler
 {
 public:
 	static ZephyrScriptDefinition* CompileScriptFile( const std::string& filePath );
+	static ZephyrScriptDefinition* CompileScriptSource( const std::string& scriptSource, const std::string& scriptName );
 };
@@ -478,6 +478,12 @@ bool ZephyrParser::ParseFunctionDefinition()
 		return false;
 	}
 
+	if ( g_zephyrAPI->GetNativeFunctionIndex( functionNameToken.GetData() ) >= 0 )
+	{
+		ReportError( Stringf( "Function '%s' is already defined as a native function and can't be redefined here", functionNameToken.GetData().c_str() ) );
+		return false;
+	}
+
 	// Create this function chunk so params are saved inside
 	bool succeeded = CreateBytecodeChunk( functionNameToken.GetData(), eBytecodeChunkType::EVENT );
 	if ( !succeeded )
@@ -616,7 +622,16 @@ bool ZephyrParser::ParseFunctionCall()
 	//		ReportError( "FireEvent must specify an event to call in parentheses" );
 	//	}
 
-	if ( !ParseEventArgs() )
+	// Native functions are bound by index now so calls don't look anything up by name
+	int nativeFunctionIdx = g_zephyrAPI->GetNativeFunctionIndex( functionName.GetData() );
+	if ( nativeFunctionIdx >= 0 )
+	{
+		if ( !ParseNativeFunctionArgs( *g_zephyrAPI->GetNativeFunction( nativeFunctionIdx ) ) )
+		{
+			return false;
+		}
+	}
+	else if ( !ParseEventArgs() )
 	{
 		return false;
 	}
@@ -628,6 +643,13 @@ bool ZephyrParser::ParseFunctionCall()
 		return false;
 	}
 
+	if ( nativeFunctionIdx >= 0 )
+	{
+		WriteConstantToCurChunk( ZephyrValue( (float)nativeFunctionIdx ) );
+		WriteOpCodeToCurChunk( eOpCode::NATIVE_FUNCTION_CALL );
+		return true;
+	}
+
 	WriteConstantToCurChunk( ZephyrValue( functionName.GetData() ) );
 	WriteOpCodeToCurChunk( eOpCode::FUNCTION_CALL );
 
@@ -719,6 +741,109 @@ bool ZephyrParser::ParseEventArgs()
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Same var: value form as event args, but each value is followed by its param index instead of
+// its name. Identifiers passed straight in are listed with their param index to get out values
+//-----------------------------------------------------------------------------------------------
+bool ZephyrParser::ParseNativeFunctionArgs( const ZephyrNativeFunction& nativeFunction )
+{
+	ZephyrToken identifier = ConsumeCurToken();
+	int argCount = 0;
+	uint passedParamFlags = 0;
+
+	std::vector<std::string> identifierNames;
+	std::vector<int> identifierParamIdxs;
+
+	while ( identifier.GetType() == eTokenType::IDENTIFIER )
+	{
+		if ( !ConsumeExpectedNextToken( eTokenType::COLON ) )
+		{
+			ReportError( "Parameter to function must be in the form, var: value" );
+			return false;
+		}
+
+		int paramIdx = nativeFunction.GetParamIndex( identifier.GetData() );
+		if ( paramIdx < 0 )
+		{
+			ReportError( Stringf( "Function '%s' has no parameter '%s'", nativeFunction.name.c_str(), identifier.GetData().c_str() ) );
+			return false;
+		}
+
+		if ( ( passedParamFlags & ( 1 << paramIdx ) ) != 0 )
+		{
+			ReportError( Stringf( "Parameter '%s' is passed to function '%s' more than once", identifier.GetData().c_str(), nativeFunction.name.c_str() ) );
+			return false;
+		}
+
+		passedParamFlags |= ( 1 << paramIdx );
+
+		ZephyrToken valueToken = GetCurToken();
+		switch ( valueToken.GetType() )
+		{
+			case eTokenType::CONSTANT_NUMBER:
+			case eTokenType::VEC2:
+			case eTokenType::VEC3:
+			case eTokenType::ENTITY:
+			case eTokenType::TRUE_TOKEN:
+			case eTokenType::FALSE_TOKEN:
+			case eTokenType::NULL_TOKEN:
+			case eTokenType::CONSTANT_STRING:
+			{
+				if ( !ParseExpression() )
+				{
+					return false;
+				}
+			}
+			break;
+
+			case eTokenType::IDENTIFIER:
+			{
+				// Only pass single identifiers by reference
+				eTokenType nextType = PeekNextToken().GetType();
+				if ( nextType == eTokenType::COMMA
+					 || nextType == eTokenType::PARENTHESIS_RIGHT
+					 || nextType == eTokenType::IDENTIFIER )
+				{
+					identifierNames.push_back( valueToken.GetData() );
+					identifierParamIdxs.push_back( paramIdx );
+				}
+
+				if ( !ParseExpression() )
+				{
+					return false;
+				}
+			}
+			break;
+
+			default:
+			{
+				ReportError( "Must set parameter equal to a value in the form, var: value" );
+				return false;
+			}
+		}
+
+		WriteConstantToCurChunk( ZephyrValue( (float)paramIdx ) );
+		++argCount;
+
+		AdvanceToNextTokenIfTypeMatches( eTokenType::COMMA );
+
+		identifier = ConsumeCurToken();
+	}
+
+	WriteConstantToCurChunk( ZephyrValue( (float)argCount ) );
+
+	for ( int identifierIdx = 0; identifierIdx < (int)identifierNames.size(); ++identifierIdx )
+	{
+		WriteConstantToCurChunk( identifierNames[identifierIdx] );
+		WriteConstantToCurChunk( ZephyrValue( (float)identifierParamIdxs[identifierIdx] ) );
+	}
+
+	WriteConstantToCurChunk( ZephyrValue( (float)identifierNames.size() ) );
+
+	return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 bool ZephyrParser::ParseChangeStateStatement()
 {
@@ -10,6 +10,7 @@
 class ZephyrBytecodeChunk;
 class ZephyrScriptDefinition;
 class ZephyrToken;
+struct ZephyrNativeFunction;
 enum class eBytecodeChunkType;
 
 
@@ -65,6 +66,7 @@ private:
 	bool ParseVariableDeclaration( const eValueType& varType );
 	bool ParseFunctionCall();
 	bool ParseEventArgs();
+	bool ParseNativeFunctionArgs( const ZephyrNativeFunction& nativeFunction );
 	bool ParseChangeStateStatement();
 	bool ParseIfStatement();
 	bool ParseAssignment();
@@ -1,7 +1,9 @@
 #include "Engine/Zephyr/Core/ZephyrVirtualMachine.hpp"
 #include "Engine/Zephyr/Core/ZephyrBytecodeChunk.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrCommandBuffer.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrComponent.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrEngineEvents.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrNativeFunction.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrSystem.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
@@ -250,7 +252,14 @@ void ZephyrVirtualMachine::InterpretBytecodeChunk( const ZephyrBytecodeChunk& by
 					return;
 				}
 
-				CallMemberFunctionOnEntity( memberAccessorResult.finalMemberVal.GetAsEntity(), memberAccessorResult.memberNames.back(), args );
+				EntityId targetId = memberAccessorResult.finalMemberVal.GetAsEntity();
+				if ( IsDeferringCallsToEntity( targetId ) )
+				{
+					DeferMemberFunctionCall( targetId, memberAccessorResult.memberNames.back(), args );
+					break;
+				}
+
+				CallMemberFunctionOnEntity( targetId, memberAccessorResult.memberNames.back(), args );
 
 				// Set new values of identifier parameters
 				UpdateIdentifierParameters( identifierToParamNames, *args, localVariables );
@@ -424,6 +433,24 @@ void ZephyrVirtualMachine::InterpretBytecodeChunk( const ZephyrBytecodeChunk& by
 				// Try to call GameAPI function, then local function
 				if ( g_zephyrAPI->IsMethodRegistered( eventName.GetAsString() ) )
 				{
+					if ( m_zephyrComponent.IsDeferringCommands() )
+					{
+						// A deferred call runs after this script, variables go in by value and only out params
+						// would need to come back
+						for ( auto const& identifierPair : identifierToParamNames )
+						{
+							if ( g_zephyrAPI->IsMethodOutParam( eventName.GetAsString(), identifierPair.second ) )
+							{
+								ReportError( Stringf( "Function '%s' can't set '%s' during a parallel update", eventName.GetAsString().c_str(), identifierPair.first.c_str() ) );
+								PTR_SAFE_DELETE( args );
+								return;
+							}
+						}
+
+						m_zephyrComponent.m_deferredCommands->FireGameEvent( eventName.GetAsString(), args );
+						break;
+					}
+
 					g_eventSystem->FireEvent( eventName.GetAsString(), args, EVERYWHERE );
 				}
 				else
@@ -441,6 +468,16 @@ void ZephyrVirtualMachine::InterpretBytecodeChunk( const ZephyrBytecodeChunk& by
 			}
 			break;
 
+			case eOpCode::NATIVE_FUNCTION_CALL:
+			{
+				int functionIdx = (int)PopConstant().GetAsNumber();
+				const ZephyrNativeFunction* nativeFunction = g_zephyrAPI->GetNativeFunction( functionIdx );
+				GUARANTEE_OR_DIE( nativeFunction != nullptr, "Native function index isn't registered" );
+
+				CallNativeFunction( functionIdx, *nativeFunction, localVariables );
+			}
+			break;
+
 			case eOpCode::CHANGE_STATE:
 			{
 				ZephyrValue stateName = PopConstant();
@@ -1312,6 +1349,81 @@ void ZephyrVirtualMachine::InsertParametersIntoEventArgs( EventArgs& args )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Args come off the stack straight into fixed slots by param index, so unlike event calls nothing
+// is marshalled through EventArgs
+//-----------------------------------------------------------------------------------------------
+void ZephyrVirtualMachine::CallNativeFunction( int functionIdx, const ZephyrNativeFunction& nativeFunction, ZephyrValueMap& localVariables )
+{
+	int identifierCount = (int)PopConstant().GetAsNumber();
+	ZephyrValue identifierNames[MAX_NATIVE_FUNCTION_PARAMS];
+	int identifierParamIdxs[MAX_NATIVE_FUNCTION_PARAMS];
+	for ( int identifierIdx = 0; identifierIdx < identifierCount; ++identifierIdx )
+	{
+		identifierParamIdxs[identifierIdx] = (int)PopConstant().GetAsNumber();
+		identifierNames[identifierIdx] = PopConstant();
+	}
+
+	// Params the script didn't pass read their defaults in place
+	int numParams = (int)nativeFunction.params.size();
+	ZephyrValue argValues[MAX_NATIVE_FUNCTION_PARAMS];
+	const ZephyrValue* args[MAX_NATIVE_FUNCTION_PARAMS];
+	for ( int paramIdx = 0; paramIdx < numParams; ++paramIdx )
+	{
+		args[paramIdx] = &nativeFunction.params[paramIdx].defaultValue;
+	}
+
+	bool areArgsValid = true;
+	int argCount = (int)PopConstant().GetAsNumber();
+	for ( int argIdx = 0; argIdx < argCount; ++argIdx )
+	{
+		int paramIdx = (int)PopConstant().GetAsNumber();
+		argValues[paramIdx] = PopConstant();
+		args[paramIdx] = &argValues[paramIdx];
+
+		const ZephyrNativeParam& param = nativeFunction.params[paramIdx];
+		if ( argValues[paramIdx].GetType() != param.GetType() )
+		{
+			ReportError( Stringf( "Parameter '%s' of function '%s' must be a %s, not a %s", param.name.c_str(), nativeFunction.name.c_str(), 
+								  ToString( param.GetType() ).c_str(), ToString( argValues[paramIdx].GetType() ).c_str() ) );
+			areArgsValid = false;
+		}
+	}
+
+	if ( !areArgsValid )
+	{
+		return;
+	}
+
+	if ( m_zephyrComponent.IsDeferringCommands() )
+	{
+		for ( int identifierIdx = 0; identifierIdx < identifierCount; ++identifierIdx )
+		{
+			if ( nativeFunction.params[identifierParamIdxs[identifierIdx]].isOut )
+			{
+				ReportError( Stringf( "Function '%s' can't set '%s' during a parallel update", nativeFunction.name.c_str(), identifierNames[identifierIdx].GetAsString().c_str() ) );
+				return;
+			}
+		}
+
+		m_zephyrComponent.m_deferredCommands->CallNativeFunction( m_zephyrComponent.GetParentEntityId(), functionIdx, args, numParams );
+		return;
+	}
+
+	ZephyrNativeCallArgs callArgs( m_zephyrComponent.GetParentEntityId(), args, argValues, numParams );
+	nativeFunction.function( callArgs );
+
+	for ( int identifierIdx = 0; identifierIdx < identifierCount; ++identifierIdx )
+	{
+		int paramIdx = identifierParamIdxs[identifierIdx];
+		if ( callArgs.WasOutValueSet( paramIdx ) )
+		{
+			AssignToVariable( identifierNames[identifierIdx].GetAsString(), callArgs.GetArg( paramIdx ), localVariables );
+		}
+	}
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void ZephyrVirtualMachine::UpdateIdentifierParameters( const std::map<std::string, std::string>& identifierToParamNames, const EventArgs& args, ZephyrValueMap& localVariables )
 {
@@ -1381,6 +1493,11 @@ ZephyrValue ZephyrVirtualMachine::GetZephyrValFromEventArgs( const std::string&
 //-----------------------------------------------------------------------------------------------
 ZephyrValue ZephyrVirtualMachine::GetGlobalVariableFromEntity( EntityId entityId, const std::string& variableName )
 {
+	if ( IsDeferringCallsToEntity( entityId ) )
+	{
+		return ZephyrSystem::GetGlobalVariableSnapshot( entityId, variableName );
+	}
+
 	return ZephyrSystem::GetGlobalVariable( entityId, variableName );
 }
 
@@ -1388,6 +1505,20 @@ ZephyrValue ZephyrVirtualMachine::GetGlobalVariableFromEntity( EntityId entityId
 //-----------------------------------------------------------------------------------------------
 void ZephyrVirtualMachine::SetGlobalVariableInEntity( EntityId entityId, const std::string& variableName, const ZephyrValue& value )
 {
+	if ( m_zephyrComponent.IsDeferringCommands() )
+	{
+		// Native variables are game state other scripts may be reading, so only this entity's own
+		// script variables can change in place
+		if ( entityId == m_zephyrComponent.GetParentEntityId()
+			 && m_globalVariables != nullptr
+			 && m_globalVariables->find( variableName ) != m_globalVariables->end() )
+		{
+			return m_zephyrComponent.SetGlobalVariable( variableName, value );
+		}
+
+		return m_zephyrComponent.m_deferredCommands->SetVariable( entityId, variableName, value );
+	}
+
 	return ZephyrSystem::SetGlobalVariable( entityId, variableName, value );
 }
 
@@ -1401,7 +1532,7 @@ void ZephyrVirtualMachine::SetGlobalVec2MemberVariableInEntity( EntityId entityI
 		ReportError( Stringf( "Unknown entity does not contain a member '%s'", variableName.c_str() ) );
 		return;
 	}
-	ZephyrValue oldValue = ZephyrSystem::GetGlobalVariable( entityId, variableName );
+	ZephyrValue oldValue = GetGlobalVariableFromEntity( entityId, variableName );
 
 	Vec2 newValue = oldValue.GetAsVec2();
 	if ( memberName == "x" )
@@ -1413,7 +1544,7 @@ void ZephyrVirtualMachine::SetGlobalVec2MemberVariableInEntity( EntityId entityI
 		newValue.y = value.GetAsNumber();
 	}
 
-	return ZephyrSystem::SetGlobalVariable( entityId, variableName, ZephyrValue( newValue ) );
+	return SetGlobalVariableInEntity( entityId, variableName, ZephyrValue( newValue ) );
 }
 
 
@@ -1426,7 +1557,7 @@ void ZephyrVirtualMachine::SetGlobalVec3MemberVariableInEntity( EntityId entityI
 		ReportError( Stringf( "Unknown entity does not contain a member '%s'", variableName.c_str() ) );
 		return;
 	}
-	ZephyrValue oldValue = ZephyrSystem::GetGlobalVariable( entityId, variableName );
+	ZephyrValue oldValue = GetGlobalVariableFromEntity( entityId, variableName );
 
 	Vec3 newValue = oldValue.GetAsVec3();
 	if ( memberName == "x" )
@@ -1442,7 +1573,7 @@ void ZephyrVirtualMachine::SetGlobalVec3MemberVariableInEntity( EntityId entityI
 		newValue.z = value.GetAsNumber();
 	}
 
-	return ZephyrSystem::SetGlobalVariable( entityId, variableName, ZephyrValue( newValue ) );
+	return SetGlobalVariableInEntity( entityId, variableName, ZephyrValue( newValue ) );
 }
 
 
@@ -1461,10 +1592,45 @@ bool ZephyrVirtualMachine::CallMemberFunctionOnEntity( EntityId entityId, const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Takes ownership of the args
+//-----------------------------------------------------------------------------------------------
+void ZephyrVirtualMachine::DeferMemberFunctionCall( EntityId entityId, const std::string& functionName, EventArgs* args )
+{
+	ZephyrComponent* zephyrComp = (ZephyrComponent*)GetComponentFromEntityId( entityId, ENTITY_COMPONENT_TYPE_ZEPHYR );
+	if ( zephyrComp == nullptr )
+	{
+		ReportError( Stringf( "Entity '%s' does not have a zephyr component", Entity::GetName( entityId ).c_str() ) );
+		PTR_SAFE_DELETE( args );
+		return;
+	}
+
+	m_zephyrComponent.m_deferredCommands->CallFunction( entityId, functionName, args );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Only other entities are deferred, this script's own entity is never touched by another job
+//-----------------------------------------------------------------------------------------------
+bool ZephyrVirtualMachine::IsDeferringCallsToEntity( EntityId entityId ) const
+{
+	return m_zephyrComponent.IsDeferringCommands()
+		&& entityId != m_zephyrComponent.GetParentEntityId();
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void ZephyrVirtualMachine::ReportError( const std::string& errorMsg )
 {
-	g_devConsole->PrintError( Stringf( "Error in script'%s': %s", m_zephyrComponent.GetScriptName().c_str(), errorMsg.c_str() ) );
+	std::string message = Stringf( "Error in script'%s': %s", m_zephyrComponent.GetScriptName().c_str(), errorMsg.c_str() );
+	if ( m_zephyrComponent.IsDeferringCommands() )
+	{
+		m_zephyrComponent.m_deferredCommands->PrintError( message );
+	}
+	else
+	{
+		g_devConsole->PrintError( message );
+	}
 
 	m_zephyrComponent.m_compState = eComponentState::INVALID_SCRIPT;
 }
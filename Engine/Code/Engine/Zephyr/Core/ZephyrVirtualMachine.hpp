@@ -8,6 +8,7 @@
 //-----------------------------------------------------------------------------------------------
 class ZephyrBytecodeChunk;
 class ZephyrComponent;
+struct ZephyrNativeFunction;
 
 
 //-----------------------------------------------------------------------------------------------
@@ -64,6 +65,7 @@ private:
 	
 	std::map<std::string, std::string> GetCallerVariableToParamNamesFromParameters( const std::string& eventName );
 	void InsertParametersIntoEventArgs( EventArgs& args );
+	void CallNativeFunction( int functionIdx, const ZephyrNativeFunction& nativeFunction, ZephyrValueMap& localVariables );
 	void UpdateIdentifierParameters( const std::map<std::string, std::string>& identifierParams, const EventArgs& args, ZephyrValueMap& localVariables );
 	ZephyrValue GetZephyrValFromEventArgs( const std::string& varName, const EventArgs& args );
 
@@ -72,6 +74,8 @@ private:
 	void SetGlobalVec2MemberVariableInEntity( EntityId entityId, const std::string& variableName, const std::string& memberName, const ZephyrValue& value );
 	void SetGlobalVec3MemberVariableInEntity( EntityId entityId, const std::string& variableName, const std::string& memberName, const ZephyrValue& value );
 	bool CallMemberFunctionOnEntity			( EntityId entityId, const std::string& functionName, EventArgs* args );
+	void DeferMemberFunctionCall			( EntityId entityId, const std::string& functionName, EventArgs* args );
+	bool IsDeferringCallsToEntity			( EntityId entityId ) const;
 
 	void ReportError( const std::string& errorMsg );
 	bool IsErrorValue( const ZephyrValue& zephyrValue );
@@ -0,0 +1,151 @@
+#include "Engine/Zephyr/GameInterface/ZephyrCommandBuffer.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrEngineEvents.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrSystem.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+ZephyrCommandBuffer::~ZephyrCommandBuffer()
+{
+	Clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrCommandBuffer::SetVariable( EntityId entityId, const std::string& varName, const ZephyrValue& value )
+{
+	ZephyrCommand command;
+	command.type = eZephyrCommandType::SET_VARIABLE;
+	command.entityId = entityId;
+	command.name = varName;
+	command.value = value;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrCommandBuffer::CallNativeFunction( EntityId callerId, int nativeFunctionIdx, const ZephyrValue** args, int numArgs )
+{
+	ZephyrCommand command;
+	command.type = eZephyrCommandType::CALL_NATIVE_FUNCTION;
+	command.entityId = callerId;
+	command.nativeFunctionIdx = nativeFunctionIdx;
+
+	command.nativeArgs.reserve( numArgs );
+	for ( int argIdx = 0; argIdx < numArgs; ++argIdx )
+	{
+		command.nativeArgs.push_back( *args[argIdx] );
+	}
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrCommandBuffer::PrintError( const std::string& message )
+{
+	ZephyrCommand command;
+	command.type = eZephyrCommandType::PRINT_ERROR;
+	command.name = message;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrCommandBuffer::CallFunction( EntityId entityId, const std::string& functionName, EventArgs* args )
+{
+	ZephyrCommand command;
+	command.type = eZephyrCommandType::CALL_FUNCTION;
+	command.entityId = entityId;
+	command.name = functionName;
+	command.eventArgs = args;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrCommandBuffer::FireGameEvent( const std::string& eventName, EventArgs* args )
+{
+	ZephyrCommand command;
+	command.type = eZephyrCommandType::FIRE_GAME_EVENT;
+	command.name = eventName;
+	command.eventArgs = args;
+
+	m_commands.push_back( command );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs on the main thread, anything a command triggers runs immediately the same as a serial update
+//-----------------------------------------------------------------------------------------------
+void ZephyrCommandBuffer::Apply() const
+{
+	for ( int commandIdx = 0; commandIdx < (int)m_commands.size(); ++commandIdx )
+	{
+		const ZephyrCommand& command = m_commands[commandIdx];
+		switch ( command.type )
+		{
+			case eZephyrCommandType::SET_VARIABLE:
+			{
+				ZephyrSystem::SetGlobalVariable( command.entityId, command.name, command.value );
+			}
+			break;
+
+			case eZephyrCommandType::CALL_FUNCTION:
+			{
+				ZephyrSystem::FireScriptEvent( command.entityId, command.name, command.eventArgs );
+			}
+			break;
+
+			case eZephyrCommandType::FIRE_GAME_EVENT:
+			{
+				g_eventSystem->FireEvent( command.name, command.eventArgs, EVERYWHERE );
+			}
+			break;
+
+			case eZephyrCommandType::CALL_NATIVE_FUNCTION:
+			{
+				const ZephyrNativeFunction* nativeFunction = g_zephyrAPI->GetNativeFunction( command.nativeFunctionIdx );
+				if ( nativeFunction == nullptr )
+				{
+					break;
+				}
+
+				int numArgs = (int)command.nativeArgs.size();
+				const ZephyrValue* args[MAX_NATIVE_FUNCTION_PARAMS];
+				ZephyrValue outValues[MAX_NATIVE_FUNCTION_PARAMS];
+				for ( int argIdx = 0; argIdx < numArgs; ++argIdx )
+				{
+					args[argIdx] = &command.nativeArgs[argIdx];
+				}
+
+				ZephyrNativeCallArgs callArgs( command.entityId, args, outValues, numArgs );
+				nativeFunction->function( callArgs );
+			}
+			break;
+
+			case eZephyrCommandType::PRINT_ERROR:
+			{
+				g_devConsole->PrintError( command.name );
+			}
+			break;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrCommandBuffer::Clear()
+{
+	for ( int commandIdx = 0; commandIdx < (int)m_commands.size(); ++commandIdx )
+	{
+		PTR_SAFE_DELETE( m_commands[commandIdx].eventArgs );
+	}
+
+	m_commands.clear();
+}
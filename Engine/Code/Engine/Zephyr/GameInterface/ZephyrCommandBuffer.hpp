@@ -0,0 +1,65 @@
+#pragma once
+#include "Engine/Zephyr/Core/ZephyrCommon.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrNativeFunction.hpp"
+
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+enum class eZephyrCommandType
+{
+	SET_VARIABLE,
+	CALL_FUNCTION,
+	FIRE_GAME_EVENT,
+	CALL_NATIVE_FUNCTION,
+	PRINT_ERROR,
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct ZephyrCommand
+{
+public:
+	eZephyrCommandType type = eZephyrCommandType::FIRE_GAME_EVENT;
+	EntityId entityId = INVALID_ENTITY_ID;				// Entity written to or called, the caller for native functions
+	std::string name;									// Variable, function or event name, or the error message
+	ZephyrValue value;
+	EventArgs* eventArgs = nullptr;						// Owned by the buffer
+	int nativeFunctionIdx = -1;
+	std::vector<ZephyrValue> nativeArgs;				// Every param, defaults already filled in
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Everything a script does outside its own entity while scripts run in parallel. Each update job
+// records into its own buffer and the buffers are applied in component order once all jobs finish,
+// so the result doesn't depend on how many threads ran. Calls recorded here run after the script
+// has moved on, so their out params never make it back
+//-----------------------------------------------------------------------------------------------
+class ZephyrCommandBuffer
+{
+public:
+	ZephyrCommandBuffer() = default;
+	~ZephyrCommandBuffer();
+
+	ZephyrCommandBuffer( const ZephyrCommandBuffer& other ) = delete;
+	ZephyrCommandBuffer& operator=( const ZephyrCommandBuffer& other ) = delete;
+
+	void		SetVariable( EntityId entityId, const std::string& varName, const ZephyrValue& value );
+	void		CallNativeFunction( EntityId callerId, int nativeFunctionIdx, const ZephyrValue** args, int numArgs );
+	void		PrintError( const std::string& message );
+
+	// Takes ownership of the args
+	void		CallFunction( EntityId entityId, const std::string& functionName, EventArgs* args );
+	void		FireGameEvent( const std::string& eventName, EventArgs* args );
+
+	void		Apply() const;
+
+	int			GetNumCommands() const											{ return (int)m_commands.size(); }
+	bool		IsEmpty() const													{ return m_commands.empty(); }
+	void		Clear();
+
+private:
+	std::vector<ZephyrCommand> m_commands;
+};
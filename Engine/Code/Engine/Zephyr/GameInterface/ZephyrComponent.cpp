@@ -57,6 +57,8 @@ void ZephyrComponent::Destroy()
 	g_eventSystem->DeRegisterObject( this );
 
 	PTR_SAFE_DELETE( m_globalBytecodeChunk );
+	m_stateVariables.clear();
+	m_globalVariablesSnapshot.clear();
 
 	m_compState = eComponentState::UNINITIALIZED;
 }
@@ -78,7 +80,8 @@ void ZephyrComponent::InterpretGlobalBytecodeChunk()
 	// Initialize default state variables
 	if ( m_curStateBytecodeChunk != nullptr )
 	{
-		ZephyrInterpreter::InterpretStateBytecodeChunk( *m_curStateBytecodeChunk, m_globalBytecodeChunk->GetUpdateableVariables(), *this, m_curStateBytecodeChunk->GetUpdateableVariables() );
+		m_stateVariables = m_curStateBytecodeChunk->GetVariables();
+		ZephyrInterpreter::InterpretStateBytecodeChunk( *m_curStateBytecodeChunk, m_globalBytecodeChunk->GetUpdateableVariables(), *this, &m_stateVariables );
 	}
 }
 
@@ -101,6 +104,19 @@ ZephyrValue ZephyrComponent::GetGlobalVariable( const std::string& varName )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+ZephyrValue ZephyrComponent::GetGlobalVariableSnapshot( const std::string& varName ) const
+{
+	auto iter = m_globalVariablesSnapshot.find( varName );
+	if ( iter == m_globalVariablesSnapshot.end() )
+	{
+		return ZephyrValue::ERROR_VALUE;
+	}
+
+	return iter->second;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void ZephyrComponent::SetGlobalVariable( const std::string& varName, const ZephyrValue& value )
 {
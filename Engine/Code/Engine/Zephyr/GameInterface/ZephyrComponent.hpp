@@ -9,6 +9,7 @@
 
 //-----------------------------------------------------------------------------------------------
 class ZephyrBytecodeChunk;
+class ZephyrCommandBuffer;
 class Entity;
 
 
@@ -43,7 +44,9 @@ public:
 	// Accessors
 	std::string		GetScriptName() const													{ return m_componentDef.zephyrScriptName;	}
 	ZephyrValue		GetGlobalVariable( const std::string& varName );
+	ZephyrValue		GetGlobalVariableSnapshot( const std::string& varName ) const;
 	void			SetGlobalVariable( const std::string& varName, const ZephyrValue& value );
+	bool			IsDeferringCommands() const												{ return m_deferredCommands != nullptr; }
 	bool			IsScriptValid() const													{ return m_compState != eComponentState::INVALID_SCRIPT
 																									&& m_compState != eComponentState::INVALID_PARENT
 																									&& m_compState != eComponentState::UNINITIALIZED; }
@@ -63,6 +66,12 @@ public:
 	ZephyrBytecodeChunk* m_globalBytecodeChunk = nullptr;
 	ZephyrBytecodeChunk* m_curStateBytecodeChunk = nullptr;
 	ZephyrBytecodeChunkMap m_stateBytecodeChunks;				// Duplicate here to avoid touching comp or script def at runtime. Change to ptr?
+	ZephyrValueMap m_stateVariables;							// State chunks are shared by every entity running the script, so each keeps its own copy
+
+	// Only used while the scene updates in parallel, other entities read the frame start values
+	// and anything this script does outside its own entity is recorded instead of run
+	ZephyrValueMap m_globalVariablesSnapshot;
+	ZephyrCommandBuffer* m_deferredCommands = nullptr;
 
 	enum class eComponentState m_compState = eComponentState::UNINITIALIZED;
 };
@@ -1,4 +1,6 @@
 #include "Engine/Zephyr/GameInterface/ZephyrEngineEvents.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
 									
 
 //-----------------------------------------------------------------------------------------------
@@ -15,3 +17,78 @@ bool ZephyrEngineEvents::IsMethodRegistered( const std::string& methodName )
 	
 	return iter != m_registeredMethods.end();
 }
+
+
+//-----------------------------------------------------------------------------------------------
+bool ZephyrEngineEvents::IsMethodOutParam( const std::string& methodName, const std::string& paramName ) const
+{
+	auto iter = m_methodOutParams.find( methodName );
+	if ( iter == m_methodOutParams.end() )
+	{
+		return false;
+	}
+
+	const Strings& outParamNames = iter->second;
+	for ( int paramIdx = 0; paramIdx < (int)outParamNames.size(); ++paramIdx )
+	{
+		if ( outParamNames[paramIdx] == paramName )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrEngineEvents::RegisterNativeFunction( const std::string& functionName, const std::vector<ZephyrNativeParam>& params, ZephyrNativeFunctionPtr function )
+{
+	GUARANTEE_OR_DIE( function != nullptr, Stringf( "Native function '%s' registered without a function", functionName.c_str() ) );
+	GUARANTEE_OR_DIE( (int)params.size() <= MAX_NATIVE_FUNCTION_PARAMS, Stringf( "Native function '%s' has more than %i params", functionName.c_str(), MAX_NATIVE_FUNCTION_PARAMS ) );
+	GUARANTEE_OR_DIE( !IsMethodRegistered( functionName ) && GetNativeFunctionIndex( functionName ) < 0, Stringf( "Zephyr function '%s' is already registered", functionName.c_str() ) );
+
+	ZephyrNativeFunction nativeFunction;
+	nativeFunction.name = functionName;
+	nativeFunction.params = params;
+	nativeFunction.function = function;
+
+	// Compiled scripts hold on to indexes, so functions are only ever added
+	m_nativeFunctionIndexes[functionName] = (int)m_nativeFunctions.size();
+	m_nativeFunctions.push_back( nativeFunction );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrEngineEvents::RegisterMethodOutParams( const std::string& methodName, const Strings& outParamNames )
+{
+	GUARANTEE_OR_DIE( IsMethodRegistered( methodName ), Stringf( "Out params registered for unknown method '%s'", methodName.c_str() ) );
+
+	m_methodOutParams[methodName] = outParamNames;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int ZephyrEngineEvents::GetNativeFunctionIndex( const std::string& functionName ) const
+{
+	auto iter = m_nativeFunctionIndexes.find( functionName );
+	if ( iter == m_nativeFunctionIndexes.end() )
+	{
+		return -1;
+	}
+
+	return iter->second;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+const ZephyrNativeFunction* ZephyrEngineEvents::GetNativeFunction( int functionIdx ) const
+{
+	if ( functionIdx < 0
+		 || functionIdx >= (int)m_nativeFunctions.size() )
+	{
+		return nullptr;
+	}
+
+	return &m_nativeFunctions[functionIdx];
+}
@@ -1,8 +1,11 @@
 #pragma once
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrNativeFunction.hpp"
 
+#include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <vector>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -16,10 +19,25 @@ public:
 	virtual ~ZephyrEngineEvents();
 
 	bool IsMethodRegistered( const std::string& methodName );
+	bool IsMethodOutParam( const std::string& methodName, const std::string& paramName ) const;
+
+	// Native functions are resolved to an index when a script compiles and take their args off
+	// the VM stack. Methods registered as events still work by name through EventArgs
+	int GetNativeFunctionIndex( const std::string& functionName ) const;
+	const ZephyrNativeFunction* GetNativeFunction( int functionIdx ) const;
 
 	virtual Entity* GetEntityById( const EntityId& id ) const = 0;
 	virtual Entity* GetEntityByName( const std::string& name ) const = 0;
 
+protected:
+	void RegisterNativeFunction( const std::string& functionName, const std::vector<ZephyrNativeParam>& params, ZephyrNativeFunctionPtr function );
+
+	// Params a method writes back into its EventArgs, scripts can't pass variables to them while deferring
+	void RegisterMethodOutParams( const std::string& methodName, const Strings& outParamNames );
+
 protected:
 	std::unordered_set<std::string> m_registeredMethods;
+	std::unordered_map<std::string, Strings> m_methodOutParams;
+	std::vector<ZephyrNativeFunction> m_nativeFunctions;
+	std::unordered_map<std::string, int> m_nativeFunctionIndexes;
 };
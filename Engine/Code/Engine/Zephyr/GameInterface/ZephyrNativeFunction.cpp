@@ -0,0 +1,35 @@
+#include "Engine/Zephyr/GameInterface/ZephyrNativeFunction.hpp"
+
+
+//-----------------------------------------------------------------------------------------------
+ZephyrNativeCallArgs::ZephyrNativeCallArgs( EntityId callerId, const ZephyrValue** args, ZephyrValue* outValues, int numArgs )
+	: m_callerId( callerId )
+	, m_args( args )
+	, m_outValues( outValues )
+	, m_numArgs( numArgs )
+{
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrNativeCallArgs::SetOutValue( int paramIdx, const ZephyrValue& value )
+{
+	m_outValues[paramIdx] = value;
+	m_args[paramIdx] = &m_outValues[paramIdx];
+	m_outValueFlags |= ( 1 << paramIdx );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int ZephyrNativeFunction::GetParamIndex( const std::string& paramName ) const
+{
+	for ( int paramIdx = 0; paramIdx < (int)params.size(); ++paramIdx )
+	{
+		if ( params[paramIdx].name == paramName )
+		{
+			return paramIdx;
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Engine/Zephyr/Core/ZephyrCommon.hpp"
+
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr int MAX_NATIVE_FUNCTION_PARAMS = 16;
+
+
+//-----------------------------------------------------------------------------------------------
+// The default value also sets the type, args of any other type are a script error
+struct ZephyrNativeParam
+{
+public:
+	std::string name;
+	ZephyrValue defaultValue;
+	bool isOut = false;														// Set through SetOutValue, can't be deferred
+
+public:
+	ZephyrNativeParam( const std::string& name, const ZephyrValue& defaultValue, bool isOut = false )
+		: name( name )
+		, defaultValue( defaultValue )
+		, isOut( isOut )
+	{
+	}
+
+	eValueType GetType() const												{ return defaultValue.GetType(); }
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Args of one native call by param index, in the order the params were registered. Values the
+// script didn't pass point at the registered defaults, nothing is copied into a map
+//-----------------------------------------------------------------------------------------------
+class ZephyrNativeCallArgs
+{
+public:
+	ZephyrNativeCallArgs( EntityId callerId, const ZephyrValue** args, ZephyrValue* outValues, int numArgs );
+
+	EntityId			GetCallerId() const									{ return m_callerId; }
+	int					GetNumArgs() const									{ return m_numArgs; }
+	const ZephyrValue&	GetArg( int paramIdx ) const						{ return *m_args[paramIdx]; }
+
+	float				GetNumber( int paramIdx ) const						{ return m_args[paramIdx]->GetAsNumber(); }
+	Vec2				GetVec2( int paramIdx ) const						{ return m_args[paramIdx]->GetAsVec2(); }
+	Vec3				GetVec3( int paramIdx ) const						{ return m_args[paramIdx]->GetAsVec3(); }
+	bool				GetBool( int paramIdx ) const						{ return m_args[paramIdx]->GetAsBool(); }
+	std::string			GetString( int paramIdx ) const						{ return m_args[paramIdx]->GetAsString(); }
+	EntityId			GetEntity( int paramIdx ) const						{ return m_args[paramIdx]->GetAsEntity(); }
+
+	// Script variables passed straight in as an out param get the value back after the call
+	void				SetOutValue( int paramIdx, const ZephyrValue& value );
+	bool				WasOutValueSet( int paramIdx ) const				{ return ( m_outValueFlags & ( 1 << paramIdx ) ) != 0; }
+
+private:
+	EntityId m_callerId = INVALID_ENTITY_ID;
+	const ZephyrValue** m_args = nullptr;
+	ZephyrValue* m_outValues = nullptr;
+	int m_numArgs = 0;
+	uint m_outValueFlags = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+typedef void ( *ZephyrNativeFunctionPtr )( ZephyrNativeCallArgs& args );
+
+
+//-----------------------------------------------------------------------------------------------
+struct ZephyrNativeFunction
+{
+public:
+	std::string name;
+	std::vector<ZephyrNativeParam> params;
+	ZephyrNativeFunctionPtr function = nullptr;
+
+public:
+	int GetParamIndex( const std::string& paramName ) const;
+};
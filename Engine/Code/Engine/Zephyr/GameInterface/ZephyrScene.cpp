@@ -1,8 +1,16 @@
 #include "Engine/Zephyr/GameInterface/ZephyrScene.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrSystem.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrCommandBuffer.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrComponent.hpp"
 
 
+//-----------------------------------------------------------------------------------------------
+ZephyrScene::~ZephyrScene()
+{
+	PTR_VECTOR_SAFE_DELETE( commandBuffers );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 ZephyrComponent* ZephyrScene::CreateAndAddComponent( Entity* parentEntity, const ZephyrComponentDefinition& componentDef )
 {
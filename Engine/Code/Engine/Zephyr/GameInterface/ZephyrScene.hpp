@@ -7,16 +7,38 @@
 //-----------------------------------------------------------------------------------------------
 struct ZephyrComponentDefinition;
 class Entity;
+class ZephyrCommandBuffer;
 class ZephyrComponent;
 
 
+//-----------------------------------------------------------------------------------------------
+struct ZephyrUpdateStats
+{
+public:
+	int numComponents = 0;
+	int numJobs = 0;
+	int numCommands = 0;
+	double snapshotMs = 0.0;
+	double scriptMs = 0.0;
+	double applyMs = 0.0;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 struct ZephyrScene
 {
 public:
 	ZephyrComponentVector zephyrComponents;
 
+	// Parallel update
+	bool isParallelUpdateEnabled = false;			// Scenes opt in, scripts can't use out params during OnUpdate once they do
+	int minComponentsPerJob = 64;
+	std::vector<ZephyrCommandBuffer*> commandBuffers;			// One per update job, kept between frames
+	ZephyrUpdateStats lastUpdateStats;
+
 public:
+	~ZephyrScene();
+
 	ZephyrComponent*	CreateAndAddComponent( Entity* parentEntity, const ZephyrComponentDefinition& componentDef );
 	void				Destroy();
 };
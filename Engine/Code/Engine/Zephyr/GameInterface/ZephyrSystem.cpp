@@ -1,13 +1,23 @@
 #include "Engine/Zephyr/GameInterface/ZephyrSystem.hpp"
 #include "Engine/Zephyr/Core/ZephyrBytecodeChunk.hpp"
+#include "Engine/Zephyr/Core/ZephyrCompiler.hpp"
 #include "Engine/Zephyr/Core/ZephyrInterpreter.hpp"
+#include "Engine/Zephyr/Core/ZephyrScriptDefinition.hpp"
+#include "Engine/Zephyr/GameInterface/ZephyrCommandBuffer.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrComponent.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrComponentDefinition.hpp"
 #include "Engine/Zephyr/GameInterface/ZephyrScene.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/HashUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
 #include "Engine/Framework/Entity.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Time/Time.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
@@ -132,18 +142,13 @@ ZephyrValue ZephyrSystem::GetGlobalVariable( ZephyrComponent* zephyrComp, const
 	}
 
 	// Try to get native first
-	EventArgs args;
-	args.SetValue( PARENT_ENTITY_ID_STR, zephyrComp->GetParentEntityId() );
-	args.SetValue( "varName", varName );
-	g_eventSystem->FireEvent( "GetNativeEntityVariable", &args );
-
-	// If this wasn't native it must be a script variable
-	bool isNative = args.GetValue( "isNative", false );
-	if ( isNative )
+	ZephyrValue nativeValue;
+	if ( TryToGetNativeVariable( zephyrComp->GetParentEntityId(), varName, nativeValue ) )
 	{
-		return args.GetValue( "zephyrValue", ZephyrValue() );
+		return nativeValue;
 	}
 
+	// If this wasn't native it must be a script variable
 	return zephyrComp->GetGlobalVariable( varName );
 }
 
@@ -157,6 +162,46 @@ ZephyrValue ZephyrSystem::GetGlobalVariable( const EntityId& entityId, const std
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Reads another entity while scenes update in parallel. Native variables come from game state,
+// which doesn't change until the deferred commands are applied, so both halves are frame start values
+//-----------------------------------------------------------------------------------------------
+ZephyrValue ZephyrSystem::GetGlobalVariableSnapshot( const EntityId& entityId, const std::string& varName )
+{
+	ZephyrComponent* zephyrComp = (ZephyrComponent*)GetComponentFromEntityId( entityId, ENTITY_COMPONENT_TYPE_ZEPHYR );
+	if ( zephyrComp == nullptr )
+	{
+		return ZephyrValue::ERROR_VALUE;
+	}
+
+	ZephyrValue nativeValue;
+	if ( TryToGetNativeVariable( entityId, varName, nativeValue ) )
+	{
+		return nativeValue;
+	}
+
+	return zephyrComp->GetGlobalVariableSnapshot( varName );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+bool ZephyrSystem::TryToGetNativeVariable( const EntityId& entityId, const std::string& varName, ZephyrValue& out_value )
+{
+	EventArgs args;
+	args.SetValue( PARENT_ENTITY_ID_STR, entityId );
+	args.SetValue( "varName", varName );
+	g_eventSystem->FireEvent( "GetNativeEntityVariable", &args );
+
+	bool isNative = args.GetValue( "isNative", false );
+	if ( isNative )
+	{
+		out_value = args.GetValue( "zephyrValue", ZephyrValue() );
+	}
+
+	return isNative;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void ZephyrSystem::SetGlobalVariable( ZephyrComponent* zephyrComp, const std::string& varName, const ZephyrValue& value )
 {
@@ -223,7 +268,8 @@ void ZephyrSystem::ChangeZephyrScriptState( ZephyrComponent* zephyrComp, const s
 
 	zephyrComp->m_curStateBytecodeChunk = targetStateBytecodeChunk;
 	// Initialize state variables each time the state is entered
-	ZephyrInterpreter::InterpretStateBytecodeChunk( *zephyrComp->m_curStateBytecodeChunk, zephyrComp->m_globalBytecodeChunk->GetUpdateableVariables(), *zephyrComp, zephyrComp->m_curStateBytecodeChunk->GetUpdateableVariables() );
+	zephyrComp->m_stateVariables = targetStateBytecodeChunk->GetVariables();
+	ZephyrInterpreter::InterpretStateBytecodeChunk( *zephyrComp->m_curStateBytecodeChunk, zephyrComp->m_globalBytecodeChunk->GetUpdateableVariables(), *zephyrComp, &zephyrComp->m_stateVariables );
 
 	ZephyrSystem::FireScriptEvent( zephyrComp, "OnEnter" );
 	//zephyrComp->m_state = eComponentState::STARTED;
@@ -295,6 +341,12 @@ void ZephyrSystem::ReloadZephyrScript( ZephyrComponent* zephyrComp )
 //-----------------------------------------------------------------------------------------------
 void ZephyrSystem::UpdateScene( ZephyrScene& scene )
 {
+	if ( scene.isParallelUpdateEnabled )
+	{
+		UpdateSceneInParallel( scene );
+		return;
+	}
+
 	for ( ZephyrComponent*& zephyrComp : scene.zephyrComponents )
 	{
 		if ( zephyrComp == nullptr )
@@ -327,12 +379,19 @@ void ZephyrSystem::UpdateComponent( ZephyrComponent* zephyrComp )
 {
 	if ( !zephyrComp->IsScriptValid() )
 	{
-		EventArgs args;
-		args.SetValue( PARENT_ENTITY_ID_STR, zephyrComp->GetParentEntityId() );
-		args.SetValue( "text", "Script Error" );
-		args.SetValue( "color", "red" );
+		EventArgs* args = new EventArgs();
+		args->SetValue( PARENT_ENTITY_ID_STR, zephyrComp->GetParentEntityId() );
+		args->SetValue( "text", "Script Error" );
+		args->SetValue( "color", "red" );
+
+		if ( zephyrComp->IsDeferringCommands() )
+		{
+			zephyrComp->m_deferredCommands->FireGameEvent( "PrintDebugText", args );
+			return;
+		}
 
-		g_eventSystem->FireEvent( "PrintDebugText", &args );
+		g_eventSystem->FireEvent( "PrintDebugText", args );
+		PTR_SAFE_DELETE( args );
 		return;
 	}
 
@@ -348,6 +407,116 @@ void ZephyrSystem::UpdateComponent( ZephyrComponent* zephyrComp )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Scripts run in contiguous chunks of components on the job system, this thread takes the first.
+// Each script sees its own entity live and every other entity as it was at frame start, and
+// anything it does outside its own entity waits in its chunk's command buffer. Buffers are applied
+// in component order, so the result is the same for any number of jobs
+//-----------------------------------------------------------------------------------------------
+void ZephyrSystem::UpdateSceneInParallel( ZephyrScene& scene )
+{
+	double startTime = GetCurrentTimeSeconds();
+
+	int numJobs = GetNumUpdateJobs( scene );
+	while ( (int)scene.commandBuffers.size() < numJobs )
+	{
+		scene.commandBuffers.push_back( new ZephyrCommandBuffer() );
+	}
+
+	RunUpdatePhaseInParallel( eZephyrUpdatePhase::SNAPSHOT_GLOBALS, scene, numJobs );
+	double snapshotEndTime = GetCurrentTimeSeconds();
+
+	RunUpdatePhaseInParallel( eZephyrUpdatePhase::RUN_SCRIPTS, scene, numJobs );
+	double scriptEndTime = GetCurrentTimeSeconds();
+
+	// Sync point
+	int numCommands = 0;
+	for ( int jobIdx = 0; jobIdx < numJobs; ++jobIdx )
+	{
+		ZephyrCommandBuffer& commands = *scene.commandBuffers[jobIdx];
+		numCommands += commands.GetNumCommands();
+
+		commands.Apply();
+		commands.Clear();
+	}
+
+	ZephyrUpdateStats& stats = scene.lastUpdateStats;
+	stats.numComponents = (int)scene.zephyrComponents.size();
+	stats.numJobs = numJobs;
+	stats.numCommands = numCommands;
+	stats.snapshotMs = ( snapshotEndTime - startTime ) * 1000.0;
+	stats.scriptMs = ( scriptEndTime - snapshotEndTime ) * 1000.0;
+	stats.applyMs = ( GetCurrentTimeSeconds() - scriptEndTime ) * 1000.0;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrSystem::RunUpdatePhaseInParallel( eZephyrUpdatePhase phase, ZephyrScene& scene, int numJobs )
+{
+	const ZephyrComponentVector& components = scene.zephyrComponents;
+	if ( g_jobSystem == nullptr )
+	{
+		RunUpdatePhase( phase, components, 0, (int)components.size(), *scene.commandBuffers[0] );
+		return;
+	}
+
+	g_jobSystem->ParallelFor( (int)components.size(), numJobs, [&]( int jobIdx, int firstCompIdx, int endCompIdx )
+	{
+		RunUpdatePhase( phase, components, firstCompIdx, endCompIdx, *scene.commandBuffers[jobIdx] );
+	} );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ZephyrSystem::RunUpdatePhase( eZephyrUpdatePhase phase, const ZephyrComponentVector& components, int firstCompIdx, int endCompIdx, ZephyrCommandBuffer& commands )
+{
+	for ( int compIdx = firstCompIdx; compIdx < endCompIdx; ++compIdx )
+	{
+		ZephyrComponent* zephyrComp = components[compIdx];
+		if ( zephyrComp == nullptr )
+		{
+			continue;
+		}
+
+		switch ( phase )
+		{
+			case eZephyrUpdatePhase::SNAPSHOT_GLOBALS:
+			{
+				// Broken scripts read as errors the same as they would serially
+				if ( !zephyrComp->IsScriptValid() )
+				{
+					zephyrComp->m_globalVariablesSnapshot.clear();
+					break;
+				}
+
+				zephyrComp->m_globalVariablesSnapshot = zephyrComp->m_globalBytecodeChunk->GetVariables();
+			}
+			break;
+
+			case eZephyrUpdatePhase::RUN_SCRIPTS:
+			{
+				zephyrComp->m_deferredCommands = &commands;
+				UpdateComponent( zephyrComp );
+				zephyrComp->m_deferredCommands = nullptr;
+			}
+			break;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+int ZephyrSystem::GetNumUpdateJobs( const ZephyrScene& scene )
+{
+	if ( g_jobSystem == nullptr )
+	{
+		return 1;
+	}
+
+	return g_jobSystem->GetNumParallelForRanges( (int)scene.zephyrComponents.size(), scene.minComponentsPerJob );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void ZephyrSystem::FireSpawnEvent( ZephyrComponent* zephyrComp )
 {
@@ -396,7 +565,7 @@ bool ZephyrSystem::FireScriptEvent( ZephyrComponent* zephyrComp, const std::stri
 	ZephyrValueMap* stateVariables = nullptr;
 	if ( zephyrComp->m_curStateBytecodeChunk != nullptr )
 	{
-		stateVariables = zephyrComp->m_curStateBytecodeChunk->GetUpdateableVariables();
+		stateVariables = &zephyrComp->m_stateVariables;
 	}
 
 	//zephyrComp->m_parentEntity->AddGameEventParams( args );
@@ -415,3 +584,235 @@ bool ZephyrSystem::FireScriptEvent( const EntityId& entityId, const std::string&
 }
 
 
+
+
+//-----------------------------------------------------------------------------------------------
+// Update benchmark
+//-----------------------------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------------------------
+// Every entity reads and writes another one and calls a function on it each frame, and each
+// target has two writers, so apply order shows up in the result
+//-----------------------------------------------------------------------------------------------
+static const char* s_benchmarkScriptSource =
+	"Number value = 0\n"
+	"Number received = 0\n"
+	"Number seed = 0\n"
+	"Entity target = null\n"
+	"\n"
+	"Function OnPing( Number amount )\n"
+	"{\n"
+	"	received = received + amount\n"
+	"}\n"
+	"\n"
+	"State Walk\n"
+	"{\n"
+	"	Number steps = 0\n"
+	"\n"
+	"	OnUpdate()\n"
+	"	{\n"
+	"		steps = steps + 1\n"
+	"		value = value * 0.5 + seed + steps\n"
+	"		if( target != null )\n"
+	"		{\n"
+	"			value = value + target.value * 0.25\n"
+	"			target.OnPing( amount: steps )\n"
+	"		}\n"
+	"\n"
+	"		if( steps > 4 )\n"
+	"		{\n"
+	"			ChangeState( Rest )\n"
+	"		}\n"
+	"	}\n"
+	"}\n"
+	"\n"
+	"State Rest\n"
+	"{\n"
+	"	Number restSteps = 0\n"
+	"\n"
+	"	OnUpdate()\n"
+	"	{\n"
+	"		restSteps = restSteps + 1\n"
+	"		if( target != null )\n"
+	"		{\n"
+	"			target.seed = value * 0.001 + restSteps\n"
+	"		}\n"
+	"\n"
+	"		if( restSteps > 2 )\n"
+	"		{\n"
+	"			ChangeState( Walk )\n"
+	"		}\n"
+	"	}\n"
+	"}\n";
+
+
+//-----------------------------------------------------------------------------------------------
+// Owns plain entities running the benchmark script and answers component lookups for them. The
+// game's lookup runs first and won't know these ids, so this only answers ids it owns
+//-----------------------------------------------------------------------------------------------
+class ZephyrBenchmarkScene
+{
+public:
+	ZephyrBenchmarkScene( const ZephyrComponentDefinition& componentDef, int numEntities )
+	{
+		g_eventSystem->RegisterMethodEvent( "get_component_from_entity_id", "", EVERYWHERE, this, &ZephyrBenchmarkScene::GetComponentFromEntityId );
+
+		for ( int entityIdx = 0; entityIdx < numEntities; ++entityIdx )
+		{
+			Entity* entity = new Entity();
+			m_entities.push_back( entity );
+
+			ZephyrComponent* zephyrComp = m_scene.CreateAndAddComponent( entity, componentDef );
+			int slotIdx = Entity::GetSlotIndex( entity->GetId() );
+			if ( slotIdx >= (int)m_componentsBySlot.size() )
+			{
+				m_componentsBySlot.resize( Entity::GetNumSlots(), nullptr );
+			}
+			m_componentsBySlot[slotIdx] = zephyrComp;
+		}
+
+		for ( int entityIdx = 0; entityIdx < numEntities; ++entityIdx )
+		{
+			ZephyrValueMap initialValues;
+			initialValues["seed"] = ZephyrValue( (float)( entityIdx % 17 ) );
+			if ( entityIdx > 0 )
+			{
+				initialValues["target"] = ZephyrValue( m_entities[entityIdx / 2]->GetId() );
+			}
+
+			ZephyrSystem::InitializeGlobalVariables( m_scene.zephyrComponents[entityIdx], initialValues );
+		}
+	}
+
+	~ZephyrBenchmarkScene()
+	{
+		g_eventSystem->DeRegisterObject( this );
+
+		m_scene.Destroy();
+		PTR_VECTOR_SAFE_DELETE( m_entities );
+	}
+
+	void GetComponentFromEntityId( EventArgs* args )
+	{
+		EntityId entityId = args->GetValue( "entityId", INVALID_ENTITY_ID );
+		if ( entityId == INVALID_ENTITY_ID )
+		{
+			return;
+		}
+
+		int slotIdx = Entity::GetSlotIndex( entityId );
+		if ( slotIdx >= (int)m_componentsBySlot.size()
+			 || m_componentsBySlot[slotIdx] == nullptr
+			 || m_componentsBySlot[slotIdx]->GetParentEntityId() != entityId )
+		{
+			return;
+		}
+
+		args->SetValue( "entityComponent", (void*)m_componentsBySlot[slotIdx] );
+	}
+
+	// Ids differ between scenes, so only script values go in
+	uint32_t GetStateHash()
+	{
+		std::vector<float> state;
+		state.reserve( m_scene.zephyrComponents.size() * 3 );
+		for ( int compIdx = 0; compIdx < (int)m_scene.zephyrComponents.size(); ++compIdx )
+		{
+			ZephyrComponent* zephyrComp = m_scene.zephyrComponents[compIdx];
+			state.push_back( zephyrComp->GetGlobalVariable( "value" ).GetAsNumber() );
+			state.push_back( zephyrComp->GetGlobalVariable( "received" ).GetAsNumber() );
+			state.push_back( zephyrComp->GetGlobalVariable( "seed" ).GetAsNumber() );
+		}
+
+		return Hash( (byte*)state.data(), state.size() * sizeof( float ) );
+	}
+
+public:
+	ZephyrScene m_scene;
+
+private:
+	std::vector<Entity*> m_entities;
+	std::vector<ZephyrComponent*> m_componentsBySlot;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// The serial run is the old immediate update. The single job run defers the same way the parallel
+// run does, so those two have to match exactly every frame
+//-----------------------------------------------------------------------------------------------
+bool BenchmarkZephyrUpdateEvent( EventArgs* args )
+{
+	int numEntities = args->GetValue( "entities", 10000 );
+	int numFrames = args->GetValue( "frames", 60 );
+
+	ZephyrScriptDefinition* scriptDef = ZephyrCompiler::CompileScriptSource( s_benchmarkScriptSource, "ZephyrUpdateBenchmark" );
+	if ( scriptDef == nullptr
+		 || !scriptDef->IsValid() )
+	{
+		g_devConsole->PrintError( "Zephyr update benchmark script failed to compile" );
+		PTR_SAFE_DELETE( scriptDef );
+		return false;
+	}
+
+	ZephyrComponentDefinition componentDef;
+	componentDef.isScriptValid = true;
+	componentDef.zephyrScriptName = "ZephyrUpdateBenchmark";
+	componentDef.zephyrScriptDef = scriptDef;
+
+	bool isDeterministic = true;
+	double serialSeconds = 0.0;
+	double singleJobSeconds = 0.0;
+	double parallelSeconds = 0.0;
+	int numJobs = 1;
+	int numCommandsPerFrame = 0;
+	{
+		ZephyrBenchmarkScene serialScene( componentDef, numEntities );
+		ZephyrBenchmarkScene singleJobScene( componentDef, numEntities );
+		ZephyrBenchmarkScene parallelScene( componentDef, numEntities );
+		singleJobScene.m_scene.isParallelUpdateEnabled = true;
+		singleJobScene.m_scene.minComponentsPerJob = numEntities + 1;
+		parallelScene.m_scene.isParallelUpdateEnabled = true;
+
+		for ( int frameIdx = 0; frameIdx < numFrames; ++frameIdx )
+		{
+			double startTime = GetCurrentTimeSeconds();
+			ZephyrSystem::UpdateScene( serialScene.m_scene );
+			double serialEndTime = GetCurrentTimeSeconds();
+			ZephyrSystem::UpdateScene( singleJobScene.m_scene );
+			double singleJobEndTime = GetCurrentTimeSeconds();
+			ZephyrSystem::UpdateScene( parallelScene.m_scene );
+			double parallelEndTime = GetCurrentTimeSeconds();
+
+			serialSeconds += serialEndTime - startTime;
+			singleJobSeconds += singleJobEndTime - serialEndTime;
+			parallelSeconds += parallelEndTime - singleJobEndTime;
+
+			if ( singleJobScene.GetStateHash() != parallelScene.GetStateHash() )
+			{
+				g_devConsole->PrintError( Stringf( "Parallel zephyr update diverged on frame %i", frameIdx ) );
+				isDeterministic = false;
+				break;
+			}
+		}
+
+		numJobs = parallelScene.m_scene.lastUpdateStats.numJobs;
+		numCommandsPerFrame = parallelScene.m_scene.lastUpdateStats.numCommands;
+	}
+
+	PTR_SAFE_DELETE( scriptDef );
+
+	double frameCount = (double)Max( numFrames, 1 );
+	double serialMs = serialSeconds * 1000.0 / frameCount;
+	double singleJobMs = singleJobSeconds * 1000.0 / frameCount;
+	double parallelMs = parallelSeconds * 1000.0 / frameCount;
+
+	g_devConsole->PrintString( Stringf( "Zephyr update: %i scripted entities, %i frames, %i jobs, %i deferred commands per frame", numEntities, numFrames, numJobs, numCommandsPerFrame ) );
+	g_devConsole->PrintString( Stringf( "  Serial: %.3f ms  Deferred single job: %.3f ms  Parallel: %.3f ms  Speedup: %.2fx", serialMs, singleJobMs, parallelMs, parallelMs > 0.0 ? serialMs / parallelMs : 0.0 ) );
+	if ( isDeterministic )
+	{
+		g_devConsole->PrintString( "  Parallel results match the single job results every frame", Rgba8::GREEN );
+	}
+
+	return isDeterministic;
+}
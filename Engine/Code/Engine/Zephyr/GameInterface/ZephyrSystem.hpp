@@ -7,11 +7,23 @@
 //-----------------------------------------------------------------------------------------------
 struct ZephyrScene;
 struct ZephyrComponentDefinition;
+class ZephyrCommandBuffer;
 class ZephyrComponent;
 
 class Entity;
 
 
+//-----------------------------------------------------------------------------------------------
+// Every phase finishes on all jobs before the next starts, so scripts only ever read snapshots
+// that are complete
+//-----------------------------------------------------------------------------------------------
+enum class eZephyrUpdatePhase
+{
+	SNAPSHOT_GLOBALS,
+	RUN_SCRIPTS,
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class ZephyrSystem
 {
@@ -26,6 +38,7 @@ public:
 
 	static ZephyrValue					GetGlobalVariable( ZephyrComponent* zephyrComp, const std::string& varName );
 	static ZephyrValue					GetGlobalVariable( const EntityId& entityId, const std::string& varName );
+	static ZephyrValue					GetGlobalVariableSnapshot( const EntityId& entityId, const std::string& varName );
 	static void							SetGlobalVariable( ZephyrComponent* zephyrComp, const std::string& varName, const ZephyrValue& value );
 	static void							SetGlobalVariable( const EntityId& entityId, const std::string& varName, const ZephyrValue& value );
 
@@ -49,6 +62,18 @@ public:
 private:
 	static ZephyrComponent*				CreateComponent( Entity* parentEntity, const ZephyrComponentDefinition& componentDef );
 	static void							UpdateComponent( ZephyrComponent* zephyrComp );
+	static bool							TryToGetNativeVariable( const EntityId& entityId, const std::string& varName, ZephyrValue& out_value );
+
+	// Parallel update
+	static void							UpdateSceneInParallel( ZephyrScene& scene );
+	static void							RunUpdatePhaseInParallel( eZephyrUpdatePhase phase, ZephyrScene& scene, int numJobs );
+	static void							RunUpdatePhase( eZephyrUpdatePhase phase, const ZephyrComponentVector& components, int firstCompIdx, int endCompIdx, ZephyrCommandBuffer& commands );
+	static int							GetNumUpdateJobs( const ZephyrScene& scene );
 	static void							UnloadZephyrScript( ZephyrComponent* zephyrComp );
 	static void							ReloadZephyrScript( ZephyrComponent* zephyrComp );
 };
+
+
+//-----------------------------------------------------------------------------------------------
+// Console commands
+bool BenchmarkZephyrUpdateEvent( EventArgs* args );
@@ -33,6 +33,7 @@
 #include "Game/DataParsing/DataLoader.hpp"
 #include "Game/Framework/World.hpp"
 #include "Game/Framework/GameEntity.hpp"
+#include "Game/Graphics/SpriteRenderingSystem.hpp"
 
 
 //-----------------------------------------------------------------------------------------------
@@ -56,6 +57,8 @@ void Game::Startup()
 
 	InitializeUI();
 
+	SpriteRenderingSystem::Startup( g_renderer );
+
 	m_world = new World( m_gameClock );
 
 	m_startingMapName = g_gameConfigBlackboard.GetValue( std::string( "startMap" ), m_startingMapName );
@@ -74,6 +77,7 @@ void Game::Shutdown()
 
 	// Clean up member variables
 	PTR_SAFE_DELETE( m_world );
+	SpriteRenderingSystem::Shutdown();
 	PTR_SAFE_DELETE( m_rng );
 	PTR_SAFE_DELETE( m_debugInfoTextBox );
 	PTR_SAFE_DELETE( m_uiCamera );
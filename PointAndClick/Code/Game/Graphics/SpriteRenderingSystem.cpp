@@ -3,6 +3,7 @@
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Renderer/MeshUtils.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
 #include "Engine/Renderer/SpriteAnimDefinition.hpp"
 #include "Engine/Renderer/SpriteDefinition.hpp"
 
@@ -13,10 +14,62 @@
 #include "Game/Graphics/SpriteAnimationScene.hpp"
 #include "Game/Graphics/SpriteAnimationSetDefinition.hpp"
 
+#include <unordered_map>
+
+
+//-----------------------------------------------------------------------------------------------
+static SpriteBatch* s_spriteBatch = nullptr;
+static std::unordered_map<EntityId, Vec3> s_entityPositions;
+
+
+//-----------------------------------------------------------------------------------------------
+// Built once per scene render so each component finds its entity's position without a search
+//-----------------------------------------------------------------------------------------------
+static void BuildEntityPositionMap( const std::vector<GameEntity*>& sceneEntities )
+{
+	s_entityPositions.clear();
+	for ( GameEntity* entity : sceneEntities )
+	{
+		s_entityPositions.emplace( entity->GetId(), entity->GetPosition() );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static Vec3 GetEntityPosition( EntityId entityId )
+{
+	auto iter = s_entityPositions.find( entityId );
+	if ( iter == s_entityPositions.end() )
+	{
+		return Vec3::ZERO;
+	}
+
+	return iter->second;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SpriteRenderingSystem::Startup( RenderContext* renderer )
+{
+	s_spriteBatch = new SpriteBatch( renderer );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void SpriteRenderingSystem::Shutdown()
+{
+	PTR_SAFE_DELETE( s_spriteBatch );
+	s_entityPositions.clear();
+}
+
 
 //-----------------------------------------------------------------------------------------------
 void SpriteRenderingSystem::RenderScene( const SpriteAnimationScene& spriteAnimScene, const std::vector<GameEntity*>& sceneEntities )
 {
+	BuildEntityPositionMap( sceneEntities );
+
+	s_spriteBatch->Begin();
+
 	for ( SpriteAnimationComponent* spriteAnimComp : spriteAnimScene.animComponents )
 	{
 		if ( spriteAnimComp->curSpriteAnimSetDef == nullptr )
@@ -31,31 +84,28 @@ void SpriteRenderingSystem::RenderScene( const SpriteAnimationScene& spriteAnimS
 		Vec2 mins, maxs;
 		spriteDef.GetUVs( mins, maxs );
 
-		std::vector<Vertex_PCU> vertexes;
-		AppendVertsForAABB2D( vertexes, spriteAnimComp->spriteAnimCompDef.localDrawBounds, Rgba8::WHITE, mins, maxs );
-
-		// HACK: Find a better way to get transforms into this function
-		Vec3 position = Vec3::ZERO;
-		for ( GameEntity* entity : sceneEntities )
-		{
-			if ( spriteAnimComp->GetParentEntityId() == entity->GetId() )
-			{
-				position = entity->GetPosition();
-				break;
-			}
-		}
+		Vec3 position = GetEntityPosition( spriteAnimComp->GetParentEntityId() );
+		const AABB2& localDrawBounds = spriteAnimComp->spriteAnimCompDef.localDrawBounds;
 
-		Vertex_PCU::TransformVertexArray( vertexes, 1.f, 0.f, position );
+		Vec3 corners[4];
+		corners[0] = position + Vec3( localDrawBounds.mins, 0.f );
+		corners[1] = position + Vec3( localDrawBounds.maxs.x, localDrawBounds.mins.y, 0.f );
+		corners[2] = position + Vec3( localDrawBounds.mins.x, localDrawBounds.maxs.y, 0.f );
+		corners[3] = position + Vec3( localDrawBounds.maxs, 0.f );
 
-		g_renderer->BindTexture( 0, &( spriteDef.GetTexture() ) );
-		g_renderer->DrawVertexArray( vertexes );
+		// Equal depths keep the scene's component order
+		s_spriteBatch->AddSprite( corners, mins, maxs, &( spriteDef.GetTexture() ), nullptr, 0.f );
 	}
+
+	s_spriteBatch->End();
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void SpriteRenderingSystem::DebugRenderScene( const SpriteAnimationScene& spriteAnimScene, const std::vector<GameEntity*>& sceneEntities )
 {
+	BuildEntityPositionMap( sceneEntities );
+
 	std::vector<Vertex_PCU> vertexes;
 	for ( SpriteAnimationComponent* spriteAnimComp : spriteAnimScene.animComponents )
 	{
@@ -64,16 +114,7 @@ void SpriteRenderingSystem::DebugRenderScene( const SpriteAnimationScene& sprite
 			continue;
 		}
 		
-		// HACK: Find a better way to get transforms into this function
-		Vec3 position = Vec3::ZERO;
-		for ( GameEntity* entity : sceneEntities )
-		{
-			if ( spriteAnimComp->GetParentEntityId() == entity->GetId() )
-			{
-				position = entity->GetPosition();
-				break;
-			}
-		}
+		Vec3 position = GetEntityPosition( spriteAnimComp->GetParentEntityId() );
 
 		AABB2 worldDrawBounds = spriteAnimComp->spriteAnimCompDef.localDrawBounds;
 		worldDrawBounds.Translate( position.XY() );
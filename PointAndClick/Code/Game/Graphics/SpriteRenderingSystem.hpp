@@ -5,12 +5,16 @@
 //-----------------------------------------------------------------------------------------------
 struct SpriteAnimationScene;
 class GameEntity;
+class RenderContext;
 
 
 //-----------------------------------------------------------------------------------------------
 class SpriteRenderingSystem
 {
 public:
+	static void Startup( RenderContext* renderer );
+	static void Shutdown();
+
 	static void RenderScene( const SpriteAnimationScene& spriteAnimScene, const std::vector<GameEntity*>& sceneEntities );
 	static void DebugRenderScene( const SpriteAnimationScene& spriteAnimScene, const std::vector<GameEntity*>& sceneEntities );
 };
@@ -25,6 +25,19 @@
 #include "Game/SpriteAnimationSetDefinition.hpp"
 
 
+//-----------------------------------------------------------------------------------------------
+// Script events fired every frame or every hit, interned up front so firing them doesn't build strings
+static const ScriptEventId ON_HEALTH_CHANGE_EVENT = ScriptEventRegistry::RegisterName( "OnHealthChange" );
+static const ScriptEventId POSITION_UPDATED_EVENT = ScriptEventRegistry::RegisterName( "PositionUpdated" );
+static const ScriptEventId ON_POSITION_CHANGE_EVENT = ScriptEventRegistry::RegisterName( "OnPositionChange" );
+static const ScriptEventId ON_COLLISION_ENTER_EVENT = ScriptEventRegistry::RegisterName( "OnCollisionEnter" );
+static const ScriptEventId ON_COLLISION_STAY_EVENT = ScriptEventRegistry::RegisterName( "OnCollisionStay" );
+static const ScriptEventId ON_COLLISION_EXIT_EVENT = ScriptEventRegistry::RegisterName( "OnCollisionExit" );
+static const ScriptEventId ON_TRIGGER_ENTER_EVENT = ScriptEventRegistry::RegisterName( "OnTriggerEnter" );
+static const ScriptEventId ON_TRIGGER_STAY_EVENT = ScriptEventRegistry::RegisterName( "OnTriggerStay" );
+static const ScriptEventId ON_TRIGGER_EXIT_EVENT = ScriptEventRegistry::RegisterName( "OnTriggerExit" );
+
+
 //-----------------------------------------------------------------------------------------------
 Entity::Entity( const EntityDefinition& entityDef, Map* map )
 	: ZephyrEntity( entityDef )
@@ -32,6 +45,12 @@ Entity::Entity( const EntityDefinition& entityDef, Map* map )
 	, m_map( map )
 {
 	m_curHealth = m_entityDef.GetMaxHealth();
+	m_damageTypeMultipliers = m_entityDef.GetDamageMultipliers();
+
+	if ( g_game != nullptr )
+	{
+		m_rng = g_game->m_rng->GetSubStream( (unsigned int)GetId() );
+	}
 
 	if ( map != nullptr )
 	{
@@ -107,7 +126,7 @@ void Entity::InitPhysics( Rigidbody* newRigidbody )
 		m_rigidbody->SetSimulationMode( m_entityDef.GetSimMode() );
 	}
 
-	m_rigidbody->m_userProperties.SetValue( "entityId", m_id );
+	m_rigidbody->GetUserProperties().SetValue( "entityId", m_id );
 
 	NamedProperties params;
 	params.SetValue( "radius", GetPhysicsRadius() );
@@ -234,7 +253,7 @@ void Entity::SetPosition( const Vec3& position )
 		EventArgs args;
 		args.SetValue( "newPos", m_rigidbody->GetWorldPosition() );
 
-		FireScriptEvent( "PositionUpdated", &args );
+		FireScriptEvent( ScriptEventRegistry::GetName( POSITION_UPDATED_EVENT ), &args );
 	}
 }
 
@@ -379,49 +398,96 @@ void Entity::ResetDamageMultipliers()
 {
 	m_baseDamageMultiplier = 1.f;
 
-	for ( auto& damageMultiplier : m_damageTypeMultipliers )
+	for ( int damageTypeIdx = 0; damageTypeIdx < (int)m_damageTypeMultipliers.size(); ++damageTypeIdx )
+	{
+		m_damageTypeMultipliers[damageTypeIdx].Reset();
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Entity::AddNewDamageMultiplier( const DamageTypeId& damageTypeId, float newMultiplier )
+{
+	if ( !damageTypeId.IsValid() )
+	{
+		return;
+	}
+
+	if ( damageTypeId.index >= (int)m_damageTypeMultipliers.size() )
+	{
+		m_damageTypeMultipliers.resize( damageTypeId.index + 1 );
+	}
+
+	m_damageTypeMultipliers[damageTypeId.index] = DamageMultiplier( newMultiplier );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Entity::ChangeDamageMultiplier( const DamageTypeId& damageTypeId, float newMultiplier )
+{
+	DamageMultiplier* damageMultiplier = GetDamageMultiplier( damageTypeId );
+	if ( damageMultiplier == nullptr )
+	{
+		g_devConsole->PrintError( Stringf( "Tried to change multiplier of unknown damage type '%s'", DamageTypeRegistry::GetName( damageTypeId ).c_str() ) );
+		return;
+	}
+
+	damageMultiplier->curMultiplier = newMultiplier;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Entity::PermanentlyChangeDamageMultiplier( const DamageTypeId& damageTypeId, float newDefaultMultiplier )
+{
+	DamageMultiplier* damageMultiplier = GetDamageMultiplier( damageTypeId );
+	if ( damageMultiplier == nullptr )
 	{
-		damageMultiplier.second.curMultiplier = damageMultiplier.second.defaultMultiplier;
+		g_devConsole->PrintError( Stringf( "Tried to permanently change multiplier of unknown damage type '%s'", DamageTypeRegistry::GetName( damageTypeId ).c_str() ) );
+		return;
 	}
+
+	damageMultiplier->defaultMultiplier = newDefaultMultiplier;
+	damageMultiplier->curMultiplier = newDefaultMultiplier;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::AddNewDamageMultiplier( const std::string& damageType, float newMultiplier )
 {
-	m_damageTypeMultipliers[damageType] = DamageMultiplier( newMultiplier );
+	AddNewDamageMultiplier( DamageTypeRegistry::RegisterName( damageType ), newMultiplier );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::ChangeDamageMultiplier( const std::string& damageType, float newMultiplier )
 {
-	auto damageIter = m_damageTypeMultipliers.find( damageType );
-	if ( damageIter == m_damageTypeMultipliers.end() )
+	DamageTypeId damageTypeId = DamageTypeRegistry::GetId( damageType );
+	if ( GetDamageMultiplier( damageTypeId ) == nullptr )
 	{
 		g_devConsole->PrintError( Stringf( "Tried to change multiplier of unknown damage type '%s'", damageType.c_str() ) );
+		return;
 	}
 
-	damageIter->second.curMultiplier = newMultiplier;
+	ChangeDamageMultiplier( damageTypeId, newMultiplier );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::PermanentlyChangeDamageMultiplier( const std::string& damageType, float newDefaultMultiplier )
 {
-	auto damageIter = m_damageTypeMultipliers.find( damageType );
-	if ( damageIter == m_damageTypeMultipliers.end() )
+	DamageTypeId damageTypeId = DamageTypeRegistry::GetId( damageType );
+	if ( GetDamageMultiplier( damageTypeId ) == nullptr )
 	{
 		g_devConsole->PrintError( Stringf( "Tried to permanently change multiplier of unknown damage type '%s'", damageType.c_str() ) );
+		return;
 	}
 
-	damageIter->second.defaultMultiplier = newDefaultMultiplier;
-	damageIter->second.curMultiplier = newDefaultMultiplier;
+	PermanentlyChangeDamageMultiplier( damageTypeId, newDefaultMultiplier );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void Entity::TakeDamage( float damage, const std::string& type )
+void Entity::TakeDamage( float damage, const DamageTypeId& damageTypeId )
 {
 	if ( IsDead() )
 	{
@@ -429,11 +495,10 @@ void Entity::TakeDamage( float damage, const std::string& type )
 	}
 
 	float damageMultiplier = 1.f;
-
-	auto damageIter = m_damageTypeMultipliers.find( type );
-	if ( damageIter != m_damageTypeMultipliers.end() )
+	if ( damageTypeId.index >= 0
+		 && damageTypeId.index < (int)m_damageTypeMultipliers.size() )
 	{
-		damageMultiplier = damageIter->second.curMultiplier;
+		damageMultiplier = m_damageTypeMultipliers[damageTypeId.index].curMultiplier;
 	}
 
 	m_curHealth -= damage * damageMultiplier * m_baseDamageMultiplier;
@@ -447,11 +512,33 @@ void Entity::TakeDamage( float damage, const std::string& type )
 		EventArgs args;
 		args.SetValue( "newHealth", m_curHealth );
 
-		m_scriptObj->FireEvent( "OnHealthChange", &args );
+		m_scriptObj->FireEvent( ScriptEventRegistry::GetName( ON_HEALTH_CHANGE_EVENT ), &args );
 	}
 }
 
 
+//-----------------------------------------------------------------------------------------------
+void Entity::TakeDamage( float damage, const std::string& type )
+{
+	// Unknown types have no multipliers anywhere, an invalid id takes the same path
+	TakeDamage( damage, DamageTypeRegistry::GetId( type ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+DamageMultiplier* Entity::GetDamageMultiplier( const DamageTypeId& damageTypeId )
+{
+	if ( damageTypeId.index < 0
+		 || damageTypeId.index >= (int)m_damageTypeMultipliers.size()
+		 || !m_damageTypeMultipliers[damageTypeId.index].isDefined )
+	{
+		return nullptr;
+	}
+
+	return &m_damageTypeMultipliers[damageTypeId.index];
+}
+
+
 //-----------------------------------------------------------------------------------------------
 void Entity::MoveWithPhysics( float speed, const Vec2& direction )
 {
@@ -463,7 +550,7 @@ void Entity::MoveWithPhysics( float speed, const Vec2& direction )
 		EventArgs args;
 		args.SetValue( "newPos", m_rigidbody->GetWorldPosition() );
 
-		FireScriptEvent( "OnPositionChange", &args );
+		FireScriptEvent( ScriptEventRegistry::GetName( ON_POSITION_CHANGE_EVENT ), &args );
 	}
 }
 
@@ -649,52 +736,52 @@ void Entity::PlaySpriteAnimation( const std::string& spriteAnimDefSetName )
 //-----------------------------------------------------------------------------------------------
 void Entity::EnterCollisionEvent( Collision collision )
 {
-	SendPhysicsEventToScript( collision, "OnCollisionEnter" );
+	SendPhysicsEventToScript( collision, ON_COLLISION_ENTER_EVENT );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::StayCollisionEvent( Collision collision )
 {
-	SendPhysicsEventToScript( collision, "OnCollisionStay" );
+	SendPhysicsEventToScript( collision, ON_COLLISION_STAY_EVENT );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::ExitCollisionEvent( Collision collision )
 {
-	SendPhysicsEventToScript( collision, "OnCollisionExit" );
+	SendPhysicsEventToScript( collision, ON_COLLISION_EXIT_EVENT );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::EnterTriggerEvent( Collision collision )
 {
-	SendPhysicsEventToScript( collision, "OnTriggerEnter" );
+	SendPhysicsEventToScript( collision, ON_TRIGGER_ENTER_EVENT );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::StayTriggerEvent( Collision collision )
 {
-	SendPhysicsEventToScript( collision, "OnTriggerStay" );
+	SendPhysicsEventToScript( collision, ON_TRIGGER_STAY_EVENT );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Entity::ExitTriggerEvent( Collision collision )
 {
-	SendPhysicsEventToScript( collision, "OnTriggerExit" );
+	SendPhysicsEventToScript( collision, ON_TRIGGER_EXIT_EVENT );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void Entity::SendPhysicsEventToScript( Collision collision, const std::string& eventName )
+void Entity::SendPhysicsEventToScript( Collision collision, const ScriptEventId& eventId )
 {
 	if ( !IsDead() )
 	{
-		//Entity* theirEntity = (Entity*)collision.theirCollider->m_rigidbody->m_userProperties.GetValue( "entityId", (EntityId)-1 );
-		EntityId theirEntityId = collision.theirCollider->GetRigidbody()->m_userProperties.GetValue( "entityId", (EntityId)-1 );
+		//Entity* theirEntity = (Entity*)collision.theirCollider->m_rigidbody->GetUserProperties().GetValue( "entityId", (EntityId)-1 );
+		EntityId theirEntityId = collision.theirCollider->GetRigidbody()->GetUserProperties().GetValue( "entityId", (EntityId)-1 );
 
 		Entity* theirEntity = g_game->GetEntityById( theirEntityId );
 
@@ -718,7 +805,7 @@ void Entity::SendPhysicsEventToScript( Collision collision, const std::string& e
 			args.SetValue( "otherEntity", otherId );
 			args.SetValue( "otherEntityName", otherName );
 			args.SetValue( "otherEntityType", otherType );
-			m_scriptObj->FireEvent( eventName, &args );
+			m_scriptObj->FireEvent( ScriptEventRegistry::GetName( eventId ), &args );
 		}
 	}
 }
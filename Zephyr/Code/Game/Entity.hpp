@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
@@ -31,25 +32,6 @@ enum class eFaction
 };
 
 
-//-----------------------------------------------------------------------------------------------
-struct DamageMultiplier
-{
-public:
-	float defaultMultiplier = 1.f;
-	float curMultiplier = 1.f;
-
-public:
-	DamageMultiplier() = default;
-
-	DamageMultiplier( float defaultMultiplier )
-		: defaultMultiplier( defaultMultiplier )
-		, curMultiplier( defaultMultiplier )
-	{ }
-
-	void Reset()					{ curMultiplier = defaultMultiplier; }
-};
-
-
 //-----------------------------------------------------------------------------------------------
 class Entity : public ZephyrEntity
 {
@@ -92,6 +74,7 @@ public:
 	const eFaction		GetFaction() const										{ return m_faction; }
 	void				SetFaction( const eFaction& faction )					{ m_faction = faction; }
 	Map*				GetMap() const											{ return m_map; }
+	RandomNumberGenerator& GetRNG()												{ return m_rng; }
 	void				SetMap( Map* map )										{ m_map = map; }
 		
 	void				AddItemToInventory( Entity* item );
@@ -104,6 +87,9 @@ public:
 	
 	void				MakeInvincibleToAllDamage();
 	void				ResetDamageMultipliers();
+	void				AddNewDamageMultiplier( const DamageTypeId& damageTypeId, float newMultiplier );
+	void				ChangeDamageMultiplier( const DamageTypeId& damageTypeId, float newMultiplier );
+	void				PermanentlyChangeDamageMultiplier( const DamageTypeId& damageTypeId, float newDefaultMultiplier );
 	void				AddNewDamageMultiplier( const std::string& damageType, float newMultiplier );
 	void				ChangeDamageMultiplier( const std::string& damageType, float newMultiplier );
 	void				PermanentlyChangeDamageMultiplier( const std::string& damageType, float newDefaultMultiplier );
@@ -112,6 +98,7 @@ public:
 	bool				IsGarbage() const										{ return m_isGarbage; }
 	bool				IsPlayer() const										{ return m_isPlayer; }
 				 
+	void				TakeDamage( float damage, const DamageTypeId& damageTypeId );
 	void				TakeDamage( float damage, const std::string& type = "normal" );
 	//void				ApplyFriction();
 
@@ -134,9 +121,10 @@ protected:
 	void				EnterTriggerEvent( Collision collision );
 	void				StayTriggerEvent( Collision collision );
 	void				ExitTriggerEvent( Collision collision );
-	void				SendPhysicsEventToScript( Collision collision, const std::string& eventName );
+	void				SendPhysicsEventToScript( Collision collision, const ScriptEventId& eventId );
 
 	char				GetKeyCodeFromString( const std::string& keyCodeStr );
+	DamageMultiplier*	GetDamageMultiplier( const DamageTypeId& damageTypeId );
 
 protected:
 	// Game state
@@ -149,8 +137,9 @@ protected:
 	bool									m_isPlayer = false;
 	Map*									m_map = nullptr;
 	std::vector<Entity*>					m_inventory;									// entity owns all items in inventory
-	std::map<std::string, DamageMultiplier>	m_damageTypeMultipliers;
+	std::vector<DamageMultiplier>			m_damageTypeMultipliers;						// indexed by DamageTypeId, starts as the definition's
 	float									m_baseDamageMultiplier = 1.f;
+	RandomNumberGenerator					m_rng;											// this entity's own stream, so its rolls don't depend on anything else rolling first
 
 	Entity*									m_dialoguePartner = nullptr;
 
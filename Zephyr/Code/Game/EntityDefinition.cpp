@@ -153,6 +153,29 @@ EntityDefinition::EntityDefinition( const XmlElement& entityDefElem, SpriteSheet
 	{
 		m_maxHealth = ParseXmlAttribute( *gameplayElem, "maxHealth", m_maxHealth );
 		m_damageRange = ParseXmlAttribute( *gameplayElem, "damage", m_damageRange );
+
+		// Damage types get their ids here, so entities can look up multipliers by index
+		const XmlElement* damageMultiplierElem = gameplayElem->FirstChildElement( "DamageMultiplier" );
+		while ( damageMultiplierElem != nullptr )
+		{
+			std::string damageType = ParseXmlAttribute( *damageMultiplierElem, "type", "" );
+			if ( damageType.empty() )
+			{
+				g_devConsole->PrintError( Stringf( "EntityTypes.xml: DamageMultiplier in '%s' is missing a type attribute", m_type.c_str() ) );
+			}
+			else
+			{
+				DamageTypeId damageTypeId = DamageTypeRegistry::RegisterName( damageType );
+				if ( damageTypeId.index >= (int)m_damageMultipliers.size() )
+				{
+					m_damageMultipliers.resize( damageTypeId.index + 1 );
+				}
+
+				m_damageMultipliers[damageTypeId.index] = DamageMultiplier( ParseXmlAttribute( *damageMultiplierElem, "multiplier", 1.f ) );
+			}
+
+			damageMultiplierElem = damageMultiplierElem->NextSiblingElement( "DamageMultiplier" );
+		}
 	}
 	
 	m_isValid = true;
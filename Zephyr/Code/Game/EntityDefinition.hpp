@@ -8,6 +8,7 @@
 #include "Game/GameCommon.hpp"
 
 #include <string>
+#include <vector>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -30,6 +31,27 @@ enum class eEntityClass
 std::string GetEntityClassAsString( eEntityClass entityClass );
 
 
+//-----------------------------------------------------------------------------------------------
+struct DamageMultiplier
+{
+public:
+	float defaultMultiplier = 1.f;
+	float curMultiplier = 1.f;
+	bool isDefined = false;
+
+public:
+	DamageMultiplier() = default;
+
+	DamageMultiplier( float defaultMultiplier )
+		: defaultMultiplier( defaultMultiplier )
+		, curMultiplier( defaultMultiplier )
+		, isDefined( true )
+	{ }
+
+	void Reset()					{ curMultiplier = defaultMultiplier; }
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class EntityDefinition : public ZephyrEntityDefinition
 {
@@ -53,6 +75,7 @@ public:
 	bool			IsTrigger() const															{ return m_isTrigger; }
 
 	FloatRange		GetDamageRange() const														{ return m_damageRange; }
+	const std::vector<DamageMultiplier>& GetDamageMultipliers() const							{ return m_damageMultipliers; }
 
 	SpriteAnimationSetDefinition* GetDefaultSpriteAnimSetDef() const							{ return m_defaultSpriteAnimSetDef; }
 	std::map< std::string, SpriteAnimationSetDefinition* > GetSpriteAnimSetDefs() const			{ return m_spriteAnimSetDefs; }
@@ -77,6 +100,7 @@ protected:
 	float			m_speed = 0.f;
 
 	FloatRange		m_damageRange = FloatRange( 0.f );
+	std::vector<DamageMultiplier> m_damageMultipliers;											// indexed by DamageTypeId
 
 	AABB2			m_localDrawBounds;
 	AABB2			m_uvCoords = AABB2::ONE_BY_ONE;
@@ -14,10 +14,12 @@
 #include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/OS/Window.hpp"
+#include "Engine/Pathfinding/GridPathfinder.hpp"
 #include "Engine/Physics/PhysicsSystem.hpp"
 #include "Engine/Physics/PhysicsCommon.hpp"
 #include "Engine/Physics/2D/DiscCollider.hpp"
 #include "Engine/Physics/2D/Polygon2Collider.hpp"
+#include "Engine/Physics/2D/TileGridCollider.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Camera.hpp"
@@ -85,6 +87,7 @@ void Game::Startup()
 	m_physicsSystem->Startup( m_gameClock );
 	g_colliderFactory->RegisterCreator( "disc", &DiscCollider::Create );
 	g_colliderFactory->RegisterCreator( "polygon2", &Polygon2Collider::Create );
+	g_colliderFactory->RegisterCreator( "tile_grid", &TileGridCollider::Create );
 	g_physicsConfig->PopulateFromXml();
 
 	//DisableAllPhysicsLayerInteraction( eCollisionLayer::NONE );
@@ -112,6 +115,7 @@ void Game::Startup()
 	m_dataPathSuffix = g_gameConfigBlackboard.GetValue( std::string( "dataPathSuffix" ), "" );
 	
 	g_eventSystem->RegisterMethodEvent( "print_bytecode_chunk", "Usage: print_bytecode_chunk entityName=<> chunkName=<>", eUsageLocation::DEV_CONSOLE, this, &Game::PrintBytecodeChunk );
+	g_eventSystem->RegisterEvent( "benchmark_pathfinding", "Usage: benchmark_pathfinding size=128 paths=1000 density=.3. Compare A* and JPS on a random grid and time a batch of async requests.", eUsageLocation::DEV_CONSOLE, BenchmarkPathfindingEvent );
 
 	g_devConsole->PrintString( "Game Started", Rgba8::GREEN );
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include "Engine/Core/NameIdRegistry.hpp"
+
 #include <string>
 
 class Window;
@@ -35,6 +37,18 @@ class GJK2DCollision;
 typedef PhysicsSystem<GJK2DCollision> PhysicsSystem2D;
 
 
+//-----------------------------------------------------------------------------------------------
+// Interned names, registered while loading data
+//-----------------------------------------------------------------------------------------------
+struct DamageTypeTag {};
+struct ScriptEventTag {};
+
+typedef NameId<DamageTypeTag> DamageTypeId;
+typedef NameId<ScriptEventTag> ScriptEventId;
+typedef NameIdRegistry<DamageTypeTag> DamageTypeRegistry;
+typedef NameIdRegistry<ScriptEventTag> ScriptEventRegistry;
+
+
 //-----------------------------------------------------------------------------------------------
 // Global Functions
 //
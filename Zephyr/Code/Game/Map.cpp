@@ -2,6 +2,7 @@
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Math/Transform.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
 #include "Engine/Physics/PhysicsCommon.hpp"
@@ -41,15 +42,13 @@ Map::Map( const MapData& mapData, World* world )
 //-----------------------------------------------------------------------------------------------
 Map::~Map()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		if ( m_entities[entityIdx] != nullptr )
-		{
-			PTR_SAFE_DELETE( m_entities[entityIdx] );
-		}
+		Entity* entity = m_entities[entityIdx];
+		PTR_SAFE_DELETE( entity );
 	}
 
-	m_entities.clear();
+	m_entities.Clear();
 
 	PTR_SAFE_DELETE( m_physicsScene );
 }
@@ -64,12 +63,9 @@ void Map::Load( Entity* player )
 		return;
 	}
 
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		if ( m_entities[entityIdx] != nullptr )
-		{
-			m_entities[entityIdx]->Load();
-		}
+		m_entities[entityIdx]->Load();
 	}
 	
 	m_player = player;
@@ -86,18 +82,11 @@ void Map::Load( Entity* player )
 void Map::Unload()
 {
 	// Remove reference to player from this map
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		if ( m_entities[entityIdx] == m_player )
-		{
-			m_entities[entityIdx] = nullptr;
-			continue;
-		}
+	m_entities.Remove( m_player );
 
-		if ( m_entities[entityIdx] != nullptr )
-		{
-			m_entities[entityIdx]->Unload();
-		}
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
+	{
+		m_entities[entityIdx]->Unload();
 	}
 
 	m_player->m_rigidbody->Destroy();
@@ -114,15 +103,17 @@ void Map::Update( float deltaSeconds )
 	LARGE_INTEGER ticksBefore;
 	QueryPerformanceCounter( &ticksBefore );
 	
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); )
 	{
-		Entity* const& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
+		Entity* entity = m_entities[entityIdx];
+		entity->Update( deltaSeconds );
+
+		// An entity that left the map during its update had the last entity swapped into its place
+		if ( entityIdx < m_entities.GetCount()
+			 && m_entities[entityIdx] == entity )
 		{
-			continue;
+			++entityIdx;
 		}
-
-		entity->Update( deltaSeconds );
 	}
 
 	LARGE_INTEGER ticksAfter;
@@ -130,7 +121,7 @@ void Map::Update( float deltaSeconds )
 
 	double msElapsed = (double)( ticksAfter.QuadPart - ticksBefore.QuadPart ) * 1000.0 / (double)frequency.QuadPart ;
 
-	DebugAddScreenTextf( Vec4( 0.f, .05f, 10.f, 10.f ), Vec2::ZERO, 32.f, Rgba8::WHITE, Rgba8::WHITE, 0.f, "Entity Count: %d", (int)m_entities.size() );
+	DebugAddScreenTextf( Vec4( 0.f, .05f, 10.f, 10.f ), Vec2::ZERO, 32.f, Rgba8::WHITE, Rgba8::WHITE, 0.f, "Entity Count: %d", m_entities.GetCount() );
 	DebugAddScreenTextf( Vec4( 0.f, 0.f, 10.f, 10.f ), Vec2::ZERO, 32.f, Rgba8::WHITE, Rgba8::WHITE, 0.f, "Update Time: %.2f ms", msElapsed );
 
 	g_game->GetCurrentPhysicsSystem()->Update( *m_physicsScene );
@@ -144,14 +135,9 @@ void Map::Update( float deltaSeconds )
 //-----------------------------------------------------------------------------------------------
 void Map::Render() const
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity* const& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->Render();
 	}
 }
@@ -160,14 +146,9 @@ void Map::Render() const
 //-----------------------------------------------------------------------------------------------
 void Map::DebugRender() const
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity* const& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->DebugRender();
 	}
 }
@@ -257,14 +238,9 @@ Entity* Map::SpawnNewEntityOfTypeAtPosition( const std::string& entityDefName, c
 //-----------------------------------------------------------------------------------------------
 void Map::UnloadAllEntityScripts()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->UnloadZephyrScript();
 	}
 }
@@ -273,14 +249,9 @@ void Map::UnloadAllEntityScripts()
 //-----------------------------------------------------------------------------------------------
 void Map::ReloadAllEntityScripts()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->ReloadZephyrScript();
 	}
 }
@@ -289,14 +260,9 @@ void Map::ReloadAllEntityScripts()
 //-----------------------------------------------------------------------------------------------
 void Map::InitializeAllZephyrEntityVariables()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
+		Entity* entity = m_entities[entityIdx];
 		entity->InitializeZephyrEntityVariables();
 	}
 }
@@ -305,11 +271,10 @@ void Map::InitializeAllZephyrEntityVariables()
 //-----------------------------------------------------------------------------------------------
 void Map::CallAllMapEntityZephyrSpawnEvents( Entity* player )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr 
-			 || entity == player )
+		Entity* entity = m_entities[entityIdx];
+		if ( entity == player )
 		{
 			continue;
 		}
@@ -322,37 +287,15 @@ void Map::CallAllMapEntityZephyrSpawnEvents( Entity* player )
 //-----------------------------------------------------------------------------------------------
 void Map::RemoveOwnershipOfEntity( Entity* entityToRemove )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			continue;
-		}
-
-		if ( entity == entityToRemove )
-		{
-			m_entities[entityIdx] = nullptr;
-		}
-	}
+	m_entities.Remove( entityToRemove );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Map::TakeOwnershipOfEntity( Entity* entityToAdd )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr )
-		{
-			entity = entityToAdd;
-			return;
-		}
-	}
-
 	entityToAdd->m_map = this;
-	m_entities.push_back( entityToAdd );
+	m_entities.Add( entityToAdd );
 }
 
 
@@ -418,36 +361,26 @@ void Map::LoadEntities( const std::vector<MapEntityDefinition>& mapEntityDefs )
 //-----------------------------------------------------------------------------------------------
 void Map::AddToEntityList( Entity* entity )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
-	{
-		if ( m_entities[entityIdx] == nullptr )
-		{
-			m_entities[entityIdx] = entity;
-			return;
-		}
-	}
-
-	m_entities.push_back( entity );
+	m_entities.Add( entity );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void Map::DeleteDeadEntities()
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	// Walk backwards so the entity swapped into a removed slot has already been checked
+	for ( int entityIdx = m_entities.GetCount() - 1; entityIdx >= 0; --entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || !entity->IsDead() )
+		Entity* entity = m_entities[entityIdx];
+		if ( !entity->IsDead() )
 		{
 			continue;
 		}
 		
 		m_world->RemoveEntityFromWorldById( entity->GetId() );
 
+		m_entities.RemoveAtIndex( entityIdx );
 		PTR_SAFE_DELETE( entity );
-
-		m_entities[entityIdx] = nullptr;
 	}
 }
 
@@ -462,11 +395,10 @@ void Map::WarpEntityInMap( Entity* entity, Portal* portal )
 //-----------------------------------------------------------------------------------------------
 Entity* Map::GetEntityByName( const std::string& name )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || entity->IsDead() )
+		Entity* entity = m_entities[entityIdx];
+		if ( entity->IsDead() )
 		{
 			continue;
 		}
@@ -484,33 +416,24 @@ Entity* Map::GetEntityByName( const std::string& name )
 //-----------------------------------------------------------------------------------------------
 Entity* Map::GetEntityById( EntityId id )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	Entity* entity = m_entities.GetById( id );
+	if ( entity == nullptr
+		 || entity->IsDead() )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || entity->IsDead() )
-		{
-			continue;
-		}
-
-		if ( entity->GetId() == id )
-		{
-			return entity;
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	return entity;
 }
 
 
 //-----------------------------------------------------------------------------------------------
 Entity* Map::GetEntityAtPosition( const Vec2& position )
 {
-	for ( int entityIdx = 0; entityIdx < (int)m_entities.size(); ++entityIdx )
+	for ( int entityIdx = 0; entityIdx < m_entities.GetCount(); ++entityIdx )
 	{
-		Entity*& entity = m_entities[entityIdx];
-		if ( entity == nullptr
-			 || entity->IsDead() )
+		Entity* entity = m_entities[entityIdx];
+		if ( entity->IsDead() )
 		{
 			continue;
 		}
@@ -523,3 +446,35 @@ Entity* Map::GetEntityAtPosition( const Vec2& position )
 
 	return nullptr;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 Map::GetPathDirection( Entity& entity, const Vec2& targetPos )
+{
+	return ( targetPos - entity.GetPosition().XY() ).GetNormalized();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 Map::GetChaseDirection( Entity& entity, const Entity& targetEntity )
+{
+	return ( targetEntity.GetPosition().XY() - entity.GetPosition().XY() ).GetNormalized();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 Map::GetFleeDirection( Entity& entity, const Entity& targetEntity )
+{
+	return ( entity.GetPosition().XY() - targetEntity.GetPosition().XY() ).GetNormalized();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 Map::GetRandomWanderPosition( RandomNumberGenerator& rng ) const
+{
+	Vec2 mapDimensions = GetDimensions();
+	float newX = rng.RollRandomFloatInRange( 2.f, mapDimensions.x - 2.f );
+	float newY = rng.RollRandomFloatInRange( 2.f, mapDimensions.y - 2.f );
+
+	return Vec2( newX, newY );
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include "Engine/Framework/EntityStore.hpp"
+
 #include "Game/Tile.hpp"
 #include "Game/Entity.hpp"
 #include "Game/GameCommon.hpp"
@@ -75,6 +77,12 @@ public:
 
 	Entity* GetEntityAtPosition( const Vec2& position );
 
+	// Steering for scripted movement, maps without navigation data go in a straight line
+	virtual Vec2 GetPathDirection( Entity& entity, const Vec2& targetPos );
+	virtual Vec2 GetChaseDirection( Entity& entity, const Entity& targetEntity );
+	virtual Vec2 GetFleeDirection( Entity& entity, const Entity& targetEntity );
+	virtual Vec2 GetRandomWanderPosition( RandomNumberGenerator& rng ) const;
+
 private:
 	void LoadEntities( const std::vector<MapEntityDefinition>& mapEntityDefs );
 	
@@ -94,5 +102,5 @@ protected:
 	float						m_playerStartYaw = 0.f;
 
 	Entity*						m_player = nullptr;
-	std::vector<Entity*>		m_entities;
+	EntityStore<Entity>			m_entities;
 };
@@ -42,7 +42,7 @@ void Portal::EnterTriggerEvent( Collision collision )
 {
 	if ( !IsDead() )
 	{
-		EntityId theirEntityId = collision.theirCollider->GetRigidbody()->m_userProperties.GetValue( "entityId", (EntityId)-1 );
+		EntityId theirEntityId = collision.theirCollider->GetRigidbody()->GetUserProperties().GetValue( "entityId", (EntityId)-1 );
 
 		Entity* theirEntity = g_game->GetEntityById( theirEntityId );
 		if ( theirEntity != nullptr )
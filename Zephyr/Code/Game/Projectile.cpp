@@ -12,7 +12,7 @@
 Projectile::Projectile( const EntityDefinition& entityDef, Map* map )
 	: Entity( entityDef, map )
 {
-	m_damage = entityDef.GetDamageRange().GetRandomInRange( g_game->m_rng );
+	m_damage = entityDef.GetDamageRange().GetRandomInRange( &m_rng );
 
 	m_rigidbody->SetDrag( 0.f );
 }
@@ -522,7 +522,10 @@ void ZephyrGameAPI::WinGame( EventArgs* args )
 
 //-----------------------------------------------------------------------------------------------
 /**
- * Move an entity towards a location.
+ * Move an entity towards a location, following a path around walls when the map has one.
+ *
+ * returns:
+ *	- Fires the PathFound event once a path has been searched for, with parameters "found" (Bool), "goalPos" (Vec2), and "numWaypoints" (Number)
  *
  * params:
  *	- pos: target position
@@ -542,8 +545,13 @@ void ZephyrGameAPI::MoveToLocation( EventArgs* args )
 		return;
 	}
 
-	Vec2 moveDirection = targetPos - entity->GetPosition().XY();
-	moveDirection.Normalize();
+	Map* map = entity->GetMap();
+	if ( map == nullptr )
+	{
+		return;
+	}
+
+	Vec2 moveDirection = map->GetPathDirection( *entity, targetPos );
 
 	float speed = args->GetValue( "speed", entity->GetSpeed() );
 
@@ -587,7 +595,7 @@ void ZephyrGameAPI::MoveInDirection( EventArgs* args )
 
 //-----------------------------------------------------------------------------------------------
 /**
- * Move the entity that fired this event towards a target entity.
+ * Move the entity that fired this event towards a target entity, around walls when the map has a path.
  *
  * params:
  *	Target will be determined by the following optional parameters, checking in order the targetId, then targetName. If neither is specified the entity won't move.
@@ -613,8 +621,13 @@ void ZephyrGameAPI::ChaseTargetEntity( EventArgs* args )
 		return;
 	}
 
-	Vec2 moveDirection = targetEntity->GetPosition().XY() - entity->GetPosition().XY();
-	moveDirection.Normalize();
+	Map* map = entity->GetMap();
+	if ( map == nullptr )
+	{
+		return;
+	}
+
+	Vec2 moveDirection = map->GetChaseDirection( *entity, *targetEntity );
 
 	float speed = args->GetValue( "speed", entity->GetSpeed() );
 
@@ -624,7 +637,7 @@ void ZephyrGameAPI::ChaseTargetEntity( EventArgs* args )
 
 //-----------------------------------------------------------------------------------------------
 /**
- * Move the entity that fired this event away from a target entity.
+ * Move the entity that fired this event away from a target entity, toward open ground rather than into walls when the map allows.
  *
  * params:
  *	Target will be determined by the following optional parameters, checking in order the targetId, then targetName. If neither is specified the entity won't move.
@@ -650,12 +663,17 @@ void ZephyrGameAPI::FleeTargetEntity( EventArgs* args )
 		return;
 	}
 
-	Vec2 moveDirection = targetEntity->GetPosition().XY() - entity->GetPosition().XY();
-	moveDirection.Normalize();
+	Map* map = entity->GetMap();
+	if ( map == nullptr )
+	{
+		return;
+	}
+
+	Vec2 moveDirection = map->GetFleeDirection( *entity, *targetEntity );
 
 	float speed = args->GetValue( "speed", entity->GetSpeed() );
 
-	entity->MoveWithPhysics( speed, -moveDirection );
+	entity->MoveWithPhysics( speed, moveDirection );
 }
 
 
@@ -695,7 +713,7 @@ void ZephyrGameAPI::GetEntityLocation( EventArgs* args )
 
 //-----------------------------------------------------------------------------------------------
 /**
- * Gets a new random position inside current map for the calling entity to wander towards.
+ * Gets a new random position inside current map for the calling entity to wander towards, on an open tile when the map has tiles.
  *
  * returns:
  *	- Fires the TargetPositionUpdated event with a parameter "newPos" containing a Vec2 with the requested position
@@ -722,11 +740,7 @@ void ZephyrGameAPI::GetNewWanderTargetPosition( EventArgs* args )
 		return;
 	}
 
-	Vec2 mapDimensions = map->GetDimensions();
-	float newX = g_game->m_rng->RollRandomFloatInRange( 2.f, mapDimensions.x - 2.f );
-	float newY = g_game->m_rng->RollRandomFloatInRange( 2.f, mapDimensions.y - 2.f );
-	
-	args->SetValue( "newPos", Vec2( newX, newY ) );
+	args->SetValue( "newPos", map->GetRandomWanderPosition( entity->GetRNG() ) );
 
 	//entity->FireScriptEvent( "TargetPositionUpdated", &targetArgs );
 }
@@ -915,9 +929,17 @@ void ZephyrGameAPI::SpawnEntitiesInRange( EventArgs* args )
 		return;
 	}
 
+	// Roll on the spawner's own stream when there is one so spawns replay the same way
+	RandomNumberGenerator* rng = g_game->m_rng;
+	Entity* spawner = (Entity*)args->GetValue( "entity", ( void* )nullptr );
+	if ( spawner != nullptr )
+	{
+		rng = &spawner->GetRNG();
+	}
+
 	for ( int i = 0; i < entityCount; ++i )
 	{
-		Vec2 randomPosition = Vec2( g_game->m_rng->RollRandomFloatInRange( minPos.x, maxPos.x ), g_game->m_rng->RollRandomFloatInRange( minPos.y, maxPos.y ) );
+		Vec2 randomPosition = Vec2( rng->RollRandomFloatInRange( minPos.x, maxPos.x ), rng->RollRandomFloatInRange( minPos.y, maxPos.y ) );
 		args->SetValue( "position", randomPosition );
 		g_eventSystem->FireEvent( "SpawnEntity", args );
 	}
@@ -1,4 +1,6 @@
 #include "Game/TileMap.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EventSystem.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Math/MathUtils.hpp"
@@ -8,6 +10,8 @@
 #include "Engine/Physics/PhysicsCommon.hpp"
 #include "Engine/Physics/PhysicsScene.hpp"
 #include "Engine/Physics/Rigidbody.hpp"
+#include "Engine/Physics/2D/TileGridCollider.hpp"
+#include "Engine/Physics/CollisionResolvers/CollisionPolicies.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
@@ -15,6 +19,7 @@
 #include "Engine/Renderer/MeshUtils.hpp"
 #include "Engine/Renderer/GPUMesh.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
+#include "Engine/Time/Time.hpp"
 
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
@@ -45,14 +50,28 @@ void TileMap::Load( Entity* player )
 {
 	Map::Load( player );
 
-	CreateTileRigidbodies();
+	CreateTileGridRigidbody();
+
+	std::vector<byte> solidCells;
+	GetSolidCells( solidCells );
+	m_pathfinder.SetGrid( m_dimensions, solidCells );
+
+	g_eventSystem->RegisterMethodEvent( "benchmark_tile_colliders", "Usage: benchmark_tile_colliders discs=200 steps=120. Compare per tile rigidbodies with the merged tile grid collider on this map.", eUsageLocation::DEV_CONSOLE, this, &TileMap::BenchmarkTileColliders );
 }
 
 
 //-----------------------------------------------------------------------------------------------
 void TileMap::Unload()
 {
-	DestroyTileRigidbodies();
+	g_eventSystem->DeRegisterObject( this );
+
+	DestroyTileGridRigidbody();
+
+	// Nobody is left to answer, let the batch in flight land and drop it
+	m_pathfinder.FinishPendingRequests();
+	m_pathfinder.ClaimCompletedResults( m_completedPathResults );
+	m_completedPathResults.clear();
+	m_navPaths.clear();
 
 	Map::Unload();
 }
@@ -63,6 +82,9 @@ void TileMap::Update( float deltaSeconds )
 {
 	Map::Update( deltaSeconds );
 
+	m_pathfinder.Update();
+	UpdateNavPaths();
+
 	UpdateCameras();
 }
 
@@ -327,40 +349,306 @@ void TileMap::BuildCardinalDirectionsArray()
 
 
 //-----------------------------------------------------------------------------------------------
-void TileMap::CreateTileRigidbodies()
+// One collider for the whole map instead of one per solid tile, the broadphase used to pair every
+// moving body with every wall tile each step
+//-----------------------------------------------------------------------------------------------
+void TileMap::CreateTileGridRigidbody()
+{
+	std::vector<byte> solidCells;
+	GetSolidCells( solidCells );
+
+	NamedProperties params;
+	params.SetValue( "cellSize", TILE_SIZE );
+
+	TileGridCollider* tileGridCollider = (TileGridCollider*)m_physicsScene->CreateCollider( "tile_grid", &params );
+	tileGridCollider->SetSolidCells( m_dimensions, solidCells );
+
+	m_tileGridRigidbody = m_physicsScene->CreateRigidbody();
+	m_tileGridRigidbody->TakeCollider( tileGridCollider );
+	m_tileGridRigidbody->SetSimulationMode( SIMULATION_MODE_STATIC );
+	m_tileGridRigidbody->SetPosition( Vec3::ZERO );
+	m_tileGridRigidbody->SetLayer( eCollisionLayer::STATIC_ENVIRONMENT );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::DestroyTileGridRigidbody()
 {
-	m_tileRigidbodies.reserve( m_tiles.size() );
+	if ( m_tileGridRigidbody != nullptr )
+	{
+		m_tileGridRigidbody->Destroy();
+		m_tileGridRigidbody = nullptr;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::GetSolidCells( std::vector<byte>& out_solidCells ) const
+{
+	out_solidCells.resize( m_tiles.size() );
 
 	for ( int tileIdx = 0; tileIdx < (int)m_tiles.size(); ++tileIdx )
 	{
-		if ( m_tiles[tileIdx].IsSolid() )
+		out_solidCells[tileIdx] = m_tiles[tileIdx].IsSolid() ? 1 : 0;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void TileMap::UpdateNavPaths()
+{
+	m_pathfinder.ClaimCompletedResults( m_completedPathResults );
+
+	for ( int resultIdx = 0; resultIdx < (int)m_completedPathResults.size(); ++resultIdx )
+	{
+		GridPathResult& result = m_completedPathResults[resultIdx];
+
+		auto navPathIter = m_navPaths.find( (EntityId)result.ownerId );
+		if ( navPathIter == m_navPaths.end()
+			 || navPathIter->second.pendingRequestId != result.requestId )
 		{
-			Rigidbody* rigidbody = m_physicsScene->CreateRigidbody();
+			// Asked for somewhere else since
+			continue;
+		}
 
-			NamedProperties params;
-			params.SetValue( "polygon2", m_tiles[tileIdx].GetBounds().GetAsPolygon2() );
+		Entity* entity = GetEntityById( (EntityId)result.ownerId );
+		if ( entity == nullptr )
+		{
+			m_navPaths.erase( navPathIter );
+			continue;
+		}
 
-			Collider* polygonCollider = m_physicsScene->CreateCollider( "polygon2", &params );
-			rigidbody->TakeCollider( polygonCollider );
-			rigidbody->SetSimulationMode( SIMULATION_MODE_STATIC );
-			rigidbody->SetPosition( Vec3( m_tiles[tileIdx].GetBounds().GetCenter(), 0.f ) );
-			rigidbody->SetLayer( eCollisionLayer::STATIC_ENVIRONMENT );
+		TileMapNavPath& navPath = navPathIter->second;
+		navPath.waypoints.swap( result.path );
+		navPath.nextWaypointIdx = 1;
+		navPath.pendingRequestId = -1;
+
+		EventArgs args;
+		args.SetValue( "found", result.didFindPath );
+		args.SetValue( "goalPos", GetWorldCoordsFromTileCenter( result.goal ) );
+		args.SetValue( "numWaypoints", (float)navPath.waypoints.size() );
+
+		entity->FireScriptEvent( "PathFound", &args );
+	}
+
+	m_completedPathResults.clear();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Asks for a path the first time an entity heads somewhere and steers straight at the target
+// until the answer comes back a frame or two later, or if there's no way through
+//-----------------------------------------------------------------------------------------------
+Vec2 TileMap::GetPathDirection( Entity& entity, const Vec2& targetPos )
+{
+	Vec2 entityPos = entity.GetPosition().XY();
+	IntVec2 startCell = GetTileCoordsFromWorldCoords( entityPos );
+	IntVec2 goalCell = GetTileCoordsFromWorldCoords( targetPos );
+	if ( startCell == goalCell
+		 || !m_pathfinder.IsWalkable( startCell )
+		 || !m_pathfinder.IsWalkable( goalCell ) )
+	{
+		return Map::GetPathDirection( entity, targetPos );
+	}
 
-			m_tileRigidbodies.push_back( rigidbody );
+	TileMapNavPath& navPath = m_navPaths[entity.GetId()];
+	bool isPathStale = navPath.goalCell != goalCell
+						|| navPath.gridVersion != m_pathfinder.GetGridVersion()
+						|| ( navPath.pendingRequestId < 0 && navPath.waypoints.empty() && navPath.nextWaypointIdx == 0 );
+	if ( isPathStale )
+	{
+		navPath = TileMapNavPath();
+		navPath.goalCell = goalCell;
+		navPath.gridVersion = m_pathfinder.GetGridVersion();
+		navPath.pendingRequestId = m_pathfinder.RequestPath( (int)entity.GetId(), startCell, goalCell );
+	}
+
+	if ( navPath.pendingRequestId >= 0
+		 || navPath.waypoints.empty() )
+	{
+		return Map::GetPathDirection( entity, targetPos );
+	}
+
+	while ( navPath.nextWaypointIdx < (int)navPath.waypoints.size() )
+	{
+		Vec2 waypointPos = GetWorldCoordsFromTileCenter( navPath.waypoints[navPath.nextWaypointIdx] );
+		if ( GetDistance2D( entityPos, waypointPos ) > TILE_SIZE * .25f )
+		{
+			return ( waypointPos - entityPos ).GetNormalized();
 		}
+
+		++navPath.nextWaypointIdx;
 	}
+
+	return Map::GetPathDirection( entity, targetPos );
 }
 
 
 //-----------------------------------------------------------------------------------------------
-void TileMap::DestroyTileRigidbodies()
+// Every entity chasing the same target shares one flow field toward the target's tile
+//-----------------------------------------------------------------------------------------------
+Vec2 TileMap::GetChaseDirection( Entity& entity, const Entity& targetEntity )
 {
-	for ( int rigidbodyIdx = 0; rigidbodyIdx < (int)m_tileRigidbodies.size(); ++rigidbodyIdx )
+	IntVec2 entityCell = GetTileCoordsFromWorldCoords( entity.GetPosition().XY() );
+	IntVec2 targetCell = GetTileCoordsFromWorldCoords( targetEntity.GetPosition().XY() );
+
+	Vec2 flowDirection;
+	if ( entityCell != targetCell
+		 && m_pathfinder.GetFlowDirection( targetCell, entityCell, flowDirection ) )
 	{
-		m_tileRigidbodies[rigidbodyIdx]->Destroy();
+		return flowDirection;
 	}
 
-	m_tileRigidbodies.clear();
+	return Map::GetChaseDirection( entity, targetEntity );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 TileMap::GetFleeDirection( Entity& entity, const Entity& targetEntity )
+{
+	IntVec2 entityCell = GetTileCoordsFromWorldCoords( entity.GetPosition().XY() );
+	IntVec2 targetCell = GetTileCoordsFromWorldCoords( targetEntity.GetPosition().XY() );
+
+	Vec2 fleeDirection;
+	if ( m_pathfinder.GetFleeDirection( targetCell, entityCell, fleeDirection ) )
+	{
+		return fleeDirection;
+	}
+
+	return Map::GetFleeDirection( entity, targetEntity );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 TileMap::GetRandomWanderPosition( RandomNumberGenerator& rng ) const
+{
+	// Dense maps could miss for a while, fall back to anywhere inside the walls
+	for ( int attemptNum = 0; attemptNum < 32; ++attemptNum )
+	{
+		IntVec2 tileCoords( rng.RollRandomIntLessThan( m_dimensions.x ), rng.RollRandomIntLessThan( m_dimensions.y ) );
+		if ( m_pathfinder.IsWalkable( tileCoords ) )
+		{
+			return GetWorldCoordsFromTileCenter( tileCoords );
+		}
+	}
+
+	return Map::GetRandomWanderPosition( rng );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Runs the collision step on throwaway scenes so the live map isn't touched. Integration costs the
+// same either way, so only the broadphase and narrowphase are timed
+//-----------------------------------------------------------------------------------------------
+void TileMap::BenchmarkTileColliders( EventArgs* args )
+{
+	int numDiscs = args->GetValue( "discs", 200 );
+	int numSteps = args->GetValue( "steps", 120 );
+	if ( numDiscs <= 0
+		 || numSteps <= 0 )
+	{
+		g_devConsole->PrintError( "benchmark_tile_colliders: discs and steps must be positive" );
+		return;
+	}
+
+	std::vector<byte> solidCells;
+	GetSolidCells( solidCells );
+
+	std::vector<int> openTileIndexes;
+	for ( int tileIdx = 0; tileIdx < (int)solidCells.size(); ++tileIdx )
+	{
+		if ( solidCells[tileIdx] == 0 )
+		{
+			openTileIndexes.push_back( tileIdx );
+		}
+	}
+
+	if ( openTileIndexes.empty() )
+	{
+		g_devConsole->PrintError( "benchmark_tile_colliders: map has no open tiles to place discs on" );
+		return;
+	}
+
+	g_devConsole->PrintString( Stringf( "Stepping %i discs for %i steps on %ix%i tiles", numDiscs, numSteps, m_dimensions.x, m_dimensions.y ) );
+
+	const char* modeNames[] = { "Rigidbody per tile", "Tile grid, unmerged", "Tile grid, merged" };
+	double perTileSeconds = 0.0;
+	for ( int modeIdx = 0; modeIdx < 3; ++modeIdx )
+	{
+		PhysicsScene scene;
+		int numTileColliders = 0;
+
+		if ( modeIdx == 0 )
+		{
+			for ( int tileIdx = 0; tileIdx < (int)m_tiles.size(); ++tileIdx )
+			{
+				if ( solidCells[tileIdx] == 0 )
+				{
+					continue;
+				}
+
+				NamedProperties params;
+				params.SetValue( "polygon2", m_tiles[tileIdx].GetBounds().GetAsPolygon2() );
+
+				Rigidbody* rigidbody = scene.CreateRigidbody();
+				rigidbody->TakeCollider( scene.CreateCollider( "polygon2", &params ) );
+				rigidbody->SetSimulationMode( SIMULATION_MODE_STATIC );
+				rigidbody->SetPosition( Vec3( m_tiles[tileIdx].GetBounds().GetCenter(), 0.f ) );
+				rigidbody->SetLayer( eCollisionLayer::STATIC_ENVIRONMENT );
+				++numTileColliders;
+			}
+		}
+		else
+		{
+			NamedProperties params;
+			params.SetValue( "cellSize", TILE_SIZE );
+
+			TileGridCollider* tileGridCollider = (TileGridCollider*)scene.CreateCollider( "tile_grid", &params );
+			tileGridCollider->SetSolidCells( m_dimensions, solidCells, modeIdx == 2 );
+
+			Rigidbody* rigidbody = scene.CreateRigidbody();
+			rigidbody->TakeCollider( tileGridCollider );
+			rigidbody->SetSimulationMode( SIMULATION_MODE_STATIC );
+			rigidbody->SetPosition( Vec3::ZERO );
+			rigidbody->SetLayer( eCollisionLayer::STATIC_ENVIRONMENT );
+			numTileColliders = tileGridCollider->GetNumRects();
+		}
+
+		// Default seed every mode so each one steps the same discs
+		RandomNumberGenerator rng;
+		for ( int discIdx = 0; discIdx < numDiscs; ++discIdx )
+		{
+			const Tile& tile = m_tiles[openTileIndexes[rng.RollRandomIntLessThan( (int)openTileIndexes.size() )]];
+
+			NamedProperties params;
+			params.SetValue( "radius", .3f );
+
+			Rigidbody* rigidbody = scene.CreateRigidbody();
+			rigidbody->TakeCollider( scene.CreateCollider( "disc", &params ) );
+			rigidbody->SetSimulationMode( SIMULATION_MODE_DYNAMIC );
+			rigidbody->SetPosition( Vec3( tile.GetBounds().GetCenter(), 0.f ) );
+			rigidbody->SetLayer( eCollisionLayer::PLAYER );
+		}
+
+		PhysicsStepStats stats;
+		double startTime = GetCurrentTimeSeconds();
+		for ( int stepIdx = 0; stepIdx < numSteps; ++stepIdx )
+		{
+			GJK2DCollision::ResolveCollisions( scene.colliders, scene.collisions, (uint)stepIdx, stats );
+		}
+		double elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+
+		if ( modeIdx == 0 )
+		{
+			perTileSeconds = elapsedSeconds;
+		}
+
+		g_devConsole->PrintString( Stringf( "  %s: %i tile colliders, %i pairs, %.3f ms per step (%.1fx)",
+											modeNames[modeIdx], numTileColliders, stats.numPairsTested,
+											elapsedSeconds * 1000.0 / (double)numSteps, perTileSeconds / elapsedSeconds ) );
+
+		scene.Reset();
+	}
 }
 
 
@@ -422,6 +710,20 @@ int TileMap::GetTileIndexFromWorldCoords( const Vec2& coords ) const
 }
 
 
+//-----------------------------------------------------------------------------------------------
+IntVec2 TileMap::GetTileCoordsFromWorldCoords( const Vec2& worldCoords ) const
+{
+	return IntVec2( (int)floorf( worldCoords.x / TILE_SIZE ), (int)floorf( worldCoords.y / TILE_SIZE ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+Vec2 TileMap::GetWorldCoordsFromTileCenter( const IntVec2& tileCoords ) const
+{
+	return Vec2( ( (float)tileCoords.x + .5f ) * TILE_SIZE, ( (float)tileCoords.y + .5f ) * TILE_SIZE );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 const Tile* TileMap::GetTileFromTileCoords( const IntVec2& tileCoords ) const
 {
@@ -1,6 +1,9 @@
 #pragma once
 #include "Game/Map.hpp"
 #include "Engine/Math/Transform.hpp"
+#include "Engine/Pathfinding/GridPathfinder.hpp"
+
+#include <map>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -25,6 +28,19 @@ enum class eCardinalDirection
 };
 
 
+//-----------------------------------------------------------------------------------------------
+// Path an entity is walking, the waypoints are jump points so each leg is a straight or diagonal run
+struct TileMapNavPath
+{
+public:
+	IntVec2 goalCell = IntVec2::ZERO;
+	std::vector<IntVec2> waypoints;
+	int nextWaypointIdx = 0;
+	int pendingRequestId = -1;
+	uint gridVersion = 0;
+};
+
+
 //-----------------------------------------------------------------------------------------------
 class TileMap : public Map
 {
@@ -47,6 +63,14 @@ public:
 	//RaycastResult			RaycastAgainstEntities( const Vec2& startPos, const Vec2& forwardNormal, float maxDist ) const;
 	//RaycastResult			RaycastAgainstEntitiesFast( const Vec2& startPos, const Vec2& forwardNormal, float maxDist ) const;
 
+	// Compares collision step time with one polygon rigidbody per tile against the tile grid collider
+	void					BenchmarkTileColliders( EventArgs* args );
+
+	virtual Vec2			GetPathDirection( Entity& entity, const Vec2& targetPos ) override;
+	virtual Vec2			GetChaseDirection( Entity& entity, const Entity& targetEntity ) override;
+	virtual Vec2			GetFleeDirection( Entity& entity, const Entity& targetEntity ) override;
+	virtual Vec2			GetRandomWanderPosition( RandomNumberGenerator& rng ) const override;
+
 private:
 	void						PopulateTiles( const std::vector<TileDefinition*>& tileDefs );
 	void						CreateInitialTiles( const std::vector<TileDefinition*>& tileDefs );
@@ -70,8 +94,15 @@ private:
 	
 	void						BuildCardinalDirectionsArray();
 	
-	void						CreateTileRigidbodies();
-	void						DestroyTileRigidbodies();
+	// Every solid tile shares one static rigidbody with a tile grid collider
+	void						CreateTileGridRigidbody();
+	void						DestroyTileGridRigidbody();
+	void						GetSolidCells( std::vector<byte>& out_solidCells ) const;
+
+	// Hands finished path requests to their entities and fires PathFound on them
+	void						UpdateNavPaths();
+	IntVec2						GetTileCoordsFromWorldCoords( const Vec2& worldCoords ) const;
+	Vec2						GetWorldCoordsFromTileCenter( const IntVec2& tileCoords ) const;
 
 private:
 	Transform				m_raytraceTransform;
@@ -83,5 +114,9 @@ private:
 
 	std::vector<Vertex_PCU> m_mesh;
 
-	std::vector<Rigidbody*> m_tileRigidbodies;
+	Rigidbody*				m_tileGridRigidbody = nullptr;
+
+	GridPathfinder			m_pathfinder;
+	std::map<EntityId, TileMapNavPath> m_navPaths;
+	std::vector<GridPathResult> m_completedPathResults;
 };